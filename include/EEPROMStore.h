@@ -1,35 +1,66 @@
-// Only supported for AVR micros because we use the special EEMEM directive
-// to automatically allocated memory in the eeprom. 
-#if defined(__AVR__)
+// Only supported for AVR micros (and the native build, which emulates the
+// avr-libc eeprom API). 
+#if defined(__AVR__) || defined(NATIVE_HAL)
 
+#include <stddef.h>
 #include <avr/eeprom.h>
 #include <util/crc16.h>
 
-template <class TData> class EEPROMStore
+// TAddress is the eeprom offset of the stored record. The layout is fixed, so
+// it does not depend on where the store object is placed in RAM. 
+//
+// The record is kept in two banks. Save() writes the bank which is not the
+// current one (sequence number, data, checksum last), so a power cut during
+// the write leaves a bank with a bad checksum and the other bank still holds
+// the previous record: a torn save always loads as the old or the new data.
+// Load() takes the valid bank with the newer sequence number. 
+template <class TData, uint16_t TAddress = 0> class EEPROMStore
 {
-  // The data stored in the eprom. The EEMEM complier attribute instructs
-  // the complier to locate this variable in the eeprom. 
-  struct EEMEM CEEPROMData
+  // One bank of the record. The checksum covers the sequence number and the data. 
+  struct CEEPROMBank
   {
-    uint16_t m_uChecksum;
+    uint8_t m_uSequence;
     TData m_UserData;
+    uint16_t m_uChecksum;
+  };
+
+  static const uint8_t BankCount = 2;
+
+  static void *BankAddress(uint8_t uBank)
+  {
+    return reinterpret_cast<void *>(TAddress + uBank * sizeof(CEEPROMBank));
+  }
 
-  } m_EEPROMData;
+  uint8_t m_uBank;            // Bank of the loaded record
+  uint8_t m_uSequence;        // Sequence number of the loaded record
 
 public:
   TData Data;
 
-  EEPROMStore()
+  // Size of the eeprom area used by the store
+  static const size_t StorageSize = BankCount * sizeof(CEEPROMBank);
+
+  // The constructor only sets the defaults, the eeprom is read by Begin(), so
+  // a global store does no eeprom access before setup(). 
+  EEPROMStore() : m_uBank(0), m_uSequence(0)
+  {
+    Reset();
+  }
+
+  // Loads the stored record, keeps the defaults when no record is valid. 
+  bool Begin()
   {
+    if (Load())
+      return true;
+
     Reset();
-    if (!Load())
-      Reset();
+    return false;
   }
 
   bool Load()
   {
-    CEEPROMData WorkingCopy;
-    if (Load(WorkingCopy))
+    CEEPROMBank WorkingCopy;
+    if (LoadCurrent(WorkingCopy))
     {
       memcpy(&Data, &WorkingCopy.m_UserData, sizeof(TData));
       return true;
@@ -43,15 +74,28 @@ public:
     // We only save if the current version in the eeprom doesn't match the data we plan to save. 
     // This helps protect the eeprom against save called many times within the arduino loop,
     // though it makes things a little slower. 
-    uint16_t uChecksum = CalculateChecksum(Data);
-    CEEPROMData StoredVersion;
-    if (!Load(StoredVersion) || StoredVersion.m_uChecksum != uChecksum || memcmp(&StoredVersion.m_UserData, &Data, sizeof(Data)) != 0)
-    {
-      eeprom_write_word(&m_EEPROMData.m_uChecksum, uChecksum);
-      eeprom_write_block(&Data, &m_EEPROMData.m_UserData, sizeof(Data));
-      return true; 
-    }
-    return false; 
+    CEEPROMBank StoredVersion;
+    bool bValid = LoadCurrent(StoredVersion);
+    if (bValid && memcmp(&StoredVersion.m_UserData, &Data, sizeof(Data)) == 0)
+      return false;
+
+    // Without a valid bank the record goes to bank 0. 
+    uint8_t uBank = bValid ? (uint8_t)((m_uBank + 1) % BankCount) : 0;
+
+    CEEPROMBank NewVersion;
+    memset(&NewVersion, 0, sizeof(NewVersion));
+    NewVersion.m_uSequence = bValid ? (uint8_t)(m_uSequence + 1) : 0;
+    memcpy(&NewVersion.m_UserData, &Data, sizeof(Data));
+    NewVersion.m_uChecksum = CalculateChecksum(NewVersion);
+
+    // Field by field in the bank order, the checksum is the commit marker. 
+    uint8_t *pBank = reinterpret_cast<uint8_t *>(BankAddress(uBank));
+    eeprom_update_block(&NewVersion, pBank, offsetof(CEEPROMBank, m_uChecksum));
+    eeprom_update_word(reinterpret_cast<uint16_t *>(pBank + offsetof(CEEPROMBank, m_uChecksum)), NewVersion.m_uChecksum);
+
+    m_uBank = uBank;
+    m_uSequence = NewVersion.m_uSequence;
+    return true; 
   }
 
   void Reset()
@@ -60,18 +104,40 @@ public:
   }
 
 private:
-  bool Load(CEEPROMData &Result)
+  // Loads the newest valid bank, remembers its position for the next Save(). 
+  bool LoadCurrent(CEEPROMBank &Result)
   {
-    eeprom_read_block(&Result, (const void *)&m_EEPROMData, sizeof(CEEPROMData));
-    uint16_t uChecksum = CalculateChecksum(Result.m_UserData);
-    return uChecksum == Result.m_uChecksum;
+    bool bValid = false;
+
+    for (uint8_t uBank = 0; uBank < BankCount; uBank++)
+    {
+      CEEPROMBank Candidate;
+      eeprom_read_block(&Candidate, BankAddress(uBank), sizeof(CEEPROMBank));
+
+      if (CalculateChecksum(Candidate) != Candidate.m_uChecksum)
+        continue;
+
+      // The sequence number wraps, the banks differ by one save. 
+      if (!bValid || (int8_t)(Candidate.m_uSequence - m_uSequence) > 0)
+      {
+        memcpy(&Result, &Candidate, sizeof(CEEPROMBank));
+        m_uBank = uBank;
+        m_uSequence = Candidate.m_uSequence;
+        bValid = true;
+      }
+    }
+
+    return bValid;
+  }
+
+  uint16_t CalculateChecksum(const CEEPROMBank &Bank) const
+  {
+    return CalculateChecksum(reinterpret_cast<const uint8_t *>(&Bank), offsetof(CEEPROMBank, m_uChecksum));
   }
 
-  uint16_t CalculateChecksum(const TData &TestData) const
+  uint16_t CalculateChecksum(const uint8_t *pRawData, size_t szData) const
   {
     uint16_t uChecksum = 0;
-    const uint8_t *pRawData = reinterpret_cast<const uint8_t *>(&TestData);
-    size_t szData = sizeof(TestData);
 
     while (szData--)
     {
@@ -81,6 +147,47 @@ private:
     return uChecksum;
   }
 };
+
+// Loads the record of the first release store: the checksum (crc16 of the data)
+// followed by the data, at the RAM address of the store object of that build,
+// because EEMEM did not apply to the class member. This build can not know that
+// address, so the whole eeprom is searched. Data.Valid() rejects the windows
+// which pass the checksum by chance; two different records fail the search. 
+template <class TData> bool EEPROMLegacyLoad(TData &Data)
+{
+  struct CLegacyRecord
+  {
+    uint16_t m_uChecksum;
+    TData m_UserData;
+  };
+
+  bool bFound = false;
+
+  for (size_t szAddress = 0; szAddress + sizeof(CLegacyRecord) <= E2END + 1; szAddress++)
+  {
+    CLegacyRecord Candidate;
+    eeprom_read_block(&Candidate, reinterpret_cast<const void *>(szAddress), sizeof(CLegacyRecord));
+
+    uint16_t uChecksum = 0;
+    const uint8_t *pRawData = reinterpret_cast<const uint8_t *>(&Candidate.m_UserData);
+
+    for (size_t i = 0; i < sizeof(TData); i++)
+    {
+      uChecksum = _crc16_update(uChecksum, pRawData[i]);
+    }
+
+    if (uChecksum != Candidate.m_uChecksum || !Candidate.m_UserData.Valid())
+      continue;
+
+    if (bFound && memcmp(&Data, &Candidate.m_UserData, sizeof(TData)) != 0)
+      return false;
+
+    memcpy(&Data, &Candidate.m_UserData, sizeof(TData));
+    bFound = true;
+  }
+
+  return bFound;
+}
 #else
-#error EEPROMStore is only supported on AVR micros.
+#error EEPROMStore is only supported on AVR micros and the native build.
 #endif
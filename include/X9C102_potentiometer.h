@@ -23,6 +23,8 @@
 /*********************************************************************************************************************/
 
 #include <Arduino.h>
+#include "cs_port_LL.h"
+#include "inc_timer_LL.h"
 
 /*********************************************************************************************************************/
 /*-----------------------------------------------------Constants-----------------------------------------------------*/
@@ -32,7 +34,9 @@
 #define MIN_RESISTANCE (1)
 
 #define POTENTIOMETER_RESOLUTION (100)
-#define POTENTIOMETER_TICK (1)
+#ifndef POTENTIOMETER_TICK
+#define POTENTIOMETER_TICK (1)                   /* INC low/high time in us, datasheet tIL/tIH min 1 us */
+#endif
 
 /*********************************************************************************************************************/
 /*--------------------------------------------------------PVs--------------------------------------------------------*/
@@ -47,9 +51,6 @@ typedef enum
 /*********************************************************************************************************************/
 /*------------------------------------------------------Classes------------------------------------------------------*/
 /*********************************************************************************************************************/
-#ifdef __cplusplus
-extern "C" {
-#endif
 
 class X9C102_potentiometer 
 {
@@ -63,14 +64,79 @@ private:
     void setValue(uint8_t val);
 
 public:
+    X9C102_potentiometer(void);
     X9C102_potentiometer(uint8_t UD, uint8_t INC);
     void potentiometerInit(void);
+    void potentiometerInit(uint8_t UD, uint8_t INC);
     void potentiometerSetVal(uint8_t val, potentiometer_direction dir);
-    void setValueLeftChannel(uint8_t val);
-};
+    void potentiometerStepVal(uint8_t from, uint8_t to, potentiometer_direction dir);
+    void potentiometerIdle(void);
 
-#ifdef  __cplusplus
-}
-#endif
+    /**
+     * @brief Function sets the value of the potentiometer behind the given CS line (LeftChipSelect, ...) in one
+     *        transaction: the line is selected for the set and released at the end of the scope with INC low, so
+     *        the wiper is not stored
+     * @param argument: uint8_t val, potentiometer_direction dir
+     * @retval None
+     */
+    template <class TChipSelect>
+    void potentiometerTransaction(uint8_t val, potentiometer_direction dir)
+    {
+        {
+            ScopedChipSelect<TChipSelect> chip_select;
+            potentiometerSetVal(val, dir);
+        }
+
+        potentiometerIdle();
+    }
+
+    /**
+     * @brief Function sets the value of every potentiometer of the channel mask in one transaction: the chips
+     *        share INC and U/D, so they are pulsed together. The wipers are not stored
+     * @param argument: uint8_t channel_mask, uint8_t val, potentiometer_direction dir
+     * @retval None
+     */
+    void potentiometerTransaction(uint8_t channel_mask, uint8_t val, potentiometer_direction dir)
+    {
+        {
+            ScopedChannelSelect chip_select(channel_mask);
+            potentiometerSetVal(val, dir);
+        }
+
+        potentiometerIdle();
+    }
+
+    /**
+     * @brief Function moves every potentiometer of the channel mask from one value to another in one transaction,
+     *        without re-homing the wipers. The wipers are not stored, no move - no transaction
+     * @param argument: uint8_t channel_mask, uint8_t from, uint8_t to, potentiometer_direction dir
+     * @retval None
+     */
+    void potentiometerStepTransaction(uint8_t channel_mask, uint8_t from, uint8_t to, potentiometer_direction dir)
+    {
+        if (from == to) {
+            return;                             /* INC would still be high: the release would store the wiper */
+        }
+
+        {
+            ScopedChannelSelect chip_select(channel_mask);
+            potentiometerStepVal(from, to, dir);
+        }
+
+        potentiometerIdle();
+    }
+
+    /**
+     * @brief Function stores the wipers of the channel mask in their non-volatile memory: the CS lines are selected
+     *        and released with INC high, the X9C102 is busy for POTENTIOMETER_STORE_TIME afterwards
+     * @param argument: uint8_t channel_mask
+     * @retval None
+     */
+    void potentiometerStoreTransaction(uint8_t channel_mask)
+    {
+        ScopedChannelSelect chip_select(channel_mask);
+        delayMicroseconds(POTENTIOMETER_TICK);
+    }
+};
 
 #endif
\ No newline at end of file
@@ -7,7 +7,20 @@
 *    @license    MIT (see License.txt)
 *
 *    @description:
-*    Implements the low level port intercation for X9C102 potentiometer CS line control
+*    Implements the low level port intercation for X9C102 potentiometer CS line control. The CS lines are active
+*    low and addressed by a channel bitmask (CHANNEL_MASK(channel), main.h), any subset of the channels can be
+*    selected at once:
+*
+*      CS_FANOUT == STD_OFF - 2 channels on PORTC bits: PC7 - channel 0, left (pin 13), PC6 - channel 1, right
+*                             (pin 5). Only the CS bits are changed, the other PORTC bits (outputs or pull-ups) are
+*                             kept. A single line is changed with one SBI/CBI instruction, several lines with a
+*                             read-modify-write guarded against interrupts. A channel mask known at run time
+*                             (ScopedChannelSelect) is switched onto the same compile-time ChipSelect code.
+*      CS_FANOUT == STD_ON  - up to 8 channels on the outputs Q0..Q7 of a 74HC595 shift register: SER - MOSI
+*                             (PB2), SRCLK - SCK (PB1), RCLK - CS_FANOUT_LATCH_GPIO, /OE tied low. Every change
+*                             shifts the whole CS state out by the SPI peripheral (1 byte) and latches it.
+*
+*    All functions can be called from an ISR as well.
 *
 *    @section  HISTORY
 *    v1.0  - First version
@@ -24,19 +37,178 @@
 /*********************************************************************************************************************/
 
 #include <Arduino.h>
+#include <util/atomic.h>
+
+#include "main.h"
 
 /*********************************************************************************************************************/
 /*------------------------------------------------------Macros-------------------------------------------------------*/
 /*********************************************************************************************************************/
 
-#define PORTB_BITMASK       (uint8_t)((1 << DDB5) | (1 << DDB5))
+#define PORTB_BITMASK       (uint8_t)((1 << DDB5) | (1 << DDB6))          /* INC (pin 9) and U/D (pin 10) */
 #define PORTC_BITMASK       (uint8_t)((1 << DDC6) | (1 << DDC7))
 
+#define CS_LEFT_CHANNEL_MASK    (uint8_t)(1 << PORTC7)
+#define CS_RIGHT_CHANNEL_MASK   (uint8_t)(1 << PORTC6)
+#define CS_ALL_CHANNELS_MASK    (uint8_t)(CS_LEFT_CHANNEL_MASK | CS_RIGHT_CHANNEL_MASK)
+
+#define CS_FANOUT_SPI_BITMASK   (uint8_t)((1 << DDB0) | (1 << DDB1) | (1 << DDB2))   /* SS (master mode), SCK, MOSI */
+#define CS_FANOUT_LATCH_MASK    (uint8_t)(1 << PORTD4)                     /* CS_FANOUT_LATCH_GPIO */
+#define CS_FANOUT_MAX_CHANNELS  (8)
+
 /*********************************************************************************************************************/
 /*------------------------------------------------Function Prototypes------------------------------------------------*/
 /*********************************************************************************************************************/
 
 void CSportInit(void);
-void CSportSet(uint8_t state);
+void CSportSelect(uint8_t channel_mask);
+void CSportRelease(uint8_t channel_mask);
+uint8_t CSportSelected(void);
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Function maps a channel mask to the PORTC CS bits of the direct CS lines
+ * @param argument: uint8_t channel_mask
+ * @retval uint8_t
+ */
+constexpr uint8_t CSportMask(uint8_t channel_mask)
+{
+  return (uint8_t)(((channel_mask & CHANNEL_MASK(LEFT_CHANNEL_INDEX)) ? CS_LEFT_CHANNEL_MASK : 0) |
+                   ((channel_mask & CHANNEL_MASK(RIGHT_CHANNEL_INDEX)) ? CS_RIGHT_CHANNEL_MASK : 0));
+}
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*CS lines of the given channel mask, select drives them low, release high*/
+template <uint8_t TChannelMask>
+class ChipSelect
+{
+private:
+  static_assert(TChannelMask != 0 && (TChannelMask & (uint8_t)~ALL_CHANNELS_MASK) == 0,
+                "mask must contain configured channels only");
+
+  static constexpr uint8_t port_mask = CSportMask(TChannelMask);
+  static constexpr bool single_line_f = (port_mask & (port_mask - 1)) == 0;
+
+public:
+  static void select(void)
+  {
+#if (CS_FANOUT == STD_OFF)
+    if constexpr (single_line_f) {
+      PORTC &= (uint8_t)~port_mask;             /* CBI */
+    } else {
+      ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        PORTC &= (uint8_t)~port_mask;
+      }
+    }
+#else
+    CSportSelect(TChannelMask);
+#endif
+  }
+
+  static void release(void)
+  {
+#if (CS_FANOUT == STD_OFF)
+    if constexpr (single_line_f) {
+      PORTC |= port_mask;                       /* SBI */
+    } else {
+      ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        PORTC |= port_mask;
+      }
+    }
+#else
+    CSportRelease(TChannelMask);
+#endif
+  }
+
+  static bool isSelected(void)
+  {
+#if (CS_FANOUT == STD_OFF)
+    return (PORTC & port_mask) == 0;
+#else
+    return (CSportSelected() & TChannelMask) == TChannelMask;
+#endif
+  }
+};
+
+/*Selects the CS lines for the lifetime of the object, inlined to the same SBI/CBI as the hand-written calls*/
+template <class TChipSelect>
+class ScopedChipSelect
+{
+public:
+  ScopedChipSelect(void) { TChipSelect::select(); }
+  ~ScopedChipSelect(void) { TChipSelect::release(); }
+
+  ScopedChipSelect(const ScopedChipSelect &) = delete;
+  ScopedChipSelect &operator=(const ScopedChipSelect &) = delete;
+};
+
+/*Selects the CS lines of a channel mask known at run time for the lifetime of the object. With the direct CS lines
+  the mask is dispatched to the ChipSelect specialisations, so a single line is still one SBI/CBI, with the fan-out
+  it goes to CSportSelect()/CSportRelease()*/
+class ScopedChannelSelect
+{
+private:
+  uint8_t _channel_mask;
+
+  template <uint8_t TChannelMask, bool TSelect>
+  static void apply(void)
+  {
+    if constexpr (TSelect) {
+      ChipSelect<TChannelMask>::select();
+    } else {
+      ChipSelect<TChannelMask>::release();
+    }
+  }
+
+  template <bool TSelect>
+  static void dispatch(uint8_t channel_mask)
+  {
+#if (CS_FANOUT == STD_OFF)
+    switch (channel_mask & ALL_CHANNELS_MASK) {
+    case CHANNEL_MASK(LEFT_CHANNEL_INDEX):
+      apply<CHANNEL_MASK(LEFT_CHANNEL_INDEX), TSelect>();
+      break;
+
+#if (VU_CHANNEL_COUNT > 1)
+    case CHANNEL_MASK(RIGHT_CHANNEL_INDEX):
+      apply<CHANNEL_MASK(RIGHT_CHANNEL_INDEX), TSelect>();
+      break;
+
+    case ALL_CHANNELS_MASK:
+      apply<ALL_CHANNELS_MASK, TSelect>();
+      break;
+#endif
+
+    default:
+      break;
+    }
+#else
+    if constexpr (TSelect) {
+      CSportSelect(channel_mask);
+    } else {
+      CSportRelease(channel_mask);
+    }
+#endif
+  }
+
+public:
+  explicit ScopedChannelSelect(uint8_t channel_mask) : _channel_mask(channel_mask) { dispatch<true>(channel_mask); }
+  ~ScopedChannelSelect(void) { dispatch<false>(_channel_mask); }
+
+  ScopedChannelSelect(const ScopedChannelSelect &) = delete;
+  ScopedChannelSelect &operator=(const ScopedChannelSelect &) = delete;
+};
+
+typedef ChipSelect<CHANNEL_MASK(LEFT_CHANNEL_INDEX)> LeftChipSelect;
+#if (VU_CHANNEL_COUNT > 1)
+typedef ChipSelect<CHANNEL_MASK(RIGHT_CHANNEL_INDEX)> RightChipSelect;
+#endif
+typedef ChipSelect<ALL_CHANNELS_MASK> AllChipSelect;
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,302 @@
+/**
+**********************************************************************************************************************
+*    @file           : debug_log.h
+*    @brief          : debug_log.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Non-blocking buffered back end for the DEBUG/DEBUG_NL macros. The print calls only enqueue bytes into a
+*    fixed ring buffer, the main loop drains the buffer into the real serial port within a per-iteration byte budget.
+*    Producer and consumer are both the main loop context, the buffer must not be written from the ISRs.
+*
+*    The buffer holds whole records: a text line between beginRecord() and endRecord(), or a single write() call
+*    outside of them (a COBS frame of TelemetryWriter). The space of a record is reserved before its bytes are
+*    stored, so on overflow a record is dropped or overwritten as a whole and its delimiter never goes alone.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef DEBUG_LOG_H_
+#define DEBUG_LOG_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <Arduino.h>
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define DEBUG_LOG_DROP_NEWEST       (0)               /* Full buffer: the new record is discarded */
+#define DEBUG_LOG_DROP_OLDEST       (1)               /* Full buffer: the oldest unsent records are overwritten */
+#define DEBUG_LOG_RECORD_BYTES      (8)               /* Average record size the record boundary queue is sized for */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+template <uint16_t TSize, uint8_t TPolicy> class DebugLogBuffer : public Print
+{
+  static_assert((TSize & (TSize - 1)) == 0, "DebugLogBuffer size must be a power of 2");
+  static_assert(TSize <= 256, "DebugLogBuffer indexes are 8 bit");
+  static_assert(TSize >= 2 * DEBUG_LOG_RECORD_BYTES, "DebugLogBuffer too small");
+
+private:
+  static const uint8_t RecordSlots = (uint8_t)(TSize / DEBUG_LOG_RECORD_BYTES);
+
+  uint8_t _buffer[TSize];
+  uint8_t _ends[RecordSlots];                   /* End of every complete record, oldest first */
+  uint8_t _head;                                /* End of the open record */
+  uint8_t _commit;                              /* End of the last complete record, start of the open record */
+  uint8_t _tail;                                /* Next byte to send */
+  uint8_t _first;                               /* _ends index of the oldest record */
+  uint8_t _records;                             /* Complete records in the buffer */
+  bool _open_f;                                 /* Between beginRecord() and endRecord() */
+  bool _drop_f;                                 /* Open record dropped, the rest of its bytes is ignored */
+  bool _sending_f;                              /* Oldest record partially sent, it can not be dropped anymore */
+  uint16_t _overflow_count;
+
+  /**
+   * @brief Function counts one lost record (saturated)
+   * @param argument: None
+   * @retval None
+   */
+  void countOverflow(void)
+  {
+    if (_overflow_count != UINT16_MAX) {
+      ++_overflow_count;
+    }
+  }
+
+  /**
+   * @brief Function drops the oldest complete record which is not being sent. The rest of a partially sent record
+   *        is moved over the dropped one, so the sink still gets whole records
+   * @param argument: None
+   * @retval bool: false if there is no record to drop
+   */
+  bool dropOldest(void)
+  {
+    if (!_sending_f) {
+      if (_records == 0) {
+        return false;
+      }
+
+      _tail = _ends[_first];
+    } else {
+      if (_records < 2) {
+        return false;
+      }
+
+      uint8_t next_end = _ends[(_first + 1) & (RecordSlots - 1)];
+      uint8_t rest = (uint8_t)((_ends[_first] - _tail) & (TSize - 1));
+
+      for (uint8_t i = rest; i > 0; i--) {
+        _buffer[(next_end - rest + i - 1) & (TSize - 1)] = _buffer[(_tail + i - 1) & (TSize - 1)];
+      }
+
+      _tail = (uint8_t)((next_end - rest) & (TSize - 1));
+    }
+
+    _first = (uint8_t)((_first + 1) & (RecordSlots - 1));
+    --_records;
+    countOverflow();
+
+    return true;
+  }
+
+  /**
+   * @brief Function makes room for size more bytes of the open record, applies the overflow policy
+   * @param argument: uint16_t size
+   * @retval bool: false if the room can not be made, the open record has to be dropped
+   */
+  bool reserve(uint16_t size)
+  {
+    while ((uint16_t)((TSize - 1) - pending()) < size) {
+      if (TPolicy == DEBUG_LOG_DROP_NEWEST || !dropOldest()) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Function appends one byte to the open record, drops the whole record if the byte does not fit
+   * @param argument: uint8_t value
+   * @retval None
+   */
+  void put(uint8_t value)
+  {
+    if (_drop_f) {
+      return;
+    }
+
+    if (!reserve(1)) {
+      _drop_f = true;
+      _head = _commit;
+      return;
+    }
+
+    _buffer[_head] = value;
+    _head = (uint8_t)((_head + 1) & (TSize - 1));
+  }
+
+public:
+  DebugLogBuffer()
+    : _head(0), _commit(0), _tail(0), _first(0), _records(0), _open_f(false), _drop_f(false), _sending_f(false),
+      _overflow_count(0)
+  {
+  }
+
+  /**
+   * @brief Function opens a record, the bytes written until endRecord() are kept or dropped together
+   * @param argument: None
+   * @retval None
+   */
+  void beginRecord(void)
+  {
+    _open_f = true;
+    _drop_f = false;
+    _head = _commit;
+  }
+
+  /**
+   * @brief Function completes the open record, from now on the drain can send it
+   * @param argument: None
+   * @retval bool: true if the record was stored, false if it was dropped (counted as overflow)
+   */
+  bool endRecord(void)
+  {
+    _open_f = false;
+
+    if (!_drop_f && _head == _commit) {
+      return true;                              /* Empty record */
+    }
+
+    if (_drop_f || (_records == RecordSlots && (TPolicy == DEBUG_LOG_DROP_NEWEST || !dropOldest()))) {
+      _drop_f = false;
+      _head = _commit;
+      countOverflow();
+      return false;
+    }
+
+    _ends[(_first + _records) & (RecordSlots - 1)] = _head;
+    ++_records;
+    _commit = _head;
+
+    return true;
+  }
+
+  /**
+   * @brief Function enqueues one byte: into the open record, otherwise as a record of its own
+   * @param argument: uint8_t value
+   * @retval size_t: 1 if the byte was stored
+   */
+  virtual size_t write(uint8_t value)
+  {
+    if (_open_f) {
+      put(value);
+      return _drop_f ? 0 : 1;
+    }
+
+    beginRecord();
+    put(value);
+
+    return endRecord() ? 1 : 0;
+  }
+
+  /**
+   * @brief Function enqueues the bytes: into the open record, otherwise as one record (the space of the whole record
+   *        is reserved first)
+   * @param argument: const uint8_t *buffer, size_t size
+   * @retval size_t: number of bytes stored
+   */
+  virtual size_t write(const uint8_t *buffer, size_t size)
+  {
+    const bool record_f = !_open_f;
+
+    if (record_f) {
+      beginRecord();
+
+      if (size > (size_t)(TSize - 1) || !reserve((uint16_t)size)) {
+        _drop_f = true;
+      }
+    }
+
+    for (size_t i = 0; i < size; i++) {
+      put(buffer[i]);
+    }
+
+    if (record_f) {
+      return endRecord() ? size : 0;
+    }
+
+    return _drop_f ? 0 : size;
+  }
+
+  using Print::write;
+
+  /**
+   * @brief Function sends at most budget bytes of the complete records to the sink
+   * @param argument: Print &sink, uint8_t budget
+   * @retval uint8_t: number of bytes sent
+   */
+  uint8_t drain(Print &sink, uint8_t budget)
+  {
+    uint8_t sent = 0;
+
+    while (sent < budget && _records != 0) {
+      sink.write(_buffer[_tail]);
+      _tail = (uint8_t)((_tail + 1) & (TSize - 1));
+      ++sent;
+
+      _sending_f = (_tail != _ends[_first]);
+
+      if (!_sending_f) {
+        _first = (uint8_t)((_first + 1) & (RecordSlots - 1));
+        --_records;
+      }
+    }
+
+    return sent;
+  }
+
+  /**
+   * @brief Function returns the number of bytes waiting for the drain (the open record included)
+   * @param argument: None
+   * @retval uint8_t
+   */
+  uint8_t pending(void) const
+  {
+    return (uint8_t)((_head - _tail) & (TSize - 1));
+  }
+
+  /**
+   * @brief Function returns the number of bytes which can be enqueued without overflow, 0 if no record fits
+   * @param argument: None
+   * @retval uint8_t
+   */
+  uint8_t room(void) const
+  {
+    return (_records == RecordSlots) ? 0 : (uint8_t)((TSize - 1) - pending());
+  }
+
+  /**
+   * @brief Function returns the number of records lost because of the buffer overflow (saturated)
+   * @param argument: None
+   * @retval uint16_t
+   */
+  uint16_t getOverflowCount(void) const
+  {
+    return _overflow_count;
+  }
+};
+
+#endif
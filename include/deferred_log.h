@@ -0,0 +1,205 @@
+/**
+**********************************************************************************************************************
+*    @file           : deferred_log.h
+*    @brief          : deferred_log.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Deferred-formatting log back end for the LOG(fmt, ...) macro. Format strings use "{}" as argument placeholder
+*    and must be plain string literals.
+*
+*    Deferred mode: the log site ID is a compile-time FNV-1a hash of the format string, the string itself is not
+*    linked into the firmware. A log call emits TELEMETRY_RECORD_LOG record: | ID (2) | arguments |, every argument
+*    is prefixed with a type tag (size in bytes | LOG_ARG_SIGNED, or LOG_ARG_STRING + length). The build step
+*    tools/log_catalog.py collects the format strings into the host-side catalog, tools/log_decoder.py rebuilds
+*    the text.
+*
+*    Text mode: format strings are kept in flash (F()) and formatted on the device.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef DEFERRED_LOG_H_
+#define DEFERRED_LOG_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <Arduino.h>
+#include "telemetry.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define LOG_ARG_SIGNED              (uint8_t)(0x80)
+#define LOG_ARG_STRING              (uint8_t)(0x40)   /* Followed by length byte and characters */
+#define LOG_ARG_STRING_MAX          (uint8_t)(24)
+
+#define LOG_FNV_OFFSET_BASIS        (2166136261UL)
+#define LOG_FNV_PRIME               (16777619UL)
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Compile-time log site IDs---------------------------------------------*/
+/*********************************************************************************************************************/
+
+/* Forces the constant evaluation of the log site ID (string literal is not emitted) */
+template <uint16_t TId> struct LogId
+{
+  static const uint16_t value = TId;
+};
+
+constexpr uint32_t logFnv1a(const char *text, uint32_t hash = LOG_FNV_OFFSET_BASIS)
+{
+  return (*text == '\0') ? hash : logFnv1a(text + 1, (uint32_t)((hash ^ (uint8_t)*text) * LOG_FNV_PRIME));
+}
+
+constexpr uint16_t logFold(uint32_t hash)
+{
+  return (uint16_t)((hash >> 16) ^ (hash & 0xFFFF));
+}
+
+constexpr uint16_t logId(const char *format)
+{
+  return logFold(logFnv1a(format));
+}
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Deferred mode----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Function appends an integer argument: type tag (size | signed flag) and raw little-endian bytes
+ * @param argument: TelemetryWriter &writer, T value
+ * @retval None
+ */
+template <typename T> inline void logPut(TelemetryWriter &writer, T value)
+{
+  const uint8_t *raw = reinterpret_cast<const uint8_t *>(&value);
+
+  writer.putU8((uint8_t)(sizeof(T) | (((T)(-1) < (T)(0)) ? LOG_ARG_SIGNED : 0)));
+
+  for (uint8_t i = 0; i < sizeof(T); i++) {
+    writer.putU8(raw[i]);
+  }
+}
+
+/**
+ * @brief Function appends a string argument (RAM string), truncated to LOG_ARG_STRING_MAX characters
+ * @param argument: TelemetryWriter &writer, const char *value
+ * @retval None
+ */
+inline void logPut(TelemetryWriter &writer, const char *value)
+{
+  uint8_t length = (uint8_t)strnlen(value, LOG_ARG_STRING_MAX);
+
+  writer.putU8(LOG_ARG_STRING);
+  writer.putU8(length);
+
+  for (uint8_t i = 0; i < length; i++) {
+    writer.putU8((uint8_t)value[i]);
+  }
+}
+
+/**
+ * @brief Function appends a string argument (flash string), truncated to LOG_ARG_STRING_MAX characters
+ * @param argument: TelemetryWriter &writer, const __FlashStringHelper *value
+ * @retval None
+ */
+inline void logPut(TelemetryWriter &writer, const __FlashStringHelper *value)
+{
+  PGM_P text = reinterpret_cast<PGM_P>(value);
+  uint8_t length = (uint8_t)strnlen_P(text, LOG_ARG_STRING_MAX);
+
+  writer.putU8(LOG_ARG_STRING);
+  writer.putU8(length);
+
+  for (uint8_t i = 0; i < length; i++) {
+    writer.putU8(pgm_read_byte(text + i));
+  }
+}
+
+inline void logPutArgs(TelemetryWriter &writer)
+{
+  (void)writer;
+}
+
+template <typename T, typename... TArgs> inline void logPutArgs(TelemetryWriter &writer, T value, TArgs... rest)
+{
+  logPut(writer, value);
+  logPutArgs(writer, rest...);
+}
+
+/**
+ * @brief Function emits one deferred log record
+ * @param argument: TelemetryWriter &writer, uint16_t id - log site ID, TArgs... args
+ * @retval None
+ */
+template <typename... TArgs> void logEmit(TelemetryWriter &writer, uint16_t id, TArgs... args)
+{
+  writer.begin(TELEMETRY_RECORD_LOG);
+  writer.putU16(id);
+  logPutArgs(writer, args...);
+  writer.end();
+}
+
+/*********************************************************************************************************************/
+/*----------------------------------------------------Text mode------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Function prints the flash format string up to the next "{}" placeholder
+ * @param argument: Print &out, PGM_P format
+ * @retval PGM_P: position after the placeholder, NULL if the end of the format string is reached
+ */
+inline PGM_P logPrintUntilArg(Print &out, PGM_P format)
+{
+  char c;
+
+  while ((c = (char)pgm_read_byte(format)) != '\0') {
+    if (c == '{' && (char)pgm_read_byte(format + 1) == '}') {
+      return format + 2;
+    }
+
+    out.write((uint8_t)c);
+    ++format;
+  }
+
+  return NULL;
+}
+
+inline void logPrintArgs(Print &out, PGM_P format)
+{
+  while (format != NULL) {
+    format = logPrintUntilArg(out, format);
+  }
+}
+
+template <typename T, typename... TArgs> inline void logPrintArgs(Print &out, PGM_P format, T value, TArgs... rest)
+{
+  format = logPrintUntilArg(out, format);
+
+  if (format != NULL) {
+    out.print(value);
+    logPrintArgs(out, format, rest...);
+  }
+}
+
+/**
+ * @brief Function formats and prints one log line on the device
+ * @param argument: Print &out, const __FlashStringHelper *format, TArgs... args
+ * @retval None
+ */
+template <typename... TArgs> void logPrint(Print &out, const __FlashStringHelper *format, TArgs... args)
+{
+  logPrintArgs(out, reinterpret_cast<PGM_P>(format), args...);
+  out.println();
+}
+
+#endif
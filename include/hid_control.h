@@ -0,0 +1,135 @@
+/**
+**********************************************************************************************************************
+*    @file           : hid_control.h
+*    @brief          : hid_control.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    USB HID control interface (USB_HID_CONTROL). The object is a PluggableUSB module, so the device enumerates as
+*    a CDC + HID composite device and the USB serial keeps working. The host sends output reports on the interrupt
+*    OUT endpoint (or with SET_REPORT on the control pipe); the first byte is the report ID:
+*
+*    | 1 - consumer control | uint16 consumer usage (remote buttons: volume, track, play/pause), 0 - released |
+*    | 2 - levels           | uint8 value per channel, HID_CONTROL_VALUE_KEEP leaves the channel              |
+*    | 3 - preset           | uint8 action (0 - recall, 1 - store), uint8 slot                                 |
+*
+*    After every report the device answers with the input report 4 on the interrupt IN endpoint: the status of
+*    the report (consoleStatus values, serial_console.h) and the value of every channel. The same report is
+*    returned by GET_REPORT. The host tool is tools/vu_hid.py.
+*
+*    HidControl only moves the reports, the command handling is done by the firmware. The module is plugged by its
+*    constructor: the core enumerates the device before setup().
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef HID_CONTROL_H_
+#define HID_CONTROL_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <PluggableUSB.h>
+
+#include "main.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define HID_CONTROL_REPORT_CONSUMER         (uint8_t)(1)
+#define HID_CONTROL_REPORT_LEVELS           (uint8_t)(2)
+#define HID_CONTROL_REPORT_PRESET           (uint8_t)(3)
+#define HID_CONTROL_REPORT_STATE            (uint8_t)(4)
+
+#define HID_CONTROL_PRESET_RECALL           (uint8_t)(0)
+#define HID_CONTROL_PRESET_STORE            (uint8_t)(1)
+#define HID_CONTROL_VALUE_KEEP              (uint8_t)(0xFF)
+
+/* Report lengths incl. the report ID */
+#define HID_CONTROL_CONSUMER_SIZE           (3)
+#define HID_CONTROL_LEVELS_SIZE             (1 + VU_CHANNEL_COUNT)
+#define HID_CONTROL_PRESET_SIZE             (3)
+#define HID_CONTROL_STATE_SIZE              (2 + VU_CHANNEL_COUNT)
+#define HID_CONTROL_MAX_REPORT_SIZE         (HID_CONTROL_STATE_SIZE)
+
+/* Consumer page usages taken from the host (HID Usage Tables, Consumer page 0x0C) */
+#define HID_USAGE_SCAN_NEXT_TRACK           (uint16_t)(0x00B5)        /* Next channel (right button) */
+#define HID_USAGE_SCAN_PREVIOUS_TRACK       (uint16_t)(0x00B6)        /* Previous channel (left button) */
+#define HID_USAGE_PLAY_PAUSE                (uint16_t)(0x00CD)        /* Commit */
+#define HID_USAGE_VOLUME_INCREMENT          (uint16_t)(0x00E9)
+#define HID_USAGE_VOLUME_DECREMENT          (uint16_t)(0x00EA)
+#define HID_USAGE_FAST_FORWARD              (uint16_t)(0x00B3)        /* Coarse up (full resolution) */
+#define HID_USAGE_REWIND                    (uint16_t)(0x00B4)        /* Coarse down (full resolution) */
+
+/* HID class */
+#define HID_CONTROL_DESCRIPTOR_TYPE         (uint8_t)(0x21)
+#define HID_CONTROL_REPORT_DESCRIPTOR_TYPE  (uint8_t)(0x22)
+#define HID_CONTROL_GET_REPORT              (uint8_t)(0x01)
+#define HID_CONTROL_GET_IDLE                (uint8_t)(0x02)
+#define HID_CONTROL_GET_PROTOCOL            (uint8_t)(0x03)
+#define HID_CONTROL_SET_REPORT              (uint8_t)(0x09)
+#define HID_CONTROL_SET_IDLE                (uint8_t)(0x0A)
+#define HID_CONTROL_SET_PROTOCOL            (uint8_t)(0x0B)
+
+static_assert(HID_CONTROL_MAX_REPORT_SIZE <= USB_EP_SIZE, "HID report beyond the endpoint size");
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*HID class descriptor with one report descriptor*/
+struct HidControlClassDescriptor
+{
+  uint8_t len;
+  uint8_t dtype;
+  uint8_t bcd_hid_low;
+  uint8_t bcd_hid_high;
+  uint8_t country;
+  uint8_t descriptor_count;
+  uint8_t report_dtype;
+  uint8_t report_length_low;
+  uint8_t report_length_high;
+};
+
+/*Interface descriptor set of the module: interface, HID class, interrupt IN and OUT endpoints*/
+struct HidControlDescriptor
+{
+  InterfaceDescriptor interface;
+  HidControlClassDescriptor hid;
+  EndpointDescriptor in;
+  EndpointDescriptor out;
+};
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+class HidControl : public PluggableUSBModule
+{
+private:
+  uint8_t _endpoint_type[2];
+  uint8_t _idle;
+  uint8_t _protocol;
+  uint8_t _state[HID_CONTROL_STATE_SIZE];       /* Last input report, for GET_REPORT */
+  volatile uint8_t _control_length;             /* SET_REPORT received in the USB interrupt, 0 - none */
+  uint8_t _control_report[HID_CONTROL_MAX_REPORT_SIZE];
+
+protected:
+  int getInterface(uint8_t *interface_count) override;
+  int getDescriptor(USBSetup &setup) override;
+  bool setup(USBSetup &setup) override;
+
+public:
+  HidControl();
+  uint8_t read(uint8_t *report);
+  bool sendState(uint8_t status, const uint8_t *values);
+};
+
+#endif
@@ -0,0 +1,63 @@
+/**
+**********************************************************************************************************************
+*    @file           : inc_timer_LL.h
+*    @brief          : inc_timer_LL.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Implements the X9C102 INC pulse generation by the Timer1 output compare (POTENTIOMETER_HW_PULSES == STD_ON).
+*    INC has to be on OC1A (PB5, pin 9). The timer runs in the normal mode at clk/1 and toggles OC1A on every
+*    compare match, so every edge is placed by the hardware. The compare match ISR counts the edges and arms the
+*    next one half a period later; a late ISR (other interrupts) only makes that phase longer, never shorter, and
+*    can neither add nor drop a pulse. After the last edge the ISR stops the timer and gives PB5 back to PORTB,
+*    INC stays low, so the CS release does not store the wiper. The caller sleeps in the idle mode for the burst,
+*    the CPU is busy only in the ISR.
+*
+*    OC1A follows INC: it is forced high by INCtimerInit() and INCtimerIdle() (after the CS release), a burst starting
+*    high has an odd number of edges, a burst starting low (the value steps after the reset) an even one.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef INC_TIMER_LL_H_
+#define INC_TIMER_LL_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <Arduino.h>
+
+#include "main.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#ifndef POTENTIOMETER_HW_TICK
+#define POTENTIOMETER_HW_TICK   (4)                     /* INC low/high time in us, the compare ISR has to fit in */
+#endif
+
+#define INC_TIMER_HALF_PERIOD   (uint16_t)((F_CPU / 1000000UL) * POTENTIOMETER_HW_TICK)    /* Timer1 clocks */
+#define INC_TIMER_MIN_LEAD      (uint16_t)(F_CPU / 1000000UL)  /* Next edge >= 1 us after the ISR (tIL/tIH min) */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define INC_TIMER_OC1A_MASK     (uint8_t)(1 << PORTB5)  /* INC (pin 9) */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+
+void INCtimerInit(void);
+void INCtimerPulses(uint16_t count);
+void INCtimerIdle(void);
+
+#endif
@@ -0,0 +1,58 @@
+/**
+**********************************************************************************************************************
+*    @file           : json_writer.h
+*    @brief          : json_writer.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Minimal streaming JSON writer for flat objects. Key/value pairs are written straight to the Print sink,
+*    keys are stored in flash (F() macro). There is no document buffer, so there is no capacity to mis-size.
+*
+*    Usage:
+*      JsonWriter json(Serial);
+*      json.beginObject();
+*      json.add(F("free_ram"), profiler.getFreeRAM());
+*      json.endObject();                          -> {"free_ram":1234}\n
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef JSON_WRITER_H_
+#define JSON_WRITER_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <Arduino.h>
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+class JsonWriter
+{
+private:
+  Print &_sink;
+  bool _first_f;
+
+  void key(const __FlashStringHelper *name);
+
+public:
+  explicit JsonWriter(Print &sink);
+  void beginObject(void);
+  void add(const __FlashStringHelper *name, long value);
+  void add(const __FlashStringHelper *name, unsigned long value);
+  void add(const __FlashStringHelper *name, int value);
+  void add(const __FlashStringHelper *name, unsigned int value);
+  void add(const __FlashStringHelper *name, bool value);
+  void add(const __FlashStringHelper *name, const char *value);
+  void endObject(void);
+};
+
+#endif
@@ -31,6 +31,9 @@
 #define UD_POTENTIOMETER_GPIO               (uint8_t)(10)
 #define INC_POTENTIOMETER_GPIO              (uint8_t)(9)
 
+#define CS_FANOUT_LATCH_GPIO                (uint8_t)(4)              /* 74HC595 RCLK (PD4), SER - MOSI, SRCLK - SCK */
+#define UNIT_BUS_DE_GPIO                    (uint8_t)(18)             /* A0 (PF7): RS-485 DE and /RE, on RX1/TX1 */
+
 #define DEBUG_RX                            (uint8_t)(7)              /* Software serial debugger GPIO RX pin*/
 #define DEBUG_TX                            (uint8_t)(6)              /* Software serial debugger GPIO TX pin*/
 
@@ -40,54 +43,213 @@
 #define STD_ON                              (1)
 #define STD_OFF                             (0)
 
+/* Feature switches, can be overridden from the build flags (-D SAMPLING_PROFILER=STD_OFF) */
+
+#ifndef DEBUG_PRINTER
 #define DEBUG_PRINTER                       (STD_OFF)
+#endif
+#ifndef SOFTWARE_SERIAL_DEBUG
 #define SOFTWARE_SERIAL_DEBUG               (STD_OFF)
+#endif
+#ifndef DEBUG_IR_FULL_INFO
 #define DEBUG_IR_FULL_INFO                  (STD_OFF)
+#endif
+#ifndef AVR_WDT_ENABLE
 #define AVR_WDT_ENABLE                      (STD_ON)
+#endif
+#ifndef INIT_POTENTIOMETERS_WITH_EEPROM_VAL
 #define INIT_POTENTIOMETERS_WITH_EEPROM_VAL (STD_ON)
+#endif
+#ifndef EEPROM_CHECK_TASK_ENABLE
 #define EEPROM_CHECK_TASK_ENABLE            (STD_ON)
+#endif
+#ifndef ARDUINO_PROFILER
 #define ARDUINO_PROFILER                    (STD_OFF)
+#endif
+#ifndef CS_FANOUT
+#define CS_FANOUT                           (STD_OFF)                 /* CS lines from a 74HC595 on SPI, 8 channels */
+#endif
+#ifndef POTENTIOMETER_HW_PULSES
+#define POTENTIOMETER_HW_PULSES             (STD_OFF)                 /* INC pulses by the Timer1 output compare */
+#endif
+#ifndef POTENTIOMETER_FULL_RESOLUTION
+#define POTENTIOMETER_FULL_RESOLUTION       (STD_OFF)                 /* All X9C102 taps, fine/coarse up/down */
+#endif
+#ifndef WIPER_RESYNC
+#define WIPER_RESYNC                        (STD_OFF)                 /* Idle re-homing of the written wipers */
+#endif
+#ifndef LEVEL_CALIBRATION
+#define LEVEL_CALIBRATION                   (STD_OFF)                 /* Up/down and EEPROM in dB levels */
+#endif
+#ifndef SERIAL_CONSOLE
+#define SERIAL_CONSOLE                      (STD_OFF)                 /* Binary command frames on the USB serial */
+#endif
+#ifndef USB_HID_CONTROL
+#define USB_HID_CONTROL                     (STD_OFF)                 /* CDC + HID composite, HID output reports */
+#endif
+#ifndef UNIT_BUS
+#define UNIT_BUS                            (STD_OFF)                 /* Addressed RS-485 bus of several units */
+#endif
+#ifndef SAMPLING_PROFILER
+#define SAMPLING_PROFILER                   (STD_ON)                  /* Timer4 only while started via USB serial */
+#endif
 
 #define POTENTIOMETER_LOW_BOUNDRY           (uint8_t)(1)              /* 3 KOhm */
 #define POTENTIOMETER_HIGH_BOUNDRY          (uint8_t)(14)             /*42 KOhm with step of 3 KOhm (14 * 3 = 42)*/
+#define POTENTIOMETER_STORE_TIME            (uint32_t)(20)            /* ms, tCPH: wiper store cycle */
 
 #define POTETNIOMETER_RESET_VALUE           (uint8_t)(5)
+
+/* Full resolution (POTENTIOMETER_FULL_RESOLUTION): the step value is the tap, up/down moves the wiper from its
+   position instead of re-homing it. Repeated up/down (held button) accelerates, the coarse buttons jump */
+#define POTENTIOMETER_FINE_LOW_BOUNDRY      (uint8_t)(0)
+#define POTENTIOMETER_FINE_HIGH_BOUNDRY     (uint8_t)(99)
+#define POTENTIOMETER_COARSE_STEP           (uint8_t)(10)             /* Taps (levels) per coarse up/down */
+#define POTENTIOMETER_ACCEL_WINDOW          (uint32_t)(250)           /* ms between up/down counted as a repeat */
+#define POTENTIOMETER_ACCEL_REPEATS         (uint8_t)(4)              /* Repeats per doubling of the step */
+#define POTENTIOMETER_ACCEL_MAX_STEP        (uint8_t)(8)
+
+/* Idle wiper resync (WIPER_RESYNC): the X9C102 can not be read back, a pulse lost or added by noise on INC moves
+   the wiper away from the step value for good. When idle, every written channel is homed against the quiet end
+   stop (the last tap) and ramped back to its step value */
+#ifndef WIPER_RESYNC_IDLE
+#define WIPER_RESYNC_IDLE                   (1000UL * 60 * 10)        /* 10 minutes without IR commands */
+#endif
+#define WIPER_RESYNC_SLEW                   (uint8_t)(10)             /* Taps per DELAY_PERIOD of the ramp */
+#define WIPER_RESYNC_OVERSHOOT              (uint8_t)(8)              /* Pulses beyond the end stop, lost drift */
+
+/* Calibrated levels (LEVEL_CALIBRATION), level 0 is the low boundary tap */
+#define LEVEL_STEP_CDB                      (uint16_t)(100)           /* 1 dB per level, in 0.01 dB */
+#define LEVEL_INPUT_OHM                     (uint32_t)(10000)         /* K157DA1 input resistance behind the X9C102 */
+#define POTENTIOMETER_RESET_LEVEL           (uint8_t)(6)              /* -6 dB, tap 5 (POTETNIOMETER_RESET_VALUE) */
+#define POTENTIOMETER_STEP_OHM              (uint16_t)(3000)          /* Nominal resistance of one step */
+#define POTENTIOMETER_WIPER_OHM             (uint16_t)(40)
+#ifndef CHANNEL_STEP_OHM                                              /* Measured step resistance of channel 0..7 */
+#define CHANNEL_STEP_OHM                    {3000, 3000, 3000, 3000, 3000, 3000, 3000, 3000}
+#endif
+
+#if (LEVEL_CALIBRATION == STD_ON)
+#define CHANNEL_RESET_VALUE                 POTENTIOMETER_RESET_LEVEL /* EEPROM default: level or step value */
+#define CHANNEL_SCALE                       CHANNEL_SCALE_LEVELS
+#else
+#define CHANNEL_RESET_VALUE                 POTETNIOMETER_RESET_VALUE
+#define CHANNEL_SCALE                       CHANNEL_SCALE_TAPS
+#endif
+
+/* EEPROM configuration record */
+#define CONFIGURATION_VERSION               (uint8_t)(1)
+#define CHANNEL_SCALE_TAPS                  (uint8_t)(0)              /* Step values are X9C102 taps */
+#define CHANNEL_SCALE_LEVELS                (uint8_t)(1)              /* Step values are calibrated levels */
+#define CONFIGURATION_EEPROM_ADDRESS        (uint16_t)(32)
+#define CONFIGURATION_LEGACY_LOW            (uint8_t)(1)              /* Step value boundaries of the first release */
+#define CONFIGURATION_LEGACY_HIGH           (uint8_t)(14)
+#define PRESET_EEPROM_ADDRESS               (uint16_t)(64)            /* Presets, behind the configuration */
+#define PRESET_COUNT                        (uint8_t)(4)
+
+/* Multi-unit bus (UNIT_BUS) on Serial1, every unit of a bus needs its own address */
+#ifndef UNIT_BUS_ADDRESS
+#define UNIT_BUS_ADDRESS                    (1)                       /* 1..254, 0 - master: IR commands mirrored */
+#endif
+#define UNIT_BUS_BAUDRATE                   (unsigned long)(115200)
+#define UNIT_BUS_TURNAROUND_US              (uint32_t)(100)           /* Master releases the bus after its request */
+
+#ifndef VU_CHANNEL_COUNT
+#define VU_CHANNEL_COUNT                    (2)                       /* More than 2 channels need CS_FANOUT */
+#endif
+#ifndef VU_CHANNEL_DOWN_MASK
+#define VU_CHANNEL_DOWN_MASK                (0x01)                    /* Channels wired as the left one (DOWN) */
+#endif
+
+#define LEFT_CHANNEL_INDEX                  (uint8_t)(0)
+#define RIGHT_CHANNEL_INDEX                 (uint8_t)(1)
+#define NO_CHANNEL_SELECTED                 (uint8_t)(0xFF)
+#define CHANNEL_MASK(channel)               (uint8_t)(1U << (channel))
+#define ALL_CHANNELS_MASK                   (uint8_t)((1U << VU_CHANNEL_COUNT) - 1)
+
 #define DELAY_PERIOD                        (int)(100)                /* 100ms delay for non-blocking timer */
+#ifndef DELAY_EEPROM_CHECK
 #define DELAY_EEPROM_CHECK                  (1000UL * 60 * 5)         /* delay 5 minutes */
+#endif
 #define WDT_TRIGGER_TIME                    WDTO_4S
 
+#define DEBUG_LOG_BUFFER_SIZE               (uint16_t)(256)           /* Debug TX ring buffer size, power of 2 (max 256) */
+#define DEBUG_LOG_DROP_POLICY               (DEBUG_LOG_DROP_NEWEST)   /* DEBUG_LOG_DROP_NEWEST or DEBUG_LOG_DROP_OLDEST */
+#define DEBUG_LOG_DRAIN_BUDGET              (uint8_t)(8)              /* Max bytes sent to the debug port per loop */
+#ifndef DEBUG_LOG_DEFERRED
+#define DEBUG_LOG_DEFERRED                  (STD_ON)                  /* LOG() sends IDs, text is rebuilt by tools/log_decoder.py */
+#endif
+
+#define PROFILER_OUTPUT_BINARY              (0)                       /* COBS framed telemetry records (telemetry.h) */
+#define PROFILER_OUTPUT_JSON                (1)                       /* JSON object per tick (Node-RED profiler flow) */
+#ifndef PROFILER_OUTPUT_FORMAT
+#define PROFILER_OUTPUT_FORMAT              (PROFILER_OUTPUT_BINARY)
+#endif
+
+#define SAMPLING_PROFILER_PERIOD_US         (uint16_t)(997)           /* Not a divider of DELAY_PERIOD to avoid aliasing */
+#define SAMPLING_PROFILER_START_CMD         ('S')
+#define SAMPLING_PROFILER_STOP_CMD          ('X')
+
 /*********************************************************************************************************************/
 /*--------------------------------------------------------PVs--------------------------------------------------------*/
 /*********************************************************************************************************************/
 
-/*Parameters to be stored in the EEPROM memory*/
+/*Parameters to be stored in the EEPROM memory (CONFIGURATION_EEPROM_ADDRESS). The version and the scale tell how
+  the step values are to be read, so a record of another build (taps or calibrated levels) is converted instead of
+  misread. Another channel count changes the layout, the checksum check then loads the defaults*/
 struct ChannelsConfiguration 
 {
-  uint8_t channel_left_step_value;
-  uint8_t channel_right_step_value;
+  uint8_t version;                              /* CONFIGURATION_VERSION */
+  uint8_t scale;                                /* CHANNEL_SCALE_TAPS or CHANNEL_SCALE_LEVELS */
+  uint8_t channel_step_value[VU_CHANNEL_COUNT];
 
   void Reset()
   {
-    channel_left_step_value = POTETNIOMETER_RESET_VALUE;
-    channel_right_step_value = POTETNIOMETER_RESET_VALUE;
+    version = CONFIGURATION_VERSION;
+    scale = CHANNEL_SCALE;
+
+    for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+      channel_step_value[channel] = CHANNEL_RESET_VALUE;
+    }
   }
 };
 
-/*enumeration for potentiometers CS line selection*/
-enum channelsState 
+/*Presets (SERIAL_CONSOLE, USB_HID_CONTROL, UNIT_BUS) at PRESET_EEPROM_ADDRESS. Presets of another scale are dropped
+  on load*/
+struct PresetsConfiguration
 {
-  LEFT_CHANNEL_SELECT,
-  RIGHT_CHANNEL_SELECT,
-  RELEASE_CHANNELS_CS_LINES,
-  SELECT_ALL_CS_CHANNELS
+  uint8_t scale;                                /* CHANNEL_SCALE_TAPS or CHANNEL_SCALE_LEVELS */
+  uint8_t used_mask;                            /* Bit per stored slot */
+  uint8_t channel_step_value[PRESET_COUNT][VU_CHANNEL_COUNT];
+
+  void Reset()
+  {
+    scale = CHANNEL_SCALE;
+    used_mask = 0;
+
+    for (uint8_t slot = 0; slot < PRESET_COUNT; slot++) {
+      for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+        channel_step_value[slot][channel] = CHANNEL_RESET_VALUE;
+      }
+    }
+  }
 };
 
-/*enumeration for channel selection flags*/
-enum channelSelectFlags 
+/*Record of the first firmware release: taps of the left and right channel, no header. Its EEPROM address was the RAM
+  address of the store object (EEMEM did not apply to the class member), so it is searched for (EEPROMLegacyLoad())
+  and converted once*/
+struct ChannelsConfigurationLegacy
 {
-  LEFT_CHANNEL_SELECT_F = 1 << 0,
-  RIGHT_CHANNEL_SELECT_F = 1 << 1,
-  CHANNEL_SELECTION_IDLE_F = 1 << 2
+  uint8_t channel_left_step_value;
+  uint8_t channel_right_step_value;
+
+  /* Rejects the EEPROM windows which pass the checksum by chance (all zero bytes do) */
+  bool Valid() const
+  {
+    return channel_left_step_value >= CONFIGURATION_LEGACY_LOW &&
+           channel_left_step_value <= CONFIGURATION_LEGACY_HIGH &&
+           channel_right_step_value >= CONFIGURATION_LEGACY_LOW &&
+           channel_right_step_value <= CONFIGURATION_LEGACY_HIGH;
+  }
 };
 
 #endif
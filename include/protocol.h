@@ -28,6 +28,8 @@
 #define COMMIT_CHANGES_CMD_ADDR                        (uint16_t)(0x6B86)
 #define PRINT_DEBUG_INFO_CMD_ADDR                      (uint16_t)(0x6B86)
 #define FACTORY_RESET_VU_VAL_CMD_ADDR                  (uint16_t)(0x6B86)
+#define INCREASE_VU_VALUE_COARSE_CMD_ADDR              (uint16_t)(0x6B86)
+#define DECREASE_VU_VALUE_COARSE_CMD_ADDR              (uint16_t)(0x6B86)
 
 /*CMD value*/
 #define SELECT_RIGHT_CHANNEL_CMD_C                     (uint16_t)(0x2)
@@ -37,6 +39,8 @@
 #define COMMIT_CHANGES_CMD_C                           (uint16_t)(0x12)
 #define PRINT_DEBUG_INFO_CMD_C                         (uint16_t)(0xD)
 #define FACTORY_RESET_VU_VAL_CMD_C                     (uint16_t)(0xE)
+#define INCREASE_VU_VALUE_COARSE_CMD_C                 (uint16_t)(0x1B)
+#define DECREASE_VU_VALUE_COARSE_CMD_C                 (uint16_t)(0x1F)
 
 /*Raw data value*/
 #define SELECT_RIGHT_CHANNEL_CMD_RAW                   (uint32_t)(0xFD026B86)
@@ -46,5 +50,7 @@
 #define COMMIT_CHANGES_CMD_RAW                         (uint32_t)(0xED126B86)
 #define PRINT_DEBUG_INFO_CMD_RAW                       (uint32_t)(0xF20D6B86)
 #define FACTORY_RESET_VU_VAL_CMD_RAW                   (uint32_t)(0xF10E6B86)
+#define INCREASE_VU_VALUE_COARSE_CMD_RAW               (uint32_t)(0xE41B6B86)   /* POTENTIOMETER_FULL_RESOLUTION */
+#define DECREASE_VU_VALUE_COARSE_CMD_RAW               (uint32_t)(0xE01F6B86)
 
 #endif
\ No newline at end of file
@@ -0,0 +1,116 @@
+/**
+**********************************************************************************************************************
+*    @file           : serial_console.h
+*    @brief          : serial_console.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Binary command console on the USB serial port (SERIAL_CONSOLE), used to drive the device from a PC, e.g. for
+*    the production calibration. A request is COBS framed (0x00 is the frame delimiter) like the telemetry
+*    records and has the layout:
+*
+*    | version (1) | command (1) | request ID (2) | payload (command specific) | CRC16 (2) |
+*
+*    The response is a TELEMETRY_RECORD_CONSOLE telemetry record (telemetry.h) with the payload:
+*
+*    | request ID (2) | command (1) | status (1) | data (command specific) |
+*
+*    All multi-byte fields are little-endian, CRC16 is the same as the one of the telemetry records. A frame with
+*    a bad CRC or length is dropped without a response (its request ID can not be trusted) and counted, the host
+*    repeats the request after its timeout. The host client is tools/vu_console.py, new commands have to be added
+*    to both the enumeration below and the client.
+*
+*    ConsoleReader decodes the frames byte by byte in place, the command handling is done by the firmware.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef SERIAL_CONSOLE_H_
+#define SERIAL_CONSOLE_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdint.h>
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define CONSOLE_VERSION             (uint8_t)(1)
+#define CONSOLE_HEADER_SIZE         (4)
+#define CONSOLE_CRC_SIZE            (2)
+#define CONSOLE_MAX_FRAME_SIZE      (40)              /* Encoded frame without the delimiter (unit bus too) */
+#define CONSOLE_BATCH_MAX           (uint8_t)(8)      /* (channel, value) pairs of a batch */
+#define CONSOLE_FRAME_DELIMITER     (uint8_t)(0x00)
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*Console commands. Values are part of the wire format and must never be reused*/
+enum consoleCommand
+{
+  CONSOLE_CMD_SET_LEVEL = 1,                    /* uint8 channel, uint8 value */
+  CONSOLE_CMD_SET_BATCH = 2,                    /* (uint8 channel, uint8 value)[1..CONSOLE_BATCH_MAX] */
+  CONSOLE_CMD_QUERY_STATE = 3,                  /* -> uint8 count, scale, selected, low, high, (value, tap)[] */
+  CONSOLE_CMD_COMMIT = 4,
+  CONSOLE_CMD_PRESET_STORE = 5,                 /* uint8 slot */
+  CONSOLE_CMD_PRESET_RECALL = 6,                /* uint8 slot */
+  CONSOLE_CMD_STATS = 7,                        /* -> uint32 uptime ms, uint16 IR commands, frames, errors,
+                                                      uint16 resyncs[] */
+  CONSOLE_CMD_PROFILER = 8                      /* uint8 1 - start, 0 - stop the sampling profiler */
+};
+
+/*Response status. Values are part of the wire format*/
+enum consoleStatus
+{
+  CONSOLE_STATUS_OK = 0,
+  CONSOLE_STATUS_UNCHANGED = 1,                 /* Commit/preset store: EEPROM already up to date */
+  CONSOLE_STATUS_BAD_LENGTH = 2,
+  CONSOLE_STATUS_BAD_VALUE = 3,                 /* Channel, value or slot out of range, nothing changed */
+  CONSOLE_STATUS_UNKNOWN_COMMAND = 4,
+  CONSOLE_STATUS_EMPTY = 5,                     /* Preset slot not stored */
+  CONSOLE_STATUS_UNSUPPORTED = 6,               /* Feature not in this build */
+  CONSOLE_STATUS_BAD_VERSION = 7
+};
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+class ConsoleReader
+{
+protected:
+  uint8_t _frame[CONSOLE_MAX_FRAME_SIZE];
+  uint8_t _length;                              /* Received bytes of the frame, decoded length after feed() */
+
+private:
+  const uint8_t _header_size;                   /* Frame bytes before the payload (unit_bus.h has a longer one) */
+  bool _overflow;
+  bool _complete_f;                             /* _frame holds a decoded request */
+  uint16_t _frames;
+  uint16_t _errors;
+
+  bool decode(void);
+
+public:
+  explicit ConsoleReader(uint8_t header_size = CONSOLE_HEADER_SIZE);
+  bool feed(uint8_t value);
+
+  uint8_t version(void) const { return _frame[0]; }
+  uint8_t command(void) const { return _frame[1]; }
+  uint16_t requestId(void) const { return (uint16_t)(_frame[2] | (_frame[3] << 8)); }
+  const uint8_t *payload(void) const { return &_frame[_header_size]; }
+  uint8_t payloadLength(void) const { return (uint8_t)(_length - _header_size - CONSOLE_CRC_SIZE); }
+  uint16_t frames(void) const { return _frames; }
+  uint16_t errors(void) const { return _errors; }
+};
+
+#endif
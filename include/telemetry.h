@@ -0,0 +1,86 @@
+/**
+**********************************************************************************************************************
+*    @file           : telemetry.h
+*    @brief          : telemetry.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Compact binary telemetry records. Every record is COBS framed (0x00 is the frame delimiter) and has the layout:
+*
+*    | version (1) | type (1) | sequence (2) | timestamp ms (4) | payload (type specific) | CRC16 (2) |
+*
+*    All multi-byte fields are little-endian. CRC16 is the avr-libc _crc16_update() (poly 0xA001, init 0) over all
+*    preceding bytes of the record. The host decoder is tools/telemetry.py, new record types have to be added to
+*    both the enumeration below and the decoder schema table.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <Arduino.h>
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define TELEMETRY_VERSION           (uint8_t)(1)
+#define TELEMETRY_HEADER_SIZE       (8)
+#define TELEMETRY_CRC_SIZE          (2)
+#define TELEMETRY_MAX_RECORD_SIZE   (48)              /* Header + payload + CRC, must be below 254 (single COBS block) */
+#define TELEMETRY_FRAME_DELIMITER   (uint8_t)(0x00)
+#define TELEMETRY_MAX_FRAME_SIZE    (TELEMETRY_MAX_RECORD_SIZE + 2)  /* COBS code byte and delimiter */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*Telemetry record types. Values are part of the wire format and must never be reused*/
+enum telemetryRecordType
+{
+  TELEMETRY_RECORD_MEMORY = 1,                  /* int16 ram_usage, block_usage, free_block, free_ram */
+  TELEMETRY_RECORD_PROFILER_SAMPLES = 2,        /* uint16 dropped samples, uint16 PC samples[] */
+  TELEMETRY_RECORD_SCHEDULER = 3,               /* reserved */
+  TELEMETRY_RECORD_LATENCY = 4,                 /* reserved */
+  TELEMETRY_RECORD_EEPROM_WEAR = 5,             /* reserved */
+  TELEMETRY_RECORD_LOG = 6,                     /* uint16 log site ID, tagged arguments (deferred_log.h) */
+  TELEMETRY_RECORD_CONSOLE = 7                  /* uint16 request ID, uint8 command, status, data (serial_console.h) */
+};
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+class TelemetryWriter
+{
+private:
+  Print &_sink;
+  uint16_t _sequence;
+  uint8_t _length;
+  bool _overflow;
+  uint8_t _frame[TELEMETRY_MAX_FRAME_SIZE];      /* COBS code byte, record, delimiter */
+
+  void putByte(uint8_t value);
+
+public:
+  explicit TelemetryWriter(Print &sink);
+  void begin(uint8_t type);
+  void putU8(uint8_t value);
+  void putU16(uint16_t value);
+  void putI16(int16_t value);
+  void putU32(uint32_t value);
+  uint8_t remaining(void) const;
+  bool end(void);
+};
+
+#endif
@@ -0,0 +1,134 @@
+/**
+**********************************************************************************************************************
+*    @file           : unit_bus.h
+*    @brief          : unit_bus.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Addressed multi-unit bus (UNIT_BUS) on the hardware UART (Serial1, RS-485 transceiver, UNIT_BUS_DE_GPIO drives
+*    DE and /RE). One master (a PC, or a unit built with UNIT_BUS_ADDRESS == UNIT_BUS_MASTER) talks to any number of
+*    units, half-duplex: a unit only transmits the response to a request addressed to it. A frame is COBS framed
+*    like the console requests and has the layout:
+*
+*    | version (1) | destination (1) | source (1) | sequence (1) | command (1) | payload | CRC16 (2) |
+*
+*    The commands are the serial console commands (serial_console.h) plus UNIT_BUS_CMD_GROUP_COMMIT. The response
+*    swaps the addresses and keeps the sequence and the command, the payload is the status and the data of the
+*    console response. A frame to UNIT_BUS_BROADCAST is executed by every unit and never answered.
+*
+*    The sequence number makes the retries safe: a unit executes a frame of the same source and sequence as the
+*    last one once, a repeated request gets the stored response again. The group commit makes all units persist
+*    their values at the same time: the master broadcasts it with a token, then confirms the units one by one with
+*    the same token; a unit which missed the broadcast commits on the confirm, the others answer the stored status.
+*    The token is only remembered until the next other request. Frames of another version are dropped unanswered
+*    (their addresses can not be trusted).
+*
+*    UnitBusNode only moves the frames, the command handling is done by the firmware. The host master is
+*    tools/vu_bus.py.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef UNIT_BUS_H_
+#define UNIT_BUS_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <Arduino.h>
+
+#include "serial_console.h"
+#include "main.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define UNIT_BUS_VERSION            (uint8_t)(1)
+#define UNIT_BUS_HEADER_SIZE        (5)
+#define UNIT_BUS_MAX_FRAME_SIZE     (CONSOLE_MAX_FRAME_SIZE - 1)  /* Decoded frame incl. CRC, COBS adds 1 */
+#define UNIT_BUS_MASTER             (uint8_t)(0x00)
+#define UNIT_BUS_BROADCAST          (uint8_t)(0xFF)
+
+#define UNIT_BUS_CMD_GROUP_COMMIT   (uint8_t)(0x20)   /* uint8 token, -> status of the commit of the token */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*Frame decoder of the bus layout, the console accessors of the same bytes are hidden*/
+class UnitBusReader : public ConsoleReader
+{
+public:
+  UnitBusReader() : ConsoleReader(UNIT_BUS_HEADER_SIZE) {}
+
+  uint8_t destination(void) const { return _frame[1]; }
+  uint8_t source(void) const { return _frame[2]; }
+  uint8_t sequence(void) const { return _frame[3]; }
+  uint8_t command(void) const { return _frame[4]; }
+  const uint8_t *frame(void) const { return _frame; }
+  uint8_t frameLength(void) const { return _length; }
+};
+
+class UnitBusNode
+{
+private:
+  UnitBusReader _reader;
+  const uint8_t _address;
+  uint8_t _request[CONSOLE_MAX_FRAME_SIZE];     /* Decoded request waiting for its execution */
+  uint8_t _request_length;
+  bool _pending_f;
+  bool _last_f;                                 /* _last_source/_last_sequence valid */
+  uint8_t _last_source;
+  uint8_t _last_sequence;
+  uint8_t _frame[UNIT_BUS_MAX_FRAME_SIZE];      /* Response to the last request (kept for the retries) */
+  uint8_t _frame_length;                        /* 0 - no response */
+  bool _silent_f;                               /* Broadcast request: the response is not built */
+  bool _overflow;
+  bool _transmit_f;
+  uint8_t _sequence;                            /* Next sequence of the requests sent as master */
+  bool _group_f;
+  uint8_t _group_token;
+  uint8_t _group_status;
+  uint32_t _received_time;                      /* micros() at the end of the last request */
+  uint16_t _duplicates;
+  uint16_t _overruns;                           /* Requests dropped while one was pending */
+
+  void putByte(uint8_t value);
+
+public:
+  explicit UnitBusNode(uint8_t address);
+  bool feed(uint8_t value, uint32_t time);
+
+  bool pending(void) const { return _pending_f; }
+  bool broadcast(void) const { return _request[1] == UNIT_BUS_BROADCAST; }
+  uint8_t command(void) const { return _request[4]; }
+  const uint8_t *payload(void) const { return &_request[UNIT_BUS_HEADER_SIZE]; }
+  uint8_t payloadLength(void) const { return (uint8_t)(_request_length - UNIT_BUS_HEADER_SIZE - CONSOLE_CRC_SIZE); }
+
+  void begin(void);
+  void beginRequest(uint8_t destination, uint8_t command);
+  void putU8(uint8_t value);
+  void putU16(uint16_t value);
+  void putU32(uint32_t value);
+  bool end(void);
+
+  bool transmitReady(uint32_t time) const;
+  void transmit(Print &port);
+
+  bool groupCommitted(uint8_t token, uint8_t *status) const;
+  void setGroupCommit(uint8_t token, uint8_t status);
+
+  uint8_t address(void) const { return _address; }
+  const UnitBusReader &reader(void) const { return _reader; }
+  uint16_t duplicates(void) const { return _duplicates; }
+  uint16_t overruns(void) const { return _overruns; }
+};
+
+#endif
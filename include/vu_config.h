@@ -0,0 +1,177 @@
+/**
+**********************************************************************************************************************
+*    @file           : vu_config.h
+*    @brief          : vu_config.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Typed compile-time configuration of the VU meter controller (vu_controller.h). VuConfig takes its values from
+*    the main.h switches, so the -D build flag overrides keep working. A variant derives from it and hides the
+*    members it changes; several variants can be instantiated side by side in one host binary:
+*
+*      struct WideRangeConfig : VuConfig
+*      {
+*        static constexpr uint8_t high_boundary = 99;
+*        static constexpr bool eeprom_check_task = false;
+*      };
+*
+*    A variant which sets full_resolution sets its boundaries as well, the production ones follow the switch.
+*
+*    The channel count and the CS fan-out are hardware options, the firmware takes them from VU_CHANNEL_COUNT and
+*    CS_FANOUT (main.h) because the EEPROM record and the CS port layer depend on them as well.
+*
+*    vuConfigCheck<TConfig>() validates a configuration at compile time, the controller calls it.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef VU_CONFIG_H_
+#define VU_CONFIG_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdint.h>
+
+#include "main.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define VU_CONFIG_POTENTIOMETER_TAPS        (uint8_t)(100)          /* X9C102 wiper positions */
+#define VU_CONFIG_MAX_CHANNELS              (8)                     /* Channel masks are uint8_t */
+#define VU_CONFIG_OC1A_PIN                  (uint8_t)(9)            /* Timer1 OC1A (PB5) */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*Production configuration*/
+struct VuConfig
+{
+  /* GPIO */
+  static constexpr uint8_t receiver_pin = RECEIVER_GPIO;
+  static constexpr uint8_t left_channel_pin = LEFT_CHANNEL;
+  static constexpr uint8_t right_channel_pin = RIGHT_CHANNEL;
+  static constexpr uint8_t ud_pin = UD_POTENTIOMETER_GPIO;
+  static constexpr uint8_t inc_pin = INC_POTENTIOMETER_GPIO;
+  static constexpr uint8_t cs_fanout_latch_pin = CS_FANOUT_LATCH_GPIO;
+
+  /* Channels: count, CS lines (direct PORTC or 74HC595 fan-out), channels wired as the left one (DIRECTION_DOWN) */
+  static constexpr uint8_t channel_count = VU_CHANNEL_COUNT;
+  static constexpr bool cs_fanout = (CS_FANOUT == STD_ON);
+  static constexpr uint8_t channel_down_mask = VU_CHANNEL_DOWN_MASK;
+
+  /* Potentiometer step values (taps), the full resolution has its own boundaries */
+  static constexpr bool full_resolution = (POTENTIOMETER_FULL_RESOLUTION == STD_ON);
+  static constexpr uint8_t low_boundary = full_resolution ? POTENTIOMETER_FINE_LOW_BOUNDRY : POTENTIOMETER_LOW_BOUNDRY;
+  static constexpr uint8_t high_boundary =
+    full_resolution ? POTENTIOMETER_FINE_HIGH_BOUNDRY : POTENTIOMETER_HIGH_BOUNDRY;
+  static constexpr uint8_t reset_value = POTETNIOMETER_RESET_VALUE;
+
+  /* Full resolution up/down: coarse step, acceleration of repeated fine steps (window in ms) */
+  static constexpr uint8_t coarse_step = POTENTIOMETER_COARSE_STEP;
+  static constexpr uint32_t accel_window = POTENTIOMETER_ACCEL_WINDOW;
+  static constexpr uint8_t accel_repeats = POTENTIOMETER_ACCEL_REPEATS;
+  static constexpr uint8_t accel_max_step = POTENTIOMETER_ACCEL_MAX_STEP;
+
+  /* Idle wiper resync: ramp speed in taps per command_period, pulses pushed against the end stop */
+  static constexpr bool wiper_resync = (WIPER_RESYNC == STD_ON);
+  static constexpr uint32_t resync_idle_period = WIPER_RESYNC_IDLE;
+  static constexpr uint8_t resync_slew = WIPER_RESYNC_SLEW;
+  static constexpr uint8_t resync_overshoot = WIPER_RESYNC_OVERSHOOT;
+
+  /* Calibrated levels (vu_levels.h): the controller values are levels instead of step values when enabled */
+  static constexpr bool level_calibration = (LEVEL_CALIBRATION == STD_ON);
+  static constexpr uint16_t level_step_cdb = LEVEL_STEP_CDB;
+  static constexpr uint32_t level_input_ohm = LEVEL_INPUT_OHM;
+  static constexpr uint8_t reset_level = POTENTIOMETER_RESET_LEVEL;
+  static constexpr uint16_t potentiometer_step_ohm = POTENTIOMETER_STEP_OHM;
+  static constexpr uint16_t wiper_ohm = POTENTIOMETER_WIPER_OHM;
+  static constexpr uint16_t channel_step_ohm[VU_CONFIG_MAX_CHANNELS] = CHANNEL_STEP_OHM;
+
+  /* Timing, ms */
+  static constexpr uint32_t command_period = DELAY_PERIOD;
+  static constexpr uint32_t eeprom_check_period = DELAY_EEPROM_CHECK;
+
+  /* Features */
+  static constexpr bool eeprom_check_task = (EEPROM_CHECK_TASK_ENABLE == STD_ON);
+  static constexpr bool init_potentiometers_with_eeprom = (INIT_POTENTIOMETERS_WITH_EEPROM_VAL == STD_ON);
+  static constexpr bool watchdog = (AVR_WDT_ENABLE == STD_ON);
+  static constexpr bool inc_hw_pulses = (POTENTIOMETER_HW_PULSES == STD_ON);
+};
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+template <class TConfig>
+constexpr bool vuConfigPinsUnique(void)
+{
+  const uint8_t pins[] = {TConfig::receiver_pin, TConfig::left_channel_pin, TConfig::right_channel_pin,
+                          TConfig::ud_pin, TConfig::inc_pin, TConfig::cs_fanout_latch_pin};
+
+  for (uint8_t i = 0; i < sizeof(pins); i++) {
+    for (uint8_t j = (uint8_t)(i + 1); j < sizeof(pins); j++) {
+      if (pins[i] == pins[j]) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+template <class TConfig>
+constexpr bool vuConfigStepOhmValid(void)
+{
+  for (uint8_t channel = 0; channel < TConfig::channel_count; channel++) {
+    if (TConfig::channel_step_ohm[channel] == 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Function validates the configuration at compile time
+ * @param argument: None
+ * @retval bool - always true, an invalid configuration does not compile
+ */
+template <class TConfig>
+constexpr bool vuConfigCheck(void)
+{
+  static_assert(TConfig::low_boundary < TConfig::high_boundary, "low boundary must be below the high boundary");
+  static_assert(TConfig::low_boundary <= TConfig::reset_value && TConfig::reset_value <= TConfig::high_boundary,
+                "reset value must be within the boundaries");
+  static_assert(TConfig::high_boundary < VU_CONFIG_POTENTIOMETER_TAPS, "high boundary beyond the potentiometer taps");
+  static_assert(vuConfigPinsUnique<TConfig>(), "GPIO pins must be unique");
+  static_assert(TConfig::channel_count >= 1 && TConfig::channel_count <= VU_CONFIG_MAX_CHANNELS, "1..8 channels");
+  static_assert(TConfig::cs_fanout || TConfig::channel_count <= 2, "more than 2 channels need the CS fan-out");
+  static_assert((TConfig::channel_down_mask >> TConfig::channel_count) == 0, "down mask beyond the channel count");
+  static_assert(!TConfig::inc_hw_pulses || TConfig::inc_pin == VU_CONFIG_OC1A_PIN,
+                "hardware INC pulses need INC on OC1A (pin 9)");
+  static_assert(TConfig::coarse_step > 0 && TConfig::accel_repeats > 0 && TConfig::accel_max_step > 0,
+                "coarse step and acceleration must not be 0");
+  static_assert(TConfig::resync_slew > 0 && TConfig::resync_overshoot <= UINT8_MAX - VU_CONFIG_POTENTIOMETER_TAPS,
+                "resync slew must not be 0, overshoot beyond uint8_t");
+  static_assert(!TConfig::wiper_resync || TConfig::resync_idle_period > TConfig::command_period,
+                "resync idle period must be longer than the command period");
+  static_assert(TConfig::potentiometer_step_ohm > 0, "step resistance must not be 0");
+  static_assert(vuConfigStepOhmValid<TConfig>(), "channel step resistance must not be 0");
+  static_assert(TConfig::command_period > 0, "command period must not be 0");
+  static_assert(!TConfig::eeprom_check_task || TConfig::eeprom_check_period > TConfig::command_period,
+                "EEPROM check period must be longer than the command period");
+
+  return true;
+}
+
+#endif
@@ -0,0 +1,590 @@
+/**
+**********************************************************************************************************************
+*    @file           : vu_controller.h
+*    @brief          : vu_controller.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    IR command state machine of the VU meter (channel selection, step value up/down, commit, factory reset and
+*    the periodic EEPROM check). The behavior comes from the configuration template argument (vu_config.h), the
+*    disabled features compile away with if constexpr. The hardware is reached through the back end, the firmware
+*    passes the X9C102 and EEPROMStore back end, host tools pass mocks. The back end has to provide:
+*
+*      void potentiometerSetVal(uint8_t channel_mask, uint8_t val, potentiometer_direction dir);
+*                                                               - one CS transaction for all channels of the mask
+*      bool storeConfig(const uint8_t *values);                 - channel_count step values, true when EEPROM
+*                                                                 was written
+*      void potentiometerStepVal(uint8_t channel_mask, uint8_t from, uint8_t to, potentiometer_direction dir);
+*                                                               - full_resolution or wiper_resync only: one CS
+*                                                                 transaction which moves the wipers from "from"
+*                                                                 to "to" ("to" beyond the last tap: end stop)
+*      void potentiometerStore(uint8_t channel_mask);           - init_potentiometers_with_eeprom off only: one CS
+*                                                                 transaction which stores the wipers in the
+*                                                                 X9C102 non-volatile memory
+*
+*    Every potentiometer write selects and releases its own CS lines, no CS line stays selected between commands,
+*    so noise on INC cannot move a wiper. The writes do not store the wipers in the X9C102 (endurance 100000
+*    stores); without the init at boot the wipers come back from that memory at power-up, so they are stored
+*    together with every EEPROM write of the configuration. The channel selection commands only choose the channel
+*    of up/down: "left" selects the previous channel, "right" the next one (from idle: channel 0 and channel 1), so
+*    two channels behave as the left/right pair.
+*
+*    The channel values are step values (taps), with level_calibration calibrated levels (vu_levels.h): up/down
+*    moves by one level, the EEPROM holds the levels and the potentiometers get the tap of the level from the
+*    PROGMEM table of their channel.
+*
+*    With full_resolution the boundaries cover all X9C102 taps. Up/down moves the wiper from its position (one
+*    pulse per tap) instead of re-homing it with 100 pulses, begin() and the factory reset still home the wipers.
+*    The coarse up/down commands move by coarse_step, repeated fine up/down (a held button) within accel_window
+*    doubles the step every accel_repeats repeats up to accel_max_step.
+*
+*    With wiper_resync wiperResync() (called every command_period) repairs the wiper drift the firmware can not
+*    see: after resync_idle_period without IR commands each channel written since its last resync is ramped to the
+*    quiet end stop, pushed resync_overshoot pulses further (any drift is lost against the stop) and ramped back
+*    to its tap, resync_slew taps per call. One channel at a time; an IR command stops the ramp and re-homes the
+*    channel. resyncCount() counts the resyncs of every channel.
+*
+*    setValues() sets several channels as one actuation (serial console batches and presets): all values are
+*    checked before any is changed, channels with the same move share one CS transaction.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef VU_CONTROLLER_H_
+#define VU_CONTROLLER_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdint.h>
+
+#include "X9C102_potentiometer.h"
+#include "protocol.h"
+#include "vu_config.h"
+#include "vu_levels.h"
+#include "main.h"
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*Result of a processed command, used by the caller for the log output*/
+typedef enum
+{
+  IR_CMD_RIGHT_CHANNEL_SELECTED,
+  IR_CMD_LEFT_CHANNEL_SELECTED,
+  IR_CMD_COMMIT_STORED,
+  IR_CMD_COMMIT_UNCHANGED,
+  IR_CMD_VALUE_UP,
+  IR_CMD_VALUE_DOWN,
+  IR_CMD_VALUE_LIMIT,                           /* Up/down at the boundary or without a selected channel */
+  IR_CMD_FACTORY_RESET_STORED,
+  IR_CMD_FACTORY_RESET_UNCHANGED,
+  IR_CMD_DEBUG_INFO,
+  IR_CMD_UNKNOWN,
+
+  IR_CMD_EEPROM_CHECK_IDLE,                     /* EEPROM check task results */
+  IR_CMD_EEPROM_CHECK_STORED,
+  IR_CMD_EEPROM_CHECK_UNCHANGED,
+
+  IR_CMD_RESYNC_IDLE,                           /* Idle wiper resync results */
+  IR_CMD_RESYNC_STARTED,
+  IR_CMD_RESYNC_STEP,
+  IR_CMD_RESYNC_DONE
+} irCommandResult;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+template <class TConfig, class TBackend>
+class VuController
+{
+private:
+  static_assert(vuConfigCheck<TConfig>(), "invalid VU meter configuration");
+
+  static constexpr uint8_t all_channels_mask = (uint8_t)((1U << TConfig::channel_count) - 1);
+  static constexpr uint8_t down_channels_mask = (uint8_t)(TConfig::channel_down_mask & all_channels_mask);
+  static constexpr uint8_t up_channels_mask = (uint8_t)(all_channels_mask & ~TConfig::channel_down_mask);
+  static constexpr uint8_t resync_end_tap = (uint8_t)(VU_CONFIG_POTENTIOMETER_TAPS - 1);  /* Quiet end stop */
+
+public:
+  /* Range and reset value of the channel values: step values or calibrated levels */
+  static constexpr uint8_t value_low = TConfig::level_calibration ? 0 : TConfig::low_boundary;
+  static constexpr uint8_t value_high =
+    TConfig::level_calibration ? (uint8_t)(VuLevels<TConfig>::level_count - 1) : TConfig::high_boundary;
+  static constexpr uint8_t value_reset = TConfig::level_calibration ? TConfig::reset_level : TConfig::reset_value;
+
+private:
+  TBackend &_backend;
+  uint8_t _channel_value[TConfig::channel_count];
+  uint8_t _selected_channel;                    /* NO_CHANNEL_SELECTED when idle */
+  uint32_t _eeprom_check_time;                  /* millis() of the last EEPROM check */
+  uint32_t _previous_cmd;                       /* Last dispatched command and its time, for the acceleration */
+  uint32_t _previous_time;
+  uint8_t _step_repeats;                        /* Repeats of the running fine up/down */
+  uint32_t _activity_time;                      /* millis() of the last IR command, for the idle resync */
+  uint8_t _resync_pending;                      /* Channels written since their last resync */
+  uint8_t _resync_channel;                      /* Channel being resynced, NO_CHANNEL_SELECTED when none */
+  uint8_t _resync_tap;                          /* Wiper position on the resync ramp */
+  bool _resync_homed_f;                         /* Ramp back from the end stop */
+  uint16_t _resync_count[TConfig::channel_count];
+
+  static uint8_t clamp(uint8_t value)
+  {
+    if (value < value_low) {
+      return value_low;
+    }
+
+    if (value > value_high) {
+      return value_high;
+    }
+
+    return value;
+  }
+
+  void write(uint8_t channel)
+  {
+    _backend.potentiometerSetVal(CHANNEL_MASK(channel), channelTap(channel), channelDirection(channel));
+    _resync_pending |= CHANNEL_MASK(channel);
+  }
+
+  /**
+   * @brief Function stops a running resync ramp, the channel is re-homed to its tap and stays pending
+   * @param argument: None
+   * @retval None
+   */
+  void resyncStop(void)
+  {
+    if constexpr (TConfig::wiper_resync) {
+      if (_resync_channel != NO_CHANNEL_SELECTED) {
+        const uint8_t channel = _resync_channel;
+
+        _resync_channel = NO_CHANNEL_SELECTED;
+        write(channel);
+      }
+    }
+  }
+
+  irCommandResult store(irCommandResult stored, irCommandResult unchanged)
+  {
+    if (!_backend.storeConfig(_channel_value)) {
+      return unchanged;
+    }
+
+    if constexpr (!TConfig::init_potentiometers_with_eeprom) {
+      _backend.potentiometerStore(all_channels_mask);
+    }
+
+    return stored;
+  }
+
+  /**
+   * @brief Function returns the step of a fine up/down: 1, with full_resolution doubled every accel_repeats
+   *        repeats of the same command within accel_window, up to accel_max_step
+   * @param argument: bool repeat_f - same command as the previous one within accel_window
+   * @retval uint8_t
+   */
+  uint8_t fineStep(bool repeat_f)
+  {
+    if constexpr (TConfig::full_resolution) {
+      uint8_t step = 1;
+
+      if (!repeat_f) {
+        _step_repeats = 0;
+      } else if (_step_repeats < UINT8_MAX) {
+        ++_step_repeats;
+      }
+
+      for (uint8_t doublings = _step_repeats / TConfig::accel_repeats; doublings > 0; doublings--) {
+        if (step >= TConfig::accel_max_step) {
+          break;
+        }
+
+        step = (uint8_t)(step << 1);
+      }
+
+      return (step > TConfig::accel_max_step) ? TConfig::accel_max_step : step;
+    } else {
+      (void)repeat_f;
+      return 1;
+    }
+  }
+
+  /**
+   * @brief Function moves the value of the selected channel by a step, stopped at the boundary. Lower value
+   *        increases the signal magnitude. The boundary is checked before the step, so the uint8_t value never
+   *        wraps around
+   * @param argument: bool up_f - towards value_low, uint8_t step, irCommandResult result - result of a move
+   * @retval irCommandResult
+   */
+  irCommandResult move(bool up_f, uint8_t step, irCommandResult result)
+  {
+    if (_selected_channel == NO_CHANNEL_SELECTED) {
+      return IR_CMD_VALUE_LIMIT;
+    }
+
+    const uint8_t channel = _selected_channel;
+    uint8_t value = _channel_value[channel];
+
+    if (up_f) {
+      if (value <= value_low) {
+        return IR_CMD_VALUE_LIMIT;
+      }
+
+      value = (uint8_t)((value - value_low > step) ? value - step : value_low);
+    } else {
+      if (value >= value_high) {
+        return IR_CMD_VALUE_LIMIT;
+      }
+
+      value = (uint8_t)((value_high - value > step) ? value + step : value_high);
+    }
+
+    if constexpr (TConfig::full_resolution) {
+      const uint8_t from = channelTap(channel);
+
+      _channel_value[channel] = value;
+      _backend.potentiometerStepVal(CHANNEL_MASK(channel), from, channelTap(channel), channelDirection(channel));
+      _resync_pending |= CHANNEL_MASK(channel);
+    } else {
+      _channel_value[channel] = value;
+      write(channel);
+    }
+
+    return result;
+  }
+
+public:
+  explicit VuController(TBackend &backend)
+    : _backend(backend), _selected_channel(NO_CHANNEL_SELECTED), _eeprom_check_time(0), _previous_cmd(0),
+      _previous_time(0), _step_repeats(0), _activity_time(0), _resync_pending(0),
+      _resync_channel(NO_CHANNEL_SELECTED), _resync_tap(0), _resync_homed_f(false)
+  {
+    for (uint8_t channel = 0; channel < TConfig::channel_count; channel++) {
+      _channel_value[channel] = value_reset;
+      _resync_count[channel] = 0;
+    }
+  }
+
+  static constexpr potentiometer_direction channelDirection(uint8_t channel)
+  {
+    return (TConfig::channel_down_mask & CHANNEL_MASK(channel)) ? DIRECTION_DOWN : DIRECTION_UP;
+  }
+
+  uint8_t channelValue(uint8_t channel) const { return _channel_value[channel]; }
+
+  /**
+   * @brief Function returns the potentiometer tap of the channel value
+   * @param argument: uint8_t channel
+   * @retval uint8_t
+   */
+  uint8_t channelTap(uint8_t channel) const
+  {
+    if constexpr (TConfig::level_calibration) {
+      return VuLevels<TConfig>::tap(channel, _channel_value[channel]);
+    } else {
+      return _channel_value[channel];
+    }
+  }
+  uint8_t selectedChannel(void) const { return _selected_channel; }
+  uint8_t resyncChannel(void) const { return _resync_channel; }
+  uint16_t resyncCount(uint8_t channel) const { return _resync_count[channel]; }
+
+  /**
+   * @brief Function starts the controller with the stored configuration. The stored values are clamped to the
+   *        boundaries (the record can come from a build with other boundaries) and, when enabled, written to the
+   *        potentiometers. The whole command state is reset, so a controller can be restarted in place.
+   * @param argument: const uint8_t *values - channel_count stored step values, uint32_t time - millis()
+   * @retval None
+   */
+  void begin(const uint8_t *values, uint32_t time)
+  {
+    _selected_channel = NO_CHANNEL_SELECTED;
+    _eeprom_check_time = time;
+    _previous_cmd = 0;
+    _previous_time = 0;
+    _step_repeats = 0;
+    _activity_time = time;
+    _resync_pending = 0;
+    _resync_channel = NO_CHANNEL_SELECTED;
+    _resync_tap = 0;
+    _resync_homed_f = false;
+
+    for (uint8_t channel = 0; channel < TConfig::channel_count; channel++) {
+      _channel_value[channel] = clamp(values[channel]);
+      _resync_count[channel] = 0;
+
+      if constexpr (TConfig::init_potentiometers_with_eeprom) {
+        write(channel);
+      }
+    }
+  }
+
+  /**
+   * @brief Function processes one decoded IR command
+   * @param argument: uint32_t received_cmd, uint32_t time - millis() of the reception
+   * @retval irCommandResult
+   */
+  irCommandResult dispatch(uint32_t received_cmd, uint32_t time)
+  {
+    const bool repeat_f =
+      (received_cmd == _previous_cmd) && ((uint32_t)(time - _previous_time) <= TConfig::accel_window);
+
+    _previous_cmd = received_cmd;
+    _previous_time = time;
+    _activity_time = time;
+    resyncStop();
+
+    switch (received_cmd) {
+    case SELECT_RIGHT_CHANNEL_CMD_RAW:
+      if (_selected_channel == NO_CHANNEL_SELECTED) {
+        _selected_channel = (TConfig::channel_count > RIGHT_CHANNEL_INDEX) ? RIGHT_CHANNEL_INDEX : LEFT_CHANNEL_INDEX;
+      } else if (_selected_channel + 1 < TConfig::channel_count) {
+        ++_selected_channel;
+      }
+      return IR_CMD_RIGHT_CHANNEL_SELECTED;
+
+    case SELECT_LEFT_CHANNEL_CMD_RAW:
+      if (_selected_channel == NO_CHANNEL_SELECTED) {
+        _selected_channel = LEFT_CHANNEL_INDEX;
+      } else if (_selected_channel > 0) {
+        --_selected_channel;
+      }
+      return IR_CMD_LEFT_CHANNEL_SELECTED;
+
+    case COMMIT_CHANGES_CMD_RAW:
+      _selected_channel = NO_CHANNEL_SELECTED;
+
+      return store(IR_CMD_COMMIT_STORED, IR_CMD_COMMIT_UNCHANGED);
+
+    case INCREASE_VU_VALUE_CMD_RAW:
+      return move(true, fineStep(repeat_f), IR_CMD_VALUE_UP);
+
+    case DECREASE_VU_VALUE_CMD_RAW:
+      return move(false, fineStep(repeat_f), IR_CMD_VALUE_DOWN);
+
+    case INCREASE_VU_VALUE_COARSE_CMD_RAW:
+      if constexpr (TConfig::full_resolution) {
+        return move(true, TConfig::coarse_step, IR_CMD_VALUE_UP);
+      }
+
+      return IR_CMD_UNKNOWN;
+
+    case DECREASE_VU_VALUE_COARSE_CMD_RAW:
+      if constexpr (TConfig::full_resolution) {
+        return move(false, TConfig::coarse_step, IR_CMD_VALUE_DOWN);
+      }
+
+      return IR_CMD_UNKNOWN;
+
+    /* The channels of one direction are pulsed together (shared INC and U/D lines). The calibrated taps of the
+       reset level differ per channel, so each channel gets its own transaction */
+    case FACTORY_RESET_VU_VAL_CMD_RAW:
+      for (uint8_t channel = 0; channel < TConfig::channel_count; channel++) {
+        _channel_value[channel] = value_reset;
+
+        if constexpr (TConfig::level_calibration) {
+          write(channel);
+        }
+      }
+
+      if constexpr (!TConfig::level_calibration) {
+        if constexpr (up_channels_mask != 0) {
+          _backend.potentiometerSetVal(up_channels_mask, TConfig::reset_value, DIRECTION_UP);
+        }
+
+        if constexpr (down_channels_mask != 0) {
+          _backend.potentiometerSetVal(down_channels_mask, TConfig::reset_value, DIRECTION_DOWN);
+        }
+
+        _resync_pending = all_channels_mask;
+      }
+
+      _selected_channel = NO_CHANNEL_SELECTED;
+
+      return store(IR_CMD_FACTORY_RESET_STORED, IR_CMD_FACTORY_RESET_UNCHANGED);
+
+    case PRINT_DEBUG_INFO_CMD_RAW:
+      return IR_CMD_DEBUG_INFO;
+
+    default:
+      return IR_CMD_UNKNOWN;
+    }
+  }
+
+  /**
+   * @brief Function sets the values of several channels as one actuation. Nothing changes when a channel or a
+   *        value is out of range. Channels with the same tap and direction (full_resolution: the same move) are
+   *        written in one CS transaction, an unchanged channel of the full resolution is not written
+   * @param argument: const uint8_t *channels, const uint8_t *values, uint8_t count - pairs, uint32_t time - millis()
+   * @retval bool - false when nothing was set
+   */
+  bool setValues(const uint8_t *channels, const uint8_t *values, uint8_t count, uint32_t time)
+  {
+    for (uint8_t i = 0; i < count; i++) {
+      if (channels[i] >= TConfig::channel_count || values[i] < value_low || values[i] > value_high) {
+        return false;
+      }
+    }
+
+    _activity_time = time;
+    resyncStop();
+
+    uint8_t from[TConfig::channel_count];
+    uint8_t write_mask = 0;
+
+    for (uint8_t channel = 0; channel < TConfig::channel_count; channel++) {
+      from[channel] = channelTap(channel);
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+      _channel_value[channels[i]] = values[i];
+      write_mask |= CHANNEL_MASK(channels[i]);
+    }
+
+    for (uint8_t channel = 0; channel < TConfig::channel_count; channel++) {
+      if (!(write_mask & CHANNEL_MASK(channel))) {
+        continue;
+      }
+
+      const uint8_t tap = channelTap(channel);
+      const potentiometer_direction dir = channelDirection(channel);
+      uint8_t group_mask = 0;
+
+      for (uint8_t other = channel; other < TConfig::channel_count; other++) {
+        if ((write_mask & CHANNEL_MASK(other)) && channelTap(other) == tap && channelDirection(other) == dir &&
+            (!TConfig::full_resolution || from[other] == from[channel])) {
+          group_mask |= CHANNEL_MASK(other);
+        }
+      }
+
+      write_mask &= (uint8_t)~group_mask;
+
+      if constexpr (TConfig::full_resolution) {
+        if (from[channel] != tap) {
+          _backend.potentiometerStepVal(group_mask, from[channel], tap, dir);
+          _resync_pending |= group_mask;
+        }
+      } else {
+        _backend.potentiometerSetVal(group_mask, tap, dir);
+        _resync_pending |= group_mask;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Function stores the channel values, like the commit command without deselecting the channel
+   * @param argument: None
+   * @retval irCommandResult - IR_CMD_COMMIT_STORED or IR_CMD_COMMIT_UNCHANGED
+   */
+  irCommandResult commit(void)
+  {
+    return store(IR_CMD_COMMIT_STORED, IR_CMD_COMMIT_UNCHANGED);
+  }
+
+  /**
+   * @brief Function implements the EEPROM check task: every eeprom_check_period the actual potentiometer values
+   *        are stored, in case the EEPROM was not updated by pressing the "OK" button
+   * @param argument: uint32_t time - millis()
+   * @retval irCommandResult
+   */
+  irCommandResult eepromCheck(uint32_t time)
+  {
+    if constexpr (TConfig::eeprom_check_task) {
+      if ((uint32_t)(time - _eeprom_check_time) > TConfig::eeprom_check_period) {
+        _eeprom_check_time = time;
+        return store(IR_CMD_EEPROM_CHECK_STORED, IR_CMD_EEPROM_CHECK_UNCHANGED);
+      }
+    } else {
+      (void)time;
+    }
+
+    return IR_CMD_EEPROM_CHECK_IDLE;
+  }
+
+  /**
+   * @brief Function implements the idle wiper resync task, one ramp step per call (see the description)
+   * @param argument: uint32_t time - millis()
+   * @retval irCommandResult
+   */
+  irCommandResult wiperResync(uint32_t time)
+  {
+    if constexpr (TConfig::wiper_resync) {
+      irCommandResult result = IR_CMD_RESYNC_STEP;
+
+      if (_resync_channel == NO_CHANNEL_SELECTED) {
+        if (_resync_pending == 0 || (uint32_t)(time - _activity_time) < TConfig::resync_idle_period) {
+          return IR_CMD_RESYNC_IDLE;
+        }
+
+        _resync_channel = 0;
+
+        while (!(_resync_pending & CHANNEL_MASK(_resync_channel))) {
+          ++_resync_channel;
+        }
+
+        _resync_tap = channelTap(_resync_channel);
+        _resync_homed_f = false;
+        result = IR_CMD_RESYNC_STARTED;
+      }
+
+      const uint8_t channel = _resync_channel;
+      const potentiometer_direction dir = channelDirection(channel);
+
+      if (!_resync_homed_f) {
+        if (_resync_tap < resync_end_tap) {
+          const uint8_t to = (uint8_t)((resync_end_tap - _resync_tap > TConfig::resync_slew)
+                                       ? _resync_tap + TConfig::resync_slew : resync_end_tap);
+
+          _backend.potentiometerStepVal(CHANNEL_MASK(channel), _resync_tap, to, dir);
+          _resync_tap = to;
+        } else {
+          /* The X9C102 does not step beyond its end stop, so the wiper is at the end whatever its drift was */
+          _backend.potentiometerStepVal(CHANNEL_MASK(channel), resync_end_tap,
+                                        (uint8_t)(resync_end_tap + TConfig::resync_overshoot), dir);
+          _resync_homed_f = true;
+        }
+
+        return result;
+      }
+
+      const uint8_t target = channelTap(channel);
+
+      if (_resync_tap > target) {
+        const uint8_t to =
+          (uint8_t)((_resync_tap - target > TConfig::resync_slew) ? _resync_tap - TConfig::resync_slew : target);
+
+        _backend.potentiometerStepVal(CHANNEL_MASK(channel), _resync_tap, to, dir);
+        _resync_tap = to;
+      }
+
+      if (_resync_tap != target) {
+        return result;
+      }
+
+      _resync_pending &= (uint8_t)~CHANNEL_MASK(channel);
+      _resync_channel = NO_CHANNEL_SELECTED;
+
+      if (_resync_count[channel] < UINT16_MAX) {
+        ++_resync_count[channel];
+      }
+
+      return IR_CMD_RESYNC_DONE;
+    } else {
+      (void)time;
+    }
+
+    return IR_CMD_RESYNC_IDLE;
+  }
+};
+
+#endif
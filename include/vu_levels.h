@@ -0,0 +1,260 @@
+/**
+**********************************************************************************************************************
+*    @file           : vu_levels.h
+*    @brief          : vu_levels.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Calibrated level mapping of the VU meter channels. The X9C102 is a series resistor in front of the K157DA1
+*    input, so equal wiper steps are not equal changes of the gauge: the first step changes the level by about
+*    1.8 dB, the last one by about 0.5 dB. With LEVEL_CALIBRATION (main.h) the controller works in levels of
+*    level_step_cdb each (1 dB by default), level 0 is the loudest setting (the low boundary tap), 0 dB:
+*
+*      level k  ->  R = (Rin + Rmin) * 10^(k * step / 20) - Rin  ->  tap = (R - Rwiper) / Rstep(channel)
+*
+*    Rin - level_input_ohm, Rmin - resistance at the low boundary tap, Rstep(channel) - the measured resistance of
+*    one step of the channel (channel_step_ohm, the X9C102 end-to-end tolerance is +-20%), so a level is the same
+*    attenuation on every channel. The tables are computed by the compiler (constexpr, the floating point math
+*    never reaches the device) and placed in PROGMEM:
+*
+*      tap[channel][level]  - wiper tap of a level, clamped to the boundaries
+*      percent[0..100]      - nearest level of a percentage of the level 0 amplitude
+*
+*    A lookup is one pgm_read_byte(), the dB conversions are integer arithmetic (0.01 dB units).
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef VU_LEVELS_H_
+#define VU_LEVELS_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+#include "vu_config.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define VU_LEVELS_MAX               (uint8_t)(64)           /* Table columns, limits the level count */
+#define VU_LEVELS_PERCENT_ENTRIES   (uint8_t)(101)          /* 0..100 % */
+#define VU_LEVELS_EXP_TERMS         (uint8_t)(48)           /* Taylor series terms of the compile time exp() */
+#define VU_LEVELS_LN10              (2.302585092994046)
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Function returns the amplitude ratio of an attenuation, 10^(cdb / 2000), compile time only
+ * @param argument: double cdb - attenuation in 0.01 dB
+ * @retval double
+ */
+constexpr double vuLevelsGain(double cdb)
+{
+  const double x = cdb / 2000.0 * VU_LEVELS_LN10;
+  double term = 1.0;
+  double sum = 1.0;
+
+  for (uint8_t n = 1; n < VU_LEVELS_EXP_TERMS; n++) {
+    term *= x / n;
+    sum += term;
+  }
+
+  return sum;
+}
+
+/**
+ * @brief Function returns the series resistance of a level in front of the K157DA1 input
+ * @param argument: uint8_t level
+ * @retval double - Ohm
+ */
+template <class TConfig>
+constexpr double vuLevelsOhm(uint8_t level)
+{
+  const double min_ohm = (double)TConfig::low_boundary * TConfig::potentiometer_step_ohm + TConfig::wiper_ohm;
+
+  return ((double)TConfig::level_input_ohm + min_ohm) * vuLevelsGain((double)level * TConfig::level_step_cdb) -
+         (double)TConfig::level_input_ohm;
+}
+
+/**
+ * @brief Function returns the tap of a level for the given step resistance, clamped to the boundaries
+ * @param argument: uint8_t level, uint16_t step_ohm
+ * @retval uint8_t
+ */
+template <class TConfig>
+constexpr uint8_t vuLevelsTap(uint8_t level, uint16_t step_ohm)
+{
+  const double tap = (vuLevelsOhm<TConfig>(level) - TConfig::wiper_ohm) / step_ohm + 0.5;
+
+  if (tap < TConfig::low_boundary) {
+    return TConfig::low_boundary;
+  }
+
+  if (tap >= TConfig::high_boundary) {
+    return TConfig::high_boundary;
+  }
+
+  return (uint8_t)tap;
+}
+
+/**
+ * @brief Function returns the number of levels reachable with the nominal step resistance
+ * @param argument: None
+ * @retval uint8_t
+ */
+template <class TConfig>
+constexpr uint8_t vuLevelsCount(void)
+{
+  const double max_ohm = ((double)TConfig::high_boundary + 0.5) * TConfig::potentiometer_step_ohm +
+                         TConfig::wiper_ohm;
+  uint8_t count = 1;
+
+  while (count < VU_LEVELS_MAX && vuLevelsOhm<TConfig>(count) <= max_ohm) {
+    count++;
+  }
+
+  return count;
+}
+
+/*Compile time tables of a configuration, see the description*/
+template <class TConfig>
+struct VuLevelsTables
+{
+  uint8_t tap[TConfig::channel_count][vuLevelsCount<TConfig>()];
+  uint8_t percent[VU_LEVELS_PERCENT_ENTRIES];
+};
+
+/**
+ * @brief Function computes the level tables of a configuration, compile time only
+ * @param argument: None
+ * @retval VuLevelsTables<TConfig>
+ */
+template <class TConfig>
+constexpr VuLevelsTables<TConfig> vuLevelsBuild(void)
+{
+  constexpr uint8_t level_count = vuLevelsCount<TConfig>();
+  VuLevelsTables<TConfig> tables{};
+
+  for (uint8_t channel = 0; channel < TConfig::channel_count; channel++) {
+    for (uint8_t level = 0; level < level_count; level++) {
+      tables.tap[channel][level] = vuLevelsTap<TConfig>(level, TConfig::channel_step_ohm[channel]);
+    }
+  }
+
+  /* The level whose amplitude is nearest (in dB) to the percentage, 0 % is the last level */
+  for (uint8_t percent = 0; percent < VU_LEVELS_PERCENT_ENTRIES; percent++) {
+    uint8_t level = (percent == 0) ? (uint8_t)(level_count - 1) : 0;
+
+    while (percent != 0 && level + 1 < level_count &&
+           percent * vuLevelsGain((level + 0.5) * TConfig::level_step_cdb) < 100.0) {
+      level++;
+    }
+
+    tables.percent[percent] = level;
+  }
+
+  return tables;
+}
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+template <class TConfig>
+class VuLevels
+{
+public:
+  static constexpr uint8_t level_count = vuLevelsCount<TConfig>();
+
+private:
+  static_assert(TConfig::level_step_cdb > 0, "level step must not be 0");
+  static_assert(level_count >= 2, "level step larger than the tap range");
+  static_assert(!TConfig::level_calibration || TConfig::reset_level < level_count, "reset level beyond the levels");
+
+  static constexpr VuLevelsTables<TConfig> tables PROGMEM = vuLevelsBuild<TConfig>();
+
+public:
+  /**
+   * @brief Function returns the wiper tap of a level of the channel
+   * @param argument: uint8_t channel, uint8_t level - below level_count
+   * @retval uint8_t
+   */
+  static uint8_t tap(uint8_t channel, uint8_t level)
+  {
+    return pgm_read_byte(&tables.tap[channel][level]);
+  }
+
+  /**
+   * @brief Function returns the level whose tap of the channel is nearest to a tap. Scans the table, used to
+   *        convert a stored tap record only
+   * @param argument: uint8_t channel, uint8_t tap
+   * @retval uint8_t
+   */
+  static uint8_t levelOfTap(uint8_t channel, uint8_t tap)
+  {
+    uint8_t level = 0;
+    uint8_t distance = UINT8_MAX;
+
+    for (uint8_t candidate = 0; candidate < level_count; candidate++) {
+      const uint8_t candidate_tap = pgm_read_byte(&tables.tap[channel][candidate]);
+      const uint8_t candidate_distance = (uint8_t)((candidate_tap > tap) ? candidate_tap - tap : tap - candidate_tap);
+
+      if (candidate_distance < distance) {
+        level = candidate;
+        distance = candidate_distance;
+      }
+    }
+
+    return level;
+  }
+
+  /**
+   * @brief Function returns the level nearest to a percentage of the level 0 amplitude
+   * @param argument: uint8_t percent - values above 100 are taken as 100
+   * @retval uint8_t
+   */
+  static uint8_t levelOfPercent(uint8_t percent)
+  {
+    return pgm_read_byte(&tables.percent[(percent > 100) ? 100 : percent]);
+  }
+
+  /**
+   * @brief Function returns the attenuation of a level relative to level 0
+   * @param argument: uint8_t level
+   * @retval int16_t - 0.01 dB, 0 or negative
+   */
+  static constexpr int16_t levelCdb(uint8_t level)
+  {
+    return (int16_t)-(int16_t)(level * TConfig::level_step_cdb);
+  }
+
+  /**
+   * @brief Function returns the level nearest to an attenuation, clamped to the levels
+   * @param argument: int16_t cdb - 0.01 dB relative to level 0
+   * @retval uint8_t
+   */
+  static constexpr uint8_t levelOfCdb(int16_t cdb)
+  {
+    if (cdb >= 0) {
+      return 0;
+    }
+
+    const uint16_t level = (uint16_t)((-(int32_t)cdb + TConfig::level_step_cdb / 2) / TConfig::level_step_cdb);
+
+    return (level < level_count) ? (uint8_t)level : (uint8_t)(level_count - 1);
+  }
+};
+
+#endif
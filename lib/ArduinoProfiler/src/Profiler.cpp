@@ -21,7 +21,15 @@ extern struct __freelist *__flp;
 
 #include "Profiler.h"
 
+// The constructor does no work, so a global profiler adds nothing before setup().
 Profiler::Profiler()
+{
+   _initFreeRAM = 0;
+   _initFreeBlock = 0;
+}
+
+// Records the free RAM and the largest free block (malloc bisection) as the baseline.
+void Profiler::begin()
 {
    _initFreeRAM = getFreeRAM();
    _initFreeBlock = getFreeBlock();
@@ -39,13 +47,13 @@ int Profiler::getBlockUsage()
     return _initFreeBlock - getFreeBlock();
 }
 
-// Get RAM available when Object was instantiated.
+// Get RAM available when begin() was called.
 int Profiler::getInitRAM()
 {
     return _initFreeRAM;
 }
 
-// Get largest continous Block size available when Object was instantiated.
+// Get largest continous Block size available when begin() was called.
 int Profiler::getInitBlock()
 {
     return _initFreeBlock;
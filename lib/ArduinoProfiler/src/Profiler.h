@@ -14,6 +14,7 @@ class Profiler
 {
     public:
         Profiler();
+        void begin();
         int getFreeRAM();
         int getFreeBlock();
         int getRAMUsage();
@@ -0,0 +1,192 @@
+/**
+**********************************************************************************************************************
+*    @file           : SamplingProfiler.cpp
+*    @brief          : SamplingProfiler.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Statistical CPU profiler based on the Timer4 overflow interrupt (10-bit high speed timer of the ATmega32U4,
+*    IRremote keeps its default Timer3 and the potentiometer pulses Timer1)
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "SamplingProfiler.h"
+
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#if defined(__AVR_3_BYTE_PC__)
+#error SamplingProfiler supports only MCUs with 2-byte program counter
+#endif
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define SAMPLING_PROFILER_BUFFER_MASK (SAMPLING_PROFILER_BUFFER_SIZE - 1)
+#define SAMPLING_PROFILER_PRESCALER   (64UL)
+#define SAMPLING_PROFILER_CLOCK       ((1 << CS42) | (1 << CS41) | (1 << CS40))   /* clk/64 */
+
+extern "C" {
+volatile uint16_t samplingProfilerPc;                 /* Written by the naked ISR, consumed by the store handler */
+void samplingProfilerStore(void) __attribute__((signal, used, externally_visible));
+}
+
+static volatile uint16_t sample_buffer[SAMPLING_PROFILER_BUFFER_SIZE];
+static volatile uint8_t sample_head;
+static volatile uint8_t sample_tail;
+static volatile uint16_t dropped_samples;
+static uint16_t sample_top;                           /* OCR4C: TOP of the counter, sampling period - 1 tick */
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Timer4 overflow ISR. The return address pushed by the interrupt is the program counter of the
+ *        interrupted code. The ISR is naked, so the stack layout is known: after three pushes the return address
+ *        is located at SP+4 (high byte) and SP+5 (low byte). The body of the sample handling is done by the
+ *        samplingProfilerStore() signal handler, which returns from the interrupt.
+ * @param argument: None
+ * @retval None
+ */
+ISR(TIMER4_OVF_vect, ISR_NAKED)
+{
+    asm volatile(
+        "push r24                          \n\t"
+        "push r30                          \n\t"
+        "push r31                          \n\t"
+        "in   r30, __SP_L__                \n\t"
+        "in   r31, __SP_H__                \n\t"
+        "ldd  r24, Z+4                     \n\t"
+        "sts  samplingProfilerPc+1, r24    \n\t"
+        "ldd  r24, Z+5                     \n\t"
+        "sts  samplingProfilerPc, r24      \n\t"
+        "pop  r31                          \n\t"
+        "pop  r30                          \n\t"
+        "pop  r24                          \n\t"
+        "jmp  samplingProfilerStore        \n\t"
+    );
+}
+
+/**
+ * @brief Function stores the sampled program counter into the ring buffer (drops the sample if the buffer is full)
+ * @param argument: None
+ * @retval None
+ */
+void samplingProfilerStore(void)
+{
+    uint8_t next_head = (sample_head + 1) & SAMPLING_PROFILER_BUFFER_MASK;
+
+    if (next_head == sample_tail) {
+        ++dropped_samples;
+    } else {
+        sample_buffer[sample_head] = samplingProfilerPc;
+        sample_head = next_head;
+    }
+}
+
+/**
+ * @brief Function sets the sampling period (at most SAMPLING_PROFILER_MAX_PERIOD_US). The timer is not touched
+ *        before start()
+ * @param argument: uint16_t period_us
+ * @retval None
+ */
+void SamplingProfiler::begin(uint16_t period_us)
+{
+    uint32_t ticks = ((uint32_t)period_us * (F_CPU / SAMPLING_PROFILER_PRESCALER / 1000UL)) / 1000UL;
+
+    sample_top = (uint16_t)(constrain(ticks, 2UL, 1024UL) - 1);
+}
+
+/**
+ * @brief Function configures the Timer4 in normal mode (counts up to OCR4C) and starts the sampling. Ring buffer
+ *        and drop counter are cleared.
+ * @param argument: None
+ * @retval None
+ */
+void SamplingProfiler::start(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        sample_head = 0;
+        sample_tail = 0;
+        dropped_samples = 0;
+        TCCR4B = 0;                                   /* Stopped while the 10-bit registers are written */
+        TCCR4A = 0;
+        TCCR4C = 0;
+        TCCR4D = 0;
+        TC4H = (uint8_t)(sample_top >> 8);
+        OCR4C = (uint8_t)(sample_top);
+        TC4H = 0;
+        TCNT4 = 0;
+        TIFR4 = (1 << TOV4);
+        TIMSK4 |= (1 << TOIE4);
+        TCCR4B = SAMPLING_PROFILER_CLOCK;
+    }
+}
+
+/**
+ * @brief Function stops the sampling and the Timer4 clock. Samples already in the ring buffer can still be read.
+ * @param argument: None
+ * @retval None
+ */
+void SamplingProfiler::stop(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        TIMSK4 &= ~(1 << TOIE4);
+        TCCR4B = 0;
+    }
+}
+
+/**
+ * @brief Function returns the sampling state
+ * @param argument: None
+ * @retval bool
+ */
+bool SamplingProfiler::isRunning(void)
+{
+    return (TIMSK4 & (1 << TOIE4)) != 0;
+}
+
+/**
+ * @brief Function pops the oldest sample (flash word address) from the ring buffer
+ * @param argument: uint16_t *pc
+ * @retval bool: true if sample was read, false if buffer is empty
+ */
+bool SamplingProfiler::readSample(uint16_t *pc)
+{
+    if (sample_tail == sample_head) {
+        return false;
+    }
+
+    *pc = sample_buffer[sample_tail];
+    sample_tail = (sample_tail + 1) & SAMPLING_PROFILER_BUFFER_MASK;
+
+    return true;
+}
+
+/**
+ * @brief Function returns the number of samples dropped because of the ring buffer overflow
+ * @param argument: None
+ * @retval uint16_t
+ */
+uint16_t SamplingProfiler::getDroppedSamples(void)
+{
+    uint16_t dropped;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        dropped = dropped_samples;
+    }
+
+    return dropped;
+}
@@ -0,0 +1,51 @@
+/**
+**********************************************************************************************************************
+*    @file           : SamplingProfiler.h
+*    @brief          : SamplingProfiler.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Statistical CPU profiler. The Timer4 overflow interrupt samples the program counter of the interrupted code
+*    into a small ring buffer, the main loop drains the samples to the host. Samples are word addresses of the
+*    flash, the host tool (tools/sampling_profiler.py) resolves them against the firmware.elf symbol table.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef SAMPLING_PROFILER_H
+#define SAMPLING_PROFILER_H
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <Arduino.h>
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define SAMPLING_PROFILER_BUFFER_SIZE (32)          /* Must be a power of 2 */
+#define SAMPLING_PROFILER_MAX_PERIOD_US (4096)      /* 10-bit Timer4 at clk/64 (16 MHz) */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+class SamplingProfiler
+{
+public:
+    void begin(uint16_t period_us);
+    void start(void);
+    void stop(void);
+    bool isRunning(void);
+    bool readSample(uint16_t *pc);
+    uint16_t getDroppedSamples(void);
+};
+
+#endif
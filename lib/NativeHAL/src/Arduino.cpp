@@ -0,0 +1,121 @@
+/**
+**********************************************************************************************************************
+*    @file           : Arduino.cpp
+*    @brief          : Arduino.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Arduino core API for the native build (GPIO, virtual time, USB serial and hardware UART)
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "Arduino.h"
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+Serial_ Serial;
+HardwareSerial Serial1;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Function configures the pin direction (DDRx) and the pull-up (PORTx)
+ * @param argument: uint8_t pin, uint8_t mode
+ * @retval None
+ */
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  hal::PinMapping mapping;
+
+  if (!hal::pinMapping(pin, &mapping)) {
+    return;
+  }
+
+  hal::advance_ns(hal::timing.pin_mode_ns);
+
+  hal::Register &ddr = hal::registers[mapping.port - 1];
+  hal::Register &port = hal::registers[mapping.port];
+  uint8_t mask = (uint8_t)(1 << mapping.bit);
+
+  if (mode == OUTPUT) {
+    ddr |= mask;
+  } else {
+    ddr &= (uint8_t)~mask;
+
+    if (mode == INPUT_PULLUP) {
+      port |= mask;
+    } else {
+      port &= (uint8_t)~mask;
+    }
+  }
+}
+
+/**
+ * @brief Function sets the pin output level. Costs the Arduino core digitalWrite() time (pin lookup + RMW)
+ * @param argument: uint8_t pin, uint8_t value
+ * @retval None
+ */
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+  hal::PinMapping mapping;
+
+  if (!hal::pinMapping(pin, &mapping)) {
+    return;
+  }
+
+  hal::advance_ns(hal::timing.digital_write_ns);
+
+  hal::Register &port = hal::registers[mapping.port];
+  uint8_t mask = (uint8_t)(1 << mapping.bit);
+
+  if (value == LOW) {
+    port &= (uint8_t)~mask;
+  } else {
+    port |= mask;
+  }
+}
+
+int digitalRead(uint8_t pin)
+{
+  hal::PinMapping mapping;
+
+  if (!hal::pinMapping(pin, &mapping)) {
+    return LOW;
+  }
+
+  return (hal::registers[mapping.port - 2] & (1 << mapping.bit)) ? HIGH : LOW;
+}
+
+uint32_t millis(void)
+{
+  return (uint32_t)(hal::now_ns() / 1000000ULL);
+}
+
+uint32_t micros(void)
+{
+  return (uint32_t)(hal::now_ns() / 1000ULL);
+}
+
+void delay(unsigned long ms)
+{
+  hal::advance_ns((uint64_t)ms * 1000000ULL);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  hal::advance_ns((uint64_t)us * 1000ULL);
+}
@@ -0,0 +1,123 @@
+/**
+**********************************************************************************************************************
+*    @file           : Arduino.h
+*    @brief          : Arduino.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Arduino core API for the native build. GPIO goes to the emulated registers of native_hal.h, time functions use
+*    the virtual clock (delay() only advances the simulated time), Serial is the emulated USB CDC port, Serial1
+*    the emulated hardware UART.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef NATIVE_ARDUINO_H_
+#define NATIVE_ARDUINO_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "binary.h"
+#include "Print.h"
+#include "native_hal.h"
+#include "avr/io.h"
+#include "avr/pgmspace.h"
+#include "avr/interrupt.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define ARDUINO_NATIVE_HAL
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define F_CPU 16000000UL
+
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(PSTR(string_literal)))
+
+#define lowByte(w) ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+#define bit(b) (1UL << (b))
+
+#define interrupts() sei()
+#define noInterrupts() cli()
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*USB CDC serial port (Serial_ is the class name of the ATmega32U4 core)*/
+class Serial_ : public Print
+{
+public:
+  void begin(unsigned long baudrate) { (void)baudrate; }
+  void end(void) {}
+  int available(void) { return hal::serialAvailable(); }
+  int read(void) { return hal::serialRead(); }
+  int peek(void) { return hal::serialPeek(); }
+  void flush(void) {}
+  virtual int availableForWrite(void) { return 64; }
+  virtual size_t write(uint8_t value) { hal::serialWrite(&value, 1); return 1; }
+  virtual size_t write(const uint8_t *buffer, size_t size) { hal::serialWrite(buffer, size); return size; }
+  using Print::write;
+  operator bool() { return true; }
+};
+
+/*Hardware UART (Serial1, USART1 on D0/D1): bytes take their time on the wire at the baud rate, 64 byte buffers*/
+class HardwareSerial : public Print
+{
+public:
+  void begin(unsigned long baudrate) { hal::uartBegin((uint32_t)baudrate); }
+  void end(void) { hal::uartBegin(0); }
+  int available(void) { return hal::uartAvailable(); }
+  int read(void) { return hal::uartRead(); }
+  int peek(void) { return hal::uartPeek(); }
+  void flush(void) { hal::uartFlush(); }
+  virtual int availableForWrite(void) { return hal::uartAvailableForWrite(); }
+  virtual size_t write(uint8_t value) { hal::uartWrite(value); return 1; }
+  using Print::write;
+  operator bool() { return true; }
+};
+
+extern Serial_ Serial;
+extern HardwareSerial Serial1;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+/* 32 bit like unsigned long on the AVR, so the timer arithmetic wraps the same way (millis() every 49.7 days) */
+uint32_t millis(void);
+uint32_t micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void setup(void);
+void loop(void);
+
+#endif
@@ -0,0 +1,166 @@
+/**
+**********************************************************************************************************************
+*    @file           : IRremote.h
+*    @brief          : IRremote.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    IRremote (v4.x) receiver API subset for the native build. Frames are queued with hal::irInject() and become
+*    decodable when the virtual clock reaches their timestamp. Injected frames are reported as NEC, with the raw
+*    timings of a NEC frame in rawDataPtr (valid until resume(), as with the receiver ISR).
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef NATIVE_IRREMOTE_H_
+#define NATIVE_IRREMOTE_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "Arduino.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define RAW_BUFFER_LENGTH       (100)
+#define MICROS_PER_TICK         (50)
+
+#define NEC_HEADER_MARK         (9000)
+#define NEC_HEADER_SPACE        (4500)
+#define NEC_BIT_MARK            (560)
+#define NEC_ONE_SPACE           (1690)
+#define NEC_ZERO_SPACE          (560)
+#define NEC_BITS                (32)
+#define NEC_FRAME_GAP           (40000)           /* Space before the frame, rawbuf[0] */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*Receiver ISR state, raw timings in ticks: rawbuf[0] the gap before the frame, then mark, space, ...*/
+struct irparams_struct
+{
+  uint_fast8_t rawlen;
+  uint16_t rawbuf[RAW_BUFFER_LENGTH];
+};
+
+typedef enum
+{
+  UNKNOWN = 0,
+  NEC = 8
+} decode_type_t;
+
+struct IRData
+{
+  decode_type_t protocol;
+  uint16_t address;
+  uint16_t command;
+  uint32_t decodedRawData;
+  uint8_t flags;
+  irparams_struct *rawDataPtr;
+};
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+class IRrecv
+{
+private:
+  uint_fast8_t _pin;
+  bool _enabled_f;
+  irparams_struct _params;
+
+  void rawPut(uint16_t micros_value)
+  {
+    _params.rawbuf[_params.rawlen++] = (uint16_t)(micros_value / MICROS_PER_TICK);
+  }
+
+  /**
+   * @brief Function fills the raw timings of the NEC frame of raw_data (LSB first)
+   * @param argument: uint32_t raw_data
+   * @retval None
+   */
+  void rawNec(uint32_t raw_data)
+  {
+    _params.rawlen = 0;
+    rawPut(NEC_FRAME_GAP);
+    rawPut(NEC_HEADER_MARK);
+    rawPut(NEC_HEADER_SPACE);
+
+    for (uint8_t bit = 0; bit < NEC_BITS; bit++) {
+      rawPut(NEC_BIT_MARK);
+      rawPut(((raw_data >> bit) & 1) ? NEC_ONE_SPACE : NEC_ZERO_SPACE);
+    }
+
+    rawPut(NEC_BIT_MARK);
+  }
+
+public:
+  IRData decodedIRData;
+
+  IRrecv() : _pin(0), _enabled_f(false), _params(), decodedIRData() {}
+  explicit IRrecv(uint_fast8_t pin) : _pin(pin), _enabled_f(false), _params(), decodedIRData() {}
+
+  void begin(uint_fast8_t pin, bool led_feedback_f = false)
+  {
+    (void)led_feedback_f;
+    _pin = pin;
+    enableIRIn();
+  }
+
+  void enableIRIn(void) { _enabled_f = true; }
+  void disableIRIn(void) { _enabled_f = false; }
+  void resume(void) {}
+
+  bool decode(void)
+  {
+    uint32_t raw_data;
+
+    if (!_enabled_f || !hal::irPop(hal::now_ns(), &raw_data)) {
+      return false;
+    }
+
+    decodedIRData.protocol = NEC;
+    decodedIRData.address = (uint16_t)(raw_data & 0xFFFF);
+    decodedIRData.command = (uint16_t)((raw_data >> 16) & 0xFF);
+    decodedIRData.decodedRawData = raw_data;
+    decodedIRData.flags = 0;
+    decodedIRData.rawDataPtr = &_params;
+    rawNec(raw_data);
+
+    return true;
+  }
+
+  void printIRResultMinimal(Print *output)
+  {
+    output->print(F("P=NEC A=0x"));
+    output->print(decodedIRData.address, HEX);
+    output->print(F(" C=0x"));
+    output->print(decodedIRData.command, HEX);
+    output->print(F(" Raw=0x"));
+    output->print((unsigned long)decodedIRData.decodedRawData, HEX);
+  }
+
+  void printIRResultRawFormatted(Print *output)
+  {
+    output->print(F("rawData[0]: (injected by native HAL)"));
+  }
+
+  void printIRResultAsCVariables(Print *output)
+  {
+    output->print(F("uint32_t tRawData=0x"));
+    output->print((unsigned long)decodedIRData.decodedRawData, HEX);
+    output->print(';');
+  }
+};
+
+#endif
@@ -0,0 +1,162 @@
+/**
+**********************************************************************************************************************
+*    @file           : PluggableUSB.h
+*    @brief          : PluggableUSB.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    PluggableUSB API of the ATmega32U4 core (PluggableUSB.h, USBAPI.h, USBCore.h subset) for the native build.
+*    Modules are plugged behind the CDC interfaces and endpoints like on the device. The host side of the bus is
+*    emulated by the hal::usb*() functions of native_hal.h: configuration and class requests go to the modules,
+*    OUT packets are queued per endpoint (two banks, a full endpoint NAKs) and IN packets are collected.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef NATIVE_PLUGGABLE_USB_H_
+#define NATIVE_PLUGGABLE_USB_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "Arduino.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define USB_ENDPOINTS                               (7)       /* ATmega32U4 endpoints incl. the control one */
+#define USB_EP_SIZE                                 (64)
+#define CDC_INTERFACE_COUNT                         (2)
+#define CDC_ENPOINT_COUNT                           (3)
+#define CDC_FIRST_ENDPOINT                          (1)
+
+#define TRANSFER_PGM                                (0x80)
+#define TRANSFER_RELEASE                            (0x40)
+#define TRANSFER_ZERO                               (0x20)
+
+#define GET_DESCRIPTOR                              (6)
+#define REQUEST_DEVICETOHOST_STANDARD_INTERFACE     (0x81)
+#define REQUEST_DEVICETOHOST_CLASS_INTERFACE        (0xA1)
+#define REQUEST_HOSTTODEVICE_CLASS_INTERFACE        (0x21)
+
+#define USB_INTERFACE_DESCRIPTOR_TYPE               (4)
+#define USB_ENDPOINT_DESCRIPTOR_TYPE                (5)
+#define USB_DEVICE_CLASS_HUMAN_INTERFACE            (0x03)
+#define USB_ENDPOINT_TYPE_INTERRUPT                 (0x03)
+#define USB_ENDPOINT_OUT(addr)                      (uint8_t)((addr) | 0x00)
+#define USB_ENDPOINT_IN(addr)                       (uint8_t)((addr) | 0x80)
+
+#define EP_TYPE_INTERRUPT_IN                        (0xC1)
+#define EP_TYPE_INTERRUPT_OUT                       (0xC0)
+
+#define D_INTERFACE(_n, _numEndpoints, _class, _subClass, _protocol)                                              \
+  {9, USB_INTERFACE_DESCRIPTOR_TYPE, _n, 0, _numEndpoints, _class, _subClass, _protocol, 0}
+
+#define D_ENDPOINT(_addr, _attr, _packetSize, _interval)                                                           \
+  {7, USB_ENDPOINT_DESCRIPTOR_TYPE, _addr, _attr, _packetSize, _interval}
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+struct USBSetup
+{
+  uint8_t bmRequestType;
+  uint8_t bRequest;
+  uint8_t wValueL;
+  uint8_t wValueH;
+  uint16_t wIndex;
+  uint16_t wLength;
+};
+
+/*Descriptors are sent as they are laid out in the memory: no padding, as on the AVR*/
+struct __attribute__((packed)) InterfaceDescriptor
+{
+  uint8_t len;
+  uint8_t dtype;
+  uint8_t number;
+  uint8_t alternate;
+  uint8_t numEndpoints;
+  uint8_t interfaceClass;
+  uint8_t interfaceSubClass;
+  uint8_t protocol;
+  uint8_t iInterface;
+};
+
+struct __attribute__((packed)) EndpointDescriptor
+{
+  uint8_t len;
+  uint8_t dtype;
+  uint8_t addr;
+  uint8_t attr;
+  uint16_t packetSize;
+  uint8_t interval;
+};
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+class PluggableUSBModule
+{
+public:
+  PluggableUSBModule(uint8_t numEps, uint8_t numIfs, uint8_t *epType)
+    : numEndpoints(numEps), numInterfaces(numIfs), endpointType(epType)
+  {
+  }
+
+protected:
+  virtual bool setup(USBSetup &setup) = 0;
+  virtual int getInterface(uint8_t *interfaceCount) = 0;
+  virtual int getDescriptor(USBSetup &setup) = 0;
+  virtual uint8_t getShortName(char *name) { name[0] = (char)('A' + pluggedInterface); return 1; }
+
+  uint8_t pluggedInterface = 0;
+  uint8_t pluggedEndpoint = 0;
+
+  const uint8_t numEndpoints;
+  const uint8_t numInterfaces;
+  const uint8_t *endpointType;
+
+  PluggableUSBModule *next = NULL;
+
+  friend class PluggableUSB_;
+};
+
+class PluggableUSB_
+{
+private:
+  uint8_t lastIf;
+  uint8_t lastEp;
+  PluggableUSBModule *rootNode;
+
+public:
+  PluggableUSB_();
+  bool plug(PluggableUSBModule *node);
+  int getInterface(uint8_t *interfaceCount);
+  int getDescriptor(USBSetup &setup);
+  bool setup(USBSetup &setup);
+};
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+
+PluggableUSB_ &PluggableUSB(void);
+
+int USB_SendControl(uint8_t flags, const void *d, int len);
+int USB_RecvControl(void *d, int len);
+uint8_t USB_Available(uint8_t ep);
+uint8_t USB_SendSpace(uint8_t ep);
+int USB_Send(uint8_t ep, const void *data, int len);
+int USB_Recv(uint8_t ep, void *data, int len);
+int USB_Recv(uint8_t ep);
+
+#endif
@@ -0,0 +1,155 @@
+/**
+**********************************************************************************************************************
+*    @file           : Print.cpp
+*    @brief          : Print.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Arduino compatible Print class for the native build
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "Print.h"
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+  size_t count = 0;
+
+  while (size--) {
+    if (write(*buffer++) == 0) {
+      break;
+    }
+
+    ++count;
+  }
+
+  return count;
+}
+
+/**
+ * @brief Function prints the number in the given base (2..16), same as the Arduino core
+ * @param argument: unsigned long value, uint8_t base
+ * @retval size_t - number of written bytes
+ */
+size_t Print::printNumber(unsigned long value, uint8_t base)
+{
+  char buffer[8 * sizeof(long) + 1];
+  char *str = &buffer[sizeof(buffer) - 1];
+
+  *str = '\0';
+
+  if (base < 2) {
+    base = 10;
+  }
+
+  do {
+    char digit = (char)(value % base);
+    value /= base;
+    *--str = (char)((digit < 10) ? (digit + '0') : (digit + 'A' - 10));
+  } while (value != 0);
+
+  return write(str);
+}
+
+size_t Print::print(const __FlashStringHelper *str)
+{
+  return write(reinterpret_cast<const char *>(str));
+}
+
+size_t Print::print(const char *str)
+{
+  return write(str);
+}
+
+size_t Print::print(char value)
+{
+  return write((uint8_t)value);
+}
+
+size_t Print::print(unsigned char value, int base)
+{
+  return print((unsigned long)value, base);
+}
+
+size_t Print::print(int value, int base)
+{
+  return print((long)value, base);
+}
+
+size_t Print::print(unsigned int value, int base)
+{
+  return print((unsigned long)value, base);
+}
+
+size_t Print::print(long value, int base)
+{
+  if (base == DEC && value < 0) {
+    return print('-') + printNumber((unsigned long)(-(value + 1)) + 1, DEC);
+  }
+
+  return printNumber((unsigned long)value, (uint8_t)base);
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+  return printNumber(value, (uint8_t)base);
+}
+
+size_t Print::println(void)
+{
+  return write("\r\n");
+}
+
+size_t Print::println(const __FlashStringHelper *str)
+{
+  return print(str) + println();
+}
+
+size_t Print::println(const char *str)
+{
+  return print(str) + println();
+}
+
+size_t Print::println(char value)
+{
+  return print(value) + println();
+}
+
+size_t Print::println(unsigned char value, int base)
+{
+  return print(value, base) + println();
+}
+
+size_t Print::println(int value, int base)
+{
+  return print(value, base) + println();
+}
+
+size_t Print::println(unsigned int value, int base)
+{
+  return print(value, base) + println();
+}
+
+size_t Print::println(long value, int base)
+{
+  return print(value, base) + println();
+}
+
+size_t Print::println(unsigned long value, int base)
+{
+  return print(value, base) + println();
+}
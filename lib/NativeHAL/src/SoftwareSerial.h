@@ -0,0 +1,57 @@
+/**
+**********************************************************************************************************************
+*    @file           : SoftwareSerial.h
+*    @brief          : SoftwareSerial.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    SoftwareSerial API for the native build. The bit-banged debug port output is written to stderr, so it is kept
+*    apart from the USB serial output (stdout)
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef NATIVE_SOFTWARE_SERIAL_H_
+#define NATIVE_SOFTWARE_SERIAL_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdio.h>
+
+#include "Arduino.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+class SoftwareSerial : public Print
+{
+private:
+  unsigned long _bit_time_ns;
+
+public:
+  SoftwareSerial(uint8_t rx_pin, uint8_t tx_pin) : _bit_time_ns(0) { (void)rx_pin; (void)tx_pin; }
+
+  void begin(unsigned long baudrate) { _bit_time_ns = 1000000000UL / baudrate; }
+  int available(void) { return 0; }
+  int read(void) { return -1; }
+
+  /* Byte transmission (start + 8 data + stop bits) blocks the CPU */
+  virtual size_t write(uint8_t value)
+  {
+    hal::advance_ns((uint64_t)_bit_time_ns * 10);
+    fputc(value, stderr);
+    return 1;
+  }
+
+  using Print::write;
+};
+
+#endif
@@ -0,0 +1,116 @@
+/**
+**********************************************************************************************************************
+*    @file           : eeprom.h
+*    @brief          : eeprom.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    EEPROM access API of avr-libc for the native build, backed by the emulated EEPROM of native_hal.h
+*    (erased state 0xFF, per-cell write counters, write cycle time added to the virtual clock)
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef NATIVE_AVR_EEPROM_H_
+#define NATIVE_AVR_EEPROM_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../native_hal.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define EEMEM
+#define E2END                   (NATIVE_HAL_EEPROM_SIZE - 1)   /* Last EEPROM address, avr/io.h of the ATmega32U4 */
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static inline uint16_t eepromAddress(const void *address)
+{
+  return (uint16_t)(uintptr_t)address;
+}
+
+static inline uint8_t eeprom_read_byte(const uint8_t *address)
+{
+  return hal::eepromRead(eepromAddress(address));
+}
+
+static inline uint16_t eeprom_read_word(const uint16_t *address)
+{
+  uint16_t base = eepromAddress(address);
+  return (uint16_t)(hal::eepromRead(base) | (hal::eepromRead((uint16_t)(base + 1)) << 8));
+}
+
+static inline void eeprom_read_block(void *destination, const void *source, size_t size)
+{
+  uint8_t *data = (uint8_t *)destination;
+  uint16_t base = eepromAddress(source);
+
+  for (size_t i = 0; i < size; i++) {
+    data[i] = hal::eepromRead((uint16_t)(base + i));
+  }
+}
+
+static inline void eeprom_write_byte(uint8_t *address, uint8_t value)
+{
+  hal::eepromWrite(eepromAddress(address), value);
+}
+
+static inline void eeprom_write_word(uint16_t *address, uint16_t value)
+{
+  uint16_t base = eepromAddress(address);
+
+  hal::eepromWrite(base, (uint8_t)value);
+  hal::eepromWrite((uint16_t)(base + 1), (uint8_t)(value >> 8));
+}
+
+static inline void eeprom_write_block(const void *source, void *destination, size_t size)
+{
+  const uint8_t *data = (const uint8_t *)source;
+  uint16_t base = eepromAddress(destination);
+
+  for (size_t i = 0; i < size; i++) {
+    hal::eepromWrite((uint16_t)(base + i), data[i]);
+  }
+}
+
+/* Update functions skip the write cycle when the cell already holds the value (as avr-libc does) */
+static inline void eeprom_update_byte(uint8_t *address, uint8_t value)
+{
+  if (eeprom_read_byte(address) != value) {
+    eeprom_write_byte(address, value);
+  }
+}
+
+static inline void eeprom_update_word(uint16_t *address, uint16_t value)
+{
+  uint8_t *base = (uint8_t *)address;
+
+  eeprom_update_byte(base, (uint8_t)value);
+  eeprom_update_byte(base + 1, (uint8_t)(value >> 8));
+}
+
+static inline void eeprom_update_block(const void *source, void *destination, size_t size)
+{
+  const uint8_t *data = (const uint8_t *)source;
+  uint8_t *base = (uint8_t *)destination;
+
+  for (size_t i = 0; i < size; i++) {
+    eeprom_update_byte(base + i, data[i]);
+  }
+}
+
+#endif
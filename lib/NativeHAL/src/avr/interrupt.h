@@ -0,0 +1,35 @@
+/**
+**********************************************************************************************************************
+*    @file           : interrupt.h
+*    @brief          : interrupt.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Interrupt API of avr-libc for the native build. The simulation is single threaded, so the global interrupt
+*    control is a no-op and ISR() declares a plain function the simulator can call
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef NATIVE_AVR_INTERRUPT_H_
+#define NATIVE_AVR_INTERRUPT_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define ISR_BLOCK
+#define ISR_NOBLOCK
+#define ISR_NAKED
+
+#define ISR(vector, ...) extern "C" void vector(void); extern "C" void vector(void)
+
+#define cli()
+#define sei()
+
+#endif
@@ -0,0 +1,276 @@
+/**
+**********************************************************************************************************************
+*    @file           : io.h
+*    @brief          : io.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    AVR I/O register definitions for the native build. GPIO registers of the ATmega32U4 map to the emulated
+*    registers of native_hal.h, so the plain register access (PORTC = PORTC | B11000000) works unchanged.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef NATIVE_AVR_IO_H_
+#define NATIVE_AVR_IO_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "../native_hal.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Registers-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define PINB        (hal::registers[hal::REG_PINB])
+#define DDRB        (hal::registers[hal::REG_DDRB])
+#define PORTB       (hal::registers[hal::REG_PORTB])
+
+#define PINC        (hal::registers[hal::REG_PINC])
+#define DDRC        (hal::registers[hal::REG_DDRC])
+#define PORTC       (hal::registers[hal::REG_PORTC])
+
+#define PIND        (hal::registers[hal::REG_PIND])
+#define DDRD        (hal::registers[hal::REG_DDRD])
+#define PORTD       (hal::registers[hal::REG_PORTD])
+
+#define PINE        (hal::registers[hal::REG_PINE])
+#define DDRE        (hal::registers[hal::REG_DDRE])
+#define PORTE       (hal::registers[hal::REG_PORTE])
+
+#define PINF        (hal::registers[hal::REG_PINF])
+#define DDRF        (hal::registers[hal::REG_DDRF])
+#define PORTF       (hal::registers[hal::REG_PORTF])
+
+#define SPCR        (hal::registers[hal::REG_SPCR])
+#define SPSR        (hal::registers[hal::REG_SPSR])
+#define SPDR        (hal::registers[hal::REG_SPDR])
+
+#define TCCR1A      (hal::registers[hal::REG_TCCR1A])
+#define TCCR1B      (hal::registers[hal::REG_TCCR1B])
+#define TCCR1C      (hal::registers[hal::REG_TCCR1C])
+#define TIMSK1      (hal::registers[hal::REG_TIMSK1])
+#define TIFR1       (hal::registers[hal::REG_TIFR1])
+#define TCNT1       (hal::Register16(hal::REG_TCNT1L))
+#define OCR1A       (hal::Register16(hal::REG_OCR1AL))
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define _BV(bit) (1 << (bit))
+
+#define PINB0  0
+#define PINB1  1
+#define PINB2  2
+#define PINB3  3
+#define PINB4  4
+#define PINB5  5
+#define PINB6  6
+#define PINB7  7
+#define DDB0   0
+#define DDB1   1
+#define DDB2   2
+#define DDB3   3
+#define DDB4   4
+#define DDB5   5
+#define DDB6   6
+#define DDB7   7
+#define PORTB0 0
+#define PORTB1 1
+#define PORTB2 2
+#define PORTB3 3
+#define PORTB4 4
+#define PORTB5 5
+#define PORTB6 6
+#define PORTB7 7
+#define PB0    0
+#define PB1    1
+#define PB2    2
+#define PB3    3
+#define PB4    4
+#define PB5    5
+#define PB6    6
+#define PB7    7
+
+#define PINC0  0
+#define PINC1  1
+#define PINC2  2
+#define PINC3  3
+#define PINC4  4
+#define PINC5  5
+#define PINC6  6
+#define PINC7  7
+#define DDC0   0
+#define DDC1   1
+#define DDC2   2
+#define DDC3   3
+#define DDC4   4
+#define DDC5   5
+#define DDC6   6
+#define DDC7   7
+#define PORTC0 0
+#define PORTC1 1
+#define PORTC2 2
+#define PORTC3 3
+#define PORTC4 4
+#define PORTC5 5
+#define PORTC6 6
+#define PORTC7 7
+#define PC0    0
+#define PC1    1
+#define PC2    2
+#define PC3    3
+#define PC4    4
+#define PC5    5
+#define PC6    6
+#define PC7    7
+
+#define PIND0  0
+#define PIND1  1
+#define PIND2  2
+#define PIND3  3
+#define PIND4  4
+#define PIND5  5
+#define PIND6  6
+#define PIND7  7
+#define DDD0   0
+#define DDD1   1
+#define DDD2   2
+#define DDD3   3
+#define DDD4   4
+#define DDD5   5
+#define DDD6   6
+#define DDD7   7
+#define PORTD0 0
+#define PORTD1 1
+#define PORTD2 2
+#define PORTD3 3
+#define PORTD4 4
+#define PORTD5 5
+#define PORTD6 6
+#define PORTD7 7
+#define PD0    0
+#define PD1    1
+#define PD2    2
+#define PD3    3
+#define PD4    4
+#define PD5    5
+#define PD6    6
+#define PD7    7
+
+#define PINE0  0
+#define PINE1  1
+#define PINE2  2
+#define PINE3  3
+#define PINE4  4
+#define PINE5  5
+#define PINE6  6
+#define PINE7  7
+#define DDE0   0
+#define DDE1   1
+#define DDE2   2
+#define DDE3   3
+#define DDE4   4
+#define DDE5   5
+#define DDE6   6
+#define DDE7   7
+#define PORTE0 0
+#define PORTE1 1
+#define PORTE2 2
+#define PORTE3 3
+#define PORTE4 4
+#define PORTE5 5
+#define PORTE6 6
+#define PORTE7 7
+#define PE0    0
+#define PE1    1
+#define PE2    2
+#define PE3    3
+#define PE4    4
+#define PE5    5
+#define PE6    6
+#define PE7    7
+
+#define PINF0  0
+#define PINF1  1
+#define PINF2  2
+#define PINF3  3
+#define PINF4  4
+#define PINF5  5
+#define PINF6  6
+#define PINF7  7
+#define DDF0   0
+#define DDF1   1
+#define DDF2   2
+#define DDF3   3
+#define DDF4   4
+#define DDF5   5
+#define DDF6   6
+#define DDF7   7
+#define PORTF0 0
+#define PORTF1 1
+#define PORTF2 2
+#define PORTF3 3
+#define PORTF4 4
+#define PORTF5 5
+#define PORTF6 6
+#define PORTF7 7
+#define PF0    0
+#define PF1    1
+#define PF2    2
+#define PF3    3
+#define PF4    4
+#define PF5    5
+#define PF6    6
+#define PF7    7
+
+#define SPR0   0                                /* SPCR */
+#define SPR1   1
+#define CPHA   2
+#define CPOL   3
+#define MSTR   4
+#define DORD   5
+#define SPE    6
+#define SPIE   7
+#define SPI2X  0                                /* SPSR */
+#define WCOL   6
+#define SPIF   7
+
+#define WGM10  0                                /* TCCR1A */
+#define WGM11  1
+#define COM1C0 2
+#define COM1C1 3
+#define COM1B0 4
+#define COM1B1 5
+#define COM1A0 6
+#define COM1A1 7
+#define CS10   0                                /* TCCR1B */
+#define CS11   1
+#define CS12   2
+#define WGM12  3
+#define WGM13  4
+#define ICES1  6
+#define ICNC1  7
+#define FOC1C  5                                /* TCCR1C */
+#define FOC1B  6
+#define FOC1A  7
+#define TOIE1  0                                /* TIMSK1 */
+#define OCIE1A 1
+#define OCIE1B 2
+#define OCIE1C 3
+#define ICIE1  5
+#define TOV1   0                                /* TIFR1 */
+#define OCF1A  1
+#define OCF1B  2
+#define OCF1C  3
+#define ICF1   5
+
+#endif
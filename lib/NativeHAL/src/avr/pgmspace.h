@@ -0,0 +1,46 @@
+/**
+**********************************************************************************************************************
+*    @file           : pgmspace.h
+*    @brief          : pgmspace.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Program memory API of avr-libc for the native build (host has a single address space)
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef NATIVE_AVR_PGMSPACE_H_
+#define NATIVE_AVR_PGMSPACE_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define PROGMEM
+#define PSTR(string_literal) (string_literal)
+
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define pgm_read_word(address) (*(const uint16_t *)(address))
+#define pgm_read_dword(address) (*(const uint32_t *)(address))
+
+#define strlen_P strlen
+#define strnlen_P strnlen
+#define strcmp_P strcmp
+#define memcpy_P memcpy
+
+typedef const char *PGM_P;
+
+#endif
@@ -0,0 +1,39 @@
+/**
+**********************************************************************************************************************
+*    @file           : sleep.h
+*    @brief          : sleep.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Sleep API of avr-libc for the native build. Only the idle mode is emulated: sleep_cpu() runs the virtual
+*    clock to the next interrupt (hal::sleepCpu()), the time asleep is counted by hal::sleepTotalNs()
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef NATIVE_AVR_SLEEP_H_
+#define NATIVE_AVR_SLEEP_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "../native_hal.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define SLEEP_MODE_IDLE     0
+
+#define set_sleep_mode(mode) ((void)(mode))
+#define sleep_enable()
+#define sleep_disable()
+#define sleep_cpu() hal::sleepCpu()
+
+#endif
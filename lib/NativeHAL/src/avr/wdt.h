@@ -0,0 +1,47 @@
+/**
+**********************************************************************************************************************
+*    @file           : wdt.h
+*    @brief          : wdt.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Watchdog API of avr-libc for the native build. Timeouts are tracked on the virtual clock, an expiration is
+*    counted (hal::watchdogExpirations()) and reported instead of resetting the process
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef NATIVE_AVR_WDT_H_
+#define NATIVE_AVR_WDT_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "../native_hal.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define WDTO_15MS   0
+#define WDTO_30MS   1
+#define WDTO_60MS   2
+#define WDTO_120MS  3
+#define WDTO_250MS  4
+#define WDTO_500MS  5
+#define WDTO_1S     6
+#define WDTO_2S     7
+#define WDTO_4S     8
+#define WDTO_8S     9
+
+#define wdt_enable(timeout) hal::watchdogEnable(timeout)
+#define wdt_reset() hal::watchdogReset()
+#define wdt_disable() hal::watchdogDisable()
+
+#endif
@@ -0,0 +1,680 @@
+/**
+**********************************************************************************************************************
+*    @file           : native_hal.cpp
+*    @brief          : native_hal.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Implements the host side hardware abstraction shim (virtual clock, registers, EEPROM, watchdog, serial, IR,
+*    Timer1). Timer1 is emulated in the normal mode only: the count follows the virtual clock, a compare match on
+*    OCR1A applies the COM1A action to the OC1A level (driven on the PORTB5 bit, so the pin observers see the edges)
+*    and calls TIMER1_COMPA_vect when enabled. The ISR preempts the running code, its time delays that code.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "native_hal.h"
+#include "Arduino.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+namespace hal {
+
+Register registers[REG_COUNT] = {
+  Register(REG_PINB), Register(REG_DDRB), Register(REG_PORTB),
+  Register(REG_PINC), Register(REG_DDRC), Register(REG_PORTC),
+  Register(REG_PIND), Register(REG_DDRD), Register(REG_PORTD),
+  Register(REG_PINE), Register(REG_DDRE), Register(REG_PORTE),
+  Register(REG_PINF), Register(REG_DDRF), Register(REG_PORTF),
+  Register(REG_SPCR), Register(REG_SPSR), Register(REG_SPDR),
+  Register(REG_TCCR1A), Register(REG_TCCR1B), Register(REG_TCCR1C),
+  Register(REG_TCNT1L), Register(REG_TCNT1H), Register(REG_OCR1AL), Register(REG_OCR1AH),
+  Register(REG_TIMSK1), Register(REG_TIFR1),
+};
+
+Timing timing = {
+  3500,                                         /* digital_write_ns */
+  4000,                                         /* pin_mode_ns */
+  190,                                          /* register_write_ns: 3 cycles */
+  250,                                          /* eeprom_read_byte_ns */
+  3400000,                                      /* eeprom_write_byte_ns: 3.4 ms */
+  2000,                                         /* loop_overhead_ns */
+  1000,                                         /* spi_byte_ns: 8 bits at 8 MHz */
+  2500,                                         /* isr_overhead_ns: 40 cycles */
+};
+
+/*Arduino pin -> port/bit mapping of the ATmega32U4 (Leonardo / Pro Micro variant)*/
+static const PinMapping pin_map[NATIVE_HAL_PIN_COUNT] = {
+  {REG_PORTD, 2}, {REG_PORTD, 3}, {REG_PORTD, 1}, {REG_PORTD, 0},       /* D0..D3 */
+  {REG_PORTD, 4}, {REG_PORTC, 6}, {REG_PORTD, 7}, {REG_PORTE, 6},       /* D4..D7 */
+  {REG_PORTB, 4}, {REG_PORTB, 5}, {REG_PORTB, 6}, {REG_PORTB, 7},       /* D8..D11 */
+  {REG_PORTD, 6}, {REG_PORTC, 7}, {REG_PORTB, 3}, {REG_PORTB, 1},       /* D12..D15 */
+  {REG_PORTB, 2}, {REG_PORTB, 0}, {REG_PORTF, 7}, {REG_PORTF, 6},       /* D16..D19 (A0, A1) */
+  {REG_PORTF, 5}, {REG_PORTF, 4}, {REG_PORTF, 1}, {REG_PORTF, 0},       /* D20..D23 (A2..A5) */
+};
+
+static const char *const register_names[REG_COUNT] = {
+  "PINB", "DDRB", "PORTB",
+  "PINC", "DDRC", "PORTC",
+  "PIND", "DDRD", "PORTD",
+  "PINE", "DDRE", "PORTE",
+  "PINF", "DDRF", "PORTF",
+  "SPCR", "SPSR", "SPDR",
+  "TCCR1A", "TCCR1B", "TCCR1C",
+  "TCNT1L", "TCNT1H", "OCR1AL", "OCR1AH",
+  "TIMSK1", "TIFR1",
+};
+
+/* TCCR1B clock select -> prescaler, 0: stopped or external clock (not emulated) */
+static const uint16_t timer1_prescalers[8] = {0, 1, 8, 64, 256, 1024, 0, 0};
+
+/* WDTO_xx value -> timeout in ms */
+static const uint32_t watchdog_timeouts_ms[] = {15, 30, 60, 120, 250, 500, 1000, 2000, 4000, 8000};
+
+static uint64_t clock_ns;
+static std::vector<RegisterObserver *> observers;
+static uint8_t external_inputs[REG_COUNT];
+
+static uint8_t eeprom[NATIVE_HAL_EEPROM_SIZE];
+static uint32_t eeprom_writes[NATIVE_HAL_EEPROM_SIZE];
+static uint64_t eeprom_busy_ns;
+static bool eeprom_initialized_f;
+static bool eeprom_cut_armed_f;
+static bool eeprom_cut_tear_f;
+static bool eeprom_power_lost_f;
+static uint32_t eeprom_cut_writes_left;
+
+static bool watchdog_enabled_f;
+static uint64_t watchdog_timeout_ns;
+static uint64_t watchdog_last_reset_ns;
+static uint32_t watchdog_expirations;
+
+static std::deque<uint8_t> serial_input;
+static void stdoutSink(const uint8_t *data, size_t length);
+static SerialSink serial_sink = stdoutSink;
+
+struct IrFrame
+{
+  uint64_t time_ns;
+  uint32_t raw_data;
+
+  bool operator<(const IrFrame &other) const { return time_ns < other.time_ns; }
+};
+
+static std::deque<IrFrame> ir_frames;
+
+static uint64_t timer1_base_ns;                 /* Clock of the last count rebase */
+static uint16_t timer1_base_count;
+static bool timer1_oc1a_f;                      /* OC1A output compare level */
+static bool timer1_in_service_f;                /* TIMER1_COMPA_vect running */
+static uint64_t sleep_total_ns;
+
+} /* namespace hal */
+
+/* Timer1 compare match ISR of the firmware, when it defines one */
+extern "C" void TIMER1_COMPA_vect(void) __attribute__((weak));
+
+namespace hal {
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static void stdoutSink(const uint8_t *data, size_t length)
+{
+  fwrite(data, 1, length, stdout);
+}
+
+/* Timer1 clock period in ps, 0 when the timer is stopped */
+static uint64_t timer1TickPs(void)
+{
+  return (uint64_t)timer1_prescalers[registers[REG_TCCR1B].raw() & 0x07] * (1000000000000ULL / F_CPU);
+}
+
+static uint16_t timer1Count(void)
+{
+  uint64_t tick_ps = timer1TickPs();
+
+  if (tick_ps == 0) {
+    return timer1_base_count;
+  }
+
+  return (uint16_t)(timer1_base_count + (clock_ns - timer1_base_ns) * 1000ULL / tick_ps);
+}
+
+static void timer1Rebase(uint16_t count)
+{
+  timer1_base_count = count;
+  timer1_base_ns = clock_ns;
+}
+
+/**
+ * @brief Function returns the clock of the next OCR1A compare match, UINT64_MAX when the timer is stopped
+ * @param argument: None
+ * @retval uint64_t
+ */
+static uint64_t timer1NextMatchNs(void)
+{
+  uint64_t tick_ps = timer1TickPs();
+
+  if (tick_ps == 0) {
+    return UINT64_MAX;
+  }
+
+  uint64_t ticks = (clock_ns - timer1_base_ns) * 1000ULL / tick_ps;
+  uint16_t ocr = (uint16_t)(registers[REG_OCR1AL].raw() | (registers[REG_OCR1AH].raw() << 8));
+  uint16_t delta = (uint16_t)(ocr - (uint16_t)(timer1_base_count + ticks));
+  uint64_t match_ticks = ticks + ((delta == 0) ? 0x10000UL : delta);
+
+  return timer1_base_ns + (match_ticks * tick_ps + 999ULL) / 1000ULL;
+}
+
+/* COM1A action of a compare match (or of the FOC1A strobe) on the OC1A level */
+static void timer1CompareOutput(void)
+{
+  uint8_t mode = (uint8_t)((registers[REG_TCCR1A].raw() >> COM1A0) & 0x03);
+
+  if (mode == 0) {
+    return;                                     /* OC1A disconnected, PB5 is a GPIO */
+  }
+
+  timer1_oc1a_f = (mode == 1) ? !timer1_oc1a_f : (mode == 3);
+
+  Register &port = registers[REG_PORTB];
+  port.drive(timer1_oc1a_f ? (uint8_t)(port.raw() | (1 << PORTB5)) : (uint8_t)(port.raw() & ~(1 << PORTB5)));
+}
+
+/**
+ * @brief Function processes a compare match at the current clock: output action, OCF1A, ISR
+ * @param argument: None
+ * @retval uint64_t - time spent in the ISR
+ */
+static uint64_t timer1Match(void)
+{
+  uint64_t start_ns = clock_ns;
+  Register &flags = registers[REG_TIFR1];
+
+  timer1_in_service_f = true;
+  timer1CompareOutput();
+  flags.setRaw((uint8_t)(flags.raw() | (1 << OCF1A)));
+
+  if ((registers[REG_TIMSK1].raw() & (1 << OCIE1A)) && TIMER1_COMPA_vect != NULL) {
+    flags.setRaw((uint8_t)(flags.raw() & ~(1 << OCF1A)));
+    clock_ns += timing.isr_overhead_ns;
+    TIMER1_COMPA_vect();
+  }
+
+  timer1_in_service_f = false;
+
+  return clock_ns - start_ns;
+}
+
+/**
+ * @brief Register read. PINx returns the output level of the output pins and the external level of the inputs.
+ * @param argument: None
+ * @retval uint8_t
+ */
+Register::operator uint8_t() const
+{
+  if (_id == REG_TCNT1L || _id == REG_TCNT1H) {
+    uint16_t count = timer1Count();
+    return (_id == REG_TCNT1L) ? (uint8_t)count : (uint8_t)(count >> 8);
+  }
+
+  if (isPin()) {
+    uint8_t ddr = registers[_id + 1].raw();
+    uint8_t port = registers[_id + 2].raw();
+    return (uint8_t)((port & ddr) | (external_inputs[_id] & ~ddr));
+  }
+
+  return _value;
+}
+
+/**
+ * @brief Register write. Writing ones to PINx toggles PORTx bits (as on the AVR). Observers are notified.
+ * @param argument: uint8_t value
+ * @retval Register &
+ */
+Register &Register::operator=(uint8_t value)
+{
+  if (isPin()) {
+    Register &port = registers[_id + 2];
+    port = (uint8_t)(port.raw() ^ value);
+    return *this;
+  }
+
+  uint8_t old_value = _value;
+
+  if (_id == REG_TCCR1B) {
+    timer1Rebase(timer1Count());                /* Count so far with the old clock select */
+  }
+
+  _value = (_id == REG_TIFR1) ? (uint8_t)(old_value & ~value) : value;    /* Writing 1 clears a flag */
+
+  advance_ns(timing.register_write_ns);
+
+  if (_id == REG_TCNT1L) {
+    timer1Rebase((uint16_t)(value | (registers[REG_TCNT1H].raw() << 8)));
+  } else if (_id == REG_TCCR1C) {
+    if (value & (1 << FOC1A)) {
+      timer1CompareOutput();
+    }
+    _value = 0;                                 /* Strobe bits read as zero */
+  }
+
+  /* SPI master transfer: the byte is shifted out, then SPIF is set */
+  if (_id == REG_SPDR && (registers[REG_SPCR].raw() & (1 << SPE))) {
+    advance_ns(timing.spi_byte_ns);
+    registers[REG_SPSR].setRaw((uint8_t)(registers[REG_SPSR].raw() | (1 << SPIF)));
+  }
+
+  for (size_t i = 0; i < observers.size(); i++) {
+    observers[i]->onRegisterWrite(_id, old_value, value, clock_ns);
+  }
+
+  return *this;
+}
+
+/**
+ * @brief Register write by the hardware (timer output compare): observers are notified, no CPU time is spent
+ * @param argument: uint8_t value
+ * @retval None
+ */
+void Register::drive(uint8_t value)
+{
+  uint8_t old_value = _value;
+  _value = value;
+
+  for (size_t i = 0; i < observers.size(); i++) {
+    observers[i]->onRegisterWrite(_id, old_value, value, clock_ns);
+  }
+}
+
+Register16::operator uint16_t() const
+{
+  if (_low == REG_TCNT1L) {
+    return timer1Count();
+  }
+
+  return (uint16_t)(registers[_low].raw() | (registers[_low + 1].raw() << 8));
+}
+
+Register16 &Register16::operator=(uint16_t value)
+{
+  registers[_low + 1] = (uint8_t)(value >> 8);  /* High byte to TEMP first, the low byte write commits */
+  registers[_low] = (uint8_t)value;
+  return *this;
+}
+
+/**
+ * @brief Function emulates the power cycle: registers, watchdog, serial, IR, USB and UART queues are cleared, the
+ *        clock is kept
+ * @param argument: None
+ * @retval None
+ */
+void reset(void)
+{
+  for (size_t i = 0; i < REG_COUNT; i++) {
+    registers[i].setRaw(0);
+    external_inputs[i] = 0;
+  }
+
+  watchdog_enabled_f = false;
+  timer1Rebase(0);
+  timer1_oc1a_f = false;
+  serial_input.clear();
+  ir_frames.clear();
+  usbReset();
+  uartReset();
+}
+
+uint64_t now_ns(void)
+{
+  return clock_ns;
+}
+
+/**
+ * @brief Function advances the virtual clock. Watchdog timeout is checked on every clock change.
+ * @param argument: uint64_t delta_ns
+ * @retval None
+ */
+void advance_ns(uint64_t delta_ns)
+{
+  uint64_t target_ns = clock_ns + delta_ns;
+
+  /* Compare matches within the step preempt the running code, the ISR time delays it */
+  while (!timer1_in_service_f) {
+    uint64_t match_ns = timer1NextMatchNs();
+
+    if (match_ns > target_ns) {
+      break;
+    }
+
+    clock_ns = match_ns;
+    target_ns += timer1Match();
+  }
+
+  clock_ns = target_ns;
+
+  if (watchdog_enabled_f && (clock_ns - watchdog_last_reset_ns) > watchdog_timeout_ns) {
+    ++watchdog_expirations;
+    watchdog_last_reset_ns = clock_ns;
+    fprintf(stderr, "[native hal] watchdog expired at %.3f s\n", (double)clock_ns / 1e9);
+  }
+}
+
+void set_time_ns(uint64_t time_ns)
+{
+  if (time_ns > clock_ns) {
+    advance_ns(time_ns - clock_ns);
+  }
+}
+
+/**
+ * @brief Function advances the virtual clock over a period the firmware spends in idle main loop passes. The
+ *        passes would keep petting the watchdog, so the watchdog timeout is moved with the clock.
+ * @param argument: uint64_t delta_ns
+ * @retval None
+ */
+void idle_ns(uint64_t delta_ns)
+{
+  clock_ns += delta_ns;
+  watchdog_last_reset_ns += delta_ns;
+}
+
+/**
+ * @brief Function emulates the idle sleep: the clock runs to the next enabled interrupt, the Timer1 compare match
+ *        or the Timer0 overflow of millis() (modelled as the next 1 ms boundary)
+ * @param argument: None
+ * @retval None
+ */
+void sleepCpu(void)
+{
+  uint64_t wake_ns = (clock_ns / 1000000ULL + 1) * 1000000ULL;
+
+  if (registers[REG_TIMSK1].raw() & (1 << OCIE1A)) {
+    wake_ns = std::min(wake_ns, timer1NextMatchNs());
+  }
+
+  sleep_total_ns += wake_ns - clock_ns;
+  advance_ns(wake_ns - clock_ns);
+}
+
+uint64_t sleepTotalNs(void)
+{
+  return sleep_total_ns;
+}
+
+bool pinMapping(uint8_t pin, PinMapping *mapping)
+{
+  if (pin >= NATIVE_HAL_PIN_COUNT) {
+    return false;
+  }
+
+  *mapping = pin_map[pin];
+  return true;
+}
+
+const char *registerName(RegisterId reg)
+{
+  return (reg < REG_COUNT) ? register_names[reg] : "?";
+}
+
+void addObserver(RegisterObserver *observer)
+{
+  observers.push_back(observer);
+}
+
+void removeObserver(RegisterObserver *observer)
+{
+  observers.erase(std::remove(observers.begin(), observers.end(), observer), observers.end());
+}
+
+void setInputLevel(uint8_t pin, bool level)
+{
+  PinMapping mapping;
+
+  if (pinMapping(pin, &mapping)) {
+    uint8_t &inputs = external_inputs[mapping.port - 2];
+    inputs = level ? (uint8_t)(inputs | (1 << mapping.bit)) : (uint8_t)(inputs & ~(1 << mapping.bit));
+  }
+}
+
+/**
+ * @brief Function returns the EEPROM content. On the first access (it can be a global constructor) the image from
+ *        NATIVE_HAL_EEPROM_ENV file is loaded, erased state (0xFF) is used when the file does not exist
+ * @param argument: None
+ * @retval uint8_t *
+ */
+uint8_t *eepromData(void)
+{
+  if (!eeprom_initialized_f) {
+    eeprom_initialized_f = true;
+    memset(eeprom, 0xFF, sizeof(eeprom));
+
+    const char *path = getenv(NATIVE_HAL_EEPROM_ENV);
+
+    if (path != NULL && !eepromLoad(path)) {
+      memset(eeprom, 0xFF, sizeof(eeprom));
+    }
+  }
+
+  return eeprom;
+}
+
+uint32_t eepromWriteCount(uint16_t address)
+{
+  return (address < NATIVE_HAL_EEPROM_SIZE) ? eeprom_writes[address] : 0;
+}
+
+uint64_t eepromTotalWrites(void)
+{
+  uint64_t total = 0;
+
+  for (size_t i = 0; i < NATIVE_HAL_EEPROM_SIZE; i++) {
+    total += eeprom_writes[i];
+  }
+
+  return total;
+}
+
+uint64_t eepromBusyNs(void)
+{
+  return eeprom_busy_ns;
+}
+
+void eepromErase(void)
+{
+  memset(eepromData(), 0xFF, NATIVE_HAL_EEPROM_SIZE);
+  memset(eeprom_writes, 0, sizeof(eeprom_writes));
+  eeprom_busy_ns = 0;
+}
+
+void eepromPowerCut(uint32_t writes_left, bool tear_f)
+{
+  eeprom_cut_armed_f = true;
+  eeprom_cut_tear_f = tear_f;
+  eeprom_cut_writes_left = writes_left;
+}
+
+void eepromPowerRestore(void)
+{
+  eeprom_cut_armed_f = false;
+  eeprom_power_lost_f = false;
+}
+
+bool eepromPowerLost(void)
+{
+  return eeprom_power_lost_f;
+}
+
+bool eepromLoad(const char *path)
+{
+  FILE *file = fopen(path, "rb");
+
+  if (file == NULL) {
+    return false;
+  }
+
+  size_t length = fread(eepromData(), 1, NATIVE_HAL_EEPROM_SIZE, file);
+  fclose(file);
+
+  return length == NATIVE_HAL_EEPROM_SIZE;
+}
+
+bool eepromSave(const char *path)
+{
+  FILE *file = fopen(path, "wb");
+
+  if (file == NULL) {
+    return false;
+  }
+
+  size_t length = fwrite(eepromData(), 1, NATIVE_HAL_EEPROM_SIZE, file);
+  fclose(file);
+
+  return length == NATIVE_HAL_EEPROM_SIZE;
+}
+
+uint8_t eepromRead(uint16_t address)
+{
+  advance_ns(timing.eeprom_read_byte_ns);
+  return eepromData()[address % NATIVE_HAL_EEPROM_SIZE];
+}
+
+void eepromWrite(uint16_t address, uint8_t value)
+{
+  address %= NATIVE_HAL_EEPROM_SIZE;
+
+  if (eeprom_power_lost_f) {
+    return;
+  }
+
+  if (eeprom_cut_armed_f && eeprom_cut_writes_left-- == 0) {
+    eeprom_power_lost_f = true;
+
+    if (eeprom_cut_tear_f) {
+      eepromData()[address] = 0xFF;
+    }
+
+    return;
+  }
+
+  eepromData()[address] = value;
+  ++eeprom_writes[address];
+  eeprom_busy_ns += timing.eeprom_write_byte_ns;
+  advance_ns(timing.eeprom_write_byte_ns);
+}
+
+uint32_t watchdogExpirations(void)
+{
+  return watchdog_expirations;
+}
+
+void watchdogEnable(uint8_t timeout)
+{
+  uint8_t index = (timeout < sizeof(watchdog_timeouts_ms) / sizeof(watchdog_timeouts_ms[0])) ? timeout : 0;
+
+  watchdog_timeout_ns = (uint64_t)watchdog_timeouts_ms[index] * 1000000ULL;
+  watchdog_last_reset_ns = clock_ns;
+  watchdog_enabled_f = true;
+}
+
+void watchdogReset(void)
+{
+  watchdog_last_reset_ns = clock_ns;
+}
+
+void watchdogDisable(void)
+{
+  watchdog_enabled_f = false;
+}
+
+void serialInject(const uint8_t *data, size_t length)
+{
+  serial_input.insert(serial_input.end(), data, data + length);
+}
+
+void serialSetSink(SerialSink sink)
+{
+  serial_sink = sink;
+}
+
+int serialAvailable(void)
+{
+  return (int)serial_input.size();
+}
+
+int serialRead(void)
+{
+  if (serial_input.empty()) {
+    return -1;
+  }
+
+  int value = serial_input.front();
+  serial_input.pop_front();
+
+  return value;
+}
+
+int serialPeek(void)
+{
+  return serial_input.empty() ? -1 : serial_input.front();
+}
+
+void serialWrite(const uint8_t *data, size_t length)
+{
+  if (serial_sink != NULL) {
+    serial_sink(data, length);
+  }
+}
+
+/**
+ * @brief Function queues the IR frame, the frame can be decoded by the firmware from the given time
+ * @param argument: uint32_t raw_data - IRremote decodedRawData value, uint64_t time_ns
+ * @retval None
+ */
+void irInject(uint32_t raw_data, uint64_t time_ns)
+{
+  IrFrame frame = {time_ns, raw_data};
+
+  ir_frames.insert(std::upper_bound(ir_frames.begin(), ir_frames.end(), frame), frame);
+}
+
+size_t irPending(void)
+{
+  return ir_frames.size();
+}
+
+bool irPop(uint64_t time_ns, uint32_t *raw_data)
+{
+  if (ir_frames.empty() || ir_frames.front().time_ns > time_ns) {
+    return false;
+  }
+
+  *raw_data = ir_frames.front().raw_data;
+  ir_frames.pop_front();
+
+  return true;
+}
+
+} /* namespace hal */
@@ -0,0 +1,230 @@
+/**
+**********************************************************************************************************************
+*    @file           : native_hal.h
+*    @brief          : native_hal.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Host side hardware abstraction shim for the native (Linux) build of the firmware. Emulates the ATmega32U4
+*    resources used by the firmware: GPIO registers (with write observers), Arduino pin mapping of the Pro Micro,
+*    virtual clock (millis/micros/delays advance the simulated time, not the wall clock), EEPROM (with per-cell
+*    write counters), watchdog, USB serial and IR receiver input queues, Timer1 (normal mode, OC1A output compare
+*    with its interrupt), the idle sleep mode, the host side of the PluggableUSB endpoints (native_usb.cpp) and the
+*    line side of the hardware UART (native_uart.cpp).
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef NATIVE_HAL_H_
+#define NATIVE_HAL_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define NATIVE_HAL_EEPROM_SIZE      (1024)            /* ATmega32U4 EEPROM size */
+#define NATIVE_HAL_PIN_COUNT        (24)              /* Pro Micro / Leonardo digital pins D0..D23 */
+#define NATIVE_HAL_EEPROM_ENV       "NATIVE_HAL_EEPROM"  /* EEPROM image file, loaded before the global constructors */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+namespace hal {
+
+/*Emulated I/O registers*/
+enum RegisterId
+{
+  REG_PINB, REG_DDRB, REG_PORTB,
+  REG_PINC, REG_DDRC, REG_PORTC,
+  REG_PIND, REG_DDRD, REG_PORTD,
+  REG_PINE, REG_DDRE, REG_PORTE,
+  REG_PINF, REG_DDRF, REG_PORTF,
+  REG_SPCR, REG_SPSR, REG_SPDR,                 /* SPI master, a SPDR write is the transferred byte */
+  REG_TCCR1A, REG_TCCR1B, REG_TCCR1C,           /* Timer1: normal mode, OC1A drives PB5 (pin 9) */
+  REG_TCNT1L, REG_TCNT1H, REG_OCR1AL, REG_OCR1AH,
+  REG_TIMSK1, REG_TIFR1,
+  REG_COUNT
+};
+
+/*Virtual time cost of the emulated operations (ATmega32U4 @ 16 MHz estimates)*/
+struct Timing
+{
+  uint32_t digital_write_ns;                    /* Arduino digitalWrite() incl. pin lookup */
+  uint32_t pin_mode_ns;
+  uint32_t register_write_ns;                   /* Direct register RMW (IN/OR/OUT) */
+  uint32_t eeprom_read_byte_ns;
+  uint32_t eeprom_write_byte_ns;                /* Erase + write cycle, CPU busy-waits in avr-libc */
+  uint32_t loop_overhead_ns;                    /* Cost of one empty Arduino loop() pass */
+  uint32_t spi_byte_ns;                         /* SPI byte transfer, fosc/2 */
+  uint32_t isr_overhead_ns;                     /* Interrupt entry, prologue/epilogue and RETI */
+};
+
+/*Observer of the register writes, used by the device models, waveform recorders etc.*/
+class RegisterObserver
+{
+public:
+  virtual ~RegisterObserver() {}
+  virtual void onRegisterWrite(RegisterId reg, uint8_t old_value, uint8_t new_value, uint64_t time_ns) = 0;
+};
+
+/*Receiver of the firmware USB serial output*/
+typedef void (*SerialSink)(const uint8_t *data, size_t length);
+
+/*Receiver of the bytes sent by the hardware UART, end_ns - end of the stop bit on the wire*/
+typedef void (*UartSink)(uint8_t value, uint64_t end_ns);
+
+/*Port and bit of an Arduino pin*/
+struct PinMapping
+{
+  RegisterId port;                              /* REG_PORTx, DDRx = port - 1, PINx = port - 2 */
+  uint8_t bit;
+};
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*8 bit I/O register with write notification (supports the operators used on AVR registers)*/
+class Register
+{
+private:
+  RegisterId _id;
+  uint8_t _value;
+
+public:
+  constexpr explicit Register(RegisterId id) : _id(id), _value(0) {}
+
+  operator uint8_t() const;
+  Register &operator=(uint8_t value);
+  /* SBI on PINx toggles only the given bit */
+  Register &operator|=(uint8_t value) { return *this = isPin() ? value : (uint8_t)(*this | value); }
+  Register &operator&=(uint8_t value) { return *this = (uint8_t)(*this & value); }
+  Register &operator^=(uint8_t value) { return *this = (uint8_t)(*this ^ value); }
+
+  RegisterId id() const { return _id; }
+  bool isPin() const { return _id <= REG_PORTF && (_id % 3) == 0; }
+  uint8_t raw() const { return _value; }
+  void setRaw(uint8_t value) { _value = value; }
+  void drive(uint8_t value);                    /* Write by the hardware: observers notified, no CPU time */
+};
+
+/*16 bit timer register (TCNTn, OCRnA) as a low/high register pair, written high byte first as on the AVR*/
+class Register16
+{
+private:
+  RegisterId _low;
+
+public:
+  constexpr explicit Register16(RegisterId low) : _low(low) {}
+
+  operator uint16_t() const;
+  Register16 &operator=(uint16_t value);
+  Register16 &operator+=(uint16_t value) { return *this = (uint16_t)(*this + value); }
+};
+
+extern Register registers[REG_COUNT];
+extern Timing timing;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/* Reset of the whole emulated MCU state except EEPROM (power cycle) */
+void reset(void);
+
+/* Virtual clock */
+uint64_t now_ns(void);
+void advance_ns(uint64_t delta_ns);
+void set_time_ns(uint64_t time_ns);
+void idle_ns(uint64_t delta_ns);                /* Fast forward over idle main loop passes (watchdog kept alive) */
+
+/* Idle sleep: the clock runs to the next interrupt (Timer1 compare match, otherwise the 1 ms Timer0 tick) */
+void sleepCpu(void);
+uint64_t sleepTotalNs(void);
+
+/* GPIO */
+bool pinMapping(uint8_t pin, PinMapping *mapping);
+const char *registerName(RegisterId reg);
+void addObserver(RegisterObserver *observer);
+void removeObserver(RegisterObserver *observer);
+void setInputLevel(uint8_t pin, bool level);
+
+/* EEPROM */
+uint8_t *eepromData(void);
+uint32_t eepromWriteCount(uint16_t address);
+uint64_t eepromTotalWrites(void);
+uint64_t eepromBusyNs(void);
+void eepromErase(void);
+bool eepromLoad(const char *path);
+bool eepromSave(const char *path);
+/* Power-loss injection: the next writes_left writes complete, then the supply is gone and the following writes are
+   lost. tear_f leaves the interrupted cell erased (0xFF), the erase part of the cycle already happened. */
+void eepromPowerCut(uint32_t writes_left, bool tear_f);
+void eepromPowerRestore(void);
+bool eepromPowerLost(void);
+
+/* Watchdog */
+uint32_t watchdogExpirations(void);
+
+/* USB serial */
+void serialInject(const uint8_t *data, size_t length);
+void serialSetSink(SerialSink sink);            /* NULL discards the output, default sink is stdout */
+
+/* IR receiver */
+void irInject(uint32_t raw_data, uint64_t time_ns);
+size_t irPending(void);
+
+/* USB device: the PluggableUSB modules (PluggableUSB.h) seen from the host, the CDC port is Serial */
+size_t usbConfiguration(uint8_t *buffer, size_t size);
+int usbControlIn(uint8_t request_type, uint8_t request, uint16_t value, uint16_t index, uint8_t *buffer,
+                 uint16_t length);
+bool usbControlOut(uint8_t request_type, uint8_t request, uint16_t value, uint16_t index, const uint8_t *data,
+                   uint16_t length);
+bool usbOut(uint8_t endpoint, const uint8_t *data, size_t length);
+size_t usbIn(uint8_t endpoint, uint8_t *buffer, size_t size);
+
+/* Hardware UART (Serial1) seen from the line: an injected byte is received at the end of its stop bit, the
+   receive buffer holds 63 bytes like the core, the bytes beyond are lost */
+void uartInject(const uint8_t *data, size_t length, uint64_t start_ns);
+void uartSetSink(UartSink sink);                /* NULL discards the output */
+uint64_t uartByteNs(void);                      /* Start, 8 data and stop bit at the Serial1.begin() baud rate */
+uint64_t uartTxEndNs(void);                     /* End of the stop bit of the last sent byte */
+uint32_t uartOverruns(void);
+
+/* Shim back end (used by the Arduino/AVR headers of this library) */
+uint8_t eepromRead(uint16_t address);
+void eepromWrite(uint16_t address, uint8_t value);
+void watchdogEnable(uint8_t timeout);
+void watchdogReset(void);
+void watchdogDisable(void);
+int serialAvailable(void);
+int serialRead(void);
+int serialPeek(void);
+void serialWrite(const uint8_t *data, size_t length);
+bool irPop(uint64_t time_ns, uint32_t *raw_data);
+void usbReset(void);
+void uartBegin(uint32_t baudrate);              /* 0 - UART off */
+int uartAvailable(void);
+int uartRead(void);
+int uartPeek(void);
+int uartAvailableForWrite(void);
+void uartWrite(uint8_t value);
+void uartFlush(void);
+void uartReset(void);
+
+} /* namespace hal */
+
+#endif
@@ -0,0 +1,149 @@
+/**
+**********************************************************************************************************************
+*    @file           : native_main.cpp
+*    @brief          : native_main.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Default runner of the native build: calls setup() once and loop() until the requested simulated time is
+*    reached. IR frames and serial input can be scheduled from the command line. The runner is a weak symbol,
+*    a simulation program can provide its own main() and drive setup()/loop() directly.
+*
+*    Usage: program [--time SECONDS] [--ir MS:RAW]... [--serial-in TEXT] [--vcd FILE] [--quiet]
+*    EEPROM image: NATIVE_HAL_EEPROM=FILE environment variable, loaded before boot and saved at the end
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Arduino.h"
+#include "vcd_recorder.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define NATIVE_RUN_DEFAULT_TIME_S   (10.0)
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static double wallClockSeconds(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static int usage(const char *program)
+{
+  fprintf(stderr, "Usage: %s [--time SECONDS] [--ir MS:RAW]... [--serial-in TEXT] [--vcd FILE] [--quiet]\n"
+                  "  --time       simulated run time (default %.0f s)\n"
+                  "  --ir         IR frame (IRremote decodedRawData, hex) received at the given time\n"
+                  "  --serial-in  bytes available on the USB serial port after boot\n"
+                  "  --vcd        record the GPIO activity to the Value Change Dump file (GTKWave)\n"
+                  "  --quiet      discard the USB serial output\n"
+                  "EEPROM image: " NATIVE_HAL_EEPROM_ENV "=FILE, loaded before boot (if exists) and saved at the end\n",
+          program, NATIVE_RUN_DEFAULT_TIME_S);
+  return 2;
+}
+
+/**
+ * @brief Default native runner
+ * @param argument: int argc, char **argv
+ * @retval int - 0 on success, 1 when the watchdog expired, 2 on invalid arguments
+ */
+__attribute__((weak)) int main(int argc, char **argv)
+{
+  double run_time_s = NATIVE_RUN_DEFAULT_TIME_S;
+  const char *eeprom_path = getenv(NATIVE_HAL_EEPROM_ENV);
+  VcdRecorder vcd;
+
+  for (int i = 1; i < argc; i++) {
+    const char *option = argv[i];
+    const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+    if (strcmp(option, "--quiet") == 0) {
+      hal::serialSetSink(NULL);
+      continue;
+    }
+
+    if (value == NULL) {
+      return usage(argv[0]);
+    }
+
+    if (strcmp(option, "--time") == 0) {
+      run_time_s = atof(value);
+    } else if (strcmp(option, "--ir") == 0) {
+      char *separator;
+      unsigned long time_ms = strtoul(value, &separator, 10);
+
+      if (*separator != ':') {
+        return usage(argv[0]);
+      }
+
+      hal::irInject((uint32_t)strtoul(separator + 1, NULL, 16), (uint64_t)time_ms * 1000000ULL);
+    } else if (strcmp(option, "--vcd") == 0) {
+      if (!vcd.open(value)) {
+        fprintf(stderr, "[native hal] %s can not be created\n", value);
+        return 2;
+      }
+    } else if (strcmp(option, "--serial-in") == 0) {
+      hal::serialInject((const uint8_t *)value, strlen(value));
+    } else {
+      return usage(argv[0]);
+    }
+
+    ++i;
+  }
+
+  uint64_t end_ns = (uint64_t)(run_time_s * 1e9);
+  uint64_t loop_passes = 0;
+  double wall_start_s = wallClockSeconds();
+
+  setup();
+
+  while (hal::now_ns() < end_ns) {
+    loop();
+    hal::advance_ns(hal::timing.loop_overhead_ns);
+    ++loop_passes;
+  }
+
+  double wall_time_s = wallClockSeconds() - wall_start_s;
+  double simulated_s = (double)hal::now_ns() / 1e9;
+
+  fflush(stdout);
+  fprintf(stderr, "\n[native hal] simulated %.3f s in %.3f s wall time (x%.0f), %llu loop passes\n",
+          simulated_s, wall_time_s, (wall_time_s > 0) ? simulated_s / wall_time_s : 0.0,
+          (unsigned long long)loop_passes);
+  fprintf(stderr, "[native hal] EEPROM writes: %llu bytes (%.1f ms busy), watchdog expirations: %u\n",
+          (unsigned long long)hal::eepromTotalWrites(), (double)hal::eepromBusyNs() / 1e6,
+          (unsigned)hal::watchdogExpirations());
+
+  if (vcd.changes() != 0) {
+    fprintf(stderr, "[native hal] VCD: %llu value changes\n", (unsigned long long)vcd.changes());
+  }
+
+  vcd.close();
+
+  if (eeprom_path != NULL && !hal::eepromSave(eeprom_path)) {
+    fprintf(stderr, "[native hal] %s not saved\n", eeprom_path);
+  }
+
+  return (hal::watchdogExpirations() == 0) ? 0 : 1;
+}
@@ -0,0 +1,210 @@
+/**
+**********************************************************************************************************************
+*    @file           : native_uart.cpp
+*    @brief          : native_uart.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Implements the hardware UART (Serial1) of the native build and its line side (hal::uart*()). The bytes are
+*    timed by the virtual clock: an injected byte enters the receive buffer at the end of its stop bit (when the
+*    firmware looks at the UART next, like the RX interrupt of the core would have stored it), a sent byte waits
+*    for the bytes before it in the transmit buffer and is passed to the sink with the end time of its stop bit.
+*    A write to the full transmit buffer and flush() busy-wait like the core.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "native_hal.h"
+
+#include <algorithm>
+#include <deque>
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define UART_BUFFER_SIZE            (64)              /* SERIAL_RX/TX_BUFFER_SIZE of the core, one slot kept free */
+#define UART_FRAME_BITS             (10)              /* Start, 8 data and stop bit (SERIAL_8N1) */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+struct UartByte
+{
+  uint64_t time_ns;                             /* End of the stop bit */
+  uint8_t value;
+
+  bool operator<(const UartByte &other) const { return time_ns < other.time_ns; }
+};
+
+static uint32_t uart_baudrate = 0;
+static std::deque<UartByte> uart_line;          /* Injected bytes not received yet */
+static std::deque<uint8_t> uart_rx;
+static std::deque<uint64_t> uart_tx;            /* Stop bit end of the bytes in the transmit buffer */
+static uint64_t uart_tx_end_ns = 0;
+static uint32_t uart_overruns = 0;
+static hal::UartSink uart_sink = NULL;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+namespace hal {
+
+/**
+ * @brief Function moves the bytes received until now into the receive buffer, the bytes beyond its size are lost
+ * @param argument: None
+ * @retval None
+ */
+static void uartReceive(void)
+{
+  while (!uart_line.empty() && uart_line.front().time_ns <= now_ns()) {
+    if (uart_rx.size() < UART_BUFFER_SIZE - 1) {
+      uart_rx.push_back(uart_line.front().value);
+    } else {
+      ++uart_overruns;
+    }
+
+    uart_line.pop_front();
+  }
+}
+
+/**
+ * @brief Function drops the bytes already shifted out from the transmit buffer
+ * @param argument: None
+ * @retval None
+ */
+static void uartTransmit(void)
+{
+  while (!uart_tx.empty() && uart_tx.front() <= now_ns()) {
+    uart_tx.pop_front();
+  }
+}
+
+void uartInject(const uint8_t *data, size_t length, uint64_t start_ns)
+{
+  const uint64_t byte_ns = uartByteNs();
+
+  for (size_t i = 0; i < length && byte_ns != 0; i++) {
+    UartByte received = {start_ns + (i + 1) * byte_ns, data[i]};
+
+    uart_line.insert(std::upper_bound(uart_line.begin(), uart_line.end(), received), received);
+  }
+}
+
+void uartSetSink(UartSink sink)
+{
+  uart_sink = sink;
+}
+
+uint64_t uartByteNs(void)
+{
+  return (uart_baudrate == 0) ? 0 : (UART_FRAME_BITS * 1000000000ULL + uart_baudrate / 2) / uart_baudrate;
+}
+
+uint64_t uartTxEndNs(void)
+{
+  return uart_tx_end_ns;
+}
+
+uint32_t uartOverruns(void)
+{
+  return uart_overruns;
+}
+
+void uartBegin(uint32_t baudrate)
+{
+  uart_baudrate = baudrate;
+  uart_rx.clear();
+  uart_line.clear();
+}
+
+int uartAvailable(void)
+{
+  uartReceive();
+  return (int)uart_rx.size();
+}
+
+int uartRead(void)
+{
+  uartReceive();
+
+  if (uart_rx.empty()) {
+    return -1;
+  }
+
+  int value = uart_rx.front();
+  uart_rx.pop_front();
+  advance_ns(timing.register_write_ns);
+
+  return value;
+}
+
+int uartPeek(void)
+{
+  uartReceive();
+  return uart_rx.empty() ? -1 : uart_rx.front();
+}
+
+int uartAvailableForWrite(void)
+{
+  uartTransmit();
+  return (int)(UART_BUFFER_SIZE - 1 - std::min(uart_tx.size(), (size_t)(UART_BUFFER_SIZE - 1)));
+}
+
+/**
+ * @brief Function sends a byte, waits for a free slot when the transmit buffer is full
+ * @param argument: uint8_t value
+ * @retval None
+ */
+void uartWrite(uint8_t value)
+{
+  if (uart_baudrate == 0) {
+    return;
+  }
+
+  uartTransmit();
+
+  if (uart_tx.size() >= UART_BUFFER_SIZE) {
+    advance_ns(uart_tx.front() - now_ns());
+    uartTransmit();
+  }
+
+  uart_tx_end_ns = std::max(uart_tx_end_ns, now_ns()) + uartByteNs();
+  uart_tx.push_back(uart_tx_end_ns);
+  advance_ns(timing.register_write_ns);
+
+  if (uart_sink != NULL) {
+    uart_sink(value, uart_tx_end_ns);
+  }
+}
+
+void uartFlush(void)
+{
+  if (uart_tx_end_ns > now_ns()) {
+    advance_ns(uart_tx_end_ns - now_ns());
+  }
+
+  uartTransmit();
+}
+
+void uartReset(void)
+{
+  uart_baudrate = 0;
+  uart_line.clear();
+  uart_rx.clear();
+  uart_tx.clear();
+  uart_overruns = 0;
+}
+
+} /* namespace hal */
@@ -0,0 +1,352 @@
+/**
+**********************************************************************************************************************
+*    @file           : native_usb.cpp
+*    @brief          : native_usb.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Implements the PluggableUSB API of the native build and its host side (hal::usb*()). A control request of the
+*    host is handled like by the USB interrupt of the core: the standard GET_DESCRIPTOR of an interface goes to
+*    getDescriptor() of the modules, the class requests to setup(). Data sent by the modules with
+*    USB_SendControl() is collected up to wLength. An OUT endpoint holds two packets (the double bank of the
+*    ATmega32U4), the firmware reads them with USB_Available()/USB_Recv(); IN packets wait for hal::usbIn().
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "PluggableUSB.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define USB_ENDPOINT_BANKS          (2)
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+typedef std::vector<uint8_t> UsbPacket;
+
+static std::deque<UsbPacket> endpoint_out[USB_ENDPOINTS];
+static std::deque<UsbPacket> endpoint_in[USB_ENDPOINTS];
+
+static uint8_t *control_in;                     /* Data stage of the running device to host request */
+static size_t control_in_length;
+static size_t control_in_size;
+static const uint8_t *control_out;              /* Data stage of the running host to device request */
+static size_t control_out_length;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+PluggableUSB_::PluggableUSB_() : lastIf(CDC_INTERFACE_COUNT), lastEp(CDC_FIRST_ENDPOINT + CDC_ENPOINT_COUNT),
+                                 rootNode(NULL)
+{
+}
+
+bool PluggableUSB_::plug(PluggableUSBModule *node)
+{
+  if ((lastEp + node->numEndpoints) > USB_ENDPOINTS) {
+    return false;
+  }
+
+  if (rootNode == NULL) {
+    rootNode = node;
+  } else {
+    PluggableUSBModule *current = rootNode;
+
+    while (current->next != NULL) {
+      current = current->next;
+    }
+
+    current->next = node;
+  }
+
+  node->pluggedInterface = lastIf;
+  node->pluggedEndpoint = lastEp;
+  lastIf = (uint8_t)(lastIf + node->numInterfaces);
+  lastEp = (uint8_t)(lastEp + node->numEndpoints);
+
+  return true;
+}
+
+int PluggableUSB_::getInterface(uint8_t *interfaceCount)
+{
+  int sent = 0;
+
+  for (PluggableUSBModule *node = rootNode; node != NULL; node = node->next) {
+    int result = node->getInterface(interfaceCount);
+
+    if (result < 0) {
+      return -1;
+    }
+
+    sent += result;
+  }
+
+  return sent;
+}
+
+int PluggableUSB_::getDescriptor(USBSetup &setup)
+{
+  for (PluggableUSBModule *node = rootNode; node != NULL; node = node->next) {
+    int result = node->getDescriptor(setup);
+
+    if (result != 0) {
+      return result;                            /* Request handled (> 0) or stalled (< 0) */
+    }
+  }
+
+  return 0;
+}
+
+bool PluggableUSB_::setup(USBSetup &setup)
+{
+  for (PluggableUSBModule *node = rootNode; node != NULL; node = node->next) {
+    if (node->setup(setup)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+PluggableUSB_ &PluggableUSB(void)
+{
+  static PluggableUSB_ instance;
+
+  return instance;
+}
+
+int USB_SendControl(uint8_t flags, const void *d, int len)
+{
+  (void)flags;                                  /* TRANSFER_PGM: flash is host memory in the native build */
+
+  if (control_in == NULL || len < 0) {
+    return -1;
+  }
+
+  /* Like the core, the data beyond wLength is dropped but reported as sent */
+  size_t copied = std::min((size_t)len, control_in_size - control_in_length);
+
+  memcpy(control_in + control_in_length, d, copied);
+  control_in_length += copied;
+
+  return len;
+}
+
+int USB_RecvControl(void *d, int len)
+{
+  if (control_out == NULL || len < 0) {
+    return -1;
+  }
+
+  size_t copied = std::min((size_t)len, control_out_length);
+
+  memcpy(d, control_out, copied);
+  hal::advance_ns((uint64_t)hal::timing.register_write_ns * copied);
+
+  return (int)copied;
+}
+
+uint8_t USB_Available(uint8_t ep)
+{
+  ep &= 0x07;
+  return endpoint_out[ep].empty() ? 0 : (uint8_t)endpoint_out[ep].front().size();
+}
+
+uint8_t USB_SendSpace(uint8_t ep)
+{
+  ep &= 0x07;
+  return (endpoint_in[ep].size() < USB_ENDPOINT_BANKS) ? USB_EP_SIZE : 0;
+}
+
+int USB_Send(uint8_t ep, const void *data, int len)
+{
+  ep &= 0x07;
+
+  if (len < 0 || len > USB_EP_SIZE || endpoint_in[ep].size() >= USB_ENDPOINT_BANKS) {
+    return -1;                                  /* The core blocks up to 250 ms here, the host model never polls */
+  }
+
+  const uint8_t *bytes = (const uint8_t *)data;
+
+  endpoint_in[ep].push_back(UsbPacket(bytes, bytes + len));
+  hal::advance_ns((uint64_t)hal::timing.register_write_ns * (uint64_t)len);
+
+  return len;
+}
+
+int USB_Recv(uint8_t ep, void *data, int len)
+{
+  ep &= 0x07;
+
+  if (endpoint_out[ep].empty() || len <= 0) {
+    return 0;
+  }
+
+  UsbPacket &packet = endpoint_out[ep].front();
+  size_t copied = std::min((size_t)len, packet.size());
+
+  memcpy(data, packet.data(), copied);
+  packet.erase(packet.begin(), packet.begin() + (long)copied);
+  hal::advance_ns((uint64_t)hal::timing.register_write_ns * copied);
+
+  if (packet.empty()) {
+    endpoint_out[ep].pop_front();               /* Bank released to the host */
+  }
+
+  return (int)copied;
+}
+
+int USB_Recv(uint8_t ep)
+{
+  uint8_t value;
+
+  return (USB_Recv(ep, &value, 1) == 1) ? value : -1;
+}
+
+namespace hal {
+
+/**
+ * @brief Function collects the interface descriptors of the plugged modules (configuration descriptor part behind
+ *        the CDC interfaces)
+ * @param argument: uint8_t *buffer, size_t size
+ * @retval size_t - descriptor bytes
+ */
+size_t usbConfiguration(uint8_t *buffer, size_t size)
+{
+  uint8_t interface_count = CDC_INTERFACE_COUNT;
+
+  control_in = buffer;
+  control_in_size = size;
+  control_in_length = 0;
+  PluggableUSB().getInterface(&interface_count);
+  control_in = NULL;
+
+  return control_in_length;
+}
+
+static USBSetup usbSetup(uint8_t request_type, uint8_t request, uint16_t value, uint16_t index, uint16_t length)
+{
+  USBSetup setup = {request_type, request, (uint8_t)value, (uint8_t)(value >> 8), index, length};
+
+  return setup;
+}
+
+/**
+ * @brief Function runs a device to host control request, handled in the USB interrupt on the device
+ * @param argument: uint8_t request_type, uint8_t request, uint16_t value, uint16_t index, uint8_t *buffer,
+ *                  uint16_t length - wLength and buffer size
+ * @retval int - data stage length, -1 when the request is stalled
+ */
+int usbControlIn(uint8_t request_type, uint8_t request, uint16_t value, uint16_t index, uint8_t *buffer,
+                 uint16_t length)
+{
+  USBSetup setup = usbSetup(request_type, request, value, index, length);
+  bool handled_f;
+
+  advance_ns(timing.isr_overhead_ns);
+  control_in = buffer;
+  control_in_size = length;
+  control_in_length = 0;
+
+  if (request_type == REQUEST_DEVICETOHOST_STANDARD_INTERFACE && request == GET_DESCRIPTOR) {
+    handled_f = PluggableUSB().getDescriptor(setup) > 0;
+  } else {
+    handled_f = PluggableUSB().setup(setup);
+  }
+
+  control_in = NULL;
+
+  return handled_f ? (int)control_in_length : -1;
+}
+
+/**
+ * @brief Function runs a host to device control request with its data stage (e.g. HID SET_REPORT)
+ * @param argument: uint8_t request_type, uint8_t request, uint16_t value, uint16_t index, const uint8_t *data,
+ *                  uint16_t length
+ * @retval bool - false when the request is stalled
+ */
+bool usbControlOut(uint8_t request_type, uint8_t request, uint16_t value, uint16_t index, const uint8_t *data,
+                   uint16_t length)
+{
+  USBSetup setup = usbSetup(request_type, request, value, index, length);
+
+  advance_ns(timing.isr_overhead_ns);
+  control_out = data;
+  control_out_length = length;
+
+  bool handled_f = PluggableUSB().setup(setup);
+
+  control_out = NULL;
+
+  return handled_f;
+}
+
+/**
+ * @brief Function sends an OUT packet to the endpoint
+ * @param argument: uint8_t endpoint, const uint8_t *data, size_t length - up to USB_EP_SIZE
+ * @retval bool - false (NAK) while both banks are full
+ */
+bool usbOut(uint8_t endpoint, const uint8_t *data, size_t length)
+{
+  endpoint &= 0x07;
+
+  if (endpoint_out[endpoint].size() >= USB_ENDPOINT_BANKS || length > USB_EP_SIZE) {
+    return false;
+  }
+
+  endpoint_out[endpoint].push_back(UsbPacket(data, data + length));
+
+  return true;
+}
+
+/**
+ * @brief Function polls the IN endpoint
+ * @param argument: uint8_t endpoint, uint8_t *buffer, size_t size
+ * @retval size_t - packet length, 0 when the device has nothing to send
+ */
+size_t usbIn(uint8_t endpoint, uint8_t *buffer, size_t size)
+{
+  endpoint &= 0x07;
+
+  if (endpoint_in[endpoint].empty()) {
+    return 0;
+  }
+
+  UsbPacket packet = endpoint_in[endpoint].front();
+  size_t copied = std::min(size, packet.size());
+
+  endpoint_in[endpoint].pop_front();
+  memcpy(buffer, packet.data(), copied);
+
+  return copied;
+}
+
+void usbReset(void)
+{
+  for (uint8_t endpoint = 0; endpoint < USB_ENDPOINTS; endpoint++) {
+    endpoint_out[endpoint].clear();
+    endpoint_in[endpoint].clear();
+  }
+}
+
+} /* namespace hal */
@@ -0,0 +1,40 @@
+/**
+**********************************************************************************************************************
+*    @file           : atomic.h
+*    @brief          : atomic.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Atomic block API of avr-libc for the native build. The simulation is single threaded, the block body is
+*    executed once without any interrupt masking
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef NATIVE_UTIL_ATOMIC_H_
+#define NATIVE_UTIL_ATOMIC_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdint.h>
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define ATOMIC_RESTORESTATE
+#define ATOMIC_FORCEON
+#define NONATOMIC_RESTORESTATE
+#define NONATOMIC_FORCEOFF
+
+#define ATOMIC_BLOCK(type) for (uint8_t atomic_block_once = 1; atomic_block_once != 0; atomic_block_once = 0)
+#define NONATOMIC_BLOCK(type) ATOMIC_BLOCK(type)
+
+#endif
@@ -0,0 +1,52 @@
+/**
+**********************************************************************************************************************
+*    @file           : crc16.h
+*    @brief          : crc16.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    CRC helpers of avr-libc for the native build (C versions of the inline assembly)
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef NATIVE_UTIL_CRC16_H_
+#define NATIVE_UTIL_CRC16_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdint.h>
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/* Polynomial 0xA001 (x^16 + x^15 + x^2 + 1), used by the EEPROM store and the telemetry records */
+static inline uint16_t _crc16_update(uint16_t crc, uint8_t data)
+{
+  crc ^= data;
+
+  for (uint8_t i = 0; i < 8; ++i) {
+    crc = (crc & 1) ? (uint16_t)((crc >> 1) ^ 0xA001) : (uint16_t)(crc >> 1);
+  }
+
+  return crc;
+}
+
+/* Polynomial 0x8408 (CRC-CCITT, reflected) */
+static inline uint16_t _crc_ccitt_update(uint16_t crc, uint8_t data)
+{
+  data ^= (uint8_t)crc;
+  data ^= (uint8_t)(data << 4);
+
+  return (uint16_t)(((uint16_t)data << 8 | (crc >> 8)) ^ (uint8_t)(data >> 4) ^ ((uint16_t)data << 3));
+}
+
+#endif
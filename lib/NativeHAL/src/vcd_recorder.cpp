@@ -0,0 +1,230 @@
+/**
+**********************************************************************************************************************
+*    @file           : vcd_recorder.cpp
+*    @brief          : vcd_recorder.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Value Change Dump recorder of the emulated GPIO
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "vcd_recorder.h"
+
+#include <string.h>
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/* Single character VCD identifiers: pins first, then the registers */
+#define VCD_PIN_ID(pin) ((char)('!' + (pin)))
+#define VCD_REGISTER_ID(reg) ((char)('!' + NATIVE_HAL_PIN_COUNT + (reg)))
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Constructor, default signal names are the Arduino pin and the port bit (D9_PB5)
+ * @param argument: None
+ * @retval None
+ */
+VcdRecorder::VcdRecorder() : _file(NULL), _last_time_ns(0), _time_written_f(false), _changes(0)
+{
+  memset(_port_pin_count, 0, sizeof(_port_pin_count));
+
+  for (uint8_t pin = 0; pin < NATIVE_HAL_PIN_COUNT; pin++) {
+    hal::PinMapping mapping;
+
+    hal::pinMapping(pin, &mapping);
+
+    uint8_t port = (uint8_t)(mapping.port / 3);
+    _port_pins[port][_port_pin_count[port]++] = pin;
+
+    snprintf(_pin_names[pin], VCD_RECORDER_NAME_SIZE, "D%u_P%c%u", pin,
+             hal::registerName(mapping.port)[4], mapping.bit);
+  }
+}
+
+VcdRecorder::~VcdRecorder()
+{
+  close();
+}
+
+/**
+ * @brief Function sets the signal name of the pin, has to be called before open()
+ * @param argument: uint8_t pin, const char *name
+ * @retval None
+ */
+void VcdRecorder::setPinName(uint8_t pin, const char *name)
+{
+  if (pin < NATIVE_HAL_PIN_COUNT) {
+    snprintf(_pin_names[pin], VCD_RECORDER_NAME_SIZE, "%s", name);
+  }
+}
+
+/**
+ * @brief Function creates the VCD file, writes the header with the current state and starts the recording
+ * @param argument: const char *path
+ * @retval bool - false when the file can not be created
+ */
+bool VcdRecorder::open(const char *path)
+{
+  close();
+
+  _file = fopen(path, "w");
+
+  if (_file == NULL) {
+    return false;
+  }
+
+  setvbuf(_file, NULL, _IOFBF, VCD_RECORDER_BUFFER_SIZE);
+
+  fprintf(_file, "$version VU-meter native HAL $end\n$timescale 1ns $end\n$scope module mcu $end\n");
+
+  for (uint8_t pin = 0; pin < NATIVE_HAL_PIN_COUNT; pin++) {
+    fprintf(_file, "$var wire 1 %c %s $end\n", VCD_PIN_ID(pin), _pin_names[pin]);
+  }
+
+  for (uint8_t reg = 0; reg < hal::REG_COUNT; reg++) {
+    if (!hal::registers[reg].isPin()) {
+      fprintf(_file, "$var reg 8 %c %s $end\n", VCD_REGISTER_ID(reg), hal::registerName((hal::RegisterId)reg));
+    }
+  }
+
+  fprintf(_file, "$upscope $end\n$enddefinitions $end\n#%llu\n$dumpvars\n", (unsigned long long)hal::now_ns());
+
+  for (uint8_t pin = 0; pin < NATIVE_HAL_PIN_COUNT; pin++) {
+    _pin_levels[pin] = pinLevel(pin);
+    writePin(pin, _pin_levels[pin]);
+  }
+
+  for (uint8_t reg = 0; reg < hal::REG_COUNT; reg++) {
+    _register_values[reg] = hal::registers[reg].raw();
+
+    if (!hal::registers[reg].isPin()) {
+      writeRegister((hal::RegisterId)reg, _register_values[reg]);
+    }
+  }
+
+  fputs("$end\n", _file);
+
+  _last_time_ns = hal::now_ns();
+  _time_written_f = true;
+  _changes = 0;
+
+  hal::addObserver(this);
+
+  return true;
+}
+
+void VcdRecorder::close(void)
+{
+  if (_file != NULL) {
+    hal::removeObserver(this);
+    fclose(_file);
+    _file = NULL;
+  }
+}
+
+bool VcdRecorder::pinLevel(uint8_t pin) const
+{
+  hal::PinMapping mapping;
+
+  hal::pinMapping(pin, &mapping);
+  return (hal::registers[mapping.port - 2] & (1 << mapping.bit)) != 0;
+}
+
+/**
+ * @brief Function writes the timestamp line, once per timestamp
+ * @param argument: uint64_t time_ns
+ * @retval None
+ */
+void VcdRecorder::writeTime(uint64_t time_ns)
+{
+  if (_time_written_f && time_ns == _last_time_ns) {
+    return;
+  }
+
+  char text[24];
+  char *digit = &text[sizeof(text) - 1];
+  uint64_t value = time_ns;
+
+  *digit = '\n';
+
+  do {
+    *--digit = (char)('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+
+  *--digit = '#';
+  fwrite(digit, 1, (size_t)(&text[sizeof(text)] - digit), _file);
+
+  _last_time_ns = time_ns;
+  _time_written_f = true;
+}
+
+void VcdRecorder::writePin(uint8_t pin, bool level)
+{
+  char text[3] = {level ? '1' : '0', VCD_PIN_ID(pin), '\n'};
+
+  fwrite(text, 1, sizeof(text), _file);
+}
+
+void VcdRecorder::writeRegister(hal::RegisterId reg, uint8_t value)
+{
+  char text[12];
+
+  text[0] = 'b';
+
+  for (uint8_t i = 0; i < 8; i++) {
+    text[1 + i] = (value & (0x80 >> i)) ? '1' : '0';
+  }
+
+  text[9] = ' ';
+  text[10] = VCD_REGISTER_ID(reg);
+  text[11] = '\n';
+  fwrite(text, 1, sizeof(text), _file);
+}
+
+/**
+ * @brief Register write handler, writes the register value and the levels of the changed pins of the port
+ * @param argument: hal::RegisterId reg, uint8_t old_value, uint8_t new_value, uint64_t time_ns
+ * @retval None
+ */
+void VcdRecorder::onRegisterWrite(hal::RegisterId reg, uint8_t old_value, uint8_t new_value, uint64_t time_ns)
+{
+  (void)old_value;
+
+  if (new_value != _register_values[reg]) {
+    writeTime(time_ns);
+    writeRegister(reg, new_value);
+    _register_values[reg] = new_value;
+    ++_changes;
+  }
+
+  uint8_t port = (uint8_t)(reg / 3);
+
+  for (uint8_t i = 0; i < _port_pin_count[port]; i++) {
+    uint8_t pin = _port_pins[port][i];
+    bool level = pinLevel(pin);
+
+    if (level != _pin_levels[pin]) {
+      writeTime(time_ns);
+      writePin(pin, level);
+      _pin_levels[pin] = level;
+      ++_changes;
+    }
+  }
+}
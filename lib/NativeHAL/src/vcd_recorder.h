@@ -0,0 +1,73 @@
+/**
+**********************************************************************************************************************
+*    @file           : vcd_recorder.h
+*    @brief          : vcd_recorder.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Value Change Dump (IEEE 1364) recorder of the emulated GPIO. Every pin level change and every PORTx/DDRx
+*    register change is written with the virtual clock timestamp (1 ns timescale), the file can be opened in
+*    GTKWave. The output is streamed through a large stdio buffer, so long runs do not grow the memory usage.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef VCD_RECORDER_H_
+#define VCD_RECORDER_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdio.h>
+
+#include "native_hal.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define VCD_RECORDER_BUFFER_SIZE    (1UL << 20)       /* stdio buffer of the output file */
+#define VCD_RECORDER_NAME_SIZE      (24)
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+class VcdRecorder : public hal::RegisterObserver
+{
+private:
+  FILE *_file;
+  uint64_t _last_time_ns;
+  bool _time_written_f;
+  uint64_t _changes;
+
+  uint8_t _port_pins[hal::REG_COUNT / 3][8];     /* Pins of every port, only the written port is checked */
+  uint8_t _port_pin_count[hal::REG_COUNT / 3];
+  bool _pin_levels[NATIVE_HAL_PIN_COUNT];
+  uint8_t _register_values[hal::REG_COUNT];
+  char _pin_names[NATIVE_HAL_PIN_COUNT][VCD_RECORDER_NAME_SIZE];
+
+  bool pinLevel(uint8_t pin) const;
+  void writeTime(uint64_t time_ns);
+  void writePin(uint8_t pin, bool level);
+  void writeRegister(hal::RegisterId reg, uint8_t value);
+
+public:
+  VcdRecorder();
+  virtual ~VcdRecorder();
+
+  void setPinName(uint8_t pin, const char *name);
+  bool open(const char *path);
+  void close(void);
+  uint64_t changes(void) const { return _changes; }
+
+  virtual void onRegisterWrite(hal::RegisterId reg, uint8_t old_value, uint8_t new_value, uint64_t time_ns);
+};
+
+#endif
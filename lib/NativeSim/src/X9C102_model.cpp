@@ -0,0 +1,291 @@
+/**
+**********************************************************************************************************************
+*    @file           : X9C102_model.cpp
+*    @brief          : X9C102_model.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Behavioral model of the X9C102 digital potentiometer for the native build
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "X9C102_model.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define X9C102_NEVER                (~(uint64_t)0)
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*Intersil X9C102/103/104/503 datasheet, AC conditions*/
+X9C102Timing X9C102Model::timing = {
+  100,                                          /* tCI */
+  100,                                          /* tID */
+  2900,                                         /* tDI */
+  1000,                                         /* tIL */
+  1000,                                         /* tIH */
+  1000,                                         /* tIC */
+  100,                                          /* tCPH, no store */
+  20000000,                                     /* tCPH, store: 20 ms */
+};
+
+static const char *const violation_names[X9C102_VIOLATION_COUNT] = {
+  "tCI", "tID", "tDI", "tIL", "tIH", "tIC", "tCPH",
+};
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Constructor of the model, the model is attached to the emulated GPIO registers
+ * @param argument: const char *name - used in the reports, const X9C102Pins &pins,
+ *                  uint8_t stored_wiper - content of the non-volatile wiper memory
+ * @retval None
+ */
+X9C102Model::X9C102Model(const char *name, const X9C102Pins &pins, uint8_t stored_wiper)
+  : _name(name), _report_f(true), _stored_wiper(stored_wiper), _store_count(0)
+{
+  hal::pinMapping(pins.cs, &_cs);
+  hal::pinMapping(pins.inc, &_inc);
+  hal::pinMapping(pins.ud, &_ud);
+
+  powerOn();
+  hal::addObserver(this);
+}
+
+X9C102Model::~X9C102Model()
+{
+  hal::removeObserver(this);
+}
+
+/**
+ * @brief Function moves the wiper by the given steps (saturated at the end stops) as noise on INC would, without
+ *        any edge on the control lines
+ * @param argument: int8_t steps - positive towards the last tap
+ * @retval None
+ */
+void X9C102Model::injectNoise(int8_t steps)
+{
+  int16_t wiper = (int16_t)(_wiper + steps);
+
+  _wiper = (uint8_t)((wiper < 0) ? 0 : (wiper > X9C102_TAPS - 1) ? X9C102_TAPS - 1 : wiper);
+}
+
+/**
+ * @brief Function emulates the power-up: the wiper is recalled from the non-volatile memory
+ * @param argument: None
+ * @retval None
+ */
+void X9C102Model::powerOn(void)
+{
+  _wiper = _stored_wiper;
+
+  _cs_level = lineLevel(_cs);
+  _inc_level = lineLevel(_inc);
+  _ud_level = lineLevel(_ud);
+
+  _cs_fall_ns = X9C102_NEVER;
+  _cs_rise_ns = X9C102_NEVER;
+  _inc_fall_ns = X9C102_NEVER;
+  _inc_rise_ns = X9C102_NEVER;
+  _ud_change_ns = X9C102_NEVER;
+  _store_end_ns = 0;
+  _last_step_ns = 0;
+  _window_first_step_ns = 0;
+
+  _steps = 0;
+  _saturated_steps = 0;
+  _window_steps = 0;
+  memset(_violations, 0, sizeof(_violations));
+}
+
+uint32_t X9C102Model::totalViolations(void) const
+{
+  uint32_t total = 0;
+
+  for (uint8_t i = 0; i < X9C102_VIOLATION_COUNT; i++) {
+    total += _violations[i];
+  }
+
+  return total;
+}
+
+const char *X9C102Model::violationName(X9C102Violation parameter)
+{
+  return (parameter < X9C102_VIOLATION_COUNT) ? violation_names[parameter] : "?";
+}
+
+/**
+ * @brief Function returns the line level seen by the chip (PINx: driven level of outputs, input level otherwise)
+ * @param argument: const hal::PinMapping &line
+ * @retval bool
+ */
+bool X9C102Model::lineLevel(const hal::PinMapping &line) const
+{
+  return (hal::registers[line.port - 2] & (1 << line.bit)) != 0;
+}
+
+/**
+ * @brief Function checks the minimum time between the reference edge and the current edge
+ * @param argument: X9C102Violation parameter, uint64_t since_ns - reference edge, uint32_t min_ns, uint64_t time_ns
+ * @retval None
+ */
+void X9C102Model::checkMin(X9C102Violation parameter, uint64_t since_ns, uint32_t min_ns, uint64_t time_ns)
+{
+  if (since_ns == X9C102_NEVER || time_ns - since_ns >= min_ns) {
+    return;
+  }
+
+  ++_violations[parameter];
+
+  if (_report_f) {
+    fprintf(stderr, "[X9C102 %s] %s violation at %.6f s: %.3f us < %.3f us\n", _name, violationName(parameter),
+            (double)time_ns / 1e9, (double)(time_ns - since_ns) / 1e3, (double)min_ns / 1e3);
+  }
+}
+
+void X9C102Model::onCsEdge(bool level, uint64_t time_ns)
+{
+  if (!level) {
+    checkMin(X9C102_VIOLATION_T_CPH, _cs_rise_ns, timing.t_cph_ns, time_ns);
+
+    if (time_ns < _store_end_ns) {                          /* Selected during the store cycle */
+      checkMin(X9C102_VIOLATION_T_CPH, _cs_rise_ns, timing.t_cph_store_ns, time_ns);
+    }
+
+    _cs_fall_ns = time_ns;
+    return;
+  }
+
+  uint64_t last_inc_edge_ns = _inc_fall_ns;
+
+  if (_inc_rise_ns != X9C102_NEVER && (last_inc_edge_ns == X9C102_NEVER || _inc_rise_ns > last_inc_edge_ns)) {
+    last_inc_edge_ns = _inc_rise_ns;
+  }
+
+  if (last_inc_edge_ns != X9C102_NEVER && last_inc_edge_ns >= _cs_fall_ns) {
+    checkMin(X9C102_VIOLATION_T_IC, last_inc_edge_ns, timing.t_ic_ns, time_ns);
+  }
+
+  if (_inc_level) {                                         /* Deselect with INC high stores the wiper position */
+    _stored_wiper = _wiper;
+    ++_store_count;
+    _store_end_ns = time_ns + timing.t_cph_store_ns;
+  }
+
+  _cs_rise_ns = time_ns;
+}
+
+void X9C102Model::onIncEdge(bool level, uint64_t time_ns)
+{
+  bool selected_f = !_cs_level;
+
+  if (level) {
+    if (selected_f && _inc_fall_ns != X9C102_NEVER && _inc_fall_ns >= _cs_fall_ns) {
+      checkMin(X9C102_VIOLATION_T_IL, _inc_fall_ns, timing.t_il_ns, time_ns);
+    }
+
+    _inc_rise_ns = time_ns;
+    return;
+  }
+
+  _inc_fall_ns = time_ns;
+
+  if (!selected_f) {
+    return;
+  }
+
+  checkMin(X9C102_VIOLATION_T_CI, _cs_fall_ns, timing.t_ci_ns, time_ns);
+  checkMin(X9C102_VIOLATION_T_DI, _ud_change_ns, timing.t_di_ns, time_ns);
+
+  if (_inc_rise_ns != X9C102_NEVER && _inc_rise_ns >= _cs_fall_ns) {
+    checkMin(X9C102_VIOLATION_T_IH, _inc_rise_ns, timing.t_ih_ns, time_ns);
+  }
+
+  if (_window_steps++ == 0) {
+    _window_first_step_ns = time_ns;
+  }
+
+  ++_steps;
+  _last_step_ns = time_ns;
+
+  if (_ud_level) {
+    if (_wiper < X9C102_TAPS - 1) {
+      ++_wiper;
+    } else {
+      ++_saturated_steps;
+    }
+  } else {
+    if (_wiper > 0) {
+      --_wiper;
+    } else {
+      ++_saturated_steps;
+    }
+  }
+}
+
+void X9C102Model::onUdEdge(bool level, uint64_t time_ns)
+{
+  (void)level;
+
+  if (!_cs_level && _inc_level) {
+    checkMin(X9C102_VIOLATION_T_ID, _inc_rise_ns, timing.t_id_ns, time_ns);
+  }
+
+  _ud_change_ns = time_ns;
+}
+
+/**
+ * @brief Register write handler. Simultaneous edges are processed as U/D, CS fall, INC, CS rise, so the setup
+ *        times of a single port write are reported as zero
+ * @param argument: hal::RegisterId reg, uint8_t old_value, uint8_t new_value, uint64_t time_ns
+ * @retval None
+ */
+void X9C102Model::onRegisterWrite(hal::RegisterId reg, uint8_t old_value, uint8_t new_value, uint64_t time_ns)
+{
+  (void)reg;
+  (void)old_value;
+  (void)new_value;
+
+  bool cs_level = lineLevel(_cs);
+  bool inc_level = lineLevel(_inc);
+  bool ud_level = lineLevel(_ud);
+
+  if (ud_level != _ud_level) {
+    _ud_level = ud_level;
+    onUdEdge(ud_level, time_ns);
+  }
+
+  if (cs_level != _cs_level && !cs_level) {
+    _cs_level = cs_level;
+    onCsEdge(cs_level, time_ns);
+  }
+
+  if (inc_level != _inc_level) {
+    _inc_level = inc_level;
+    onIncEdge(inc_level, time_ns);
+  }
+
+  if (cs_level != _cs_level) {
+    _cs_level = cs_level;
+    onCsEdge(cs_level, time_ns);
+  }
+}
@@ -0,0 +1,145 @@
+/**
+**********************************************************************************************************************
+*    @file           : X9C102_model.h
+*    @brief          : X9C102_model.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Behavioral model of the X9C102 digital potentiometer for the native build. The model observes the emulated
+*    GPIO registers (native_hal.h) and follows the CS/INC/U-D lines of one chip: wiper position (100 taps, end-stop
+*    saturation), non-volatile store (CS rising while INC is high) and power-up recall. Every edge is checked
+*    against the datasheet AC timing, violations are counted per parameter. injectNoise() moves the wiper like
+*    pulses lost or added by noise on INC, the firmware does not see it.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef X9C102_MODEL_H_
+#define X9C102_MODEL_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "native_hal.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define X9C102_TAPS                 (100)
+#define X9C102_STORE_ENDURANCE      (100000UL)      /* Non-volatile store cycles */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*Datasheet AC timing (minimum values, ns)*/
+struct X9C102Timing
+{
+  uint32_t t_ci_ns;                             /* CS to INC setup */
+  uint32_t t_id_ns;                             /* INC high to U/D change */
+  uint32_t t_di_ns;                             /* U/D to INC setup */
+  uint32_t t_il_ns;                             /* INC low period */
+  uint32_t t_ih_ns;                             /* INC high period */
+  uint32_t t_ic_ns;                             /* INC inactive to CS inactive */
+  uint32_t t_cph_ns;                            /* CS deselect time, no store */
+  uint32_t t_cph_store_ns;                      /* CS deselect time, store */
+};
+
+/*Checked timing parameters*/
+enum X9C102Violation
+{
+  X9C102_VIOLATION_T_CI,
+  X9C102_VIOLATION_T_ID,
+  X9C102_VIOLATION_T_DI,
+  X9C102_VIOLATION_T_IL,
+  X9C102_VIOLATION_T_IH,
+  X9C102_VIOLATION_T_IC,
+  X9C102_VIOLATION_T_CPH,
+  X9C102_VIOLATION_COUNT
+};
+
+/*Arduino pins of the chip control lines*/
+struct X9C102Pins
+{
+  uint8_t cs;
+  uint8_t inc;
+  uint8_t ud;
+};
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+class X9C102Model : public hal::RegisterObserver
+{
+private:
+  const char *_name;
+  hal::PinMapping _cs;
+  hal::PinMapping _inc;
+  hal::PinMapping _ud;
+
+  bool _cs_level;
+  bool _inc_level;
+  bool _ud_level;
+  bool _report_f;
+
+  uint8_t _wiper;
+  uint8_t _stored_wiper;
+
+  uint64_t _cs_fall_ns;
+  uint64_t _cs_rise_ns;
+  uint64_t _inc_fall_ns;
+  uint64_t _inc_rise_ns;
+  uint64_t _ud_change_ns;
+  uint64_t _store_end_ns;
+  uint64_t _last_step_ns;
+  uint64_t _window_first_step_ns;
+
+  uint32_t _steps;
+  uint32_t _saturated_steps;
+  uint32_t _window_steps;
+  uint32_t _store_count;
+  uint32_t _violations[X9C102_VIOLATION_COUNT];
+
+  bool lineLevel(const hal::PinMapping &line) const;
+  void checkMin(X9C102Violation parameter, uint64_t since_ns, uint32_t min_ns, uint64_t time_ns);
+  void onCsEdge(bool level, uint64_t time_ns);
+  void onIncEdge(bool level, uint64_t time_ns);
+  void onUdEdge(bool level, uint64_t time_ns);
+
+public:
+  static X9C102Timing timing;
+
+  X9C102Model(const char *name, const X9C102Pins &pins, uint8_t stored_wiper = 0);
+  virtual ~X9C102Model();
+
+  virtual void onRegisterWrite(hal::RegisterId reg, uint8_t old_value, uint8_t new_value, uint64_t time_ns);
+
+  void powerOn(void);
+  void injectNoise(int8_t steps);
+  void setReport(bool report_f) { _report_f = report_f; }
+  void startWindow(void) { _window_steps = 0; }   /* Start of a measured pulse train */
+
+  uint8_t wiper(void) const { return _wiper; }
+  uint8_t storedWiper(void) const { return _stored_wiper; }
+  uint32_t steps(void) const { return _steps; }
+  uint32_t windowSteps(void) const { return _window_steps; }
+  uint64_t windowFirstStepNs(void) const { return _window_first_step_ns; }
+  uint64_t lastStepNs(void) const { return _last_step_ns; }
+  uint32_t saturatedSteps(void) const { return _saturated_steps; }
+  uint32_t storeCount(void) const { return _store_count; }
+  uint32_t violations(X9C102Violation parameter) const { return _violations[parameter]; }
+  uint32_t totalViolations(void) const;
+  const char *name(void) const { return _name; }
+
+  static const char *violationName(X9C102Violation parameter);
+};
+
+#endif
@@ -0,0 +1,252 @@
+/**
+**********************************************************************************************************************
+*    @file           : eeprom_power_loss.cpp
+*    @brief          : eeprom_power_loss.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Power-loss fault injection for EEPROMStore::Save(). The power is cut after every possible number of completed
+*    byte writes of a save (the interrupted cell left untouched or erased), then the store is constructed again
+*    like after the next boot. The loaded record has to be the old or the new one, never the defaults, and the
+*    next save after the recovery has to work. Also checks the sequence number wrap and reports the boot-time load
+*    cost.
+*
+*    Exit code 0 when every case recovers, 1 otherwise.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <Arduino.h>
+#include "EEPROMStore.h"
+#include "main.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define POWER_LOSS_WRAP_SAVES       (600)             /* More than two sequence number wraps */
+#define POWER_LOSS_RECORD_ADDRESS   (64)              /* Second store, next to the channels configuration */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*Larger record, so a save crosses more byte boundaries than the two channel values*/
+struct CalibrationRecord
+{
+  uint8_t left_offset;
+  uint8_t right_offset;
+  uint16_t flags;
+  uint32_t counters[3];
+
+  void Reset(void)
+  {
+    memset(this, 0, sizeof(*this));
+  }
+};
+
+static uint8_t snapshot[NATIVE_HAL_EEPROM_SIZE];
+static uint32_t failures;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static void fill(ChannelsConfiguration &data, uint8_t seed)
+{
+  data.channel_step_value[LEFT_CHANNEL_INDEX] = (uint8_t)(10 + seed);
+  data.channel_step_value[RIGHT_CHANNEL_INDEX] = (uint8_t)(90 - seed);
+}
+
+static void fill(CalibrationRecord &data, uint8_t seed)
+{
+  data.left_offset = seed;
+  data.right_offset = (uint8_t)~seed;
+  data.flags = (uint16_t)(0x1200 + seed);
+
+  for (uint8_t i = 0; i < 3; i++) {
+    data.counters[i] = 0x01020304UL * (uint32_t)(seed + i + 1);
+  }
+}
+
+static void takeSnapshot(void)
+{
+  memcpy(snapshot, hal::eepromData(), sizeof(snapshot));
+}
+
+static void restoreSnapshot(void)
+{
+  memcpy(hal::eepromData(), snapshot, sizeof(snapshot));
+}
+
+static void fail(const char *name, const char *reason, uint32_t writes, bool tear_f)
+{
+  printf("FAIL %s: %s (power cut after %lu writes%s)\n", name, reason, (unsigned long)writes,
+         tear_f ? ", torn cell" : "");
+  ++failures;
+}
+
+/**
+ * @brief Function commits the old record (on top of an older one, so both banks are valid) and cuts the power at
+ *        every byte boundary of the save of the new record
+ * @param argument: const char *name
+ * @retval None
+ */
+template <class TData, uint16_t TAddress>
+static void checkTornSaves(const char *name)
+{
+  TData older, old_data, new_data;
+  fill(older, 1);
+  fill(old_data, 2);
+  fill(new_data, 3);
+
+  hal::eepromErase();
+
+  {
+    EEPROMStore<TData, TAddress> store;
+    store.Begin();
+    store.Data = older;
+    store.Save();
+    store.Data = old_data;
+    store.Save();
+  }
+
+  takeSnapshot();
+
+  /* Reference save without the power cut */
+  uint64_t writes = hal::eepromTotalWrites();
+  {
+    EEPROMStore<TData, TAddress> store;
+    store.Begin();
+
+    if (memcmp(&store.Data, &old_data, sizeof(TData)) != 0) {
+      fail(name, "old record not loaded", 0, false);
+      return;
+    }
+
+    store.Data = new_data;
+    store.Save();
+  }
+  uint32_t save_writes = (uint32_t)(hal::eepromTotalWrites() - writes);
+  uint32_t cases = 0;
+
+  for (uint32_t cut = 0; cut <= save_writes; cut++) {
+    for (uint8_t tear = 0; tear < 2; tear++) {
+      bool tear_f = (tear != 0);
+
+      restoreSnapshot();
+      {
+        EEPROMStore<TData, TAddress> store;
+        store.Begin();
+        store.Data = new_data;
+        hal::eepromPowerCut(cut, tear_f);
+        store.Save();
+        hal::eepromPowerRestore();
+      }
+
+      /* Next boot */
+      EEPROMStore<TData, TAddress> store;
+      store.Begin();
+      bool old_f = memcmp(&store.Data, &old_data, sizeof(TData)) == 0;
+      bool new_f = memcmp(&store.Data, &new_data, sizeof(TData)) == 0;
+
+      if (!old_f && !new_f) {
+        fail(name, "neither old nor new record loaded", cut, tear_f);
+      } else if (cut == save_writes && !new_f) {
+        fail(name, "completed save not loaded", cut, tear_f);
+      }
+
+      /* The store keeps working after the recovery */
+      store.Data = older;
+      store.Save();
+      EEPROMStore<TData, TAddress> reloaded;
+      reloaded.Begin();
+
+      if (memcmp(&reloaded.Data, &older, sizeof(TData)) != 0) {
+        fail(name, "save after recovery not loaded", cut, tear_f);
+      }
+
+      ++cases;
+    }
+  }
+
+  printf("%-28s %2lu byte writes per save, %3lu power cuts recovered\n", name, (unsigned long)save_writes,
+         (unsigned long)cases);
+}
+
+/**
+ * @brief Function saves more records than the sequence number range and checks that the last one is loaded
+ * @param argument: const char *name
+ * @retval None
+ */
+template <class TData, uint16_t TAddress>
+static void checkSequenceWrap(const char *name)
+{
+  TData data;
+
+  hal::eepromErase();
+
+  for (uint16_t i = 0; i < POWER_LOSS_WRAP_SAVES; i++) {
+    EEPROMStore<TData, TAddress> store;
+    store.Begin();
+    fill(data, (uint8_t)i);
+    store.Data = data;
+    store.Save();
+
+    EEPROMStore<TData, TAddress> reloaded;
+    reloaded.Begin();
+
+    if (memcmp(&reloaded.Data, &data, sizeof(TData)) != 0) {
+      fail(name, "sequence number wrap", i, false);
+      return;
+    }
+  }
+
+  printf("%-28s %u saves, newest bank always loaded\n", name, (unsigned)POWER_LOSS_WRAP_SAVES);
+}
+
+/**
+ * @brief Function reports the boot-time cost of EEPROMStore::Begin() (both banks are read and checked)
+ * @param argument: const char *name
+ * @retval None
+ */
+template <class TData, uint16_t TAddress>
+static void reportLoadCost(const char *name)
+{
+  EEPROMStore<TData, TAddress> store;
+  uint64_t start_ns = hal::now_ns();
+  store.Begin();
+  uint64_t load_ns = hal::now_ns() - start_ns;
+
+  printf("%-28s load %4lu bytes in %6.2f us, eeprom area %u bytes\n", name,
+         (unsigned long)(load_ns / hal::timing.eeprom_read_byte_ns), (double)load_ns / 1000.0,
+         (unsigned)EEPROMStore<TData, TAddress>::StorageSize);
+}
+
+int main(void)
+{
+  hal::serialSetSink(NULL);
+
+  checkTornSaves<ChannelsConfiguration, 0>("channels configuration");
+  checkTornSaves<CalibrationRecord, POWER_LOSS_RECORD_ADDRESS>("calibration record");
+  checkSequenceWrap<ChannelsConfiguration, 0>("channels sequence wrap");
+  checkSequenceWrap<CalibrationRecord, POWER_LOSS_RECORD_ADDRESS>("calibration sequence wrap");
+  reportLoadCost<ChannelsConfiguration, 0>("channels boot load");
+  reportLoadCost<CalibrationRecord, POWER_LOSS_RECORD_ADDRESS>("calibration boot load");
+
+  printf("%s\n", (failures == 0) ? "PASS" : "FAIL");
+
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,438 @@
+/**
+**********************************************************************************************************************
+*    @file           : eeprom_soak.cpp
+*    @brief          : eeprom_soak.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Discrete-event soak simulation of the EEPROM wear. The unchanged firmware (irDataReceive(), EEPROMStore) is
+*    driven by a synthetic user model: adjustment sessions (channel select, burst of up/down presses, optional
+*    commit) and power cycles. Idle periods are skipped on the virtual clock (at most one DELAY_EEPROM_CHECK
+*    period per step, so every check of the EEPROM task is executed), so years are simulated in seconds.
+*
+*    Every power cycle is a real restart: the EEPROM image and the simulation state are written to files and the
+*    program is executed again (/proc/self/exe), so the global constructors and static variables of the firmware
+*    start from scratch like on the device.
+*
+*    Reports per-cell EEPROM write counts, projected wear-out dates (ATmega32U4 endurance 100000 cycles), the time
+*    the main loop was blocked by EEPROM writes, X9C102 non-volatile stores and the power cycles which lost
+*    uncommitted adjustments.
+*
+*    Usage: program [--years N] [--seed N] [--sessions-per-day N] [--presses N] [--commit-probability P]
+*                   [--power-cycles-per-day N] [--off-hours N] [--work FILE]
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <Arduino.h>
+#include "EEPROMStore.h"
+#include "X9C102_model.h"
+#include "protocol.h"
+#include "main.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define SOAK_STATE_MAGIC            (0x4B414F53UL)    /* "SOAK" */
+#define SOAK_EEPROM_ENDURANCE       (100000UL)        /* ATmega32U4 EEPROM write/erase cycles */
+#define SOAK_DEFAULT_WORK_FILE      "eeprom_soak.state"
+
+#define NS_PER_MS                   (1000000ULL)
+#define NS_PER_HOUR                 (3600ULL * 1000 * NS_PER_MS)
+#define NS_PER_DAY                  (24ULL * NS_PER_HOUR)
+#define DAYS_PER_YEAR               (365.25)
+
+#define SOAK_EVENT_STEP_NS          ((DELAY_PERIOD + 1) * NS_PER_MS)                       /* IR frame pending */
+#define SOAK_IDLE_STEP_NS           ((DELAY_EEPROM_CHECK + DELAY_PERIOD + 1) * NS_PER_MS)  /* One EEPROM check */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*User behavior model*/
+struct SoakProfile
+{
+  double years;
+  double sessions_per_day;                      /* Adjustment sessions (Poisson) */
+  double presses;                               /* Mean up/down presses per session (geometric) */
+  double commit_probability;                    /* Session ends with the commit button */
+  double power_cycles_per_day;                  /* Power-off events (Poisson), also in the middle of a session */
+  double off_hours;                             /* Mean power-off duration (exponential) */
+};
+
+/*Simulation state, kept in the work file across the power cycles*/
+struct SoakState
+{
+  uint32_t magic;
+  uint32_t size;
+  SoakProfile profile;
+  uint64_t rng;
+
+  uint64_t now_ns;
+  uint64_t end_ns;
+  uint64_t next_session_ns;
+  uint64_t power_off_ns;
+
+  uint64_t boots;
+  uint64_t sessions;
+  uint64_t presses;
+  uint64_t commits;
+  uint64_t lost_power_cycles;                   /* Power-off with uncommitted adjustments */
+  uint64_t eeprom_busy_ns;
+  uint64_t eeprom_max_block_ns;                 /* Longest single loop() pass blocked by EEPROM writes */
+  uint64_t eeprom_writes[NATIVE_HAL_EEPROM_SIZE];
+
+  uint8_t wiper_stored[2];                      /* X9C102 non-volatile memory: left, right */
+  uint64_t wiper_stores[2];
+  uint64_t wiper_violations;
+};
+
+static SoakState state;
+static char work_path[256] = SOAK_DEFAULT_WORK_FILE;
+static char eeprom_path[sizeof(work_path) + 8];
+
+extern EEPROMStore<ChannelsConfiguration, CONFIGURATION_EEPROM_ADDRESS> Configuration;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/* xorshift64*, the state is part of the work file so the run is reproducible across the restarts */
+static double randomUniform(void)
+{
+  state.rng ^= state.rng >> 12;
+  state.rng ^= state.rng << 25;
+  state.rng ^= state.rng >> 27;
+
+  return (double)((state.rng * 2685821657736338717ULL) >> 11) / 9007199254740992.0;
+}
+
+static uint64_t randomExponentialNs(double mean_ns)
+{
+  return (uint64_t)(-log(1.0 - randomUniform()) * mean_ns);
+}
+
+static uint64_t randomRangeNs(uint64_t min_ns, uint64_t max_ns)
+{
+  return min_ns + (uint64_t)(randomUniform() * (double)(max_ns - min_ns));
+}
+
+static bool saveState(void)
+{
+  FILE *file = fopen(work_path, "wb");
+
+  if (file == NULL) {
+    return false;
+  }
+
+  bool ok_f = fwrite(&state, sizeof(state), 1, file) == 1;
+  fclose(file);
+
+  return ok_f;
+}
+
+static bool loadState(void)
+{
+  FILE *file = fopen(work_path, "rb");
+
+  if (file == NULL) {
+    return false;
+  }
+
+  bool ok_f = fread(&state, sizeof(state), 1, file) == 1;
+  fclose(file);
+
+  return ok_f && state.magic == SOAK_STATE_MAGIC && state.size == sizeof(state);
+}
+
+/**
+ * @brief Function queues the IR frames of one adjustment session (channel select, presses, optional commit)
+ * @param argument: None
+ * @retval None
+ */
+static void startSession(void)
+{
+  uint64_t time_ns = state.now_ns;
+  uint32_t presses = 1;
+  bool up_f = randomUniform() < 0.5;
+
+  while (randomUniform() > 1.0 / state.profile.presses) {       /* Geometric distribution, mean = presses */
+    ++presses;
+  }
+
+  hal::irInject((randomUniform() < 0.5) ? SELECT_LEFT_CHANNEL_CMD_RAW : SELECT_RIGHT_CHANNEL_CMD_RAW, time_ns);
+
+  for (uint32_t i = 0; i < presses; i++) {
+    time_ns += randomRangeNs(300 * NS_PER_MS, 1000 * NS_PER_MS);
+
+    if (randomUniform() < 0.2) {                                 /* Overshoot correction */
+      up_f = !up_f;
+    }
+
+    hal::irInject(up_f ? INCREASE_VU_VALUE_CMD_RAW : DECREASE_VU_VALUE_CMD_RAW, time_ns);
+  }
+
+  if (randomUniform() < state.profile.commit_probability) {
+    time_ns += randomRangeNs(500 * NS_PER_MS, 2000 * NS_PER_MS);
+    hal::irInject(COMMIT_CHANGES_CMD_RAW, time_ns);
+    ++state.commits;
+  }
+
+  ++state.sessions;
+  state.presses += presses;
+  state.next_session_ns = time_ns + randomExponentialNs((double)NS_PER_DAY / state.profile.sessions_per_day);
+}
+
+/**
+ * @brief Function runs the firmware from the power-on to the power-off (or the end of the simulation). Idle time
+ *        is skipped, a step never crosses the next session start and never skips a DELAY_EEPROM_CHECK period.
+ * @param argument: uint64_t stop_ns
+ * @retval None
+ */
+static void runSession(uint64_t stop_ns)
+{
+  hal::set_time_ns(state.now_ns);
+  setup();
+
+  while (hal::now_ns() < stop_ns) {
+    uint64_t busy_ns = hal::eepromBusyNs();
+
+    loop();
+    hal::advance_ns(hal::timing.loop_overhead_ns);
+
+    busy_ns = hal::eepromBusyNs() - busy_ns;
+
+    if (busy_ns > state.eeprom_max_block_ns) {
+      state.eeprom_max_block_ns = busy_ns;
+    }
+
+    state.now_ns = hal::now_ns();
+
+    if (state.now_ns >= state.next_session_ns) {
+      startSession();
+    }
+
+    uint64_t next_ns = state.now_ns + ((hal::irPending() != 0) ? SOAK_EVENT_STEP_NS : SOAK_IDLE_STEP_NS);
+
+    if (next_ns > state.next_session_ns) {
+      next_ns = state.next_session_ns;
+    }
+
+    if (next_ns > stop_ns) {
+      next_ns = stop_ns;
+    }
+
+    if (next_ns > state.now_ns) {
+      hal::idle_ns(next_ns - state.now_ns);
+    }
+  }
+
+  state.now_ns = hal::now_ns();
+}
+
+/**
+ * @brief Function prints the soak report
+ * @param argument: None
+ * @retval None
+ */
+static void printReport(void)
+{
+  double years = (double)state.now_ns / (double)NS_PER_DAY / DAYS_PER_YEAR;
+  time_t start_time = time(NULL);
+
+  printf("EEPROM soak: %.2f years, DELAY_EEPROM_CHECK %lu ms, EEPROM check task %s\n", years,
+         (unsigned long)DELAY_EEPROM_CHECK, (EEPROM_CHECK_TASK_ENABLE == STD_ON) ? "on" : "off");
+  printf("Profile: %.1f sessions/day, %.1f presses/session, commit probability %.2f, %.1f power cycles/day\n",
+         state.profile.sessions_per_day, state.profile.presses, state.profile.commit_probability,
+         state.profile.power_cycles_per_day);
+  printf("Boots %llu, sessions %llu, presses %llu, commits %llu, power cycles with lost adjustments %llu\n",
+         (unsigned long long)state.boots, (unsigned long long)state.sessions, (unsigned long long)state.presses,
+         (unsigned long long)state.commits, (unsigned long long)state.lost_power_cycles);
+  printf("EEPROM blocked: %.1f ms total, %.3f ms/day, longest loop() pass %.1f ms\n",
+         (double)state.eeprom_busy_ns / 1e6, (double)state.eeprom_busy_ns / 1e6 / (years * DAYS_PER_YEAR),
+         (double)state.eeprom_max_block_ns / 1e6);
+
+  printf("\n%-8s %12s %14s %14s\n", "cell", "writes", "writes/year", "wear-out");
+
+  for (uint16_t address = 0; address < NATIVE_HAL_EEPROM_SIZE; address++) {
+    uint64_t writes = state.eeprom_writes[address];
+
+    if (writes == 0) {
+      continue;
+    }
+
+    double writes_per_year = (double)writes / years;
+    double wear_out_years = (double)SOAK_EEPROM_ENDURANCE / writes_per_year;
+    char wear_out_date[16] = "> 9999 years";
+
+    if (wear_out_years < 9999.0) {
+      time_t wear_out_time = start_time + (time_t)(wear_out_years * DAYS_PER_YEAR * 86400.0);
+      strftime(wear_out_date, sizeof(wear_out_date), "%Y-%m-%d", gmtime(&wear_out_time));
+    }
+
+    printf("0x%03x    %12llu %14.1f %14s\n", address, (unsigned long long)writes, writes_per_year, wear_out_date);
+  }
+
+  printf("\nX9C102 non-volatile stores: left %llu, right %llu (endurance %lu), timing violations %llu\n",
+         (unsigned long long)state.wiper_stores[0], (unsigned long long)state.wiper_stores[1],
+         (unsigned long)X9C102_STORE_ENDURANCE, (unsigned long long)state.wiper_violations);
+}
+
+static int usage(const char *program)
+{
+  fprintf(stderr, "Usage: %s [--years N] [--seed N] [--sessions-per-day N] [--presses N] [--commit-probability P]\n"
+                  "          [--power-cycles-per-day N] [--off-hours N] [--work FILE]\n", program);
+  return 2;
+}
+
+/**
+ * @brief Function parses the options of the first run and initializes the simulation state
+ * @param argument: int argc, char **argv
+ * @retval bool - false on invalid option
+ */
+static bool initState(int argc, char **argv)
+{
+  memset(&state, 0, sizeof(state));
+
+  state.magic = SOAK_STATE_MAGIC;
+  state.size = sizeof(state);
+  state.rng = 0x9E3779B97F4A7C15ULL;
+  state.profile.years = 10.0;
+  state.profile.sessions_per_day = 2.0;
+  state.profile.presses = 4.0;
+  state.profile.commit_probability = 0.5;
+  state.profile.power_cycles_per_day = 1.0;
+  state.profile.off_hours = 12.0;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const char *option = argv[i];
+    double value = atof(argv[i + 1]);
+
+    if (strcmp(option, "--years") == 0) {
+      state.profile.years = value;
+    } else if (strcmp(option, "--seed") == 0) {
+      state.rng ^= strtoull(argv[i + 1], NULL, 0) * 0xBF58476D1CE4E5B9ULL;
+    } else if (strcmp(option, "--sessions-per-day") == 0) {
+      state.profile.sessions_per_day = value;
+    } else if (strcmp(option, "--presses") == 0) {
+      state.profile.presses = (value < 1.0) ? 1.0 : value;
+    } else if (strcmp(option, "--commit-probability") == 0) {
+      state.profile.commit_probability = value;
+    } else if (strcmp(option, "--power-cycles-per-day") == 0) {
+      state.profile.power_cycles_per_day = value;
+    } else if (strcmp(option, "--off-hours") == 0) {
+      state.profile.off_hours = value;
+    } else if (strcmp(option, "--work") == 0) {
+      snprintf(work_path, sizeof(work_path), "%s", argv[i + 1]);
+    } else {
+      return false;
+    }
+  }
+
+  if ((argc % 2) == 0 || state.profile.sessions_per_day <= 0 || state.profile.power_cycles_per_day <= 0) {
+    return false;
+  }
+
+  state.end_ns = (uint64_t)(state.profile.years * DAYS_PER_YEAR * (double)NS_PER_DAY);
+  state.next_session_ns = randomExponentialNs((double)NS_PER_DAY / state.profile.sessions_per_day);
+  state.wiper_stored[0] = X9C102_TAPS - 1 - POTETNIOMETER_RESET_VALUE;
+  state.wiper_stored[1] = POTETNIOMETER_RESET_VALUE;
+
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  bool resume_f = (argc == 3 && strcmp(argv[1], "--resume") == 0);
+
+  if (resume_f) {
+    snprintf(work_path, sizeof(work_path), "%s", argv[2]);
+
+    if (!loadState()) {
+      fprintf(stderr, "%s: invalid work file\n", work_path);
+      return 1;
+    }
+  } else if (!initState(argc, argv)) {
+    return usage(argv[0]);
+  }
+
+  snprintf(eeprom_path, sizeof(eeprom_path), "%s.eeprom", work_path);
+
+  const X9C102Pins left_pins = {LEFT_CHANNEL, INC_POTENTIOMETER_GPIO, UD_POTENTIOMETER_GPIO};
+  const X9C102Pins right_pins = {RIGHT_CHANNEL, INC_POTENTIOMETER_GPIO, UD_POTENTIOMETER_GPIO};
+  X9C102Model left("left", left_pins, state.wiper_stored[0]);
+  X9C102Model right("right", right_pins, state.wiper_stored[1]);
+
+  left.setReport(false);
+  right.setReport(false);
+  hal::serialSetSink(NULL);
+
+  /* Power-on period, a session interrupted by the power-off keeps its remaining IR frames unprocessed */
+  state.power_off_ns = state.now_ns + randomExponentialNs((double)NS_PER_DAY / state.profile.power_cycles_per_day);
+  ++state.boots;
+
+  runSession((state.power_off_ns < state.end_ns) ? state.power_off_ns : state.end_ns);
+
+  /* Power-off: compare the live potentiometer settings with the stored configuration */
+  uint8_t live_left = (uint8_t)(X9C102_TAPS - 1 - left.wiper());
+  uint8_t live_right = right.wiper();
+
+  if (live_left != Configuration.Data.channel_step_value[LEFT_CHANNEL_INDEX] ||
+      live_right != Configuration.Data.channel_step_value[RIGHT_CHANNEL_INDEX]) {
+    ++state.lost_power_cycles;
+  }
+
+  for (uint16_t address = 0; address < NATIVE_HAL_EEPROM_SIZE; address++) {
+    state.eeprom_writes[address] += hal::eepromWriteCount(address);
+  }
+
+  state.eeprom_busy_ns += hal::eepromBusyNs();
+  state.wiper_stored[0] = left.storedWiper();
+  state.wiper_stored[1] = right.storedWiper();
+  state.wiper_stores[0] += left.storeCount();
+  state.wiper_stores[1] += right.storeCount();
+  state.wiper_violations += left.totalViolations() + right.totalViolations();
+
+  if (state.now_ns >= state.end_ns) {
+    printReport();
+    unlink(work_path);
+    unlink(eeprom_path);
+    return 0;
+  }
+
+  /* Power cycle: restart the firmware from scratch with the EEPROM content */
+  state.now_ns += randomExponentialNs(state.profile.off_hours * (double)NS_PER_HOUR);
+
+  if (!hal::eepromSave(eeprom_path) || !saveState()) {
+    fprintf(stderr, "%s: work files can not be written\n", work_path);
+    return 1;
+  }
+
+  setenv(NATIVE_HAL_EEPROM_ENV, eeprom_path, 1);
+  fflush(stdout);
+
+  char resume_option[] = "--resume";
+  char *const restart_argv[] = {argv[0], resume_option, work_path, NULL};
+
+  execv("/proc/self/exe", restart_argv);
+  perror("execv");
+
+  return 1;
+}
@@ -0,0 +1,499 @@
+/**
+**********************************************************************************************************************
+*    @file           : fuzz_ir_command.cpp
+*    @brief          : fuzz_ir_command.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Fuzz target of the IR command state machine (vu_controller.h). The input is a configuration selector byte, the
+*    stored configuration (2 bytes, the values of the further channels are derived from them) and (command, time gap)
+*    byte pairs. The selector picks the controller which processes the commands: the production configuration, a
+*    full resolution configuration, an 8 channel CS fan-out configuration or a calibrated level configuration. The
+*    controllers and their mock back ends are kept across the inputs and restarted in place, the back end checks:
+*      - the potentiometer taps and the channel values stay within their ranges, the taps always match the command
+*        state (through the level table of the channel with calibrated levels),
+*      - a relative move of the full resolution starts at the current wiper tap of the channel,
+*      - the idle wiper resync (full resolution configuration, run every command_period of the time gaps) starts
+*        only after the idle period, moves one ramp step per call and ends at the channel tap, a command stops it,
+*      - every potentiometer write is its own CS transaction of configured channels wired for the given direction,
+*        so the CS lines are released between the commands,
+*      - at most one EEPROM write per command, the EEPROM check task writes at most once per eeprom_check_period,
+*      - the wipers are stored in the X9C102 with every EEPROM write when they are not set at boot, never otherwise.
+*
+*    Built with -D IR_COMMAND_FUZZ_LIBFUZZER and -fsanitize=fuzzer (clang) this is a libFuzzer target, otherwise
+*    the program runs the given input files or random inputs (--runs N, --seed N) and reports executions/s.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "vu_controller.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define FUZZ_START_TIME             (uint32_t)(0xFFFFFFFFUL - 4 * DELAY_EEPROM_CHECK)   /* millis() wraps early */
+#define FUZZ_UNKNOWN_CMD_RAW        (uint32_t)(0xE0006B86)
+#define FUZZ_MAX_INPUT_SIZE         (512)
+#define FUZZ_RANDOM_INPUT_SIZE      (64)              /* Random inputs of the standalone driver */
+#define FUZZ_DEFAULT_RUNS           (1000000UL)
+#define FUZZ_COMMAND_COUNT          (10)
+#define FUZZ_CONFIG_COUNT           (4)
+#define FUZZ_HEADER_SIZE            (3)               /* Configuration selector and stored configuration */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define FUZZ_CHECK(condition, message)                                                                             \
+  do {                                                                                                             \
+    if (!(condition)) {                                                                                            \
+      fprintf(stderr, "invariant violated: %s (%s)\n", message, #condition);                                       \
+      abort();                                                                                                     \
+    }                                                                                                              \
+  } while (0)
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+static const uint32_t fuzz_commands[FUZZ_COMMAND_COUNT] = {
+  SELECT_RIGHT_CHANNEL_CMD_RAW,
+  SELECT_LEFT_CHANNEL_CMD_RAW,
+  INCREASE_VU_VALUE_CMD_RAW,
+  DECREASE_VU_VALUE_CMD_RAW,
+  INCREASE_VU_VALUE_COARSE_CMD_RAW,
+  DECREASE_VU_VALUE_COARSE_CMD_RAW,
+  COMMIT_CHANGES_CMD_RAW,
+  FACTORY_RESET_VU_VAL_CMD_RAW,
+  PRINT_DEBUG_INFO_CMD_RAW,
+  FUZZ_UNKNOWN_CMD_RAW,
+};
+
+/*Second configuration in the same binary: full resolution (all taps, relative moves, acceleration), no EEPROM
+  check task, no potentiometer init at boot*/
+struct FuzzWideRangeConfig : VuConfig
+{
+  static constexpr bool full_resolution = true;
+  static constexpr uint8_t low_boundary = 0;
+  static constexpr uint8_t high_boundary = VU_CONFIG_POTENTIOMETER_TAPS - 1;
+  static constexpr uint8_t reset_value = 50;
+  static constexpr bool eeprom_check_task = false;
+  static constexpr bool init_potentiometers_with_eeprom = false;
+  static constexpr bool wiper_resync = true;
+  static constexpr uint32_t resync_idle_period = 60000;
+};
+
+/*Third configuration: 8 channels on the 74HC595 CS fan-out, every other channel wired as the left one*/
+struct FuzzFanoutConfig : VuConfig
+{
+  static constexpr uint8_t channel_count = 8;
+  static constexpr bool cs_fanout = true;
+  static constexpr uint8_t channel_down_mask = 0x55;
+};
+
+/*Fourth configuration: calibrated levels, 4 channels with different step resistances*/
+struct FuzzLevelConfig : VuConfig
+{
+  static constexpr uint8_t channel_count = 4;
+  static constexpr bool cs_fanout = true;
+  static constexpr uint8_t channel_down_mask = 0x03;
+  static constexpr bool level_calibration = true;
+  static constexpr uint16_t channel_step_ohm[VU_CONFIG_MAX_CHANNELS] = {3000, 3600, 2400, 2900,
+                                                                         3000, 3000, 3000, 3000};
+};
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*Mock of the X9C102 potentiometers and the EEPROM configuration storage*/
+template <class TConfig>
+class MockBackend
+{
+public:
+  uint32_t transactions;                        /* potentiometerSetVal() calls, one CS transaction each */
+  uint8_t wiper[TConfig::channel_count];
+  uint8_t stored[TConfig::channel_count];
+  uint32_t eeprom_writes;
+  uint32_t wiper_stores;                        /* potentiometerStore() calls */
+  uint8_t written_mask;                         /* Channels written since the harness cleared it */
+
+  typedef VuController<TConfig, MockBackend> Controller;
+
+  static bool inRange(uint8_t value)
+  {
+    return value >= TConfig::low_boundary && value <= TConfig::high_boundary;
+  }
+
+  static bool valueInRange(uint8_t value)
+  {
+    return value >= Controller::value_low && value <= Controller::value_high;
+  }
+
+  /* Potentiometer tap the controller starts with for a stored value */
+  static uint8_t startTap(uint8_t channel, uint8_t value)
+  {
+    if (value < Controller::value_low) {
+      value = Controller::value_low;
+    } else if (value > Controller::value_high) {
+      value = Controller::value_high;
+    }
+
+    if constexpr (TConfig::level_calibration) {
+      return VuLevels<TConfig>::tap(channel, value);
+    } else {
+      (void)channel;
+      return value;
+    }
+  }
+
+  /* Without the init at boot the potentiometers keep the wiper of their non-volatile memory */
+  void reset(const uint8_t *channel_values)
+  {
+    transactions = 0;
+    eeprom_writes = 0;
+    wiper_stores = 0;
+    written_mask = 0;
+
+    for (uint8_t channel = 0; channel < TConfig::channel_count; channel++) {
+      stored[channel] = channel_values[channel];
+      wiper[channel] = TConfig::init_potentiometers_with_eeprom ? 0 : startTap(channel, channel_values[channel]);
+    }
+  }
+
+  void potentiometerSetVal(uint8_t channel_mask, uint8_t val, potentiometer_direction dir)
+  {
+    FUZZ_CHECK(inRange(val), "potentiometer value in range");
+    FUZZ_CHECK(dir == DIRECTION_DOWN || dir == DIRECTION_UP, "potentiometer direction");
+    FUZZ_CHECK(channel_mask != 0 && (channel_mask >> TConfig::channel_count) == 0, "configured channels selected");
+
+    for (uint8_t channel = 0; channel < TConfig::channel_count; channel++) {
+      if (channel_mask & CHANNEL_MASK(channel)) {
+        FUZZ_CHECK(dir == ((TConfig::channel_down_mask & CHANNEL_MASK(channel)) ? DIRECTION_DOWN : DIRECTION_UP),
+                   "direction of the channel wiring");
+        wiper[channel] = val;
+      }
+    }
+
+    written_mask |= channel_mask;
+    ++transactions;
+  }
+
+  void potentiometerStepVal(uint8_t channel_mask, uint8_t from, uint8_t to, potentiometer_direction dir)
+  {
+    FUZZ_CHECK(TConfig::full_resolution || TConfig::wiper_resync, "relative moves with the full resolution only");
+    FUZZ_CHECK((inRange(from) && inRange(to)) ||
+               (TConfig::wiper_resync && from < VU_CONFIG_POTENTIOMETER_TAPS &&
+                to < VU_CONFIG_POTENTIOMETER_TAPS + TConfig::resync_overshoot), "potentiometer step in range");
+    FUZZ_CHECK(channel_mask != 0 && (channel_mask & (channel_mask - 1)) == 0 &&
+               (channel_mask >> TConfig::channel_count) == 0, "relative move of one configured channel");
+
+    for (uint8_t channel = 0; channel < TConfig::channel_count; channel++) {
+      if (channel_mask & CHANNEL_MASK(channel)) {
+        FUZZ_CHECK(dir == ((TConfig::channel_down_mask & CHANNEL_MASK(channel)) ? DIRECTION_DOWN : DIRECTION_UP),
+                   "direction of the channel wiring");
+        FUZZ_CHECK(wiper[channel] == from, "relative move starts at the wiper");
+        wiper[channel] = (to < VU_CONFIG_POTENTIOMETER_TAPS) ? to : (uint8_t)(VU_CONFIG_POTENTIOMETER_TAPS - 1);
+      }
+    }
+
+    written_mask |= channel_mask;
+    ++transactions;
+  }
+
+  void potentiometerStore(uint8_t channel_mask)
+  {
+    FUZZ_CHECK(!TConfig::init_potentiometers_with_eeprom, "wipers stored without the init at boot only");
+    FUZZ_CHECK(channel_mask == (uint8_t)((1U << TConfig::channel_count) - 1), "every wiper stored");
+    FUZZ_CHECK(wiper_stores < eeprom_writes, "wipers stored after an EEPROM write");
+
+    ++wiper_stores;
+  }
+
+  bool storeConfig(const uint8_t *channel_values)
+  {
+    bool changed_f = false;
+
+    for (uint8_t channel = 0; channel < TConfig::channel_count; channel++) {
+      FUZZ_CHECK(valueInRange(channel_values[channel]), "stored values in range");
+      changed_f |= (channel_values[channel] != stored[channel]);
+      stored[channel] = channel_values[channel];
+    }
+
+    if (!changed_f) {
+      return false;                             /* EEPROMStore::Save() skips unchanged data */
+    }
+
+    ++eeprom_writes;
+
+    return true;
+  }
+};
+
+/*Controller and mock back end of one configuration, kept across the inputs and restarted in place*/
+template <class TConfig>
+struct FuzzFixture
+{
+  typedef MockBackend<TConfig> Backend;
+
+  Backend backend;
+  typename Backend::Controller controller;
+
+  FuzzFixture() : backend(), controller(backend) {}
+};
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Function checks the command state of the given channels against the potentiometers
+ * @param argument: const TFixture &fixture, uint8_t channel_mask
+ * @retval None
+ */
+template <class TFixture>
+static void fuzzCheckChannels(const TFixture &fixture, uint8_t channel_mask)
+{
+  for (; channel_mask != 0; channel_mask &= (uint8_t)(channel_mask - 1)) {
+    const uint8_t channel = (uint8_t)__builtin_ctz(channel_mask);
+
+    FUZZ_CHECK(TFixture::Backend::valueInRange(fixture.controller.channelValue(channel)), "value in range");
+    FUZZ_CHECK(fixture.backend.wiper[channel] == fixture.controller.channelTap(channel),
+               "potentiometer matches the command state");
+  }
+}
+
+/**
+ * @brief Function runs one fuzz input on the controller of the given configuration: setup() sequence of the
+ *        firmware, then the commands with their time gaps
+ * @param argument: const uint8_t *data, size_t size
+ * @retval None
+ */
+template <class TConfig>
+static void fuzzOne(const uint8_t *data, size_t size)
+{
+  static FuzzFixture<TConfig> fixture;
+  MockBackend<TConfig> &backend = fixture.backend;
+  typename MockBackend<TConfig>::Controller &controller = fixture.controller;
+  constexpr uint8_t all_mask = (uint8_t)((1U << TConfig::channel_count) - 1);
+  constexpr uint8_t down_mask = TConfig::channel_down_mask;
+  constexpr uint8_t up_mask = (uint8_t)(all_mask & ~down_mask);
+  uint8_t channel_values[TConfig::channel_count];
+  uint32_t time = FUZZ_START_TIME;
+  uint32_t last_check_write_time = time;
+  bool check_written_f = false;
+
+  for (uint8_t channel = 0; channel < TConfig::channel_count; channel++) {
+    channel_values[channel] = (uint8_t)(data[channel & 1] + (channel >> 1) * 37);
+  }
+
+  backend.reset(channel_values);
+  controller.begin(channel_values, time);
+  FUZZ_CHECK(backend.transactions == (TConfig::init_potentiometers_with_eeprom ? TConfig::channel_count : 0U),
+             "begin writes every potentiometer once when enabled");
+
+  for (size_t i = 2; i + 1 < size; i += 2) {
+    uint8_t gap = data[i + 1];
+    const uint32_t command_time = time;
+
+    /* Commands are polled every command_period, long gaps reach the EEPROM check period */
+    time += (gap & 0x80) ? (uint32_t)(gap & 0x7F) * 5000UL : TConfig::command_period + 1 + gap * 10UL;
+
+    /* The resync task runs every command_period of the gap, the idle part without pending channels is skipped */
+    if constexpr (TConfig::wiper_resync) {
+      for (uint32_t tick = command_time + TConfig::command_period; (int32_t)(time - tick) > 0;
+           tick += TConfig::command_period) {
+        const bool idle_f = (uint32_t)(tick - command_time) >= TConfig::resync_idle_period;
+        const uint32_t transactions = backend.transactions;
+        const uint8_t channel = controller.resyncChannel();
+        const irCommandResult resync = controller.wiperResync(tick);
+        const uint32_t resync_writes = backend.transactions - transactions;
+
+        FUZZ_CHECK(resync != IR_CMD_RESYNC_STARTED || idle_f, "resync only after the idle period");
+        FUZZ_CHECK((resync == IR_CMD_RESYNC_IDLE) ? resync_writes == 0
+                   : (resync == IR_CMD_RESYNC_DONE) ? resync_writes <= 1 : resync_writes == 1,
+                   "one ramp step per resync call");
+
+        if (resync == IR_CMD_RESYNC_DONE) {
+          FUZZ_CHECK(backend.wiper[channel] == controller.channelTap(channel), "resync ends at the channel tap");
+        }
+
+        if (resync == IR_CMD_RESYNC_IDLE) {
+          if (idle_f) {
+            break;
+          }
+
+          tick = command_time + TConfig::resync_idle_period - TConfig::command_period;
+        }
+      }
+    }
+
+    uint32_t writes = backend.eeprom_writes;
+    uint32_t transactions = backend.transactions;
+    const bool resync_f = (controller.resyncChannel() != NO_CHANNEL_SELECTED);
+    irCommandResult result = controller.dispatch(fuzz_commands[data[i] % FUZZ_COMMAND_COUNT], time);
+    uint32_t expected_writes = resync_f ? 1 : 0;  /* A running resync ramp is stopped by a re-homing write */
+
+    FUZZ_CHECK(backend.eeprom_writes - writes <= 1, "one EEPROM write per command");
+
+    if (result == IR_CMD_VALUE_UP || result == IR_CMD_VALUE_DOWN) {
+      expected_writes += 1;
+    } else if (result == IR_CMD_FACTORY_RESET_STORED || result == IR_CMD_FACTORY_RESET_UNCHANGED) {
+      /* One transaction per direction group, per channel with calibrated levels */
+      expected_writes += TConfig::level_calibration ? TConfig::channel_count : (up_mask != 0) + (down_mask != 0);
+    }
+
+    FUZZ_CHECK(backend.transactions - transactions == expected_writes,
+               "potentiometer writes only by up/down, factory reset and a stopped resync");
+
+    writes = backend.eeprom_writes;
+    result = controller.eepromCheck(time);
+
+    if (result == IR_CMD_EEPROM_CHECK_STORED) {
+      FUZZ_CHECK(TConfig::eeprom_check_task, "EEPROM check task disabled");
+      FUZZ_CHECK(!check_written_f || (uint32_t)(time - last_check_write_time) > TConfig::eeprom_check_period,
+                 "EEPROM check task writes once per eeprom_check_period");
+      FUZZ_CHECK(backend.eeprom_writes - writes == 1, "EEPROM check task write");
+      last_check_write_time = time;
+      check_written_f = true;
+    } else {
+      FUZZ_CHECK(backend.eeprom_writes == writes, "EEPROM check task without a write");
+    }
+
+    FUZZ_CHECK(backend.wiper_stores == (TConfig::init_potentiometers_with_eeprom ? 0 : backend.eeprom_writes),
+               "wipers stored with every EEPROM write without the init at boot");
+    FUZZ_CHECK(controller.selectedChannel() == NO_CHANNEL_SELECTED ||
+               controller.selectedChannel() < TConfig::channel_count, "selected channel configured");
+
+    /* A command changes only the selected channel and the written ones, the rest is checked once at the end */
+    const uint8_t selected = controller.selectedChannel();
+
+    fuzzCheckChannels(fixture, (uint8_t)(backend.written_mask |
+                                         ((selected < TConfig::channel_count) ? CHANNEL_MASK(selected) : 0)));
+    backend.written_mask = 0;
+  }
+
+  fuzzCheckChannels(fixture, all_mask);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+  if (size < FUZZ_HEADER_SIZE) {
+    return 0;
+  }
+
+  switch (data[0] % FUZZ_CONFIG_COUNT) {
+  case 0:
+    fuzzOne<VuConfig>(data + 1, size - 1);
+    break;
+  case 1:
+    fuzzOne<FuzzWideRangeConfig>(data + 1, size - 1);
+    break;
+  case 2:
+    fuzzOne<FuzzFanoutConfig>(data + 1, size - 1);
+    break;
+  default:
+    fuzzOne<FuzzLevelConfig>(data + 1, size - 1);
+    break;
+  }
+
+  return 0;
+}
+
+#ifndef IR_COMMAND_FUZZ_LIBFUZZER
+
+static uint64_t fuzz_rng = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t fuzzRandom(void)
+{
+  fuzz_rng ^= fuzz_rng << 13;
+  fuzz_rng ^= fuzz_rng >> 7;
+  fuzz_rng ^= fuzz_rng << 17;
+
+  return fuzz_rng;
+}
+
+static int fuzzFile(const char *path)
+{
+  static uint8_t data[FUZZ_MAX_INPUT_SIZE];
+  FILE *file = fopen(path, "rb");
+
+  if (file == NULL) {
+    perror(path);
+    return 1;
+  }
+
+  size_t size = fread(data, 1, sizeof(data), file);
+  fclose(file);
+  LLVMFuzzerTestOneInput(data, size);
+  printf("%s: %lu bytes OK\n", path, (unsigned long)size);
+
+  return 0;
+}
+
+/**
+ * @brief Standalone driver: input files, or random inputs when no file is given
+ * @param argument: int argc, char **argv
+ * @retval int
+ */
+int main(int argc, char **argv)
+{
+  unsigned long runs = FUZZ_DEFAULT_RUNS;
+  bool files_f = false;
+  int status = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+      runs = strtoul(argv[++i], NULL, 0);
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      fuzz_rng ^= strtoull(argv[++i], NULL, 0) * 0xBF58476D1CE4E5B9ULL;
+    } else {
+      status |= fuzzFile(argv[i]);
+      files_f = true;
+    }
+  }
+
+  if (files_f) {
+    return status;
+  }
+
+  static uint8_t data[FUZZ_MAX_INPUT_SIZE];
+  uint64_t commands = 0;
+  clock_t start = clock();
+
+  for (unsigned long run = 0; run < runs; run++) {
+    size_t size = FUZZ_HEADER_SIZE + (size_t)(fuzzRandom() % (FUZZ_RANDOM_INPUT_SIZE - FUZZ_HEADER_SIZE + 1));
+
+    for (size_t i = 0; i < size; i += 8) {
+      uint64_t value = fuzzRandom();
+      memcpy(&data[i], &value, (size - i < 8) ? size - i : 8);
+    }
+
+    LLVMFuzzerTestOneInput(data, size);
+    commands += (size - FUZZ_HEADER_SIZE) / 2;
+  }
+
+  double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  printf("%lu random inputs (%llu commands) OK in %.2f s, %.0f exec/s\n", runs, (unsigned long long)commands,
+         seconds, (seconds > 0) ? runs / seconds : 0.0);
+
+  return 0;
+}
+
+#endif
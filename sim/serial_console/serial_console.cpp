@@ -0,0 +1,219 @@
+/**
+**********************************************************************************************************************
+*    @file           : serial_console.cpp
+*    @brief          : serial_console.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Native run of the firmware with the USB serial port bridged to a pseudo terminal, so the serial console
+*    (SERIAL_CONSOLE) can be driven by the host client like the device:
+*
+*      program --time 60 &
+*      python3 tools/vu_console.py --port /dev/pts/N state
+*
+*    The simulated time is paced to the wall clock (the client timeouts stay meaningful). The pty path is printed
+*    on stdout as "pty: PATH" after the boot. tools/vu_console.py loopback starts the program and runs the console
+*    checks against it.
+*
+*    Build: pio run -e sim_serial_console
+*    Usage: program [--time SECONDS] - run time, default until SIGINT/SIGTERM
+*    EEPROM image: NATIVE_HAL_EEPROM=FILE environment variable, loaded before boot and saved at the end
+*    Exit code: 0 - no watchdog expiration, 1 otherwise, 2 - invalid arguments or no pty
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <Arduino.h>
+#include <termios.h>                            /* After binary.h: its B0..B11111111 clash with the baud rates */
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define BRIDGE_READ_SIZE            (64)
+#define BRIDGE_MAX_WAIT_MS          (10)              /* Poll timeout while ahead of the wall clock */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+static int master_fd = -1;
+static volatile sig_atomic_t stop_f = 0;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static uint64_t wallClockNs(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+static void onSignal(int signal_number)
+{
+  (void)signal_number;
+  stop_f = 1;
+}
+
+/**
+ * @brief Serial sink: the firmware output goes to the pty master (read by the client from the slave side)
+ * @param argument: const uint8_t *data, size_t length
+ * @retval None
+ */
+static void ptyWrite(const uint8_t *data, size_t length)
+{
+  while (length > 0) {
+    ssize_t written = write(master_fd, data, length);
+
+    if (written <= 0) {
+      return;                                   /* Nobody reads the output, it is dropped like on a closed port */
+    }
+
+    data += written;
+    length -= (size_t)written;
+  }
+}
+
+/**
+ * @brief Function opens the pty in the raw mode. The program keeps the slave open, so the master stays usable
+ *        while no client is connected
+ * @param argument: int *slave_fd
+ * @retval const char * - slave path, NULL on error
+ */
+static const char *ptyOpen(int *slave_fd)
+{
+  master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+  if (master_fd < 0 || grantpt(master_fd) != 0 || unlockpt(master_fd) != 0) {
+    return NULL;
+  }
+
+  const char *path = ptsname(master_fd);
+
+  if (path == NULL || (*slave_fd = open(path, O_RDWR | O_NOCTTY)) < 0) {
+    return NULL;
+  }
+
+  struct termios attributes;
+
+  if (tcgetattr(*slave_fd, &attributes) != 0) {
+    return NULL;
+  }
+
+  cfmakeraw(&attributes);
+
+  if (tcsetattr(*slave_fd, TCSANOW, &attributes) != 0) {
+    return NULL;
+  }
+
+  fcntl(master_fd, F_SETFL, fcntl(master_fd, F_GETFL) | O_NONBLOCK);
+
+  return path;
+}
+
+/**
+ * @brief Function moves the bytes written by the client to the firmware serial input, waits up to wait_ms for them
+ * @param argument: int wait_ms
+ * @retval None
+ */
+static void ptyRead(int wait_ms)
+{
+  struct pollfd descriptor = {master_fd, POLLIN, 0};
+
+  if (poll(&descriptor, 1, wait_ms) <= 0 || !(descriptor.revents & POLLIN)) {
+    return;
+  }
+
+  uint8_t buffer[BRIDGE_READ_SIZE];
+  ssize_t length;
+
+  while ((length = read(master_fd, buffer, sizeof(buffer))) > 0) {
+    hal::serialInject(buffer, (size_t)length);
+  }
+}
+
+/**
+ * @brief pty bridge runner
+ * @param argument: int argc, char **argv
+ * @retval int - 0 on success, 1 when the watchdog expired, 2 on invalid arguments or without a pty
+ */
+int main(int argc, char **argv)
+{
+  double run_time_s = 0;                        /* 0 - until a signal */
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--time") == 0 && i + 1 < argc) {
+      run_time_s = atof(argv[++i]);
+    } else {
+      fprintf(stderr, "Usage: %s [--time SECONDS]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  int slave_fd = -1;
+  const char *path = ptyOpen(&slave_fd);
+
+  if (path == NULL) {
+    perror("[serial console] pty");
+    return 2;
+  }
+
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+  hal::serialSetSink(ptyWrite);
+
+  const uint64_t end_ns = (uint64_t)(run_time_s * 1e9);
+  const uint64_t wall_start_ns = wallClockNs();
+
+  setup();
+
+  printf("pty: %s\n", path);
+  fflush(stdout);
+
+  while (!stop_f && (end_ns == 0 || hal::now_ns() < end_ns)) {
+    uint64_t wall_ns = wallClockNs() - wall_start_ns;
+    uint64_t ahead_ns = (hal::now_ns() > wall_ns) ? hal::now_ns() - wall_ns : 0;
+    int wait_ms = (int)(ahead_ns / 1000000ULL);
+
+    ptyRead((wait_ms < BRIDGE_MAX_WAIT_MS) ? wait_ms : BRIDGE_MAX_WAIT_MS);
+
+    loop();
+    hal::advance_ns(hal::timing.loop_overhead_ns);
+  }
+
+  fprintf(stderr, "[serial console] simulated %.3f s, EEPROM writes: %llu bytes, watchdog expirations: %u\n",
+          (double)hal::now_ns() / 1e9, (unsigned long long)hal::eepromTotalWrites(),
+          (unsigned)hal::watchdogExpirations());
+
+  const char *eeprom_path = getenv(NATIVE_HAL_EEPROM_ENV);
+
+  if (eeprom_path != NULL && !hal::eepromSave(eeprom_path)) {
+    fprintf(stderr, "[serial console] %s not saved\n", eeprom_path);
+  }
+
+  close(slave_fd);
+  close(master_fd);
+
+  return (hal::watchdogExpirations() == 0) ? 0 : 1;
+}
@@ -0,0 +1,962 @@
+/**
+**********************************************************************************************************************
+*    @file           : unit_bus.cpp
+*    @brief          : unit_bus.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Native simulation of the addressed multi-unit bus (UNIT_BUS). The firmware is one unit (UNIT_BUS_ADDRESS) on the
+*    simulated Serial1 with two X9C102 models attached to the potentiometer lines (direct CS lines, CS_FANOUT off),
+*    the program is the bus master and the half-duplex line: every byte is timed at UNIT_BUS_BAUDRATE, a byte
+*    started before the line is free is a collision, and the DE line of the firmware has to cover its frames.
+*
+*    The first part checks the firmware against the master: unicast commands, frames of other units, broadcasts
+*    (no response, DE never driven), a retry with the same sequence (same response, not executed again), frame
+*    errors, the group commit with its confirm and the bus turnaround. The node processing times (request end ->
+*    response, -> last wiper step, -> EEPROM written) are measured on the way.
+*
+*    The second part puts the firmware on a bus with 1..32 units, the other units are UnitBusNode instances with the
+*    measured processing times of the firmware. The master sets all units with unicast requests (latency grows with
+*    the unit count) and with one broadcast (constant), then persists them with the group commit and with
+*    sequential commits: the spread of the times the units start to write the EEPROM (skew) does not grow with the
+*    units for the group commit.
+*
+*    Build: pio run -e sim_unit_bus
+*    Usage: program
+*    Exit code: 0 - all checks passed, 1 otherwise
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <deque>
+
+#include <Arduino.h>
+#include <util/crc16.h>
+#include "EEPROMStore.h"
+#include "X9C102_model.h"
+#include "serial_console.h"
+#include "unit_bus.h"
+#include "vu_controller.h"
+#include "vu_levels.h"
+#include "main.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define HOST_TIMEOUT_NS             (500000000ULL)    /* Wait for a response, commits write EEPROM */
+#define HOST_SILENCE_NS             (50000000ULL)     /* No response expected: frames of other units, broadcasts */
+#define BUS_SETTLE_NS               (60000000ULL)     /* Between the rounds, beyond POTENTIOMETER_STORE_TIME */
+#define UNIT_COUNT_MAX              (32)
+#define SENDER_MASTER               (-1)
+#define SCALING_TOLERANCE           (0.10)            /* Unicast latency per added unit against the first one */
+#define BROADCAST_TOLERANCE_NS      (1000000ULL)
+#define GROUP_SKEW_LIMIT_NS         (1000000ULL)
+
+static const uint8_t unit_counts[] = {1, 2, 4, 8, 16, 32};
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/* Only the value range of the controller is used by the master */
+struct RangeBackend
+{
+};
+
+typedef VuController<VuConfig, RangeBackend> Controller;
+
+/* Byte on the line with the end of its stop bit */
+struct LineByte
+{
+  uint64_t end_ns;
+  uint8_t value;
+};
+
+/* Encoded frame of the master or of a modeled unit */
+class FrameBuffer : public Print
+{
+public:
+  uint8_t data[2 * UNIT_BUS_MAX_FRAME_SIZE];
+  size_t length = 0;
+
+  using Print::write;
+
+  size_t write(uint8_t value) override
+  {
+    if (length < sizeof(data)) {
+      data[length++] = value;
+    }
+
+    return 1;
+  }
+};
+
+/* Response seen by the master */
+struct Reply
+{
+  bool received_f;
+  uint8_t status;
+  uint8_t data[UNIT_BUS_MAX_FRAME_SIZE];        /* Response data behind the status */
+  uint8_t length;
+  uint64_t request_end_ns;
+  uint64_t response_start_ns;
+  uint64_t response_end_ns;
+};
+
+/* Processing time of the firmware, request end -> response start and -> done (last wiper step, EEPROM written) */
+struct NodeTiming
+{
+  uint64_t respond_ns;
+  uint64_t done_ns;
+};
+
+/* Unit of the multi-unit part: the frame handling of the firmware, the command handling modeled */
+struct ModelUnit
+{
+  UnitBusNode node;
+  std::deque<LineByte> rx;
+  uint8_t values[VU_CHANNEL_COUNT];
+  uint8_t stored[VU_CHANNEL_COUNT];
+  uint32_t commits;
+  bool execute_f;
+  uint64_t execute_ns;                          /* End of the pending request */
+  bool transmit_f;
+  uint64_t transmit_ns;
+  uint64_t applied_ns;
+  uint64_t persist_ns;                          /* Start of the last EEPROM write */
+
+  explicit ModelUnit(uint8_t address)
+    : node(address), rx(), values(), stored(), commits(0), execute_f(false), execute_ns(0), transmit_f(false),
+      transmit_ns(0), applied_ns(0), persist_ns(0)
+  {
+  }
+};
+
+/* Results of one unit count */
+struct FanoutResult
+{
+  uint8_t units;
+  uint64_t unicast_applied_ns;
+  uint64_t unicast_confirmed_ns;
+  uint64_t broadcast_applied_ns;
+  uint64_t group_skew_ns;
+  uint64_t group_confirmed_ns;
+  uint64_t sequential_skew_ns;
+};
+
+extern EEPROMStore<ChannelsConfiguration, CONFIGURATION_EEPROM_ADDRESS> Configuration;
+extern UnitBusNode unitBus;
+
+static X9C102Model *left_model;
+static X9C102Model *right_model;
+static ModelUnit *units[UNIT_COUNT_MAX];
+static uint8_t unit_count = 0;
+
+static std::deque<LineByte> master_rx;
+static UnitBusReader master_reader;
+static uint8_t master_sequence = 0;
+static FrameBuffer master_frame;
+
+static uint64_t line_free_ns = 0;               /* End of the stop bit of the last byte on the line */
+static uint64_t frame_start_ns = 0;             /* First byte of the last frame of a unit */
+static uint64_t firmware_end_ns = 0;            /* Last byte sent by the firmware */
+static uint32_t collisions = 0;
+static uint32_t turnaround_violations = 0;
+static uint32_t de_violations = 0;
+static uint32_t de_assertions = 0;
+static bool de_high_f = false;
+
+static uint64_t eeprom_writes = 0;
+static uint64_t eeprom_start_ns = 0;            /* Firmware: start of the loop pass of the first EEPROM write */
+static uint64_t eeprom_end_ns = 0;              /* Firmware: end of the loop pass of the last EEPROM write */
+
+static NodeTiming timing_set;
+static NodeTiming timing_commit;
+static NodeTiming timing_query;
+
+static uint32_t checks = 0;
+static uint32_t failures = 0;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static void check(bool condition_f, const char *name)
+{
+  checks++;
+
+  if (!condition_f) {
+    failures++;
+    printf("  FAIL: %s\n", name);
+  }
+}
+
+/*DE line of the firmware transceiver: must be high while the firmware sends, released after the last stop bit*/
+class DeObserver : public hal::RegisterObserver
+{
+private:
+  hal::PinMapping _pin;
+
+public:
+  DeObserver() : _pin() { hal::pinMapping(UNIT_BUS_DE_GPIO, &_pin); }
+
+  void onRegisterWrite(hal::RegisterId reg, uint8_t old_value, uint8_t new_value, uint64_t time_ns) override
+  {
+    const uint8_t mask = (uint8_t)(1U << _pin.bit);
+
+    if (reg != _pin.port || ((old_value ^ new_value) & mask) == 0) {
+      return;
+    }
+
+    de_high_f = (new_value & mask) != 0;
+
+    if (de_high_f) {
+      de_assertions++;
+    } else if (hal::uartTxEndNs() > time_ns) {
+      de_violations++;                          /* Driver off before the last stop bit */
+    }
+  }
+};
+
+/**
+ * @brief Function puts a frame on the line: the firmware receives it on Serial1, the master and the modeled units
+ *        from their queues
+ * @param argument: int sender - SENDER_MASTER or modeled unit index, const uint8_t *data, size_t length,
+ *                  uint64_t start_ns
+ * @retval uint64_t - end of the frame
+ */
+static uint64_t lineSend(int sender, const uint8_t *data, size_t length, uint64_t start_ns)
+{
+  const uint64_t byte_ns = hal::uartByteNs();
+
+  if (start_ns < line_free_ns) {
+    collisions++;
+  }
+
+  hal::uartInject(data, length, start_ns);
+
+  for (size_t i = 0; i < length; i++) {
+    const LineByte received = {start_ns + (i + 1) * byte_ns, data[i]};
+
+    if (sender != SENDER_MASTER) {
+      master_rx.push_back(received);
+    }
+
+    for (uint8_t unit = 0; unit < unit_count; unit++) {
+      if ((int)unit != sender) {
+        units[unit]->rx.push_back(received);
+      }
+    }
+  }
+
+  if (sender != SENDER_MASTER) {
+    frame_start_ns = start_ns;
+  }
+
+  line_free_ns = start_ns + length * byte_ns;
+
+  return line_free_ns;
+}
+
+/**
+ * @brief Function takes a byte sent by the firmware (UART sink)
+ * @param argument: uint8_t value, uint64_t end_ns
+ * @retval None
+ */
+static void firmwareSink(uint8_t value, uint64_t end_ns)
+{
+  const uint64_t start_ns = end_ns - hal::uartByteNs();
+  const LineByte received = {end_ns, value};
+
+  if (!de_high_f) {
+    de_violations++;
+  }
+
+  if (start_ns != firmware_end_ns) {            /* First byte of a frame */
+    if (start_ns < line_free_ns) {
+      collisions++;
+    } else if (start_ns - line_free_ns < UNIT_BUS_TURNAROUND_US * 1000ULL) {
+      turnaround_violations++;
+    }
+
+    frame_start_ns = start_ns;
+  }
+
+  master_rx.push_back(received);
+
+  for (uint8_t unit = 0; unit < unit_count; unit++) {
+    units[unit]->rx.push_back(received);
+  }
+
+  firmware_end_ns = end_ns;
+  line_free_ns = end_ns;
+}
+
+/**
+ * @brief Function builds a frame of the master with its own encoder (COBS between two delimiters)
+ * @param argument: FrameBuffer &frame, uint8_t destination, uint8_t sequence, uint8_t command,
+ *                  const uint8_t *payload, uint8_t length, uint8_t version
+ * @retval None
+ */
+static void hostFrame(FrameBuffer &frame, uint8_t destination, uint8_t sequence, uint8_t command,
+                      const uint8_t *payload, uint8_t length, uint8_t version = UNIT_BUS_VERSION)
+{
+  uint8_t decoded[UNIT_BUS_MAX_FRAME_SIZE] = {version, destination, UNIT_BUS_MASTER, sequence, command};
+  uint8_t size = UNIT_BUS_HEADER_SIZE;
+  uint16_t crc = 0;
+
+  memcpy(&decoded[size], payload, length);
+  size = (uint8_t)(size + length);
+
+  for (uint8_t i = 0; i < size; i++) {
+    crc = _crc16_update(crc, decoded[i]);
+  }
+
+  decoded[size++] = (uint8_t)crc;
+  decoded[size++] = (uint8_t)(crc >> 8);
+
+  frame.length = 0;
+  frame.write(CONSOLE_FRAME_DELIMITER);
+
+  uint8_t block_start = 0;
+
+  for (uint8_t i = 0; i <= size; i++) {
+    if (i == size || decoded[i] == 0) {
+      frame.write((uint8_t)(i - block_start + 1));
+      frame.write(&decoded[block_start], i - block_start);
+      block_start = (uint8_t)(i + 1);
+    }
+  }
+
+  frame.write(CONSOLE_FRAME_DELIMITER);
+}
+
+/**
+ * @brief Function executes the pending request of a modeled unit with the processing times of the firmware
+ * @param argument: ModelUnit &unit
+ * @retval None
+ */
+static void unitExecute(ModelUnit &unit)
+{
+  const uint8_t command = unit.node.command();
+  const uint8_t *payload = unit.node.payload();
+  const uint8_t length = unit.node.payloadLength();
+  uint64_t respond_ns = timing_query.respond_ns;
+  uint8_t status = CONSOLE_STATUS_OK;
+
+  unit.node.begin();
+
+  switch (command) {
+  case CONSOLE_CMD_SET_BATCH: {
+    const uint8_t pairs = (uint8_t)(length / 2);
+
+    for (uint8_t i = 0; i < pairs && status == CONSOLE_STATUS_OK; i++) {
+      if (payload[2 * i] >= VU_CHANNEL_COUNT || payload[2 * i + 1] < Controller::value_low ||
+          payload[2 * i + 1] > Controller::value_high) {
+        status = CONSOLE_STATUS_BAD_VALUE;
+      }
+    }
+
+    if ((length % 2) != 0 || pairs == 0) {
+      status = CONSOLE_STATUS_BAD_LENGTH;
+    }
+
+    if (status == CONSOLE_STATUS_OK) {
+      for (uint8_t i = 0; i < pairs; i++) {
+        unit.values[payload[2 * i]] = payload[2 * i + 1];
+      }
+
+      unit.applied_ns = unit.execute_ns + timing_set.done_ns;
+      respond_ns = timing_set.respond_ns;
+    }
+    break;
+  }
+
+  case CONSOLE_CMD_COMMIT:
+  case UNIT_BUS_CMD_GROUP_COMMIT:
+    if (command == UNIT_BUS_CMD_GROUP_COMMIT && unit.node.groupCommitted(payload[0], &status)) {
+      break;
+    }
+
+    status = CONSOLE_STATUS_UNCHANGED;
+
+    if (memcmp(unit.values, unit.stored, VU_CHANNEL_COUNT) != 0) {
+      memcpy(unit.stored, unit.values, VU_CHANNEL_COUNT);
+      unit.commits++;
+      unit.persist_ns = unit.execute_ns;
+      respond_ns = timing_commit.respond_ns;
+      status = CONSOLE_STATUS_OK;
+    }
+
+    if (command == UNIT_BUS_CMD_GROUP_COMMIT) {
+      unit.node.setGroupCommit(payload[0], status);
+    }
+    break;
+
+  default:
+    status = CONSOLE_STATUS_UNSUPPORTED;        /* Not modeled, the firmware covers the commands */
+    break;
+  }
+
+  unit.node.putU8(status);
+
+  if (unit.node.end()) {
+    unit.transmit_f = true;
+    unit.transmit_ns = unit.execute_ns + respond_ns;
+  }
+}
+
+/**
+ * @brief Function runs the modeled units up to the current time: reception, execution and transmission at the
+ *        exact line times, independent of the loop pass of the firmware
+ * @param argument: None
+ * @retval None
+ */
+static void unitsRun(void)
+{
+  const uint64_t now_ns = hal::now_ns();
+
+  for (uint8_t index = 0; index < unit_count; index++) {
+    ModelUnit &unit = *units[index];
+
+    while (!unit.rx.empty() && unit.rx.front().end_ns <= now_ns) {
+      if (unit.node.feed(unit.rx.front().value, (uint32_t)(unit.rx.front().end_ns / 1000))) {
+        unit.execute_f = true;
+        unit.execute_ns = unit.rx.front().end_ns;
+      }
+
+      unit.rx.pop_front();
+    }
+
+    if (unit.execute_f) {
+      unit.execute_f = false;
+      unitExecute(unit);
+    }
+
+    if (unit.transmit_f && unit.transmit_ns <= now_ns) {
+      FrameBuffer frame;
+
+      if (!unit.node.transmitReady((uint32_t)(unit.transmit_ns / 1000))) {
+        turnaround_violations++;
+      }
+
+      unit.transmit_f = false;
+      unit.node.transmit(frame);
+      lineSend(index, frame.data, frame.length, unit.transmit_ns);
+    }
+  }
+}
+
+/**
+ * @brief Function runs one loop pass of the firmware and the modeled units, records the EEPROM writes
+ * @param argument: None
+ * @retval None
+ */
+static void runStep(void)
+{
+  const uint64_t pass_ns = hal::now_ns();
+
+  unitsRun();
+  loop();
+  hal::advance_ns(hal::timing.loop_overhead_ns);
+
+  if (hal::eepromTotalWrites() != eeprom_writes) {
+    eeprom_start_ns = (eeprom_start_ns == 0) ? pass_ns : eeprom_start_ns;
+    eeprom_writes = hal::eepromTotalWrites();
+    eeprom_end_ns = hal::now_ns();
+  }
+}
+
+static void runUntil(uint64_t time_ns)
+{
+  while (hal::now_ns() < time_ns) {
+    runStep();
+  }
+}
+
+/**
+ * @brief Function sends the frame of the master when the line is free and waits for the response of the unit
+ * @param argument: const FrameBuffer &frame, uint8_t destination, uint8_t sequence, Reply &reply,
+ *                  uint64_t timeout_ns
+ * @retval bool - true if the response was received
+ */
+static bool masterExchange(const FrameBuffer &frame, uint8_t destination, uint8_t sequence, Reply &reply,
+                           uint64_t timeout_ns = HOST_TIMEOUT_NS)
+{
+  const uint64_t start_ns = (hal::now_ns() > line_free_ns) ? hal::now_ns() : line_free_ns;
+
+  memset(&reply, 0, sizeof(reply));
+  reply.request_end_ns = lineSend(SENDER_MASTER, frame.data, frame.length, start_ns);
+
+  const uint64_t deadline_ns = reply.request_end_ns + timeout_ns;
+
+  while (hal::now_ns() < deadline_ns) {
+    while (!master_rx.empty() && master_rx.front().end_ns <= hal::now_ns()) {
+      const LineByte received = master_rx.front();
+
+      master_rx.pop_front();
+
+      if (!master_reader.feed(received.value) || master_reader.destination() != UNIT_BUS_MASTER ||
+          master_reader.source() != destination || master_reader.sequence() != sequence) {
+        continue;
+      }
+
+      reply.received_f = true;
+      reply.status = master_reader.payload()[0];
+      reply.length = (uint8_t)(master_reader.payloadLength() - 1);
+      memcpy(reply.data, &master_reader.payload()[1], reply.length);
+      reply.response_start_ns = frame_start_ns;
+      reply.response_end_ns = received.end_ns;
+      return true;
+    }
+
+    runStep();
+  }
+
+  return false;
+}
+
+/**
+ * @brief Function sends a new request of the master and waits for the response (not for a broadcast)
+ * @param argument: uint8_t destination, uint8_t command, const uint8_t *payload, uint8_t length, Reply &reply
+ * @retval bool - true if the response was received
+ */
+static bool masterRequest(uint8_t destination, uint8_t command, const uint8_t *payload, uint8_t length,
+                          Reply &reply)
+{
+  hostFrame(master_frame, destination, ++master_sequence, command, payload, length);
+
+  const bool received_f = masterExchange(master_frame, destination, master_sequence, reply,
+                                         (destination == UNIT_BUS_BROADCAST) ? HOST_SILENCE_NS : HOST_TIMEOUT_NS);
+
+  if (destination == UNIT_BUS_BROADCAST) {
+    runUntil(reply.request_end_ns + HOST_SILENCE_NS);
+  }
+
+  return received_f;
+}
+
+/**
+ * @brief Function repeats the last request of the master with the same sequence number
+ * @param argument: uint8_t destination, Reply &reply
+ * @retval bool - true if the response was received
+ */
+static bool masterRetry(uint8_t destination, Reply &reply)
+{
+  return masterExchange(master_frame, destination, master_sequence, reply);
+}
+
+/**
+ * @brief Function builds the batch payload of all channels
+ * @param argument: uint8_t *payload - 2 * VU_CHANNEL_COUNT bytes, uint8_t left, uint8_t right
+ * @retval uint8_t - payload length
+ */
+static uint8_t batchPayload(uint8_t *payload, uint8_t left, uint8_t right)
+{
+  for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+    payload[2 * channel] = channel;
+    payload[2 * channel + 1] = (channel == LEFT_CHANNEL_INDEX) ? left : right;
+  }
+
+  return (uint8_t)(2 * VU_CHANNEL_COUNT);
+}
+
+/**
+ * @brief Function returns the tap of a channel value (LEVEL_CALIBRATION: through the level table)
+ * @param argument: uint8_t channel, uint8_t value
+ * @retval uint8_t
+ */
+static uint8_t valueTap(uint8_t channel, uint8_t value)
+{
+#if (LEVEL_CALIBRATION == STD_ON)
+  return VuLevels<VuConfig>::tap(channel, value);
+#else
+  (void)channel;
+  return value;
+#endif
+}
+
+/**
+ * @brief Function compares the wiper positions with the channel values. The left wiper is set with
+ *        DIRECTION_DOWN (wiper = last tap - tap)
+ * @param argument: uint8_t left, uint8_t right - channel values
+ * @retval bool
+ */
+static bool wipersMatch(uint8_t left, uint8_t right)
+{
+  const uint8_t left_expected = (uint8_t)(X9C102_TAPS - 1 - valueTap(LEFT_CHANNEL_INDEX, left));
+  const uint8_t right_expected = valueTap(RIGHT_CHANNEL_INDEX, right);
+
+  if (left_model->wiper() != left_expected || right_model->wiper() != right_expected) {
+    printf("  wiper mismatch: left %u (expected %u), right %u (expected %u)\n",
+           left_model->wiper(), left_expected, right_model->wiper(), right_expected);
+    return false;
+  }
+
+  return true;
+}
+
+static uint64_t lastWiperStepNs(void)
+{
+  return (left_model->lastStepNs() > right_model->lastStepNs()) ? left_model->lastStepNs() :
+         right_model->lastStepNs();
+}
+
+/**
+ * @brief Function runs the single unit scenario against the firmware and measures its processing times
+ * @param argument: None
+ * @retval None
+ */
+static void runScenario(void)
+{
+  const uint8_t unit = UNIT_BUS_ADDRESS;
+  const uint8_t low = (uint8_t)(Controller::value_low + 2);
+  const uint8_t high = (uint8_t)(Controller::value_high - 2);
+  uint8_t payload[2 * VU_CHANNEL_COUNT];
+  uint8_t length = 0;
+  Reply reply;
+  Reply retry;
+
+  /* Unicast */
+  check(masterRequest(unit, CONSOLE_CMD_QUERY_STATE, NULL, 0, reply) && reply.status == CONSOLE_STATUS_OK &&
+        reply.data[0] == VU_CHANNEL_COUNT, "query state answered");
+
+  length = batchPayload(payload, low, high);
+  check(masterRequest(unit, CONSOLE_CMD_SET_BATCH, payload, length, reply) && reply.status == CONSOLE_STATUS_OK,
+        "batch set");
+  check(wipersMatch(low, high), "wipers after the batch");
+
+  timing_set.respond_ns = reply.response_start_ns - reply.request_end_ns;
+  timing_set.done_ns = lastWiperStepNs() - reply.request_end_ns;
+
+  /* A wiper write does not store the wipers, the next request does not wait for a store cycle */
+  check(masterRequest(unit, CONSOLE_CMD_QUERY_STATE, NULL, 0, retry) && retry.status == CONSOLE_STATUS_OK &&
+        retry.response_start_ns - reply.request_end_ns < POTENTIOMETER_STORE_TIME * 1000000ULL,
+        "request after a wiper write without a store cycle");
+
+  runUntil(hal::now_ns() + BUS_SETTLE_NS);
+  check(masterRequest(unit, CONSOLE_CMD_QUERY_STATE, NULL, 0, reply), "query state after the settling");
+  timing_query.respond_ns = reply.response_start_ns - reply.request_end_ns;
+  timing_query.done_ns = timing_query.respond_ns;
+
+  /* Frames of another unit and of another version are skipped */
+  const uint8_t other = (uint8_t)((unit == 1) ? 2 : 1);
+  const uint8_t level[2] = {RIGHT_CHANNEL_INDEX, low};
+
+  check(!masterRequest(other, CONSOLE_CMD_SET_LEVEL, level, sizeof(level), reply) &&
+        masterRequest(unit, CONSOLE_CMD_QUERY_STATE, NULL, 0, reply) &&
+        reply.data[5 + 2 * RIGHT_CHANNEL_INDEX] == high, "frame of another unit ignored");
+
+  hostFrame(master_frame, unit, ++master_sequence, CONSOLE_CMD_QUERY_STATE, NULL, 0, UNIT_BUS_VERSION + 1);
+  check(!masterExchange(master_frame, unit, master_sequence, reply, HOST_SILENCE_NS), "other version ignored");
+
+  /* Broadcast: executed, never answered */
+  const uint32_t assertions = de_assertions;
+
+  length = batchPayload(payload, high, low);
+  check(!masterRequest(UNIT_BUS_BROADCAST, CONSOLE_CMD_SET_BATCH, payload, length, reply) &&
+        de_assertions == assertions, "broadcast not answered, DE not driven");
+  check(wipersMatch(high, low), "wipers after the broadcast");
+
+  /* Retry: same sequence, the stored response is sent again and the request is not executed again */
+  const uint64_t writes = hal::eepromTotalWrites();
+
+  check(masterRequest(unit, CONSOLE_CMD_COMMIT, NULL, 0, reply) && reply.status == CONSOLE_STATUS_OK &&
+        hal::eepromTotalWrites() != writes, "commit stored");
+  timing_commit.respond_ns = reply.response_start_ns - reply.request_end_ns;
+  timing_commit.done_ns = eeprom_end_ns - reply.request_end_ns;
+
+  const uint64_t committed_writes = hal::eepromTotalWrites();
+  const uint16_t duplicates = unitBus.duplicates();
+
+  check(masterRetry(unit, retry) && retry.status == CONSOLE_STATUS_OK && hal::eepromTotalWrites() == committed_writes
+        && unitBus.duplicates() == duplicates + 1, "retried commit answered again, not executed again");
+
+  length = batchPayload(payload, low, high);
+  check(masterRequest(unit, CONSOLE_CMD_SET_BATCH, payload, length, reply), "batch before the retry");
+
+  const uint32_t steps = right_model->steps();
+
+  check(masterRetry(unit, retry) && retry.status == CONSOLE_STATUS_OK && right_model->steps() == steps,
+        "retried batch moves the wipers once");
+
+  /* Frame errors are counted, no response */
+  Reply stats;
+
+  check(masterRequest(unit, CONSOLE_CMD_STATS, NULL, 0, stats) && stats.status == CONSOLE_STATUS_OK, "stats");
+
+  const uint16_t errors = (uint16_t)(stats.data[8] | (stats.data[9] << 8));
+
+  hostFrame(master_frame, unit, ++master_sequence, CONSOLE_CMD_QUERY_STATE, NULL, 0);
+  master_frame.data[3] ^= 0x40;                 /* Destination byte: CRC mismatch */
+  check(!masterExchange(master_frame, unit, master_sequence, reply, HOST_SILENCE_NS), "bad CRC not answered");
+  check(masterRequest(unit, CONSOLE_CMD_STATS, NULL, 0, stats) &&
+        (uint16_t)(stats.data[8] | (stats.data[9] << 8)) == errors + 1, "bad CRC counted");
+
+  check(masterRequest(unit, 0x7E, NULL, 0, reply) && reply.status == CONSOLE_STATUS_UNKNOWN_COMMAND,
+        "unknown command");
+
+  /* Presets over the bus */
+  const uint8_t slot = 2;
+
+  check(masterRequest(unit, CONSOLE_CMD_PRESET_STORE, &slot, 1, reply) && reply.status == CONSOLE_STATUS_OK,
+        "preset stored");
+  runUntil(hal::now_ns() + BUS_SETTLE_NS);
+  length = batchPayload(payload, high, high);
+  masterRequest(UNIT_BUS_BROADCAST, CONSOLE_CMD_SET_BATCH, payload, length, reply);
+  check(masterRequest(unit, CONSOLE_CMD_PRESET_RECALL, &slot, 1, reply) && reply.status == CONSOLE_STATUS_OK,
+        "preset recalled");
+  check(wipersMatch(low, high), "wipers after the preset recall");
+
+  /* Group commit: persisted by the broadcast, the confirm only reads the status of the token */
+  const uint8_t token = 0x5A;
+
+  runUntil(hal::now_ns() + BUS_SETTLE_NS);
+  length = batchPayload(payload, (uint8_t)(low + 1), (uint8_t)(high - 1));
+  masterRequest(UNIT_BUS_BROADCAST, CONSOLE_CMD_SET_BATCH, payload, length, reply);
+
+  const uint64_t group_writes = hal::eepromTotalWrites();
+
+  masterRequest(UNIT_BUS_BROADCAST, UNIT_BUS_CMD_GROUP_COMMIT, &token, 1, reply);
+  check(hal::eepromTotalWrites() != group_writes && Configuration.Data.channel_step_value[LEFT_CHANNEL_INDEX] ==
+        low + 1, "group commit broadcast persists");
+
+  const uint64_t confirm_writes = hal::eepromTotalWrites();
+
+  check(masterRequest(unit, UNIT_BUS_CMD_GROUP_COMMIT, &token, 1, reply) && reply.status == CONSOLE_STATUS_OK &&
+        hal::eepromTotalWrites() == confirm_writes, "group commit confirm, not committed again");
+
+  const uint8_t missed = (uint8_t)(token + 1);
+
+  check(masterRequest(unit, UNIT_BUS_CMD_GROUP_COMMIT, &missed, 1, reply) &&
+        reply.status == CONSOLE_STATUS_UNCHANGED, "confirm of a missed group commit commits");
+  check(masterRequest(unit, UNIT_BUS_CMD_GROUP_COMMIT, NULL, 0, reply) && reply.status == CONSOLE_STATUS_BAD_LENGTH,
+        "group commit without token");
+
+  printf("node processing: batch response %.3f ms, wipers set %.3f ms, commit response %.3f ms, "
+         "EEPROM written %.3f ms, query response %.3f ms\n", (double)timing_set.respond_ns / 1e6,
+         (double)timing_set.done_ns / 1e6, (double)timing_commit.respond_ns / 1e6,
+         (double)timing_commit.done_ns / 1e6, (double)timing_query.respond_ns / 1e6);
+}
+
+/**
+ * @brief Function returns the spread of the EEPROM write start times of all units of the bus
+ * @param argument: uint64_t firmware_ns - EEPROM write start of the firmware
+ * @retval uint64_t
+ */
+static uint64_t persistSkew(uint64_t firmware_ns)
+{
+  uint64_t first_ns = firmware_ns;
+  uint64_t last_ns = firmware_ns;
+
+  for (uint8_t unit = 0; unit < unit_count; unit++) {
+    first_ns = (units[unit]->persist_ns < first_ns) ? units[unit]->persist_ns : first_ns;
+    last_ns = (units[unit]->persist_ns > last_ns) ? units[unit]->persist_ns : last_ns;
+  }
+
+  return last_ns - first_ns;
+}
+
+/**
+ * @brief Function returns the time the last unit applied its values
+ * @param argument: None
+ * @retval uint64_t
+ */
+static uint64_t lastApplied(void)
+{
+  uint64_t last_ns = lastWiperStepNs();
+
+  for (uint8_t unit = 0; unit < unit_count; unit++) {
+    last_ns = (units[unit]->applied_ns > last_ns) ? units[unit]->applied_ns : last_ns;
+  }
+
+  return last_ns;
+}
+
+/**
+ * @brief Function runs the fan-out of the master to the firmware and count - 1 modeled units
+ * @param argument: uint8_t count, uint8_t round - alternates the values, FanoutResult &result
+ * @retval None
+ */
+static void runFanout(uint8_t count, uint8_t round, FanoutResult &result)
+{
+  const uint8_t firmware = UNIT_BUS_ADDRESS;
+  const uint8_t low = (uint8_t)(Controller::value_low + 1 + (round % 3));
+  const uint8_t high = (uint8_t)(Controller::value_high - 1 - (round % 3));
+  uint8_t addresses[UNIT_COUNT_MAX];
+  uint8_t payload[2 * VU_CHANNEL_COUNT];
+  uint8_t length = 0;
+  bool confirmed_f = true;
+  Reply reply;
+
+  addresses[0] = firmware;
+  unit_count = 0;
+
+  for (uint8_t address = 1; unit_count < count - 1; address++) {
+    if (address != firmware) {
+      units[unit_count] = new ModelUnit(address);
+      memcpy(units[unit_count]->values, Configuration.Data.channel_step_value, VU_CHANNEL_COUNT);
+      memcpy(units[unit_count]->stored, Configuration.Data.channel_step_value, VU_CHANNEL_COUNT);
+      addresses[++unit_count] = address;
+    }
+  }
+
+  result.units = count;
+  runUntil(hal::now_ns() + BUS_SETTLE_NS);
+
+  /* Unicast: one request and response per unit */
+  uint64_t start_ns = hal::now_ns();
+
+  length = batchPayload(payload, low, high);
+
+  for (uint8_t unit = 0; unit < count; unit++) {
+    confirmed_f = masterRequest(addresses[unit], CONSOLE_CMD_SET_BATCH, payload, length, reply) &&
+                  reply.status == CONSOLE_STATUS_OK && confirmed_f;
+  }
+
+  result.unicast_confirmed_ns = reply.response_end_ns - start_ns;
+  result.unicast_applied_ns = lastApplied() - start_ns;
+  check(confirmed_f && wipersMatch(low, high), "unicast fan-out confirmed by every unit");
+
+  /* Broadcast: one frame for all units */
+  runUntil(hal::now_ns() + BUS_SETTLE_NS);
+  start_ns = hal::now_ns();
+  length = batchPayload(payload, high, low);
+  masterRequest(UNIT_BUS_BROADCAST, CONSOLE_CMD_SET_BATCH, payload, length, reply);
+  result.broadcast_applied_ns = lastApplied() - start_ns;
+  check(wipersMatch(high, low), "broadcast fan-out applied");
+
+  /* Group commit: broadcast, then one confirm per unit */
+  const uint8_t token = (uint8_t)(0x80 | round);
+  const uint64_t writes = hal::eepromTotalWrites();
+
+  runUntil(hal::now_ns() + BUS_SETTLE_NS);
+  start_ns = hal::now_ns();
+  eeprom_start_ns = 0;
+  masterRequest(UNIT_BUS_BROADCAST, UNIT_BUS_CMD_GROUP_COMMIT, &token, 1, reply);
+  confirmed_f = hal::eepromTotalWrites() != writes;
+
+  const uint64_t firmware_persist_ns = eeprom_start_ns;
+  const uint64_t firmware_written_ns = eeprom_end_ns;
+
+  for (uint8_t unit = 0; unit < count; unit++) {
+    confirmed_f = masterRequest(addresses[unit], UNIT_BUS_CMD_GROUP_COMMIT, &token, 1, reply) &&
+                  reply.status == CONSOLE_STATUS_OK && confirmed_f;
+  }
+
+  for (uint8_t unit = 0; unit < unit_count; unit++) {
+    confirmed_f = confirmed_f && units[unit]->commits == 1;
+  }
+
+  result.group_confirmed_ns = reply.response_end_ns - start_ns;
+  result.group_skew_ns = persistSkew(firmware_persist_ns);
+  check(confirmed_f && eeprom_end_ns == firmware_written_ns, "group commit persisted once by every unit");
+
+  /* Sequential commits of the next values for the comparison */
+  runUntil(hal::now_ns() + BUS_SETTLE_NS);
+  length = batchPayload(payload, low, high);
+  masterRequest(UNIT_BUS_BROADCAST, CONSOLE_CMD_SET_BATCH, payload, length, reply);
+  confirmed_f = true;
+  eeprom_start_ns = 0;
+
+  for (uint8_t unit = 0; unit < count; unit++) {
+    confirmed_f = masterRequest(addresses[unit], CONSOLE_CMD_COMMIT, NULL, 0, reply) &&
+                  reply.status == CONSOLE_STATUS_OK && confirmed_f;
+  }
+
+  result.sequential_skew_ns = persistSkew(eeprom_start_ns);
+  check(confirmed_f, "sequential commits");
+
+  for (uint8_t unit = 0; unit < unit_count; unit++) {
+    delete units[unit];
+  }
+
+  unit_count = 0;
+}
+
+int main()
+{
+  const X9C102Pins left_pins = {LEFT_CHANNEL, INC_POTENTIOMETER_GPIO, UD_POTENTIOMETER_GPIO};
+  const X9C102Pins right_pins = {RIGHT_CHANNEL, INC_POTENTIOMETER_GPIO, UD_POTENTIOMETER_GPIO};
+  X9C102Model left("left", left_pins);
+  X9C102Model right("right", right_pins);
+  DeObserver de;
+  FanoutResult results[sizeof(unit_counts)];
+
+  left_model = &left;
+  right_model = &right;
+  hal::addObserver(&de);
+  hal::serialSetSink(NULL);
+  hal::uartSetSink(firmwareSink);
+
+  setup();
+  check(hal::uartByteNs() != 0, "Serial1 enabled");
+  runUntil(hal::now_ns() + BUS_SETTLE_NS);
+
+  runScenario();
+
+  if (failures == 0) {
+    printf("%5s %14s %14s %10s %14s %14s %14s %14s\n", "units", "unicast set", "unicast conf.", "per unit",
+           "broadcast set", "group commit", "group skew", "seq. skew");
+
+    for (uint8_t i = 0; i < sizeof(unit_counts); i++) {
+      FanoutResult &result = results[i];
+
+      runFanout(unit_counts[i], i, result);
+      printf("%5u %11.3f ms %11.3f ms %7.3f ms %11.3f ms %11.3f ms %11.3f ms %11.3f ms\n", result.units,
+             (double)result.unicast_applied_ns / 1e6, (double)result.unicast_confirmed_ns / 1e6,
+             (double)result.unicast_confirmed_ns / result.units / 1e6, (double)result.broadcast_applied_ns / 1e6,
+             (double)result.group_confirmed_ns / 1e6, (double)result.group_skew_ns / 1e6,
+             (double)result.sequential_skew_ns / 1e6);
+    }
+
+    const FanoutResult &single = results[0];
+    const double unit_ns = (double)(results[1].unicast_confirmed_ns - single.unicast_confirmed_ns) /
+                           (results[1].units - single.units);
+    bool linear_f = true;
+    bool constant_f = true;
+    bool skew_f = true;
+
+    for (uint8_t i = 1; i < sizeof(unit_counts); i++) {
+      const double added_ns = (double)(results[i].unicast_confirmed_ns - results[i - 1].unicast_confirmed_ns) /
+                              (results[i].units - results[i - 1].units);
+      const uint64_t broadcast_delta = (results[i].broadcast_applied_ns > single.broadcast_applied_ns) ?
+                                       results[i].broadcast_applied_ns - single.broadcast_applied_ns :
+                                       single.broadcast_applied_ns - results[i].broadcast_applied_ns;
+
+      linear_f = linear_f && added_ns >= unit_ns * (1.0 - SCALING_TOLERANCE) &&
+                 added_ns <= unit_ns * (1.0 + SCALING_TOLERANCE);
+      constant_f = constant_f && broadcast_delta <= BROADCAST_TOLERANCE_NS;
+      skew_f = skew_f && results[i].group_skew_ns <= GROUP_SKEW_LIMIT_NS &&
+               results[i].sequential_skew_ns > results[i - 1].sequential_skew_ns;
+    }
+
+    check(linear_f, "unicast fan-out latency grows linearly with the units");
+    check(constant_f, "broadcast fan-out latency independent of the units");
+    check(skew_f, "group commit skew bounded, sequential commit skew grows with the units");
+  }
+
+  check(collisions == 0, "no collision on the line");
+  check(turnaround_violations == 0, "bus turnaround respected");
+  check(de_violations == 0, "DE covers every frame of the firmware");
+  check(hal::uartOverruns() == 0 && unitBus.overruns() == 0, "no UART or node overrun");
+  check(left.totalViolations() == 0 && right.totalViolations() == 0, "no X9C102 timing violation");
+
+  printf("%lu checks, %lu failed: %s\n", (unsigned long)checks, (unsigned long)failures,
+         failures == 0 ? "PASS" : "FAIL");
+
+  return failures == 0 ? 0 : 1;
+}
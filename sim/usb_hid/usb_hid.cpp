@@ -0,0 +1,522 @@
+/**
+**********************************************************************************************************************
+*    @file           : usb_hid.cpp
+*    @brief          : usb_hid.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Native simulation of the USB HID control interface (USB_HID_CONTROL) with two X9C102 models attached to the
+*    potentiometer lines (direct CS lines, CS_FANOUT off). The program is the USB host: it parses the configuration
+*    and the report descriptor of the firmware, sends output reports on the simulated interrupt OUT endpoint and
+*    with SET_REPORT, and checks every state input report against the wiper positions. Covers the consumer control
+*    buttons (same dispatcher as IR), the atomic levels report, the presets, the commit and the malformed reports.
+*    Then the control latency (button press -> last wiper step) of HID and IR is compared: an IR command is decoded
+*    after the NEC frame and the firmware polls the receiver every DELAY_PERIOD, a HID report arrives in the next
+*    1 ms frame of the interrupt endpoint and is executed in the next loop pass.
+*
+*    Build: pio run -e sim_usb_hid
+*    Usage: program
+*    Exit code: 0 - all checks passed, 1 otherwise
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <Arduino.h>
+#include "EEPROMStore.h"
+#include "X9C102_model.h"
+#include "hid_control.h"
+#include "protocol.h"
+#include "serial_console.h"
+#include "vu_controller.h"
+#include "vu_levels.h"
+#include "main.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define HOST_INTERFACE              (uint8_t)(CDC_INTERFACE_COUNT)    /* First interface behind the CDC ones */
+#define HOST_TIMEOUT_MS             (500)             /* Wait for the state report, preset stores write EEPROM */
+#define HOST_FRAME_NS               (1000000ULL)      /* Full speed frame, interrupt endpoint bInterval 1 */
+#define NEC_FRAME_NS                (67500000ULL)     /* Leader, 32 bits and stop bit of a NEC frame */
+#define LATENCY_PRESSES             (40)
+#define LATENCY_PERIOD_NS           (263000000ULL)    /* Press period, not a multiple of DELAY_PERIOD */
+#define LATENCY_SETTLE_NS           (250000000ULL)
+#define LATENCY_HID_LIMIT_NS        (3000000ULL)      /* Worst case HID latency accepted */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/* Report layout as found by the host in the report descriptor: payload bytes per report ID */
+struct ReportLayout
+{
+  uint8_t output[8];
+  uint8_t input[8];
+};
+
+/* Only the value range of the controller is used by the host */
+struct RangeBackend
+{
+};
+
+typedef VuController<VuConfig, RangeBackend> Controller;
+
+extern EEPROMStore<ChannelsConfiguration, CONFIGURATION_EEPROM_ADDRESS> Configuration;
+
+static uint8_t endpoint_in;
+static uint8_t endpoint_out;
+static uint32_t checks = 0;
+static uint32_t failures = 0;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static void check(bool condition_f, const char *name)
+{
+  checks++;
+
+  if (!condition_f) {
+    failures++;
+    printf("  FAIL: %s\n", name);
+  }
+}
+
+static void runUntil(uint64_t time_ns)
+{
+  while (hal::now_ns() < time_ns) {
+    loop();
+    hal::advance_ns(hal::timing.loop_overhead_ns);
+  }
+}
+
+/**
+ * @brief Function returns the tap of a channel value (LEVEL_CALIBRATION: through the level table)
+ * @param argument: uint8_t channel, uint8_t value
+ * @retval uint8_t
+ */
+static uint8_t valueTap(uint8_t channel, uint8_t value)
+{
+#if (LEVEL_CALIBRATION == STD_ON)
+  return VuLevels<VuConfig>::tap(channel, value);
+#else
+  (void)channel;
+  return value;
+#endif
+}
+
+/**
+ * @brief Function compares the wiper positions with the channel values of a state report. The left wiper is
+ *        set with DIRECTION_DOWN (wiper = last tap - tap)
+ * @param argument: const uint8_t *values, const X9C102Model &left, const X9C102Model &right
+ * @retval bool
+ */
+static bool wipersMatch(const uint8_t *values, const X9C102Model &left, const X9C102Model &right)
+{
+  uint8_t left_expected = (uint8_t)(X9C102_TAPS - 1 - valueTap(LEFT_CHANNEL_INDEX, values[LEFT_CHANNEL_INDEX]));
+  uint8_t right_expected = valueTap(RIGHT_CHANNEL_INDEX, values[RIGHT_CHANNEL_INDEX]);
+
+  if (left.wiper() != left_expected || right.wiper() != right_expected) {
+    printf("  wiper mismatch: left %u (expected %u), right %u (expected %u)\n",
+           left.wiper(), left_expected, right.wiper(), right_expected);
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Function finds the interface of the firmware in the configuration descriptor
+ * @param argument: None
+ * @retval uint16_t - report descriptor length, 0 if the HID interface is not found
+ */
+static uint16_t hostEnumerate(void)
+{
+  uint8_t configuration[128];
+  size_t length = hal::usbConfiguration(configuration, sizeof(configuration));
+  uint16_t report_length = 0;
+  bool interface_f = false;
+
+  for (size_t offset = 0; offset + 2 <= length && configuration[offset] != 0; offset += configuration[offset]) {
+    const uint8_t *descriptor = &configuration[offset];
+
+    switch (descriptor[1]) {
+    case USB_INTERFACE_DESCRIPTOR_TYPE:
+      interface_f = descriptor[2] == HOST_INTERFACE && descriptor[4] == 2 &&
+                    descriptor[5] == USB_DEVICE_CLASS_HUMAN_INTERFACE;
+      break;
+
+    case HID_CONTROL_DESCRIPTOR_TYPE:
+      if (interface_f && descriptor[6] == HID_CONTROL_REPORT_DESCRIPTOR_TYPE) {
+        report_length = (uint16_t)(descriptor[7] | (descriptor[8] << 8));
+      }
+      break;
+
+    case USB_ENDPOINT_DESCRIPTOR_TYPE:
+      if (interface_f && (descriptor[3] & 0x03) == USB_ENDPOINT_TYPE_INTERRUPT) {
+        ((descriptor[2] & 0x80) ? endpoint_in : endpoint_out) = (uint8_t)(descriptor[2] & 0x0F);
+      }
+      break;
+
+    default:
+      break;
+    }
+  }
+
+  printf("configuration: %u bytes, HID interface %u, IN endpoint %u, OUT endpoint %u\n", (unsigned)length,
+         HOST_INTERFACE, endpoint_in, endpoint_out);
+
+  return (endpoint_in != 0 && endpoint_out != 0) ? report_length : 0;
+}
+
+/**
+ * @brief Function reads the report descriptor and sums the field sizes of every report ID (short items only)
+ * @param argument: uint16_t length, ReportLayout &layout
+ * @retval bool - false if the descriptor can not be read or parsed
+ */
+static bool hostReportLayout(uint16_t length, ReportLayout &layout)
+{
+  uint8_t descriptor[256];
+  uint32_t report_size = 0;
+  uint32_t report_count = 0;
+  uint8_t report_id = 0;
+  uint16_t bits[2][8] = {};
+
+  if (length > sizeof(descriptor) ||
+      hal::usbControlIn(REQUEST_DEVICETOHOST_STANDARD_INTERFACE, GET_DESCRIPTOR,
+                        (uint16_t)(HID_CONTROL_REPORT_DESCRIPTOR_TYPE << 8), HOST_INTERFACE, descriptor,
+                        length) != length) {
+    return false;
+  }
+
+  for (uint16_t offset = 0; offset < length;) {
+    const uint8_t prefix = descriptor[offset];
+    const uint8_t size = (uint8_t)(((prefix & 0x03) == 3) ? 4 : (prefix & 0x03));
+    uint32_t data = 0;
+
+    if (offset + 1 + size > length) {
+      return false;
+    }
+
+    for (uint8_t i = 0; i < size; i++) {
+      data |= (uint32_t)descriptor[offset + 1 + i] << (8 * i);
+    }
+
+    switch (prefix & 0xFC) {
+    case 0x84:                                  /* Report ID */
+      report_id = (uint8_t)data;
+      break;
+
+    case 0x74:                                  /* Report Size */
+      report_size = data;
+      break;
+
+    case 0x94:                                  /* Report Count */
+      report_count = data;
+      break;
+
+    case 0x80:                                  /* Input */
+    case 0x90:                                  /* Output */
+      if (report_id >= 8) {
+        return false;
+      }
+
+      bits[(prefix & 0xFC) == 0x90][report_id] = (uint16_t)(bits[(prefix & 0xFC) == 0x90][report_id] +
+                                                            report_size * report_count);
+      break;
+
+    default:
+      break;
+    }
+
+    offset = (uint16_t)(offset + 1 + size);
+  }
+
+  for (uint8_t id = 0; id < 8; id++) {
+    layout.input[id] = (uint8_t)(bits[0][id] / 8);
+    layout.output[id] = (uint8_t)(bits[1][id] / 8);
+  }
+
+  printf("report descriptor: %u bytes, output reports 1: %u, 2: %u, 3: %u bytes, input report 4: %u bytes\n",
+         length, layout.output[1], layout.output[2], layout.output[3], layout.input[4]);
+
+  return true;
+}
+
+/**
+ * @brief Function sends an output report on the interrupt OUT endpoint (or with SET_REPORT) and waits for the
+ *        state report on the interrupt IN endpoint
+ * @param argument: const uint8_t *report, size_t length, uint8_t *state, bool control_f - SET_REPORT
+ * @retval size_t - state report length, 0 if no state report was sent
+ */
+static size_t hostSend(const uint8_t *report, size_t length, uint8_t *state, bool control_f = false)
+{
+  if (control_f) {
+    hal::usbControlOut(REQUEST_HOSTTODEVICE_CLASS_INTERFACE, HID_CONTROL_SET_REPORT, (uint16_t)(0x0200 | report[0]),
+                       HOST_INTERFACE, report, (uint16_t)length);
+  } else if (!hal::usbOut(endpoint_out, report, length)) {
+    return 0;
+  }
+
+  const uint64_t deadline_ns = hal::now_ns() + HOST_TIMEOUT_MS * 1000000ULL;
+
+  while (hal::now_ns() < deadline_ns) {
+    size_t received = hal::usbIn(endpoint_in, state, HID_CONTROL_STATE_SIZE);
+
+    if (received != 0) {
+      return received;
+    }
+
+    runUntil(hal::now_ns() + HOST_FRAME_NS);
+  }
+
+  return 0;
+}
+
+static bool hostConsumer(uint16_t usage, uint8_t *state)
+{
+  const uint8_t report[HID_CONTROL_CONSUMER_SIZE] = {HID_CONTROL_REPORT_CONSUMER, (uint8_t)usage,
+                                                     (uint8_t)(usage >> 8)};
+
+  return hostSend(report, sizeof(report), state) == HID_CONTROL_STATE_SIZE;
+}
+
+static bool hostLevels(uint8_t left, uint8_t right, uint8_t *state, bool control_f = false)
+{
+  uint8_t report[HID_CONTROL_LEVELS_SIZE];
+
+  memset(report, HID_CONTROL_VALUE_KEEP, sizeof(report));
+  report[0] = HID_CONTROL_REPORT_LEVELS;
+  report[1 + LEFT_CHANNEL_INDEX] = left;
+  report[1 + RIGHT_CHANNEL_INDEX] = right;
+
+  return hostSend(report, sizeof(report), state, control_f) == HID_CONTROL_STATE_SIZE;
+}
+
+static bool hostPreset(uint8_t action, uint8_t slot, uint8_t *state)
+{
+  const uint8_t report[HID_CONTROL_PRESET_SIZE] = {HID_CONTROL_REPORT_PRESET, action, slot};
+
+  return hostSend(report, sizeof(report), state) == HID_CONTROL_STATE_SIZE;
+}
+
+/**
+ * @brief Function runs the report scenario, every state report is checked against the wipers
+ * @param argument: X9C102Model &left, X9C102Model &right
+ * @retval None
+ */
+static void runScenario(X9C102Model &left, X9C102Model &right)
+{
+  uint8_t state[HID_CONTROL_STATE_SIZE];
+  uint8_t saved[VU_CHANNEL_COUNT];
+  uint8_t idle = 0xFF;
+  const uint8_t low = (uint8_t)(Controller::value_low + 2);
+  const uint8_t high = (uint8_t)(Controller::value_high - 2);
+  const uint8_t *values = &state[2];
+
+  check(hal::usbControlOut(REQUEST_HOSTTODEVICE_CLASS_INTERFACE, HID_CONTROL_SET_IDLE, 0, HOST_INTERFACE, NULL, 0),
+        "SET_IDLE accepted");
+  check(hal::usbControlIn(REQUEST_DEVICETOHOST_CLASS_INTERFACE, HID_CONTROL_GET_IDLE, 0, HOST_INTERFACE, &idle,
+                          1) == 1 && idle == 0, "GET_IDLE returns the idle rate");
+  check(hal::usbControlIn(REQUEST_DEVICETOHOST_CLASS_INTERFACE, 0x7F, 0, HOST_INTERFACE, state, 1) < 0,
+        "unknown class request stalled");
+
+  /* Consumer control: the buttons of the remote */
+  check(hostConsumer(HID_USAGE_SCAN_NEXT_TRACK, state) && state[1] == CONSOLE_STATUS_OK, "next track selects");
+  memcpy(saved, values, VU_CHANNEL_COUNT);
+  check(hostConsumer(HID_USAGE_VOLUME_INCREMENT, state) && state[1] == CONSOLE_STATUS_OK &&
+        values[RIGHT_CHANNEL_INDEX] != saved[RIGHT_CHANNEL_INDEX] &&
+        values[LEFT_CHANNEL_INDEX] == saved[LEFT_CHANNEL_INDEX], "volume up moves the selected channel");
+
+  if (INIT_POTENTIOMETERS_WITH_EEPROM_VAL == STD_ON) {             /* Otherwise the left wiper is not set yet */
+    check(wipersMatch(values, left, right), "wipers after volume up");
+  }
+
+  check(hostConsumer(0, state) == false, "key release answers no state report");
+  check(hostConsumer(HID_USAGE_SCAN_PREVIOUS_TRACK, state) && hostConsumer(HID_USAGE_VOLUME_DECREMENT, state) &&
+        values[LEFT_CHANNEL_INDEX] != saved[LEFT_CHANNEL_INDEX], "previous track, volume down moves the left one");
+  check(wipersMatch(values, left, right), "wipers after volume down");
+  check(hostConsumer(0x0030, state) && state[1] == CONSOLE_STATUS_UNKNOWN_COMMAND, "unmapped usage rejected");
+
+  /* Levels: one transaction, KEEP leaves the channel */
+  check(hostLevels(low, high, state) && state[1] == CONSOLE_STATUS_OK && values[LEFT_CHANNEL_INDEX] == low &&
+        values[RIGHT_CHANNEL_INDEX] == high, "levels report sets both channels");
+  check(wipersMatch(values, left, right), "wipers after levels");
+  check(hostLevels(HID_CONTROL_VALUE_KEEP, (uint8_t)(high - 1), state) && values[LEFT_CHANNEL_INDEX] == low &&
+        values[RIGHT_CHANNEL_INDEX] == high - 1, "KEEP leaves the channel");
+  check(hostLevels((uint8_t)(low + 1), 0xFE, state) && state[1] == CONSOLE_STATUS_BAD_VALUE &&
+        values[LEFT_CHANNEL_INDEX] == low && values[RIGHT_CHANNEL_INDEX] == high - 1,
+        "out of range level rejects the whole report");
+  check(hostLevels((uint8_t)(low + 1), high, state, true) && state[1] == CONSOLE_STATUS_OK &&
+        values[LEFT_CHANNEL_INDEX] == low + 1, "levels with SET_REPORT");
+  check(wipersMatch(values, left, right), "wipers after SET_REPORT");
+
+  uint8_t feature[HID_CONTROL_STATE_SIZE];
+
+  check(hal::usbControlIn(REQUEST_DEVICETOHOST_CLASS_INTERFACE, HID_CONTROL_GET_REPORT,
+                          (uint16_t)(0x0100 | HID_CONTROL_REPORT_STATE), HOST_INTERFACE, feature,
+                          sizeof(feature)) == (int)sizeof(feature) && memcmp(feature, state, sizeof(feature)) == 0,
+        "GET_REPORT returns the last state report");
+
+  /* Presets */
+  memcpy(saved, values, VU_CHANNEL_COUNT);
+  check(hostPreset(HID_CONTROL_PRESET_STORE, 1, state) && state[1] == CONSOLE_STATUS_OK, "preset stored");
+  check(hostPreset(HID_CONTROL_PRESET_STORE, 1, state) && state[1] == CONSOLE_STATUS_UNCHANGED,
+        "same preset store unchanged");
+  check(hostLevels(high, low, state) && values[LEFT_CHANNEL_INDEX] == high, "levels changed");
+  check(hostPreset(HID_CONTROL_PRESET_RECALL, 1, state) && state[1] == CONSOLE_STATUS_OK &&
+        memcmp(values, saved, VU_CHANNEL_COUNT) == 0, "preset recalled");
+  check(wipersMatch(values, left, right), "wipers after preset recall");
+  check(hostPreset(HID_CONTROL_PRESET_RECALL, 3, state) && state[1] == CONSOLE_STATUS_EMPTY, "empty preset slot");
+  check(hostPreset(HID_CONTROL_PRESET_STORE, PRESET_COUNT, state) && state[1] == CONSOLE_STATUS_BAD_VALUE,
+        "preset slot out of range");
+  check(hostPreset(2, 0, state) && state[1] == CONSOLE_STATUS_BAD_VALUE, "unknown preset action");
+
+  /* Commit with play/pause */
+  check(hostConsumer(HID_USAGE_PLAY_PAUSE, state) &&
+        memcmp(Configuration.Data.channel_step_value, values, VU_CHANNEL_COUNT) == 0, "play/pause commits");
+
+  /* Malformed reports */
+  const uint8_t short_levels[] = {HID_CONTROL_REPORT_LEVELS, low};
+  const uint8_t unknown[] = {9, 0, 0};
+
+  check(hostSend(short_levels, sizeof(short_levels), state) && state[1] == CONSOLE_STATUS_BAD_LENGTH,
+        "short levels report");
+  check(hostSend(unknown, sizeof(unknown), state) && state[1] == CONSOLE_STATUS_UNKNOWN_COMMAND,
+        "unknown report ID");
+
+  /* No host reading the IN endpoint: the reports are executed, the state reports beyond the banks dropped */
+  for (uint8_t i = 0; i < 2; i++) {
+    hal::usbOut(endpoint_out, short_levels, sizeof(short_levels));
+    runUntil(hal::now_ns() + HOST_FRAME_NS);
+    hal::usbOut(endpoint_out, unknown, sizeof(unknown));
+    runUntil(hal::now_ns() + HOST_FRAME_NS);
+  }
+
+  uint8_t pending = 0;
+
+  while (hal::usbIn(endpoint_in, state, sizeof(state)) != 0) {
+    pending++;
+  }
+
+  check(pending == 2 && hal::usbOut(endpoint_out, unknown, sizeof(unknown)), "IN backpressure does not block");
+  runUntil(hal::now_ns() + HOST_FRAME_NS);
+  hal::usbIn(endpoint_in, state, sizeof(state));
+}
+
+/**
+ * @brief Function measures the press -> last wiper step latency of volume up/down pressed on the remote and sent
+ *        as HID consumer reports. The presses are spread over the loop and command period phases
+ * @param argument: X9C102Model &right - wiper of the selected channel, bool hid_f
+ * @retval None
+ */
+static void measureLatency(X9C102Model &right, bool hid_f)
+{
+  uint64_t min_ns = UINT64_MAX;
+  uint64_t max_ns = 0;
+  uint64_t sum_ns = 0;
+  uint32_t missed = 0;
+  uint8_t state[HID_CONTROL_STATE_SIZE];
+
+  for (uint32_t press = 0; press < LATENCY_PRESSES; press++) {
+    const uint64_t press_ns = hal::now_ns() + LATENCY_PERIOD_NS + (press * 7919ULL * 1000ULL) % HOST_FRAME_NS;
+    const uint16_t usage = (press & 1U) ? HID_USAGE_VOLUME_DECREMENT : HID_USAGE_VOLUME_INCREMENT;
+
+    if (hid_f) {
+      runUntil((press_ns / HOST_FRAME_NS + 1) * HOST_FRAME_NS);       /* Next poll of the OUT endpoint */
+    } else {
+      hal::irInject((usage == HID_USAGE_VOLUME_INCREMENT) ? INCREASE_VU_VALUE_CMD_RAW : DECREASE_VU_VALUE_CMD_RAW,
+                    press_ns + NEC_FRAME_NS);
+      runUntil(press_ns);
+    }
+
+    const uint64_t last_step_ns = right.lastStepNs();
+
+    if (hid_f) {
+      const uint8_t report[HID_CONTROL_CONSUMER_SIZE] = {HID_CONTROL_REPORT_CONSUMER, (uint8_t)usage,
+                                                         (uint8_t)(usage >> 8)};
+      hal::usbOut(endpoint_out, report, sizeof(report));
+    }
+
+    runUntil(press_ns + LATENCY_SETTLE_NS);
+
+    while (hal::usbIn(endpoint_in, state, sizeof(state)) != 0) {
+    }
+
+    if (right.lastStepNs() == last_step_ns) {
+      missed++;
+      continue;
+    }
+
+    const uint64_t latency_ns = right.lastStepNs() - press_ns;
+
+    min_ns = (latency_ns < min_ns) ? latency_ns : min_ns;
+    max_ns = (latency_ns > max_ns) ? latency_ns : max_ns;
+    sum_ns += latency_ns;
+  }
+
+  const uint32_t moved = LATENCY_PRESSES - missed;
+
+  printf("%-4s latency over %u presses: min %8.3f ms, avg %8.3f ms, max %8.3f ms\n", hid_f ? "HID" : "IR",
+         LATENCY_PRESSES, (double)min_ns / 1e6, moved ? (double)sum_ns / moved / 1e6 : 0.0, (double)max_ns / 1e6);
+
+  check(missed == 0, hid_f ? "every HID press moves the wiper" : "every IR press moves the wiper");
+
+  if (hid_f) {
+    check(max_ns <= LATENCY_HID_LIMIT_NS, "HID latency within the limit");
+  } else {
+    check(min_ns >= NEC_FRAME_NS, "IR latency includes the NEC frame");
+  }
+}
+
+int main()
+{
+  const X9C102Pins left_pins = {LEFT_CHANNEL, INC_POTENTIOMETER_GPIO, UD_POTENTIOMETER_GPIO};
+  const X9C102Pins right_pins = {RIGHT_CHANNEL, INC_POTENTIOMETER_GPIO, UD_POTENTIOMETER_GPIO};
+  X9C102Model left("left", left_pins);
+  X9C102Model right("right", right_pins);
+  ReportLayout layout = {};
+
+  hal::serialSetSink(NULL);
+
+  /* The host enumerates the device while the core attaches it, before setup() */
+  const uint16_t report_length = hostEnumerate();
+
+  check(report_length != 0, "HID interface with interrupt IN and OUT endpoints");
+  check(hostReportLayout(report_length, layout), "report descriptor readable");
+  check(layout.output[HID_CONTROL_REPORT_CONSUMER] == HID_CONTROL_CONSUMER_SIZE - 1 &&
+        layout.output[HID_CONTROL_REPORT_LEVELS] == HID_CONTROL_LEVELS_SIZE - 1 &&
+        layout.output[HID_CONTROL_REPORT_PRESET] == HID_CONTROL_PRESET_SIZE - 1 &&
+        layout.input[HID_CONTROL_REPORT_STATE] == HID_CONTROL_STATE_SIZE - 1, "report sizes of the descriptor");
+
+  if (failures == 0) {
+    setup();
+    runScenario(left, right);
+
+    uint8_t state[HID_CONTROL_STATE_SIZE];
+
+    hostConsumer(HID_USAGE_SCAN_NEXT_TRACK, state);
+    measureLatency(right, false);
+    measureLatency(right, true);
+  }
+
+  check(left.totalViolations() == 0 && right.totalViolations() == 0, "no X9C102 timing violation");
+
+  printf("%lu checks, %lu failed: %s\n", (unsigned long)checks, (unsigned long)failures,
+         failures == 0 ? "PASS" : "FAIL");
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,270 @@
+/**
+**********************************************************************************************************************
+*    @file           : x9c102_timing.cpp
+*    @brief          : x9c102_timing.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Native simulation of the firmware with two X9C102 models attached to the potentiometer lines. A fixed IR
+*    command scenario is replayed, after every command the wiper positions are compared with the channel step
+*    values of the firmware. Reports the datasheet timing violations, non-volatile stores and for every command
+*    the pulse train length (first -> last wiper step) and the settle time (IR frame received -> last wiper step).
+*    The EEPROM holds the record of the first firmware release at boot, the firmware has to find it, store it in the
+*    current format (converted to levels with LEVEL_CALIBRATION) and set the wipers from it.
+*    With POTENTIOMETER_FULL_RESOLUTION (sim_x9c102_fine) the wipers are moved from their positions, the models
+*    check that the relative moves end at the taps of the step values. With WIPER_RESYNC (sim_x9c102_resync) noise
+*    moves both wipers after the scenario, the idle resync has to bring them back to the step values.
+*
+*    Build: pio run -e sim_x9c102 (POTENTIOMETER_TICK can be overridden with PLATFORMIO_BUILD_FLAGS)
+*    Usage: program [VCD_FILE] - optional waveform of the potentiometer lines
+*    Exit code: 0 - no violation and all wiper positions as expected, 1 otherwise
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <Arduino.h>
+#include "EEPROMStore.h"
+#include "X9C102_model.h"
+#include "vcd_recorder.h"
+#include "X9C102_potentiometer.h"
+#include "protocol.h"
+#include "vu_levels.h"
+#include "main.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define SCENARIO_COMMAND_PERIOD_MS  (250)
+#define SCENARIO_SETTLE_MS          (1000)
+#define SCENARIO_LEGACY_ADDRESS     (uint16_t)(0x1C5) /* First release record: RAM address of its store object */
+#define SCENARIO_LEGACY_LEFT        (uint8_t)(7)
+#define SCENARIO_LEGACY_RIGHT       (uint8_t)(9)
+#define SCENARIO_NOISE_STEPS        (int8_t)(3)       /* Wiper drift injected before the idle resync */
+#define SCENARIO_RESYNC_MS          (15000)           /* Both ramps after the idle period */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+struct ScenarioStep
+{
+  const char *name;
+  uint32_t raw_data;
+};
+
+static const ScenarioStep scenario[] = {
+  {"select right", SELECT_RIGHT_CHANNEL_CMD_RAW},
+  {"up", INCREASE_VU_VALUE_CMD_RAW},
+  {"up", INCREASE_VU_VALUE_CMD_RAW},
+  {"down", DECREASE_VU_VALUE_CMD_RAW},
+  {"select left", SELECT_LEFT_CHANNEL_CMD_RAW},
+  {"down", DECREASE_VU_VALUE_CMD_RAW},
+  {"down", DECREASE_VU_VALUE_CMD_RAW},
+  {"coarse down", DECREASE_VU_VALUE_COARSE_CMD_RAW},
+  {"coarse up", INCREASE_VU_VALUE_COARSE_CMD_RAW},
+  {"coarse up", INCREASE_VU_VALUE_COARSE_CMD_RAW},
+  {"commit", COMMIT_CHANGES_CMD_RAW},
+  {"select right", SELECT_RIGHT_CHANNEL_CMD_RAW},
+  {"up", INCREASE_VU_VALUE_CMD_RAW},
+  {"commit", COMMIT_CHANGES_CMD_RAW},
+  {"factory reset", FACTORY_RESET_VU_VAL_CMD_RAW},
+};
+
+extern EEPROMStore<ChannelsConfiguration, CONFIGURATION_EEPROM_ADDRESS> Configuration;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static void runUntil(uint64_t time_ns)
+{
+  while (hal::now_ns() < time_ns) {
+    loop();
+    hal::advance_ns(hal::timing.loop_overhead_ns);
+  }
+}
+
+/**
+ * @brief Function returns the tap of a stored channel value (LEVEL_CALIBRATION: through the level table)
+ * @param argument: uint8_t channel
+ * @retval uint8_t
+ */
+static uint8_t storedTap(uint8_t channel)
+{
+  uint8_t value = Configuration.Data.channel_step_value[channel];
+
+#if (LEVEL_CALIBRATION == STD_ON)
+  return VuLevels<VuConfig>::tap(channel, value);
+#else
+  return value;
+#endif
+}
+
+/**
+ * @brief Function compares the wiper positions with the stored channel step values. The right channel is set
+ *        with DIRECTION_UP (wiper = step value), the left one with DIRECTION_DOWN (wiper = last tap - step value)
+ * @param argument: const X9C102Model &left, const X9C102Model &right
+ * @retval bool - true when both wipers are where expected
+ */
+static bool checkWipers(const X9C102Model &left, const X9C102Model &right)
+{
+  uint8_t left_expected = (uint8_t)(X9C102_TAPS - 1 - storedTap(LEFT_CHANNEL_INDEX));
+  uint8_t right_expected = storedTap(RIGHT_CHANNEL_INDEX);
+  bool ok_f = (left.wiper() == left_expected) && (right.wiper() == right_expected);
+
+  if (!ok_f) {
+    printf("  wiper mismatch: left %u (expected %u), right %u (expected %u)\n",
+           left.wiper(), left_expected, right.wiper(), right_expected);
+  }
+
+  return ok_f;
+}
+
+static void printCommand(const char *name, const X9C102Model &left, const X9C102Model &right, uint64_t command_ns)
+{
+  const X9C102Model &model = (left.windowSteps() > 0 && left.lastStepNs() > right.lastStepNs()) ? left : right;
+  uint32_t steps = left.windowSteps() + right.windowSteps();
+
+  if (steps == 0) {
+    printf("%-14s\n", name);
+    return;
+  }
+
+  uint64_t first_step_ns = model.windowFirstStepNs();
+
+  if (left.windowSteps() > 0 && right.windowSteps() > 0) {
+    first_step_ns = (left.windowFirstStepNs() < right.windowFirstStepNs()) ? left.windowFirstStepNs()
+                                                                           : right.windowFirstStepNs();
+  }
+
+  printf("%-14s steps %3lu, pulse train %7.3f ms (%.2f us/step), settle %8.3f ms\n", name, (unsigned long)steps,
+         (double)(model.lastStepNs() - first_step_ns) / 1e6,
+         (double)(model.lastStepNs() - first_step_ns) / 1e3 / (steps > 1 ? steps - 1 : 1),
+         (double)(model.lastStepNs() - command_ns) / 1e6);
+}
+
+static void printModel(const X9C102Model &model)
+{
+  printf("%-6s wiper %2u, stored %2u, steps %lu (%lu saturated), stores %lu, violations:",
+         model.name(), model.wiper(), model.storedWiper(), (unsigned long)model.steps(),
+         (unsigned long)model.saturatedSteps(), (unsigned long)model.storeCount());
+
+  for (uint8_t i = 0; i < X9C102_VIOLATION_COUNT; i++) {
+    printf(" %s=%lu", X9C102Model::violationName((X9C102Violation)i),
+           (unsigned long)model.violations((X9C102Violation)i));
+  }
+
+  printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+  const X9C102Pins left_pins = {LEFT_CHANNEL, INC_POTENTIOMETER_GPIO, UD_POTENTIOMETER_GPIO};
+  const X9C102Pins right_pins = {RIGHT_CHANNEL, INC_POTENTIOMETER_GPIO, UD_POTENTIOMETER_GPIO};
+  X9C102Model left("left", left_pins);
+  X9C102Model right("right", right_pins);
+  VcdRecorder vcd;
+  bool ok_f = true;
+
+  hal::serialSetSink(NULL);
+
+  if (argc > 1) {
+    vcd.setPinName(LEFT_CHANNEL, "CS_LEFT");
+    vcd.setPinName(RIGHT_CHANNEL, "CS_RIGHT");
+    vcd.setPinName(INC_POTENTIOMETER_GPIO, "INC");
+    vcd.setPinName(UD_POTENTIOMETER_GPIO, "UD");
+
+    if (!vcd.open(argv[1])) {
+      printf("%s can not be created\n", argv[1]);
+      return 1;
+    }
+  }
+
+  printf("POTENTIOMETER_TICK %d us\n", POTENTIOMETER_TICK);
+
+  /* Record of the first release (checksum, left and right taps), no record of the current format */
+  const uint16_t legacy_checksum = _crc16_update(_crc16_update(0, SCENARIO_LEGACY_LEFT), SCENARIO_LEGACY_RIGHT);
+
+  hal::eepromWrite(SCENARIO_LEGACY_ADDRESS, (uint8_t)legacy_checksum);
+  hal::eepromWrite(SCENARIO_LEGACY_ADDRESS + 1, (uint8_t)(legacy_checksum >> 8));
+  hal::eepromWrite(SCENARIO_LEGACY_ADDRESS + 2, SCENARIO_LEGACY_LEFT);
+  hal::eepromWrite(SCENARIO_LEGACY_ADDRESS + 3, SCENARIO_LEGACY_RIGHT);
+
+  uint64_t boot_start_ns = hal::now_ns();
+  setup();
+  printf("%-14s %8.3f ms\n", "boot", (double)(hal::now_ns() - boot_start_ns) / 1e6);
+
+  EEPROMStore<ChannelsConfiguration, CONFIGURATION_EEPROM_ADDRESS> converted;
+
+  if (!converted.Begin() || converted.Data.version != CONFIGURATION_VERSION || converted.Data.scale != CHANNEL_SCALE ||
+      memcmp(converted.Data.channel_step_value, Configuration.Data.channel_step_value, VU_CHANNEL_COUNT) != 0) {
+    printf("  first release record not converted\n");
+    ok_f = false;
+  }
+
+#if (LEVEL_CALIBRATION == STD_OFF)
+  if (Configuration.Data.channel_step_value[LEFT_CHANNEL_INDEX] != SCENARIO_LEGACY_LEFT ||
+      Configuration.Data.channel_step_value[RIGHT_CHANNEL_INDEX] != SCENARIO_LEGACY_RIGHT) {
+    printf("  first release step values not kept\n");
+    ok_f = false;
+  }
+#endif
+
+  if (INIT_POTENTIOMETERS_WITH_EEPROM_VAL == STD_ON) {
+    ok_f = checkWipers(left, right) && ok_f;
+  }
+
+  uint64_t command_ns = hal::now_ns();
+
+  for (size_t i = 0; i < sizeof(scenario) / sizeof(scenario[0]); i++) {
+    left.startWindow();
+    right.startWindow();
+
+    command_ns += (uint64_t)SCENARIO_COMMAND_PERIOD_MS * 1000000ULL;
+    hal::irInject(scenario[i].raw_data, command_ns);
+    runUntil(command_ns + (uint64_t)SCENARIO_COMMAND_PERIOD_MS * 1000000ULL / 2);
+
+    printCommand(scenario[i].name, left, right, command_ns);
+
+    if (scenario[i].raw_data == COMMIT_CHANGES_CMD_RAW || scenario[i].raw_data == FACTORY_RESET_VU_VAL_CMD_RAW) {
+      ok_f = checkWipers(left, right) && ok_f;
+    }
+  }
+
+  runUntil(hal::now_ns() + (uint64_t)SCENARIO_SETTLE_MS * 1000000ULL);
+
+#if (WIPER_RESYNC == STD_ON)
+  left.injectNoise(SCENARIO_NOISE_STEPS);
+  right.injectNoise(-SCENARIO_NOISE_STEPS);
+  left.startWindow();
+  right.startWindow();
+
+  runUntil(hal::now_ns() + ((uint64_t)WIPER_RESYNC_IDLE + SCENARIO_RESYNC_MS) * 1000000ULL);
+  printf("%-14s steps %3lu\n", "idle resync", (unsigned long)(left.windowSteps() + right.windowSteps()));
+  ok_f = checkWipers(left, right) && ok_f;
+#endif
+
+  printModel(left);
+  printModel(right);
+
+  if (left.totalViolations() != 0 || right.totalViolations() != 0) {
+    ok_f = false;
+  }
+
+  printf("%s\n", ok_f ? "PASS" : "FAIL");
+
+  return ok_f ? 0 : 1;
+}
@@ -21,6 +21,17 @@
 
 #include "X9C102_potentiometer.h"
 
+/**
+ * @brief Constructor for X9C102_potentiometer object, the pins are set by potentiometerInit(UD, INC)
+ * @param argument: None
+ * @retval None
+ */
+X9C102_potentiometer::X9C102_potentiometer()
+{
+    _UD = 0;
+    _INC = 0;
+}
+
 /**
  * @brief Constructor for X9C102_potentiometer object
  * @param argument: uint8_t UD, uint8_t INC
@@ -33,33 +44,41 @@ X9C102_potentiometer::X9C102_potentiometer(uint8_t UD, uint8_t INC)
 }
 
 /**
- * @brief Function implements the value reset of the X9C102 digital potentiometer
+ * @brief Function implements the value reset of the X9C102 digital potentiometer, INC is left low
  * @param argument: None
  * @retval None
  */
 void X9C102_potentiometer::resetValue()
 {
+#if (POTENTIOMETER_HW_PULSES == STD_ON)
+    INCtimerPulses(POTENTIOMETER_RESOLUTION);
+#else
     for (size_t i = 0; i < POTENTIOMETER_RESOLUTION; i++) {
-        digitalWrite(_INC, 0x0);
-        delayMicroseconds(POTENTIOMETER_TICK);
         digitalWrite(_INC, 0x1);
         delayMicroseconds(POTENTIOMETER_TICK);
+        digitalWrite(_INC, 0x0);                /* Falling edge: one wiper step */
+        delayMicroseconds(POTENTIOMETER_TICK);
     }
+#endif
 }
 
 /**
- * @brief Function implements the value set of the X9C102 digital potentiometer
+ * @brief Function implements the value set of the X9C102 digital potentiometer, INC is left low after a pulse
  * @param argument: uint8_t val
  * @retval None
  */
 void X9C102_potentiometer::setValue(uint8_t val)
 {
+#if (POTENTIOMETER_HW_PULSES == STD_ON)
+    INCtimerPulses(val);
+#else
     for (size_t i = 0; i < val; i++) {
-        digitalWrite(_INC, 0x0);
-        delayMicroseconds(POTENTIOMETER_TICK);
         digitalWrite(_INC, 0x1);
         delayMicroseconds(POTENTIOMETER_TICK);
+        digitalWrite(_INC, 0x0);                /* Falling edge: one wiper step */
+        delayMicroseconds(POTENTIOMETER_TICK);
     }
+#endif
 }
 
 /**
@@ -69,12 +88,31 @@ void X9C102_potentiometer::setValue(uint8_t val)
  */
 void X9C102_potentiometer::potentiometerInit()
 {
+    /* INC idles high between the transactions, the pulses leave it low until the CS lines are released */
+    digitalWrite(_INC, 0x1);
     pinMode(_UD, 0x1);
     pinMode(_INC, 0x1);
+
+#if (POTENTIOMETER_HW_PULSES == STD_ON)
+    INCtimerInit();                             /* INC is OC1A, see inc_timer_LL.h */
+#endif
 }
 
 /**
- * @brief Function implements the public interface for setting the X9C102 digital potentiometer value
+ * @brief Function implements the initialization of the X9C102 digital potentiometer on the given pins
+ * @param argument: uint8_t UD, uint8_t INC
+ * @retval None
+ */
+void X9C102_potentiometer::potentiometerInit(uint8_t UD, uint8_t INC)
+{
+    _UD = UD;
+    _INC = INC;
+    potentiometerInit();
+}
+
+/**
+ * @brief Function implements the public interface for setting the X9C102 digital potentiometer value. INC is left
+ *        low: releasing CS now does not store the wiper, potentiometerIdle() drives INC high after the release
  * @param argument: uint8_t val, potentiometer_direction dir
  * @retval None
  */
@@ -99,4 +137,48 @@ void X9C102_potentiometer::potentiometerSetVal(uint8_t val, potentiometer_direct
     }
 
     setValue(val);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Function moves the wiper of the selected X9C102 from the value "from" to the value "to" with |to - from|
+ *        pulses, the wiper has to be at "from". The value keeps the meaning of potentiometerSetVal(): the wiper is
+ *        the value (DIRECTION_UP) or the last tap minus the value (DIRECTION_DOWN). A "to" beyond the last tap
+ *        pushes the wiper against the end stop, the X9C102 ignores the extra pulses. INC is left low as by
+ *        potentiometerSetVal()
+ * @param argument: uint8_t from, uint8_t to, potentiometer_direction dir
+ * @retval None
+ */
+void X9C102_potentiometer::potentiometerStepVal(uint8_t from, uint8_t to, potentiometer_direction dir)
+{
+    bool wiper_up_f = (to > from);
+
+    switch (dir) {
+
+    case DIRECTION_UP: /* for right channel*/
+        digitalWrite(_UD, wiper_up_f ? 0x1 : 0x0);
+        break;
+
+    case DIRECTION_DOWN: /* for left channel*/
+        digitalWrite(_UD, wiper_up_f ? 0x0 : 0x1);
+        break;
+
+    default:
+        return;
+    }
+
+    setValue(wiper_up_f ? (uint8_t)(to - from) : (uint8_t)(from - to));
+}
+
+/**
+ * @brief Function drives INC back to its idle level (high) after a transaction, the CS lines have to be released
+ * @param argument: None
+ * @retval None
+ */
+void X9C102_potentiometer::potentiometerIdle()
+{
+#if (POTENTIOMETER_HW_PULSES == STD_ON)
+    INCtimerIdle();
+#else
+    digitalWrite(_INC, 0x1);
+#endif
+}
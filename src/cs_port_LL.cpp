@@ -21,6 +21,37 @@
 
 #include "cs_port_LL.h"
 
+#if (CS_FANOUT == STD_OFF)
+static_assert(VU_CHANNEL_COUNT >= 1 && VU_CHANNEL_COUNT <= 2, "more than 2 channels need CS_FANOUT");
+#else
+static_assert(VU_CHANNEL_COUNT >= 1 && VU_CHANNEL_COUNT <= CS_FANOUT_MAX_CHANNELS, "74HC595 has 8 outputs");
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+static uint8_t cs_fanout_selected;              /* Channels with the CS line driven low */
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+* @brief Function shifts the CS state out to the 74HC595 and latches it to the outputs (active low)
+* @param argument: uint8_t selected - channel mask
+* @retval None
+*/
+static void CSfanoutWrite(uint8_t selected)
+{
+    SPDR = (uint8_t)~selected;
+    while (!(SPSR & (1 << SPIF))) {
+    }
+
+    PORTD |= CS_FANOUT_LATCH_MASK;              /* RCLK rising edge: shift register -> outputs */
+    PORTD &= (uint8_t)~CS_FANOUT_LATCH_MASK;
+}
+#endif
+
 /**
 * @brief Function implements the low level GPIO port initialization for CS lines
 * @param argument: None
@@ -28,42 +59,84 @@
 */
 void CSportInit(void)
 {
+#if (CS_FANOUT == STD_OFF)
+    /* Set ports initial value as 1 (no potentiometer selected) before the output is enabled, so the lines do not
+       glitch low. Before the DDR bits are set this only turns on the pull-ups */
+    AllChipSelect::release();
+
     /* Config ports as OUTPUT*/
-    DDRC = DDRC | B11000000;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        DDRC |= PORTC_BITMASK;
+    }
+#else
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        /* Latch low, SPI pins as OUTPUT (SS has to be an output in the master mode) */
+        PORTD &= (uint8_t)~CS_FANOUT_LATCH_MASK;
+        DDRD |= CS_FANOUT_LATCH_MASK;
+        DDRB |= CS_FANOUT_SPI_BITMASK;
+
+        /* SPI master, mode 0, MSB first, fosc/2 */
+        SPCR = (uint8_t)((1 << SPE) | (1 << MSTR));
+        SPSR = (uint8_t)(1 << SPI2X);
 
-    /* Set ports initial value as 1 (no potentiometer selected)*/
-    PORTC = PORTC | B11000000; // 7bit - PC7 - Right channel; 6bit - PC6 - Left channel
+        /* No potentiometer selected */
+        cs_fanout_selected = 0;
+        CSfanoutWrite(cs_fanout_selected);
+    }
+#endif
 }
 
 /**
-* @brief Function implements the low level GPIO port manipulation for CS lines (set its state)
-* @param argument: None
+* @brief Function drives the CS lines of the given channels low (selected), the other lines are kept
+* @param argument: uint8_t channel_mask
+* @retval None
+*/
+void CSportSelect(uint8_t channel_mask)
+{
+    channel_mask &= ALL_CHANNELS_MASK;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+#if (CS_FANOUT == STD_OFF)
+        PORTC &= (uint8_t)~CSportMask(channel_mask);
+#else
+        cs_fanout_selected |= channel_mask;
+        CSfanoutWrite(cs_fanout_selected);
+#endif
+    }
+}
+
+/**
+* @brief Function drives the CS lines of the given channels high (released), the other lines are kept
+* @param argument: uint8_t channel_mask
 * @retval None
 */
-void CSportSet(uint8_t state)
+void CSportRelease(uint8_t channel_mask)
 {
-    switch (state) {
-    /*Left channel selected*/
-    case 0:
-        /* code */
-        PORTC =  B01000000; 
-        break;
-    
-    /*Right channel selected*/
-    case 1:
-        PORTC =  B10000000; 
-        break;
-    
-    /*Release CS lines*/
-    case 2:
-        PORTC =  B11000000;
-        break;
-
-    case 3:
-        PORTC = B00000000; 
-        break;
-    
-    default:
-        break;
+    channel_mask &= ALL_CHANNELS_MASK;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+#if (CS_FANOUT == STD_OFF)
+        PORTC |= CSportMask(channel_mask);
+#else
+        cs_fanout_selected &= (uint8_t)~channel_mask;
+        CSfanoutWrite(cs_fanout_selected);
+#endif
     }
 }
+
+/**
+* @brief Function returns the channels with the CS line selected
+* @param argument: None
+* @retval uint8_t - channel mask
+*/
+uint8_t CSportSelected(void)
+{
+#if (CS_FANOUT == STD_OFF)
+    uint8_t port = (uint8_t)~PORTC;
+
+    return (uint8_t)(((port & CS_LEFT_CHANNEL_MASK) ? CHANNEL_MASK(LEFT_CHANNEL_INDEX) : 0) |
+                     ((port & CS_RIGHT_CHANNEL_MASK) ? CHANNEL_MASK(RIGHT_CHANNEL_INDEX) : 0)) & ALL_CHANNELS_MASK;
+#else
+    return cs_fanout_selected;
+#endif
+}
@@ -0,0 +1,226 @@
+/**
+**********************************************************************************************************************
+*    @file           : hid_control.cpp
+*    @brief          : hid_control.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Implements the USB HID control interface: descriptors, HID class requests and the report transfer
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "hid_control.h"
+
+#if (USB_HID_CONTROL == STD_ON)
+
+#include <string.h>
+#include <util/atomic.h>
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+static const uint8_t report_descriptor[] PROGMEM = {
+  0x05, 0x0C,                                   /* Usage Page (Consumer) */
+  0x09, 0x01,                                   /* Usage (Consumer Control) */
+  0xA1, 0x01,                                   /* Collection (Application) */
+  0x85, HID_CONTROL_REPORT_CONSUMER,            /*   Report ID */
+  0x15, 0x00,                                   /*   Logical Minimum (0) */
+  0x26, 0xFF, 0x03,                             /*   Logical Maximum (0x3FF) */
+  0x19, 0x00,                                   /*   Usage Minimum (0) */
+  0x2A, 0xFF, 0x03,                             /*   Usage Maximum (0x3FF) */
+  0x75, 0x10,                                   /*   Report Size (16) */
+  0x95, 0x01,                                   /*   Report Count (1) */
+  0x91, 0x00,                                   /*   Output (Data, Array, Absolute) */
+  0x06, 0x00, 0xFF,                             /*   Usage Page (Vendor Defined 0xFF00) */
+  0x26, 0xFF, 0x00,                             /*   Logical Maximum (255) */
+  0x75, 0x08,                                   /*   Report Size (8) */
+  0x85, HID_CONTROL_REPORT_LEVELS,              /*   Report ID */
+  0x09, 0x01,                                   /*   Usage (levels) */
+  0x95, VU_CHANNEL_COUNT,                       /*   Report Count */
+  0x91, 0x02,                                   /*   Output (Data, Variable, Absolute) */
+  0x85, HID_CONTROL_REPORT_PRESET,              /*   Report ID */
+  0x09, 0x02,                                   /*   Usage (preset) */
+  0x95, 0x02,                                   /*   Report Count (action, slot) */
+  0x91, 0x02,                                   /*   Output (Data, Variable, Absolute) */
+  0x85, HID_CONTROL_REPORT_STATE,               /*   Report ID */
+  0x09, 0x03,                                   /*   Usage (state) */
+  0x95, 1 + VU_CHANNEL_COUNT,                   /*   Report Count (status, values) */
+  0x81, 0x02,                                   /*   Input (Data, Variable, Absolute) */
+  0xC0                                          /* End Collection */
+};
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Constructor for HidControl object. Plugs the module: the USB descriptors have to be complete before the
+ *        core attaches the device, which happens before setup()
+ * @param argument: None
+ * @retval None
+ */
+HidControl::HidControl()
+  : PluggableUSBModule(2, 1, _endpoint_type), _endpoint_type{EP_TYPE_INTERRUPT_IN, EP_TYPE_INTERRUPT_OUT},
+    _idle(0), _protocol(1), _state{HID_CONTROL_REPORT_STATE}, _control_length(0), _control_report()
+{
+  PluggableUSB().plug(this);
+}
+
+/**
+ * @brief Function sends the interface, HID class and endpoint descriptors (configuration descriptor)
+ * @param argument: uint8_t *interface_count
+ * @retval int - sent bytes, -1 on error
+ */
+int HidControl::getInterface(uint8_t *interface_count)
+{
+  *interface_count += 1;
+
+  HidControlDescriptor descriptor = {
+    D_INTERFACE(pluggedInterface, 2, USB_DEVICE_CLASS_HUMAN_INTERFACE, 0, 0),
+    {9, HID_CONTROL_DESCRIPTOR_TYPE, 0x11, 0x01, 0, 1, HID_CONTROL_REPORT_DESCRIPTOR_TYPE,
+     (uint8_t)sizeof(report_descriptor), (uint8_t)(sizeof(report_descriptor) >> 8)},
+    D_ENDPOINT(USB_ENDPOINT_IN(pluggedEndpoint), USB_ENDPOINT_TYPE_INTERRUPT, USB_EP_SIZE, 1),
+    D_ENDPOINT(USB_ENDPOINT_OUT(pluggedEndpoint + 1), USB_ENDPOINT_TYPE_INTERRUPT, USB_EP_SIZE, 1)
+  };
+
+  return USB_SendControl(0, &descriptor, sizeof(descriptor));
+}
+
+/**
+ * @brief Function sends the report descriptor (standard GET_DESCRIPTOR of the interface)
+ * @param argument: USBSetup &setup
+ * @retval int - sent bytes, 0 if the request is not for this module
+ */
+int HidControl::getDescriptor(USBSetup &setup)
+{
+  if (setup.bmRequestType != REQUEST_DEVICETOHOST_STANDARD_INTERFACE ||
+      setup.wValueH != HID_CONTROL_REPORT_DESCRIPTOR_TYPE || setup.wIndex != pluggedInterface) {
+    return 0;
+  }
+
+  return USB_SendControl(TRANSFER_PGM, report_descriptor, sizeof(report_descriptor));
+}
+
+/**
+ * @brief Function handles the HID class requests, called from the USB interrupt
+ * @param argument: USBSetup &setup
+ * @retval bool - true if the request is handled, otherwise it is stalled
+ */
+bool HidControl::setup(USBSetup &setup)
+{
+  if (setup.wIndex != pluggedInterface) {
+    return false;
+  }
+
+  if (setup.bmRequestType == REQUEST_DEVICETOHOST_CLASS_INTERFACE) {
+    switch (setup.bRequest) {
+    case HID_CONTROL_GET_REPORT:
+      return USB_SendControl(0, _state, sizeof(_state)) >= 0;
+
+    case HID_CONTROL_GET_IDLE:
+      return USB_SendControl(0, &_idle, 1) >= 0;
+
+    case HID_CONTROL_GET_PROTOCOL:
+      return USB_SendControl(0, &_protocol, 1) >= 0;
+
+    default:
+      return false;
+    }
+  }
+
+  if (setup.bmRequestType == REQUEST_HOSTTODEVICE_CLASS_INTERFACE) {
+    switch (setup.bRequest) {
+    case HID_CONTROL_SET_IDLE:
+      _idle = setup.wValueH;
+      return true;
+
+    case HID_CONTROL_SET_PROTOCOL:
+      _protocol = setup.wValueL;
+      return true;
+
+    case HID_CONTROL_SET_REPORT: {
+      /* A report not taken by read() yet is replaced, like an unread IR frame */
+      const uint16_t size = (setup.wLength < sizeof(_control_report)) ? setup.wLength : sizeof(_control_report);
+      int length = USB_RecvControl(_control_report, size);
+
+      _control_length = (length > 0) ? (uint8_t)length : 0;
+      return length >= 0;
+    }
+
+    default:
+      return false;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief Function takes the next output report: SET_REPORT first, then the interrupt OUT endpoint. The part of
+ *        an OUT packet beyond HID_CONTROL_MAX_REPORT_SIZE is dropped
+ * @param argument: uint8_t *report - HID_CONTROL_MAX_REPORT_SIZE bytes, report ID first
+ * @retval uint8_t - report length, 0 if no report was received
+ */
+uint8_t HidControl::read(uint8_t *report)
+{
+  uint8_t length = 0;
+
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    length = _control_length;
+    memcpy(report, _control_report, length);
+    _control_length = 0;
+  }
+
+  if (length != 0) {
+    return length;
+  }
+
+  const uint8_t endpoint = (uint8_t)(pluggedEndpoint + 1);
+  const uint8_t available = USB_Available(endpoint);
+
+  if (available == 0) {
+    return 0;
+  }
+
+  length = (available < HID_CONTROL_MAX_REPORT_SIZE) ? available : (uint8_t)HID_CONTROL_MAX_REPORT_SIZE;
+  USB_Recv(endpoint, report, length);
+
+  while (USB_Available(endpoint) != 0) {
+    USB_Recv(endpoint);
+  }
+
+  return length;
+}
+
+/**
+ * @brief Function sends the state input report. It is dropped when the host does not poll the IN endpoint (no
+ *        reader), USB_Send() would block the main loop otherwise
+ * @param argument: uint8_t status, const uint8_t *values - VU_CHANNEL_COUNT channel values
+ * @retval bool - true if the report was sent
+ */
+bool HidControl::sendState(uint8_t status, const uint8_t *values)
+{
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    _state[1] = status;
+    memcpy(&_state[2], values, VU_CHANNEL_COUNT);
+  }
+
+  if (USB_SendSpace(pluggedEndpoint) < sizeof(_state)) {
+    return false;
+  }
+
+  return USB_Send(pluggedEndpoint | TRANSFER_RELEASE, _state, sizeof(_state)) == (int)sizeof(_state);
+}
+
+#endif
@@ -0,0 +1,147 @@
+/**
+**********************************************************************************************************************
+*    @file           : inc_timer_LL.cpp
+*    @brief          : inc_timer_LL.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Implements the X9C102 INC pulse generation by the Timer1 output compare
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "inc_timer_LL.h"
+
+#if (POTENTIOMETER_HW_PULSES == STD_ON)
+
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <util/atomic.h>
+
+static_assert(INC_POTENTIOMETER_GPIO == 9, "hardware INC pulses need INC on OC1A (pin 9)");
+static_assert(INC_TIMER_HALF_PERIOD > INC_TIMER_MIN_LEAD, "POTENTIOMETER_HW_TICK must be at least 2 us");
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+static volatile uint16_t inc_edges_left;        /* OC1A edges until the end of the burst, 0 - idle */
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+* @brief Timer1 compare match ISR: counts the OC1A edge made by the hardware and arms the next one
+* @param argument: None
+* @retval None
+*/
+ISR(TIMER1_COMPA_vect)
+{
+    if (--inc_edges_left == 0) {
+        TIMSK1 &= (uint8_t)~(1 << OCIE1A);
+        TCCR1B = 0;                             /* Timer stopped */
+        PORTB &= (uint8_t)~INC_TIMER_OC1A_MASK; /* OC1A is low: level of INC when it is disconnected */
+        TCCR1A = 0;                             /* OC1A disconnected, PB5 back to PORTB (low) */
+        return;
+    }
+
+    /* Half a period after the last edge, at least INC_TIMER_MIN_LEAD from now when the ISR was late: a compare
+       value already passed would hold the edge for a whole counter wrap */
+    uint16_t next = (uint16_t)(OCR1A + INC_TIMER_HALF_PERIOD);
+    uint16_t now = TCNT1;
+
+    if ((int16_t)(next - now) < (int16_t)INC_TIMER_MIN_LEAD) {
+        next = (uint16_t)(now + INC_TIMER_MIN_LEAD);
+    }
+
+    OCR1A = next;
+}
+
+/**
+* @brief Function implements the Timer1 initialization for the INC pulses: timer stopped, OC1A forced high and
+*        disconnected. Has to be called with the INC pin configured as output and no CS line selected.
+* @param argument: None
+* @retval None
+*/
+void INCtimerInit(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        TIMSK1 &= (uint8_t)~(1 << OCIE1A);
+        TCCR1B = 0;
+        PORTB |= INC_TIMER_OC1A_MASK;
+        TCCR1A = (uint8_t)((1 << COM1A1) | (1 << COM1A0));    /* Set OC1A on compare match ... */
+        TCCR1C = (uint8_t)(1 << FOC1A);                       /* ... forced now */
+        TCCR1A = 0;
+        inc_edges_left = 0;
+    }
+
+    set_sleep_mode(SLEEP_MODE_IDLE);
+}
+
+/**
+* @brief Function generates count INC falling edges (one wiper step each) and returns after the last one, INC is
+*        left low. The CPU sleeps in the idle mode meanwhile. Has to be called with the interrupts enabled.
+* @param argument: uint16_t count
+* @retval None
+*/
+void INCtimerPulses(uint16_t count)
+{
+    if (count == 0) {
+        return;
+    }
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        /* From high the first edge is already a falling one */
+        inc_edges_left = (uint16_t)(2 * count - ((PORTB & INC_TIMER_OC1A_MASK) ? 1 : 0));
+        TCNT1 = 0;
+        OCR1A = INC_TIMER_HALF_PERIOD;
+        TIFR1 = (uint8_t)(1 << OCF1A);
+        TIMSK1 |= (uint8_t)(1 << OCIE1A);
+        TCCR1A = (uint8_t)(1 << COM1A0);        /* Toggle OC1A on compare match, OC1A is at the INC level */
+        TCCR1B = (uint8_t)(1 << CS10);          /* Normal mode, clk/1 */
+    }
+
+    /* Idle sleep until the ISR has made the last edge. The instruction after SEI is executed before any interrupt,
+       so an interrupt between the check and the sleep can not be lost */
+    for (;;) {
+        cli();
+
+        if (inc_edges_left == 0) {
+            sei();
+            break;
+        }
+
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+}
+
+/**
+* @brief Function drives INC back high after a burst, OC1A is forced high first. Has to be called with no CS line
+*        selected.
+* @param argument: None
+* @retval None
+*/
+void INCtimerIdle(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        TCCR1A = (uint8_t)((1 << COM1A1) | (1 << COM1A0));    /* Set OC1A on compare match ... */
+        TCCR1C = (uint8_t)(1 << FOC1A);                       /* ... forced now */
+        PORTB |= INC_TIMER_OC1A_MASK;
+        TCCR1A = 0;
+    }
+}
+
+#endif
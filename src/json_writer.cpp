@@ -0,0 +1,157 @@
+/**
+**********************************************************************************************************************
+*    @file           : json_writer.cpp
+*    @brief          : json_writer.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Implements the minimal streaming JSON writer for flat objects
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "json_writer.h"
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Constructor for JsonWriter object
+ * @param argument: Print &sink - output stream
+ * @retval None
+ */
+JsonWriter::JsonWriter(Print &sink) : _sink(sink), _first_f(true)
+{
+}
+
+/**
+ * @brief Function writes the member separator (if needed) and the quoted key followed by colon
+ * @param argument: const __FlashStringHelper *name - key stored in flash
+ * @retval None
+ */
+void JsonWriter::key(const __FlashStringHelper *name)
+{
+  if (!_first_f) {
+    _sink.write(',');
+  }
+
+  _first_f = false;
+
+  _sink.write('"');
+  _sink.print(name);
+  _sink.write('"');
+  _sink.write(':');
+}
+
+/**
+ * @brief Function opens the JSON object
+ * @param argument: None
+ * @retval None
+ */
+void JsonWriter::beginObject(void)
+{
+  _first_f = true;
+  _sink.write('{');
+}
+
+/**
+ * @brief Function writes the integer member
+ * @param argument: const __FlashStringHelper *name, long value
+ * @retval None
+ */
+void JsonWriter::add(const __FlashStringHelper *name, long value)
+{
+  key(name);
+  _sink.print(value);
+}
+
+/**
+ * @brief Function writes the unsigned integer member
+ * @param argument: const __FlashStringHelper *name, unsigned long value
+ * @retval None
+ */
+void JsonWriter::add(const __FlashStringHelper *name, unsigned long value)
+{
+  key(name);
+  _sink.print(value);
+}
+
+/**
+ * @brief Function writes the integer member
+ * @param argument: const __FlashStringHelper *name, int value
+ * @retval None
+ */
+void JsonWriter::add(const __FlashStringHelper *name, int value)
+{
+  add(name, (long)value);
+}
+
+/**
+ * @brief Function writes the unsigned integer member
+ * @param argument: const __FlashStringHelper *name, unsigned int value
+ * @retval None
+ */
+void JsonWriter::add(const __FlashStringHelper *name, unsigned int value)
+{
+  add(name, (unsigned long)value);
+}
+
+/**
+ * @brief Function writes the boolean member
+ * @param argument: const __FlashStringHelper *name, bool value
+ * @retval None
+ */
+void JsonWriter::add(const __FlashStringHelper *name, bool value)
+{
+  key(name);
+  _sink.print(value ? F("true") : F("false"));
+}
+
+/**
+ * @brief Function writes the string member. Quote, backslash and control characters are escaped.
+ * @param argument: const __FlashStringHelper *name, const char *value
+ * @retval None
+ */
+void JsonWriter::add(const __FlashStringHelper *name, const char *value)
+{
+  key(name);
+  _sink.write('"');
+
+  for (; *value != '\0'; value++) {
+    char c = *value;
+
+    if (c == '"' || c == '\\') {
+      _sink.write('\\');
+      _sink.write(c);
+    } else if ((uint8_t)c < 0x20) {
+      _sink.print(F("\\u00"));
+      _sink.write("0123456789abcdef"[(c >> 4) & 0x0F]);
+      _sink.write("0123456789abcdef"[c & 0x0F]);
+    } else {
+      _sink.write(c);
+    }
+  }
+
+  _sink.write('"');
+}
+
+/**
+ * @brief Function closes the JSON object and terminates the line (one object per line)
+ * @param argument: None
+ * @retval None
+ */
+void JsonWriter::endObject(void)
+{
+  _sink.write('}');
+  _sink.println();
+}
@@ -32,15 +32,13 @@
 #include "IRremote.h"
 #include "cs_port_LL.h"
 #include "protocol.h"
+#include "vu_controller.h"
+#include "avr/wdt.h"
 
 #if (DEBUG_PRINTER == STD_ON || SOFTWARE_SERIAL_DEBUG == STD_ON)
 #include "platform.h"
 #endif
 
-#if (AVR_WDT_ENABLE == STD_ON)
-#include "avr/wdt.h"
-#endif
-
 #include "main.h"
 /*********************************************************************************************************************/
 /*------------------------------------------------------Macros-------------------------------------------------------*/
@@ -49,21 +47,35 @@
 /* Serial log setup*/
 #if (DEBUG_PRINTER == STD_ON && SOFTWARE_SERIAL_DEBUG == STD_OFF)
 
+#include "debug_log.h"
+
+DebugLogBuffer<DEBUG_LOG_BUFFER_SIZE, DEBUG_LOG_DROP_POLICY> debugLog;
+
 #define DEBUG_SETUP(baudrate) Serial.begin(baudrate)
-#define DEBUG(string) Serial.print(string)
-#define DEBUG_NL(string_nln) Serial.println(string_nln)
+#define DEBUG(string) do { debugLog.beginRecord(); debugLog.print(string); debugLog.endRecord(); } while (0)
+#define DEBUG_NL(string_nln) \
+  do { debugLog.beginRecord(); debugLog.println(string_nln); debugLog.endRecord(); } while (0)
+#define DEBUG_DRAIN() debugLog.drain(Serial, DEBUG_LOG_DRAIN_BUDGET)
+#define DEBUG_ROOM() debugLog.room()
+#define DEBUG_OVERFLOW_COUNT() debugLog.getOverflowCount()
 
 #pragma message("Hardware serial debug enabled")
 
 #elif (DEBUG_PRINTER == STD_ON && SOFTWARE_SERIAL_DEBUG == STD_ON)
 
 #include "SoftwareSerial.h"
+#include "debug_log.h"
 
 SoftwareSerial softSerial(DEBUG_RX, DEBUG_TX);
+DebugLogBuffer<DEBUG_LOG_BUFFER_SIZE, DEBUG_LOG_DROP_POLICY> debugLog;
 
 #define DEBUG_SETUP(baudrate) softSerial.begin(baudrate)
-#define DEBUG(string) softSerial.print(string)
-#define DEBUG_NL(string_nln) softSerial.println(string_nln)
+#define DEBUG(string) do { debugLog.beginRecord(); debugLog.print(string); debugLog.endRecord(); } while (0)
+#define DEBUG_NL(string_nln) \
+  do { debugLog.beginRecord(); debugLog.println(string_nln); debugLog.endRecord(); } while (0)
+#define DEBUG_DRAIN() debugLog.drain(softSerial, DEBUG_LOG_DRAIN_BUDGET)   /* SoftwareSerial blocks IRQs per byte */
+#define DEBUG_ROOM() debugLog.room()
+#define DEBUG_OVERFLOW_COUNT() debugLog.getOverflowCount()
 
 #pragma message("Software serial debug enabled")
 
@@ -72,42 +84,228 @@ SoftwareSerial softSerial(DEBUG_RX, DEBUG_TX);
 #define DEBUG_SETUP(baudrate)
 #define DEBUG(string)
 #define DEBUG_NL(string_nln)
+#define DEBUG_DRAIN()
+#define DEBUG_ROOM() (DEBUG_LOG_BUFFER_SIZE)
+#define DEBUG_OVERFLOW_COUNT() (0)
 #pragma message("Debug disabled")
 
 #endif
 
+/* USB serial output setup: with the hardware serial debug the telemetry, console and profiler records share the port
+   with the debug output, they go through the debug buffer as whole records and wait for its room*/
+#if (DEBUG_PRINTER == STD_ON && SOFTWARE_SERIAL_DEBUG == STD_OFF)
+
+#define SERIAL_OUT debugLog
+#define SERIAL_OUT_ROOM() debugLog.room()
+#define SERIAL_RECORD_BEGIN() debugLog.beginRecord()
+#define SERIAL_RECORD_END() debugLog.endRecord()
+
+#else
+
+#define SERIAL_OUT Serial
+#define SERIAL_OUT_ROOM() (UINT8_MAX)
+#define SERIAL_RECORD_BEGIN()
+#define SERIAL_RECORD_END()
+
+#endif
+
+/* Log sites setup (format strings use "{}" placeholders, see deferred_log.h)*/
+#if (DEBUG_PRINTER == STD_ON && DEBUG_LOG_DEFERRED == STD_ON)
+
+#include "deferred_log.h"
+
+TelemetryWriter logTelemetry(debugLog);
+
+#define LOG(format, ...) logEmit(logTelemetry, LogId<logId(format)>::value, ##__VA_ARGS__)
+
+#pragma message("Deferred log formatting enabled")
+
+#elif (DEBUG_PRINTER == STD_ON)
+
+#include "deferred_log.h"
+
+#define LOG(format, ...) \
+  do { debugLog.beginRecord(); logPrint(debugLog, F(format), ##__VA_ARGS__); debugLog.endRecord(); } while (0)
+
+#else
+
+#define LOG(format, ...)
+
+#endif
+
 /*********************************************************************************************************************/
 /*------------------------------------------------------Classes------------------------------------------------------*/
 /*********************************************************************************************************************/
 
-IRrecv irreciver(RECEIVER_GPIO);
-X9C102_potentiometer potentiometer(UD_POTENTIOMETER_GPIO, INC_POTENTIOMETER_GPIO);
+/* The device objects do no work in their constructors, setup() initializes them in a defined order */
+IRrecv irreciver;
+X9C102_potentiometer potentiometer;
 
-EEPROMStore<ChannelsConfiguration> Configuration;
+EEPROMStore<ChannelsConfiguration, CONFIGURATION_EEPROM_ADDRESS> Configuration;
 
 #if(ARDUINO_PROFILER == STD_ON && DEBUG_PRINTER == STD_ON)
 
 #include "Profiler.h"
-#include "ArduinoJson-v6.19.4.h"
+
+#if (PROFILER_OUTPUT_FORMAT == PROFILER_OUTPUT_JSON)
+#include "json_writer.h"
+#endif
 
 Profiler profiler;
 
 #endif
 
+#if ((ARDUINO_PROFILER == STD_ON && DEBUG_PRINTER == STD_ON) || SAMPLING_PROFILER == STD_ON || \
+     SERIAL_CONSOLE == STD_ON)
+
+#include "telemetry.h"
+
+TelemetryWriter telemetry(SERIAL_OUT);
+
+#endif
+
+#if (SERIAL_CONSOLE == STD_ON || USB_HID_CONTROL == STD_ON || UNIT_BUS == STD_ON)
+
+#include "serial_console.h"
+
+EEPROMStore<PresetsConfiguration, PRESET_EEPROM_ADDRESS> Presets;
+
+static_assert(CONFIGURATION_EEPROM_ADDRESS + EEPROMStore<ChannelsConfiguration, CONFIGURATION_EEPROM_ADDRESS>::
+              StorageSize <= PRESET_EEPROM_ADDRESS, "presets overlap the configuration record");
+
+#endif
+
+#if (SERIAL_CONSOLE == STD_ON || UNIT_BUS == STD_ON)
+
+static uint16_t ir_command_count = 0;                              /* Accepted IR frames, command statistics */
+
+#endif
+
+#if (SERIAL_CONSOLE == STD_ON)
+
+ConsoleReader console;
+
+static_assert(TELEMETRY_HEADER_SIZE + 14 + 2 * VU_CHANNEL_COUNT + TELEMETRY_CRC_SIZE <= TELEMETRY_MAX_RECORD_SIZE,
+              "console stats response beyond the telemetry record");
+
+#endif
+
+#if (USB_HID_CONTROL == STD_ON)
+
+#include "hid_control.h"
+
+HidControl hidControl;                                             /* Plugged before setup(), see hid_control.h */
+
+#endif
+
+#if (UNIT_BUS == STD_ON)
+
+#include "unit_bus.h"
+
+UnitBusNode unitBus(UNIT_BUS_ADDRESS);
+
+static_assert(UNIT_BUS_ADDRESS >= 0 && UNIT_BUS_ADDRESS < UNIT_BUS_BROADCAST, "unit bus address out of range");
+static_assert(UNIT_BUS_HEADER_SIZE + 11 + 2 * VU_CHANNEL_COUNT + CONSOLE_CRC_SIZE <= UNIT_BUS_MAX_FRAME_SIZE,
+              "unit bus stats response beyond the frame");
+static_assert(VU_CHANNEL_COUNT <= CONSOLE_BATCH_MAX, "mirrored channels beyond the batch");
+
+#endif
+
+#if (SAMPLING_PROFILER == STD_ON)
+
+#include "SamplingProfiler.h"
+
+SamplingProfiler samplingProfiler;
+
+/* IRremote receives with its Timer3 tick on the ATmega32U4, the sampler takes Timer4 */
+#if defined(IR_USE_AVR_TIMER4_HS)
+#error "SAMPLING_PROFILER uses Timer4, IRremote must keep Timer3 (IR_USE_AVR_TIMER4_HS)"
+#endif
+static_assert(SAMPLING_PROFILER_PERIOD_US <= SAMPLING_PROFILER_MAX_PERIOD_US, "sampling period beyond Timer4 range");
+
+#endif
+
+#if (DEBUG_PRINTER == STD_ON || SOFTWARE_SERIAL_DEBUG == STD_ON)
+
+#define SYSTEM_INFO_SECTION_SIZE (uint8_t)(112)                    /* Worst case size of one system info section */
+#define SYSTEM_INFO_CHANNEL_STEP (uint8_t)(19)                     /* First EEPROM channel value section */
+#define SYSTEM_INFO_LAST_STEP    (uint8_t)(SYSTEM_INFO_CHANNEL_STEP + VU_CHANNEL_COUNT - 1)
+
+static uint8_t system_info_step = 0;                               /* 0 - idle, otherwise next section to print */
+
+#endif
+
+#if (DEBUG_PRINTER == STD_ON && DEBUG_IR_FULL_INFO == STD_ON)
+
+#define IR_INFO_SECTION_SIZE     (uint8_t)(112)                    /* Worst case size of one IR info section */
+#define IR_INFO_RAW_PER_SECTION  (uint8_t)(8)                      /* Raw timings per section, 9 characters each */
+
+enum irInfoStep
+{
+  IR_INFO_IDLE = 0,
+  IR_INFO_BASIC,
+  IR_INFO_RAW_HEADER,
+  IR_INFO_RAW,
+  IR_INFO_C_VARIABLES
+};
+
+static uint8_t ir_info_step = IR_INFO_IDLE;                        /* Next section of the received frame to print */
+static uint8_t ir_info_raw_index = 0;                              /* Next raw timing to print */
+
+#endif
+
 /*********************************************************************************************************************/
 /*------------------------------------------------Function Prototypes------------------------------------------------*/
 /*********************************************************************************************************************/
 
-static void potentiometerChannelSelect(int option);
-static bool storeEepromConfig(uint8_t left_channel_value, uint8_t right_channel_value);
+static bool configurationLoad(void);
+static bool storeEepromConfig(const uint8_t *channel_values);
+static void eepromContentLog(void);
+static void irCommandLog(irCommandResult result);
 static void irDataReceive(void);
+static void wiperResyncTask(void);
+
+#if (SAMPLING_PROFILER == STD_ON)
+static void samplingProfilerCommand(bool start_f);
+static void samplingProfilerTask(void);
+#endif
+
+#if (SERIAL_CONSOLE == STD_ON || USB_HID_CONTROL == STD_ON || UNIT_BUS == STD_ON)
+static consoleStatus presetStore(uint8_t slot);
+static consoleStatus presetRecall(uint8_t slot);
+#endif
+
+#if (SERIAL_CONSOLE == STD_ON || UNIT_BUS == STD_ON)
+template <class TWriter>
+static void commandExecute(TWriter &writer, const ConsoleReader &reader, uint8_t command, const uint8_t *payload,
+                           uint8_t length);
+#endif
+
+#if (SERIAL_CONSOLE == STD_ON)
+static void consoleExecute(void);
+static void consoleTask(void);
+#endif
+
+#if (USB_HID_CONTROL == STD_ON)
+static uint32_t hidUsageCommand(uint16_t usage);
+static void hidControlTask(void);
+#endif
+
+#if (UNIT_BUS == STD_ON)
+static void unitBusTransmit(void);
+static void unitBusExecute(void);
+static void unitBusMirror(irCommandResult result);
+static void unitBusTask(void);
+#endif
 
 #if(DEBUG_PRINTER == STD_ON || SOFTWARE_SERIAL_DEBUG == STD_ON)
 static void showSystemInfo(void);
+static void systemInfoTask(void);
 #endif
 
 #if (DEBUG_PRINTER == STD_ON && DEBUG_IR_FULL_INFO == STD_ON)
 static void irReceiveCmdInfo();
+static void irInfoTask(void);
 #endif
 
 /*********************************************************************************************************************/
@@ -116,117 +314,218 @@ static void irReceiveCmdInfo();
 
 #if (DEBUG_PRINTER == STD_ON || SOFTWARE_SERIAL_DEBUG == STD_ON)
 /**
- * @brief This function prints system info via UART
+ * @brief This function requests the system info print. The info is printed by systemInfoTask() section by section,
+ *        so the debug TX buffer is never overflowed and the main loop is not blocked
  * @param argument: None
  * @retval None
  */
 static void showSystemInfo(void)
 {
+  system_info_step = 1;
+}
 
-  DEBUG_NL("=====PLATFORM INFO START=====");
+/**
+ * @brief This function prints the next system info section via UART, when the debug TX buffer has enough room
+ * @param argument: None
+ * @retval None
+ */
+static void systemInfoTask(void)
+{
+  if (system_info_step == 0 || DEBUG_ROOM() < SYSTEM_INFO_SECTION_SIZE) {
+    return;
+  }
 
-  DEBUG("[MCU]: ");
-  DEBUG_NL(MCU);
+  switch (system_info_step++) {
+  case 1:
+    LOG("=====PLATFORM INFO START=====");
+    break;
 
-  DEBUG("[FIRMWARE VERSION]: ");
-  DEBUG_NL(FIRMWARE_VERSION);
+  case 2:
+    LOG("[MCU]: {}", F(MCU));
+    break;
 
-  DEBUG("[DEVICE DESCRIPTION]: ");
-  DEBUG_NL(DEVICE_DESCRIPTION);
+  case 3:
+    LOG("[FIRMWARE VERSION]: {}", F(FIRMWARE_VERSION));
+    break;
 
-  DEBUG("[EEPROM VOLUME]: ");
-  DEBUG(EEPROM_VOLUME);
-  DEBUG_NL(" bytes");
+  case 4:
+    LOG("[DEVICE DESCRIPTION]: {}", F(DEVICE_DESCRIPTION));
+    break;
 
-  DEBUG("[FLASH VOLUME]: ");
-  DEBUG(FLASH_VOLUME);
-  DEBUG_NL(" bytes");
+  case 5:
+    LOG("[EEPROM VOLUME]: {} bytes", EEPROM_VOLUME);
+    break;
+
+  case 6:
+    LOG("[FLASH VOLUME]: {} bytes", FLASH_VOLUME);
+    break;
 
-  DEBUG("[RAM VOLUME]: ");
-  DEBUG(RAM_VOLUME);
-  DEBUG_NL(" bytes");
+  case 7:
+    LOG("[RAM VOLUME]: {} bytes", RAM_VOLUME);
+    break;
 
-  DEBUG("[POTENTIOMETER RESOLUTION]");
-  DEBUG(POTENTIOMETER_RESOLUTION);
-  DEBUG_NL(" KOhm");
+  case 8:
+    LOG("[POTENTIOMETER RESOLUTION]{} KOhm", POTENTIOMETER_RESOLUTION);
+    break;
 
-  DEBUG("[POTENTIOMETER MAX RESISTANCE]: ");
-  DEBUG(MAX_RESISTANCE);
-  DEBUG_NL(" KOhm");
+  case 9:
+    LOG("[POTENTIOMETER MAX RESISTANCE]: {} KOhm", MAX_RESISTANCE);
+    break;
 
-  DEBUG("[POTENTIOMETER MIN RESISTANCE]: ");
-  DEBUG(MIN_RESISTANCE);
-  DEBUG_NL(" KOhm");
+  case 10:
+    LOG("[POTENTIOMETER MIN RESISTANCE]: {} KOhm", MIN_RESISTANCE);
+    break;
 
 #if (AVR_WDT_ENABLE == STD_ON)
-  DEBUG_NL("[OPTION]: Watchdog timer: [ENABLED]");
-  DEBUG("[OPTION]: Watchdog config: ");
-  DEBUG_NL(WDT_TRIGGER_TIME);
+  case 11:
+    LOG("[OPTION]: Watchdog timer: [ENABLED]");
+    LOG("[OPTION]: Watchdog config: {}", WDT_TRIGGER_TIME);
+    break;
 #endif
 
 #if (DEBUG_PRINTER == STD_ON)
-  DEBUG_NL("[OPTION]: USB Debug printer: [ENABLED]");
+  case 12:
+    LOG("[OPTION]: USB Debug printer: [ENABLED]");
+    break;
 #endif
 
 #if (SOFTWARE_SERIAL_DEBUG == STD_ON)
-  DEBUG_NL("[OPTION]: Software serial Debug printer: [ENABLED]");
+  case 13:
+    LOG("[OPTION]: Software serial Debug printer: [ENABLED]");
+    break;
 #endif
 
 #if (INIT_POTENTIOMETERS_WITH_EEPROM_VAL == STD_ON)
-  DEBUG_NL("[OPTION]: Potentiometer initialization from EEPROM: [ENABLED]");
-
-  DEBUG("[OPTION]: Current EEPROM value for Left channel: ");
-  DEBUG_NL(Configuration.Data.channel_left_step_value);
-
-  DEBUG("[OPTION]: Current EEPROM value for Right channel: ");
-  DEBUG_NL(Configuration.Data.channel_right_step_value);
+  case 14:
+    LOG("[OPTION]: Potentiometer initialization from EEPROM: [ENABLED]");
+    break;
 #endif
 
 #if (EEPROM_CHECK_TASK_ENABLE == STD_ON)
-  DEBUG_NL("[OPTION]: EEPROM memory check task: [ENABLED]");
+  case 16:
+    LOG("[OPTION]: EEPROM memory check task: [ENABLED]");
+    break;
 #endif
 
 #if (ARDUINO_PROFILER == STD_ON)
-  DEBUG_NL("[OPTION]: Arduino profiler: [ENABLED]");
+  case 17:
+    LOG("[OPTION]: Arduino profiler: [ENABLED]");
+    break;
+#endif
+
+  case 18:
+    LOG("[DEBUG LOG OVERFLOW]: {} records", DEBUG_OVERFLOW_COUNT());
+    break;
+
+  default:
+#if (INIT_POTENTIOMETERS_WITH_EEPROM_VAL == STD_ON)
+    /* One section per channel, the channel count is a build option */
+    if (system_info_step > SYSTEM_INFO_CHANNEL_STEP && system_info_step <= SYSTEM_INFO_LAST_STEP + 1) {
+      uint8_t channel = (uint8_t)(system_info_step - SYSTEM_INFO_CHANNEL_STEP - 1);
+
+      LOG("[OPTION]: Current EEPROM value for channel {}: {}", channel,
+          Configuration.Data.channel_step_value[channel]);
+    }
 #endif
 
+    if (system_info_step > SYSTEM_INFO_LAST_STEP) {           /* Compiled out sections are just skipped */
+      system_info_step = 0;
+    }
+    break;
+  }
 }
 
 #endif
 
 #if (DEBUG_PRINTER == STD_ON && DEBUG_IR_FULL_INFO == STD_ON)
 /**
- * @brief Function implements the received IR data parsing. Mainly used for the debug
+ * @brief Function implements the received IR data parsing. Mainly used for the debug. The frame is printed by
+ *        irInfoTask() section by section, the receiver is resumed after the last one (the raw timings stay valid)
  * @param argument: None
  * @retval None
  */
 static void irReceiveCmdInfo()
 {
-  if (irreciver.decode()) {
+  if (ir_info_step == IR_INFO_IDLE && irreciver.decode()) {
+    ir_info_step = IR_INFO_BASIC;
+    ir_info_raw_index = 0;
+  }
+}
+
+/**
+ * @brief Function prints the next IR info section, when the debug TX buffer has enough room. The raw dump is longer
+ *        than the buffer, it is printed IR_INFO_RAW_PER_SECTION timings per section
+ * @param argument: None
+ * @retval None
+ */
+static void irInfoTask(void)
+{
+  if (ir_info_step == IR_INFO_IDLE || DEBUG_ROOM() < IR_INFO_SECTION_SIZE) {
+    return;
+  }
+
+  const irparams_struct *raw = irreciver.decodedIRData.rawDataPtr;
+
+  switch (ir_info_step) {
+  case IR_INFO_BASIC:
     DEBUG_NL("Basic info:");
-    irreciver.printIRResultMinimal(&Serial);
-    DEBUG_NL();
-    DEBUG_NL("Basic raw format:");
-    irreciver.printIRResultRawFormatted(&Serial);
-    DEBUG_NL();
+    debugLog.beginRecord();
+    irreciver.printIRResultMinimal(&debugLog);
+    debugLog.println();
+    debugLog.endRecord();
+    ir_info_step = IR_INFO_RAW_HEADER;
+    break;
+
+  case IR_INFO_RAW_HEADER:
+    debugLog.beginRecord();
+    debugLog.print(F("Basic raw format: rawData["));
+    debugLog.print((unsigned int)raw->rawlen);
+    debugLog.println(F("]:"));
+    debugLog.endRecord();
+    ir_info_step = IR_INFO_RAW;
+    break;
+
+  case IR_INFO_RAW:
+    debugLog.beginRecord();
+
+    /* rawbuf[0] is the gap before the frame, then mark and space in turn */
+    for (uint8_t i = 0; i < IR_INFO_RAW_PER_SECTION && ir_info_raw_index < raw->rawlen; i++) {
+      debugLog.print((ir_info_raw_index & 1) ? '+' : '-');
+      debugLog.print((unsigned long)raw->rawbuf[ir_info_raw_index++] * MICROS_PER_TICK);
+      debugLog.print(' ');
+    }
+
+    debugLog.println();
+    debugLog.endRecord();
+
+    if (ir_info_raw_index >= raw->rawlen) {
+      ir_info_step = IR_INFO_C_VARIABLES;
+    }
+    break;
+
+  default:
     DEBUG_NL("Result as a C variable:");
-    irreciver.printIRResultAsCVariables(&Serial);
-    DEBUG_NL();
+    debugLog.beginRecord();
+    irreciver.printIRResultAsCVariables(&debugLog);
+    debugLog.println();
+    debugLog.endRecord();
+    ir_info_step = IR_INFO_IDLE;
+    irreciver.resume();
+    break;
   }
-
-  irreciver.resume();
 }
 #endif
 
 /**
  * @brief Function implements the EEPROM config storage and returns status after EEPROM write
- * @param argument: uint8_t left_channel_value, uint8_t right_channel_value
+ * @param argument: const uint8_t *channel_values - VU_CHANNEL_COUNT step values
  * @retval None
  */
-static bool storeEepromConfig(uint8_t left_channel_value, uint8_t right_channel_value)
+static bool storeEepromConfig(const uint8_t *channel_values)
 {
-  Configuration.Data.channel_left_step_value = left_channel_value;
-  Configuration.Data.channel_right_step_value = right_channel_value;
+  for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+    Configuration.Data.channel_step_value[channel] = channel_values[channel];
+  }
 
   bool eeprom_status_f = Configuration.Save();
 
@@ -234,250 +533,791 @@ static bool storeEepromConfig(uint8_t left_channel_value, uint8_t right_channel_
 }
 
 /**
- * @brief Function implements the selection mechanism for left and Right channel potentiometers
- * @param argument: int option
+ * @brief Function loads the EEPROM configuration. Without a valid record the record of the first release is searched
+ *        for, converted and stored at CONFIGURATION_EEPROM_ADDRESS, without both the defaults are kept. A record of a
+ *        newer version is not read. Step values of the other scale (taps or calibrated levels) are converted to the
+ *        one of this build
+ * @param argument: None
+ * @retval bool - true if a valid record was loaded
+ */
+static bool configurationLoad(void)
+{
+  bool valid_f = Configuration.Begin();
+
+  if (valid_f && Configuration.Data.version > CONFIGURATION_VERSION) {
+    Configuration.Reset();
+    valid_f = false;
+  }
+
+  if (!valid_f) {
+    ChannelsConfigurationLegacy legacy;
+
+    if (!EEPROMLegacyLoad(legacy)) {
+      return false;
+    }
+
+    Configuration.Data.scale = CHANNEL_SCALE_TAPS;
+
+    for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+      Configuration.Data.channel_step_value[channel] = POTETNIOMETER_RESET_VALUE;
+    }
+
+    Configuration.Data.channel_step_value[LEFT_CHANNEL_INDEX] = legacy.channel_left_step_value;
+#if (VU_CHANNEL_COUNT > 1)
+    Configuration.Data.channel_step_value[RIGHT_CHANNEL_INDEX] = legacy.channel_right_step_value;
+#endif
+
+    LOG("[BOOT]: first release EEPROM record converted");
+  }
+
+  if (Configuration.Data.scale != CHANNEL_SCALE) {
+    for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+      uint8_t value = Configuration.Data.channel_step_value[channel];
+
+      if constexpr (VuConfig::level_calibration) {
+        value = VuLevels<VuConfig>::levelOfTap(channel, value);
+      } else {
+        const uint8_t last_level = (uint8_t)(VuLevels<VuConfig>::level_count - 1);
+
+        value = VuLevels<VuConfig>::tap(channel, (value < last_level) ? value : last_level);
+      }
+
+      Configuration.Data.channel_step_value[channel] = value;
+    }
+
+    Configuration.Data.scale = CHANNEL_SCALE;
+  }
+
+  Configuration.Data.version = CONFIGURATION_VERSION;
+
+  if (!valid_f) {
+    Configuration.Save();
+  }
+
+  return true;
+}
+
+/*Command back end of the device: X9C102 potentiometers (one CS transaction per write) and EEPROM configuration*/
+class DeviceCommandBackend
+{
+private:
+  uint32_t _store_time = 0;                     /* millis() of the last wiper store */
+
+public:
+  void potentiometerSetVal(uint8_t channel_mask, uint8_t val, potentiometer_direction dir)
+  {
+    potentiometer.potentiometerTransaction(channel_mask, val, dir);
+  }
+
+  void potentiometerStepVal(uint8_t channel_mask, uint8_t from, uint8_t to, potentiometer_direction dir)
+  {
+    potentiometer.potentiometerStepTransaction(channel_mask, from, to, dir);
+  }
+
+  void potentiometerStore(uint8_t channel_mask)
+  {
+    potentiometer.potentiometerStoreTransaction(channel_mask);
+    _store_time = millis();
+  }
+
+  /* The X9C102 ignores CS during the store cycle. IR commands come slower, host commands wait in the USB buffers */
+  bool potentiometerReady(uint32_t time) const
+  {
+    return (time - _store_time) > POTENTIOMETER_STORE_TIME;
+  }
+
+  bool storeConfig(const uint8_t *channel_values)
+  {
+    return storeEepromConfig(channel_values);
+  }
+};
+
+static DeviceCommandBackend commandBackend;
+static VuController<VuConfig, DeviceCommandBackend> controller(commandBackend);
+
+/**
+ * @brief Function prints the stored step value of every channel
+ * @param argument: None
  * @retval None
  */
-static void potentiometerChannelSelect(int option)
+static void eepromContentLog(void)
 {
-  switch (option) {
-  case LEFT_CHANNEL_SELECT:
-    CSportSet(LEFT_CHANNEL_SELECT);
+  for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+    LOG("EEPROM storage content: channel {} step value: {}", channel, Configuration.Data.channel_step_value[channel]);
+  }
+}
+
+/**
+ * @brief Function prints the result of the processed IR command
+ * @param argument: irCommandResult result
+ * @retval None
+ */
+static void irCommandLog(irCommandResult result)
+{
+  switch (result) {
+  case IR_CMD_RIGHT_CHANNEL_SELECTED:
+    LOG("[CMD received]: Right channel selected, channel {}", controller.selectedChannel());
+    break;
+
+  case IR_CMD_LEFT_CHANNEL_SELECTED:
+    LOG("[CMD received]: Left channel selected, channel {}", controller.selectedChannel());
     break;
 
-  case RIGHT_CHANNEL_SELECT:
-    CSportSet(RIGHT_CHANNEL_SELECT);
+  case IR_CMD_COMMIT_STORED:
+    LOG("[CMD received]: Changes commited");
+    LOG("Configuration stored in eeprom");
+    eepromContentLog();
     break;
 
-  case RELEASE_CHANNELS_CS_LINES: /*release the potentiometer CS line to avoid sporadic value change*/
-    CSportSet(RELEASE_CHANNELS_CS_LINES);
+  case IR_CMD_COMMIT_UNCHANGED:
+    LOG("[CMD received]: Changes commited");
+    LOG("EEPROM data did not changed");
     break;
 
-  case SELECT_ALL_CS_CHANNELS:
-    CSportSet(SELECT_ALL_CS_CHANNELS);
+  case IR_CMD_VALUE_UP:
+  case IR_CMD_VALUE_DOWN:
+    if (result == IR_CMD_VALUE_UP) {
+      LOG("[CMD received]: VU value UP");
+    } else {
+      LOG("[CMD received]: VU value DOWN");
+    }
+
+    LOG("Channel {} step value: {}", controller.selectedChannel(),
+        controller.channelValue(controller.selectedChannel()));
+#if (LEVEL_CALIBRATION == STD_ON)
+    LOG("Channel {} level: {} x0.01 dB, tap: {}", controller.selectedChannel(),
+        VuLevels<VuConfig>::levelCdb(controller.channelValue(controller.selectedChannel())),
+        controller.channelTap(controller.selectedChannel()));
+#endif
+    break;
+
+  case IR_CMD_VALUE_LIMIT:
+    LOG("[CMD received]: VU value at the limit or no channel selected");
+    break;
+
+  case IR_CMD_FACTORY_RESET_STORED:
+    LOG("Factory reset potentiometer values");
+    eepromContentLog();
+    break;
+
+  case IR_CMD_FACTORY_RESET_UNCHANGED:
+    LOG("EEPROM Factory reset");
+    LOG("EEPROM data did not changed");
+    break;
+
+  case IR_CMD_EEPROM_CHECK_STORED:
+    LOG("EEPROM Check task");
+    LOG("EEPROM stored");
+    eepromContentLog();
+    break;
+
+  case IR_CMD_EEPROM_CHECK_UNCHANGED:
+    LOG("EEPROM Check task");
+    LOG("EEPROM data did not changed");
+    break;
+
+/*Debug info*/
+#if (DEBUG_PRINTER == STD_ON || SOFTWARE_SERIAL_DEBUG == STD_ON)
+  case IR_CMD_DEBUG_INFO:
+    showSystemInfo();
+    break;
+#endif
+
+  case IR_CMD_EEPROM_CHECK_IDLE:
     break;
 
   default:
+    LOG("[CMD received]: Unknown command");
     break;
   }
 }
 
 /**
- * @brief Function implements the reception of the IR CMD and contains its processing logic
+ * @brief Function implements the reception of the IR CMD, the processing logic is VuController
  * @param argument: None
  * @retval None
  */
 static void irDataReceive(void)
 {
-  static uint8_t left_channel_value = Configuration.Data.channel_left_step_value;
-  static uint8_t right_channel_value = Configuration.Data.channel_right_step_value;
-  static uint8_t channel_select_f = CHANNEL_SELECTION_IDLE_F;
+  if (irreciver.decode()) {
+
+    if (irreciver.decodedIRData.protocol != UNKNOWN) {
+#if (DEBUG_PRINTER == STD_ON)
+      static bool first_frame_f = true;
 
-  /* should be tested */
-  if (right_channel_value < POTENTIOMETER_LOW_BOUNDRY) {
-    right_channel_value = POTENTIOMETER_LOW_BOUNDRY;
+      if (first_frame_f) {
+        first_frame_f = false;
+        LOG("[BOOT]: first IR frame accepted at {} ms", millis());
+      }
+#endif
+      const irCommandResult result = controller.dispatch(irreciver.decodedIRData.decodedRawData, millis());
+
+      irCommandLog(result);
+#if (SERIAL_CONSOLE == STD_ON || UNIT_BUS == STD_ON)
+      ++ir_command_count;
+#endif
+#if (UNIT_BUS == STD_ON)
+      unitBusMirror(result);
+#endif
+    } else {
+      LOG("Unknown protocol");
+    }
   }
 
-  if (left_channel_value < POTENTIOMETER_LOW_BOUNDRY) {
-    left_channel_value = POTENTIOMETER_LOW_BOUNDRY;
+/**
+ * EEPROM check task
+ * This task checks the EEPROM values every 5 minutes
+ * This task should re-write EEPROM with actual potentiometer values
+ * in case if EEPROM will not be updated by pressing "OK" button
+*/
+  if constexpr (VuConfig::eeprom_check_task) {
+    irCommandLog(controller.eepromCheck(millis()));
   }
 
-  if (irreciver.decode()) {
+  irreciver.resume();
+}
 
-    if (irreciver.decodedIRData.protocol != UNKNOWN) {
-      uint32_t received_cmd = irreciver.decodedIRData.decodedRawData;
+/**
+ * @brief Function implements the idle wiper resync task: one ramp step per call, logs the start and the end
+ * @param argument: None
+ * @retval None
+ */
+static void wiperResyncTask(void)
+{
+  const uint8_t channel = controller.resyncChannel();
 
-      switch (received_cmd) {
-      
-      case SELECT_RIGHT_CHANNEL_CMD_RAW:
-        
-        DEBUG_NL("[CMD received]: Right channel selected");
-
-        channel_select_f = RIGHT_CHANNEL_SELECT_F;
-        potentiometerChannelSelect(RIGHT_CHANNEL_SELECT);
+  switch (controller.wiperResync(millis())) {
+  case IR_CMD_RESYNC_STARTED:
+    LOG("[RESYNC]: channel {} wiper resync started", controller.resyncChannel());
+    break;
 
-        break;
+  case IR_CMD_RESYNC_DONE:
+    LOG("[RESYNC]: channel {} wiper resynced, resyncs: {}", channel, controller.resyncCount(channel));
+    break;
 
-      case SELECT_LEFT_CHANNEL_CMD_RAW:
-        
-        DEBUG_NL("[CMD received]: Left channel selected");
+  default:
+    break;
+  }
 
-        channel_select_f = LEFT_CHANNEL_SELECT_F;
-        potentiometerChannelSelect(LEFT_CHANNEL_SELECT);
+  (void)channel;
+}
 
-        break;
+#if (SAMPLING_PROFILER == STD_ON)
+static bool sampling_profiler_flush_f = false;    /* Last record carries the final dropped samples counter */
 
-      case COMMIT_CHANGES_CMD_RAW:
-        
-        DEBUG_NL("[CMD received]: Changes commited");
+/**
+ * @brief Function starts or stops the sampling profiler, the samples left are sent by samplingProfilerTask()
+ * @param argument: bool start_f
+ * @retval None
+ */
+static void samplingProfilerCommand(bool start_f)
+{
+  if (start_f) {
+    samplingProfiler.start();
+  } else {
+    samplingProfiler.stop();
+    sampling_profiler_flush_f = true;
+  }
+}
 
-        potentiometerChannelSelect(RELEASE_CHANNELS_CS_LINES);
-        channel_select_f = CHANNEL_SELECTION_IDLE_F;
+/**
+ * @brief Function implements the sampling profiler control (start/stop CMD from the USB serial, the console
+ *        command with SERIAL_CONSOLE) and streams the collected PC samples to the host as
+ *        TELEMETRY_RECORD_PROFILER_SAMPLES records
+ * @param argument: None
+ * @retval None
+ */
+static void samplingProfilerTask(void)
+{
+#if (SERIAL_CONSOLE == STD_OFF)
+  while (Serial.available() > 0) {
+    switch (Serial.read()) {
+    case SAMPLING_PROFILER_START_CMD:
+      samplingProfilerCommand(true);
+      break;
+
+    case SAMPLING_PROFILER_STOP_CMD:
+      samplingProfilerCommand(false);
+      break;
+
+    default:
+      break;
+    }
+  }
+#endif
 
-        if (storeEepromConfig(left_channel_value, right_channel_value)) {
-          DEBUG_NL("Configuration stored in eeprom");
-          DEBUG_NL("EEPROM storage content: ");
+  const bool flush_f = sampling_profiler_flush_f;
+  sampling_profiler_flush_f = false;
 
-          DEBUG("Left channel step value: ");
-          DEBUG(Configuration.Data.channel_left_step_value);
-          DEBUG_NL("");
+  uint16_t sample_pc;
+  bool record_open_f = false;
+  bool empty_f = false;
 
-          DEBUG("Right channel step value: ");
-          DEBUG(Configuration.Data.channel_right_step_value);
-          DEBUG_NL("");
-        }
+  /* A record is opened only with room for the whole frame, the other samples wait in the sampler */
+  while (record_open_f || SERIAL_OUT_ROOM() >= TELEMETRY_MAX_FRAME_SIZE) {
+    if (!samplingProfiler.readSample(&sample_pc)) {
+      empty_f = true;
+      break;
+    }
 
-        else {
-          DEBUG_NL("EEPROM data did not changed");
-        }
+    if (!record_open_f) {
+      telemetry.begin(TELEMETRY_RECORD_PROFILER_SAMPLES);
+      telemetry.putU16(samplingProfiler.getDroppedSamples());
+      record_open_f = true;
+    }
 
-        break;
+    telemetry.putU16(sample_pc);
 
-      case INCREASE_VU_VALUE_CMD_RAW:
-        
-        DEBUG_NL("[CMD received]: VU value UP");
+    if (telemetry.remaining() < sizeof(sample_pc)) {
+      telemetry.end();
+      record_open_f = false;
+    }
+  }
 
-        if (channel_select_f == LEFT_CHANNEL_SELECT_F) {
-          --left_channel_value;                         /* Decrease left channel potentiometer value to increase the left channel signal magnitude */
+  if (flush_f && !empty_f) {
+    sampling_profiler_flush_f = true;           /* The final record follows the last samples */
+  } else if (!record_open_f && flush_f) {
+    telemetry.begin(TELEMETRY_RECORD_PROFILER_SAMPLES);
+    telemetry.putU16(samplingProfiler.getDroppedSamples());
+    record_open_f = true;
+  }
 
-          if (left_channel_value >= POTENTIOMETER_LOW_BOUNDRY) {
-            potentiometer.potentiometerSetVal(left_channel_value, DIRECTION_DOWN);
-            DEBUG_NL(left_channel_value);
-          }
+  if (record_open_f) {
+    telemetry.end();
+  }
+}
+#endif
 
-          else {
-            left_channel_value = POTENTIOMETER_LOW_BOUNDRY;
-          }
-        }
+#if (SERIAL_CONSOLE == STD_ON || USB_HID_CONTROL == STD_ON || UNIT_BUS == STD_ON)
+/**
+ * @brief Function stores the current channel values in the preset slot
+ * @param argument: uint8_t slot
+ * @retval consoleStatus - CONSOLE_STATUS_UNCHANGED if the EEPROM slot already holds the values
+ */
+static consoleStatus presetStore(uint8_t slot)
+{
+  if (slot >= PRESET_COUNT) {
+    return CONSOLE_STATUS_BAD_VALUE;
+  }
 
-        if (channel_select_f == RIGHT_CHANNEL_SELECT_F) {
-          --right_channel_value;                        /* Decrease right channel potentiometer value to increase the right channel signal magnitude */
+  for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+    Presets.Data.channel_step_value[slot][channel] = controller.channelValue(channel);
+  }
 
-          if (right_channel_value >= POTENTIOMETER_LOW_BOUNDRY) {
-            potentiometer.potentiometerSetVal(right_channel_value, DIRECTION_UP);
-            DEBUG_NL(right_channel_value);
-          } else {
-            right_channel_value = POTENTIOMETER_LOW_BOUNDRY;
-          }
-        } else {
-          // empty
-        }
+  Presets.Data.used_mask |= (uint8_t)(1U << slot);
 
-        break;
+  return Presets.Save() ? CONSOLE_STATUS_OK : CONSOLE_STATUS_UNCHANGED;
+}
 
-      case DECREASE_VU_VALUE_CMD_RAW:
-        
-        DEBUG_NL("[CMD received]: VU value DOWN");
+/**
+ * @brief Function applies the preset slot to all channels as one transaction (not committed)
+ * @param argument: uint8_t slot
+ * @retval consoleStatus
+ */
+static consoleStatus presetRecall(uint8_t slot)
+{
+  if (slot >= PRESET_COUNT) {
+    return CONSOLE_STATUS_BAD_VALUE;
+  }
 
-        if (channel_select_f == LEFT_CHANNEL_SELECT_F) {
-          ++left_channel_value;                         /* Increase left channel potentiometer value to decrease the left channel signal magnitude */
+  if (!(Presets.Data.used_mask & (1U << slot))) {
+    return CONSOLE_STATUS_EMPTY;
+  }
 
-          if (left_channel_value <= POTENTIOMETER_HIGH_BOUNDRY) {
-            potentiometer.potentiometerSetVal(left_channel_value, DIRECTION_DOWN);
-            DEBUG_NL(left_channel_value);
-          } else {
-            left_channel_value = POTENTIOMETER_HIGH_BOUNDRY;
-          }
-        }
+  uint8_t channels[VU_CHANNEL_COUNT];
 
-        if (channel_select_f == RIGHT_CHANNEL_SELECT_F) {
-          ++right_channel_value;                        /* Increase right channel potentiometer value to decrease the right channel signal magnitude */
+  for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+    channels[channel] = channel;
+  }
 
-          if (right_channel_value <= POTENTIOMETER_HIGH_BOUNDRY) {
-            potentiometer.potentiometerSetVal(right_channel_value, DIRECTION_UP);
-            DEBUG_NL(right_channel_value);
-          } else {
-            right_channel_value = POTENTIOMETER_HIGH_BOUNDRY;
-          }
-        } else {
-          // empty
-        }
+  return controller.setValues(channels, Presets.Data.channel_step_value[slot], VU_CHANNEL_COUNT, millis()) ?
+         CONSOLE_STATUS_OK : CONSOLE_STATUS_BAD_VALUE;
+}
+#endif
 
-        break;
+#if (SERIAL_CONSOLE == STD_ON || UNIT_BUS == STD_ON)
+/**
+ * @brief Function executes a console command and writes the status and the data of the response, shared by the
+ *        serial console and the unit bus
+ * @param argument: TWriter &writer - response (putU8/putU16/putU32), const ConsoleReader &reader - statistics,
+ *                  uint8_t command, const uint8_t *payload, uint8_t length - payload length
+ * @retval None
+ */
+template <class TWriter>
+static void commandExecute(TWriter &writer, const ConsoleReader &reader, uint8_t command, const uint8_t *payload,
+                           uint8_t length)
+{
+  uint8_t status = CONSOLE_STATUS_OK;
 
-      case FACTORY_RESET_VU_VAL_CMD_RAW:
+  switch (command) {
+  case CONSOLE_CMD_SET_LEVEL:
+  case CONSOLE_CMD_SET_BATCH: {
+    const uint8_t pairs = (uint8_t)(length / 2);
 
-        potentiometerChannelSelect(RIGHT_CHANNEL_SELECT);
-        right_channel_value = POTETNIOMETER_RESET_VALUE;
-        potentiometer.potentiometerSetVal(right_channel_value, DIRECTION_UP);
+    if ((length % 2) != 0 || pairs == 0 || pairs > CONSOLE_BATCH_MAX ||
+        (command == CONSOLE_CMD_SET_LEVEL && pairs != 1)) {
+      status = CONSOLE_STATUS_BAD_LENGTH;
+      break;
+    }
 
-        potentiometerChannelSelect(LEFT_CHANNEL_SELECT);
-        left_channel_value = POTETNIOMETER_RESET_VALUE;
-        potentiometer.potentiometerSetVal(left_channel_value, DIRECTION_DOWN);
+    uint8_t channels[CONSOLE_BATCH_MAX];
+    uint8_t values[CONSOLE_BATCH_MAX];
 
-        potentiometerChannelSelect(RELEASE_CHANNELS_CS_LINES);
+    for (uint8_t i = 0; i < pairs; i++) {
+      channels[i] = payload[2 * i];
+      values[i] = payload[2 * i + 1];
+    }
 
-        if (storeEepromConfig(left_channel_value, right_channel_value)) {
-          DEBUG_NL("Factory reset potentiometer values");
-          DEBUG_NL("EEPROM storage content: ");
+    status = controller.setValues(channels, values, pairs, millis()) ? CONSOLE_STATUS_OK : CONSOLE_STATUS_BAD_VALUE;
+    break;
+  }
 
-          DEBUG("Left channel step value: ");
-          DEBUG(Configuration.Data.channel_left_step_value);
-          DEBUG_NL("");
+  case CONSOLE_CMD_QUERY_STATE:
+    writer.putU8(CONSOLE_STATUS_OK);
+    writer.putU8(VU_CHANNEL_COUNT);
+    writer.putU8(CHANNEL_SCALE);
+    writer.putU8(controller.selectedChannel());
+    writer.putU8(controller.value_low);
+    writer.putU8(controller.value_high);
+
+    for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+      writer.putU8(controller.channelValue(channel));
+      writer.putU8(controller.channelTap(channel));
+    }
+    return;
 
-          DEBUG("Right channel step value: ");
-          DEBUG(Configuration.Data.channel_right_step_value);
-          DEBUG_NL("");
+  case CONSOLE_CMD_COMMIT:
+    status = (length != 0) ? CONSOLE_STATUS_BAD_LENGTH :
+             (controller.commit() == IR_CMD_COMMIT_STORED) ? CONSOLE_STATUS_OK : CONSOLE_STATUS_UNCHANGED;
+    break;
 
-        } else {
-          DEBUG_NL("EEPROM Factory reset");
-          DEBUG_NL("EEPROM data did not changed");
-        }
+  case CONSOLE_CMD_PRESET_STORE:
+  case CONSOLE_CMD_PRESET_RECALL:
+    if (length != 1) {
+      status = CONSOLE_STATUS_BAD_LENGTH;
+      break;
+    }
 
-        break;
+    status = (command == CONSOLE_CMD_PRESET_STORE) ? presetStore(payload[0]) : presetRecall(payload[0]);
+    break;
 
+  case CONSOLE_CMD_STATS:
+    writer.putU8(CONSOLE_STATUS_OK);
+    writer.putU32(millis());
+    writer.putU16(ir_command_count);
+    writer.putU16(reader.frames());
+    writer.putU16(reader.errors());
 
-/*Debug info*/
-#if (DEBUG_PRINTER == STD_ON || SOFTWARE_SERIAL_DEBUG == STD_ON)
-      case PRINT_DEBUG_INFO_CMD_RAW:
-        showSystemInfo();
-        break;
+    for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+      writer.putU16(controller.resyncCount(channel));
+    }
+    return;
+
+  case CONSOLE_CMD_PROFILER:
+#if (SAMPLING_PROFILER == STD_ON)
+    if (length != 1) {
+      status = CONSOLE_STATUS_BAD_LENGTH;
+      break;
+    }
+
+    samplingProfilerCommand(payload[0] != 0);
+#else
+    status = CONSOLE_STATUS_UNSUPPORTED;
 #endif
+    break;
 
-      default:
-        DEBUG_NL("[CMD received]: Unknown command");
-        break;
-      }
-    } else {
-      DEBUG_NL("Unknown protocol");
+  default:
+    status = CONSOLE_STATUS_UNKNOWN_COMMAND;
+    break;
+  }
+
+  writer.putU8(status);
+}
+#endif
+
+#if (SERIAL_CONSOLE == STD_ON)
+/**
+ * @brief Function executes the request of the console reader and sends the TELEMETRY_RECORD_CONSOLE response
+ * @param argument: None
+ * @retval None
+ */
+static void consoleExecute(void)
+{
+  telemetry.begin(TELEMETRY_RECORD_CONSOLE);
+  telemetry.putU16(console.requestId());
+  telemetry.putU8(console.command());
+
+  if (console.version() != CONSOLE_VERSION) {
+    telemetry.putU8(CONSOLE_STATUS_BAD_VERSION);
+  } else {
+    commandExecute(telemetry, console, console.command(), console.payload(), console.payloadLength());
+  }
+
+  telemetry.end();
+}
+
+/**
+ * @brief Function implements the serial console task: feeds the received bytes to the console reader and
+ *        executes every complete request. Paused during a wiper store cycle and while the USB serial output has
+ *        no room for a response
+ * @param argument: None
+ * @retval None
+ */
+static void consoleTask(void)
+{
+  while (commandBackend.potentiometerReady(millis()) && SERIAL_OUT_ROOM() >= TELEMETRY_MAX_FRAME_SIZE &&
+         Serial.available() > 0) {
+    if (console.feed((uint8_t)Serial.read())) {
+      consoleExecute();
     }
   }
+}
+#endif
 
+#if (USB_HID_CONTROL == STD_ON)
 /**
- * EEPROM check task
- * This task checks the EEPROM values every 5 minutes
- * This task should re-write EEPROM with actual potentiometer values
- * in case if EEPROM will not be updated by pressing "OK" button
-*/
-#if(EEPROM_CHECK_TASK_ENABLE == STD_ON)
-  static uint32_t old_time_eeprom_check_value = millis();
+ * @brief Function maps a consumer control usage to the IR command of the same remote button
+ * @param argument: uint16_t usage
+ * @retval uint32_t - raw IR command, 0 if the usage is not mapped
+ */
+static uint32_t hidUsageCommand(uint16_t usage)
+{
+  switch (usage) {
+  case HID_USAGE_SCAN_NEXT_TRACK:
+    return SELECT_RIGHT_CHANNEL_CMD_RAW;
+
+  case HID_USAGE_SCAN_PREVIOUS_TRACK:
+    return SELECT_LEFT_CHANNEL_CMD_RAW;
 
-  if ((millis() - old_time_eeprom_check_value) > DELAY_EEPROM_CHECK) {          /* Timer for non-blocking delay */
-    if (storeEepromConfig(left_channel_value, right_channel_value)) {
-      DEBUG_NL("EEPROM Check task");
-      DEBUG_NL("EEPROM stored");
-      DEBUG_NL("EEPROM storage content: ");
+  case HID_USAGE_PLAY_PAUSE:
+    return COMMIT_CHANGES_CMD_RAW;
 
-      DEBUG("Left channel step value: ");
-      DEBUG(Configuration.Data.channel_left_step_value);
-      DEBUG_NL("");
+  case HID_USAGE_VOLUME_INCREMENT:
+    return INCREASE_VU_VALUE_CMD_RAW;
+
+  case HID_USAGE_VOLUME_DECREMENT:
+    return DECREASE_VU_VALUE_CMD_RAW;
+
+  case HID_USAGE_FAST_FORWARD:
+    return INCREASE_VU_VALUE_COARSE_CMD_RAW;
+
+  case HID_USAGE_REWIND:
+    return DECREASE_VU_VALUE_COARSE_CMD_RAW;
+
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief Function implements the USB HID control task: executes the received output report and answers with the
+ *        state input report. Consumer usages go through the IR command dispatcher, as a button of the remote
+ * @param argument: None
+ * @retval None
+ */
+static void hidControlTask(void)
+{
+  uint8_t report[HID_CONTROL_MAX_REPORT_SIZE];
+  consoleStatus status = CONSOLE_STATUS_OK;
+
+  if (!commandBackend.potentiometerReady(millis())) {
+    return;                                     /* The OUT endpoint NAKs the next report meanwhile */
+  }
 
-      DEBUG("Right channel step value: ");
-      DEBUG(Configuration.Data.channel_right_step_value);
-      DEBUG_NL("");
+  const uint8_t length = hidControl.read(report);
 
+  if (length == 0) {
+    return;
+  }
+
+  switch (report[0]) {
+  case HID_CONTROL_REPORT_CONSUMER: {
+    if (length != HID_CONTROL_CONSUMER_SIZE) {
+      status = CONSOLE_STATUS_BAD_LENGTH;
+      break;
+    }
+
+    const uint16_t usage = (uint16_t)(report[1] | ((uint16_t)report[2] << 8));
+
+    if (usage == 0) {
+      return;                                   /* Key released, no state report */
+    }
+
+    const uint32_t command = hidUsageCommand(usage);
+
+    if (command == 0) {
+      status = CONSOLE_STATUS_UNKNOWN_COMMAND;
+      break;
+    }
+
+    irCommandLog(controller.dispatch(command, millis()));
+    break;
+  }
+
+  case HID_CONTROL_REPORT_LEVELS: {
+    if (length != HID_CONTROL_LEVELS_SIZE) {
+      status = CONSOLE_STATUS_BAD_LENGTH;
+      break;
+    }
+
+    uint8_t channels[VU_CHANNEL_COUNT];
+    uint8_t values[VU_CHANNEL_COUNT];
+    uint8_t count = 0;
+
+    for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+      if (report[1 + channel] != HID_CONTROL_VALUE_KEEP) {
+        channels[count] = channel;
+        values[count++] = report[1 + channel];
+      }
+    }
+
+    if (count != 0 && !controller.setValues(channels, values, count, millis())) {
+      status = CONSOLE_STATUS_BAD_VALUE;
+    }
+    break;
+  }
+
+  case HID_CONTROL_REPORT_PRESET:
+    if (length != HID_CONTROL_PRESET_SIZE) {
+      status = CONSOLE_STATUS_BAD_LENGTH;
+    } else if (report[1] == HID_CONTROL_PRESET_STORE) {
+      status = presetStore(report[2]);
+    } else if (report[1] == HID_CONTROL_PRESET_RECALL) {
+      status = presetRecall(report[2]);
     } else {
-      DEBUG_NL("EEPROM Check task");
-      DEBUG_NL("EEPROM data did not changed");
+      status = CONSOLE_STATUS_BAD_VALUE;
     }
+    break;
 
-    old_time_eeprom_check_value = millis();
+  default:
+    status = CONSOLE_STATUS_UNKNOWN_COMMAND;
+    break;
   }
+
+  uint8_t values[VU_CHANNEL_COUNT];
+
+  for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+    values[channel] = controller.channelValue(channel);
+  }
+
+  hidControl.sendState(status, values);
+}
 #endif
 
-  irreciver.resume();
+#if (UNIT_BUS == STD_ON)
+/**
+ * @brief Function sends the frame of the unit bus node. The transceiver drives the bus until the stop bit of the
+ *        last byte is out: Serial1.flush() blocks for the frame (up to 4 ms at UNIT_BUS_BAUDRATE)
+ * @param argument: None
+ * @retval None
+ */
+static void unitBusTransmit(void)
+{
+  digitalWrite(UNIT_BUS_DE_GPIO, HIGH);
+  unitBus.transmit(Serial1);
+  Serial1.flush();
+  digitalWrite(UNIT_BUS_DE_GPIO, LOW);
+}
+
+/**
+ * @brief Function executes the pending request of the unit bus and builds its response (none for a broadcast)
+ * @param argument: None
+ * @retval None
+ */
+static void unitBusExecute(void)
+{
+  const uint8_t command = unitBus.command();
+  const uint8_t *payload = unitBus.payload();
+  const uint8_t length = unitBus.payloadLength();
+
+  unitBus.begin();
+
+  if (command == UNIT_BUS_CMD_GROUP_COMMIT) {
+    uint8_t status = CONSOLE_STATUS_BAD_LENGTH;
+
+    /* Committed once per token: the broadcast persists all units together, the confirms only read the status */
+    if (length == 1 && !unitBus.groupCommitted(payload[0], &status)) {
+      status = (controller.commit() == IR_CMD_COMMIT_STORED) ? CONSOLE_STATUS_OK : CONSOLE_STATUS_UNCHANGED;
+      unitBus.setGroupCommit(payload[0], status);
+    }
+
+    unitBus.putU8(status);
+  } else {
+    commandExecute(unitBus, unitBus.reader(), command, payload, length);
+  }
+
+  unitBus.end();
+}
+
+/**
+ * @brief Function mirrors the IR commands of the master unit (UNIT_BUS_ADDRESS == UNIT_BUS_MASTER) to all units:
+ *        the changed channel values as a batch, a commit as a group commit
+ * @param argument: irCommandResult result - result of the dispatched IR command
+ * @retval None
+ */
+static void unitBusMirror(irCommandResult result)
+{
+  static uint8_t group_token = 0;
+
+  if (UNIT_BUS_ADDRESS != UNIT_BUS_MASTER) {
+    return;
+  }
+
+  switch (result) {
+  case IR_CMD_VALUE_UP:
+  case IR_CMD_VALUE_DOWN:
+  case IR_CMD_FACTORY_RESET_STORED:
+  case IR_CMD_FACTORY_RESET_UNCHANGED:
+    unitBus.beginRequest(UNIT_BUS_BROADCAST, CONSOLE_CMD_SET_BATCH);
+
+    for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+      unitBus.putU8(channel);
+      unitBus.putU8(controller.channelValue(channel));
+    }
+    break;
+
+  case IR_CMD_COMMIT_STORED:
+  case IR_CMD_COMMIT_UNCHANGED:
+    unitBus.beginRequest(UNIT_BUS_BROADCAST, UNIT_BUS_CMD_GROUP_COMMIT);
+    unitBus.putU8(++group_token);
+    break;
+
+  default:
+    return;
+  }
+
+  if (unitBus.end()) {
+    unitBusTransmit();
+  }
 }
 
+/**
+ * @brief Function implements the unit bus task: feeds the received bytes to the node, executes the pending request
+ *        after a running wiper store cycle and sends the response after the bus turnaround. The bytes are taken
+ *        during the store cycle too, the UART buffer holds only a few frames of the other units
+ * @param argument: None
+ * @retval None
+ */
+static void unitBusTask(void)
+{
+  while (Serial1.available() > 0) {
+    const uint8_t value = (uint8_t)Serial1.read();
+
+    if (UNIT_BUS_ADDRESS != UNIT_BUS_MASTER) {               /* One master per bus, nothing is executed by it */
+      unitBus.feed(value, micros());
+    }
+  }
+
+  if (unitBus.pending() && commandBackend.potentiometerReady(millis())) {
+    unitBusExecute();
+  }
+
+  if (unitBus.transmitReady(micros())) {
+    unitBusTransmit();
+  }
+}
+#endif
+
 /**
  * @brief Main setup function
  * @param argument: None
@@ -485,32 +1325,58 @@ static void irDataReceive(void)
  */
 void setup()
 {
-/* WDG initialization */
-#if (AVR_WDT_ENABLE == STD_ON)
-  wdt_enable(WDT_TRIGGER_TIME); /* WDTO_4S => 4 second timeout. */
-#endif
+/* WDG initialization: armed first, so a hang in any of the init steps below resets the device */
+  if constexpr (VuConfig::watchdog) {
+    wdt_enable(WDT_TRIGGER_TIME); /* WDTO_4S => 4 second timeout. */
+  }
 
   DEBUG_SETUP(BAUDRATE);
+  LOG("[BOOT]: watchdog armed, debug started at {} us", micros());
 
-  /* GPIO initialization */
+  /* GPIO initialization: the CS lines are released before the potentiometer pins are driven */
   CSportInit();
 
-  /* External devices initialization */
-  irreciver.enableIRIn();
-  potentiometer.potentiometerInit();
+  /* IR receiver before the potentiometers, a frame is captured by the ISR while the wipers are set */
+  irreciver.begin(VuConfig::receiver_pin);
+  LOG("[BOOT]: IR receiver enabled at {} us", micros());
 
-#if (INIT_POTENTIOMETERS_WITH_EEPROM_VAL == STD_ON)
+  /* Configuration from the EEPROM, the defaults are kept if no record is valid */
+  bool eeprom_valid_f = configurationLoad();
+  LOG("[BOOT]: EEPROM configuration loaded at {} us, valid: {}", micros(), eeprom_valid_f);
+  (void)eeprom_valid_f;
 
-  potentiometerChannelSelect(LEFT_CHANNEL_SELECT);
-  potentiometer.potentiometerSetVal(Configuration.Data.channel_left_step_value, DIRECTION_DOWN);
+  /* Potentiometers initialization with the EEPROM values (VuConfig::init_potentiometers_with_eeprom) */
+  potentiometer.potentiometerInit(VuConfig::ud_pin, VuConfig::inc_pin);
+  controller.begin(Configuration.Data.channel_step_value, millis());
+  LOG("[BOOT]: potentiometers set at {} us", micros());
 
-  potentiometerChannelSelect(RIGHT_CHANNEL_SELECT);
-  potentiometer.potentiometerSetVal(Configuration.Data.channel_right_step_value, DIRECTION_UP);
+#if(ARDUINO_PROFILER == STD_ON && DEBUG_PRINTER == STD_ON)
+  profiler.begin();                             /* Memory baseline, malloc bisection */
+#endif
 
+#if (SAMPLING_PROFILER == STD_ON)
+  samplingProfiler.begin(SAMPLING_PROFILER_PERIOD_US);
 #endif
 
-  potentiometerChannelSelect(RELEASE_CHANNELS_CS_LINES);
+#if (SERIAL_CONSOLE == STD_ON || USB_HID_CONTROL == STD_ON || UNIT_BUS == STD_ON)
+  /* Presets, the presets of another scale (taps or levels) are dropped */
+  if (!Presets.Begin() || Presets.Data.scale != CHANNEL_SCALE) {
+    Presets.Reset();
+  }
+#endif
+
+#if (SERIAL_CONSOLE == STD_ON)
+  Serial.begin(BAUDRATE);
+#endif
+
+#if (UNIT_BUS == STD_ON)
+  /* Transceiver in the receive mode before the UART is enabled, the bus is shared with the other units */
+  digitalWrite(UNIT_BUS_DE_GPIO, LOW);
+  pinMode(UNIT_BUS_DE_GPIO, OUTPUT);
+  Serial1.begin(UNIT_BUS_BAUDRATE);
+#endif
 
+  LOG("[BOOT]: setup done at {} us", micros());
 }
 
 /**
@@ -521,9 +1387,9 @@ void setup()
 void loop()
 {
   /* Main loop */
-  static uint32_t old_tim_value = millis();
+  static uint32_t old_tim_value = millis() - VuConfig::command_period - 1;    /* First poll in the first pass */
 
-  if ((millis() - old_tim_value) > DELAY_PERIOD) {   /* Timer for non-blocking delay */
+  if ((millis() - old_tim_value) > VuConfig::command_period) {   /* Timer for non-blocking delay */
 
 #if (DEBUG_PRINTER == STD_ON && DEBUG_IR_FULL_INFO == STD_ON)
     irReceiveCmdInfo();
@@ -531,25 +1397,69 @@ void loop()
     irDataReceive();
 #endif
 
+    if constexpr (VuConfig::wiper_resync) {
+      wiperResyncTask();
+    }
+
 #if(ARDUINO_PROFILER == STD_ON && DEBUG_PRINTER == STD_ON)
 
-  StaticJsonDocument<32> doc;
+#if (PROFILER_OUTPUT_FORMAT == PROFILER_OUTPUT_JSON)
 
-  doc["ram_usage"] = profiler.getRAMUsage();
-  doc["block_usage"] = profiler.getBlockUsage();
-  doc["free_block"] = profiler.getFreeBlock();
-  doc["free_ram"] = profiler.getFreeRAM();
+  JsonWriter json(SERIAL_OUT);
 
-  serializeJson(doc, Serial);
-  DEBUG_NL(" ");
+  SERIAL_RECORD_BEGIN();
+  json.beginObject();
+  json.add(F("ram_usage"), profiler.getRAMUsage());
+  json.add(F("block_usage"), profiler.getBlockUsage());
+  json.add(F("free_block"), profiler.getFreeBlock());
+  json.add(F("free_ram"), profiler.getFreeRAM());
+  json.endObject();
+  SERIAL_RECORD_END();
+
+#else
+
+  telemetry.begin(TELEMETRY_RECORD_MEMORY);
+  telemetry.putI16(profiler.getRAMUsage());
+  telemetry.putI16(profiler.getBlockUsage());
+  telemetry.putI16(profiler.getFreeBlock());
+  telemetry.putI16(profiler.getFreeRAM());
+  telemetry.end();
+
+#endif
 
 #endif
 
     old_tim_value = millis();
   }
 
-/* WDG pet */
-#if (AVR_WDT_ENABLE == STD_ON)
-  wdt_reset();
+#if (SERIAL_CONSOLE == STD_ON)
+  consoleTask();
+#endif
+
+#if (USB_HID_CONTROL == STD_ON)
+  hidControlTask();
+#endif
+
+#if (UNIT_BUS == STD_ON)
+  unitBusTask();
+#endif
+
+#if (SAMPLING_PROFILER == STD_ON)
+  samplingProfilerTask();
+#endif
+
+#if (DEBUG_PRINTER == STD_ON || SOFTWARE_SERIAL_DEBUG == STD_ON)
+  systemInfoTask();
 #endif
+
+#if (DEBUG_PRINTER == STD_ON && DEBUG_IR_FULL_INFO == STD_ON)
+  irInfoTask();
+#endif
+
+  DEBUG_DRAIN();
+
+/* WDG pet */
+  if constexpr (VuConfig::watchdog) {
+    wdt_reset();
+  }
 }
\ No newline at end of file
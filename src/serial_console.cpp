@@ -0,0 +1,120 @@
+/**
+**********************************************************************************************************************
+*    @file           : serial_console.cpp
+*    @brief          : serial_console.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Implements the binary command console request reader (COBS deframing in place, CRC16 and length checks)
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "serial_console.h"
+
+#include <util/crc16.h>
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Constructor for ConsoleReader object
+ * @param argument: uint8_t header_size - frame bytes before the payload
+ * @retval None
+ */
+ConsoleReader::ConsoleReader(uint8_t header_size)
+  : _frame(), _length(0), _header_size(header_size), _overflow(false), _complete_f(false), _frames(0), _errors(0)
+{
+}
+
+/**
+ * @brief Function decodes the received COBS frame in place (the decoded data is never longer than the encoded
+ *        one) and checks the length and the CRC16
+ * @param argument: None
+ * @retval bool - true if the frame is a valid request
+ */
+bool ConsoleReader::decode(void)
+{
+  uint8_t read = 0;
+  uint8_t write = 0;
+
+  while (read < _length) {
+    uint8_t code = _frame[read++];
+
+    if (code == 0 || (uint8_t)(read + code - 1) > _length) {
+      return false;
+    }
+
+    for (uint8_t i = 1; i < code; i++) {
+      _frame[write++] = _frame[read++];
+    }
+
+    if (code < 0xFF && read < _length) {
+      _frame[write++] = 0;
+    }
+  }
+
+  _length = write;
+
+  if (_length < _header_size + CONSOLE_CRC_SIZE) {
+    return false;
+  }
+
+  uint16_t crc = 0;
+
+  for (uint8_t i = 0; i < _length - CONSOLE_CRC_SIZE; i++) {
+    crc = _crc16_update(crc, _frame[i]);
+  }
+
+  return crc == (uint16_t)(_frame[_length - 2] | (_frame[_length - 1] << 8));
+}
+
+/**
+ * @brief Function takes one received byte. The request stays readable until the next call
+ * @param argument: uint8_t value
+ * @retval bool - true when the byte completed a valid request
+ */
+bool ConsoleReader::feed(uint8_t value)
+{
+  if (_complete_f) {
+    _complete_f = false;
+    _length = 0;
+  }
+
+  if (value != CONSOLE_FRAME_DELIMITER) {
+    if (_length < CONSOLE_MAX_FRAME_SIZE) {
+      _frame[_length++] = value;
+    } else {
+      _overflow = true;
+    }
+
+    return false;
+  }
+
+  if (_length == 0 && !_overflow) {
+    return false;                               /* Delimiters between the frames resynchronize the reader */
+  }
+
+  _complete_f = !_overflow && decode();
+  _overflow = false;
+
+  if (!_complete_f) {
+    _length = 0;
+    ++_errors;
+    return false;
+  }
+
+  ++_frames;
+
+  return true;
+}
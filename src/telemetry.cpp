@@ -0,0 +1,157 @@
+/**
+**********************************************************************************************************************
+*    @file           : telemetry.cpp
+*    @brief          : telemetry.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Implements the compact binary telemetry records writer (COBS framing, sequence numbers, timestamps and CRC16)
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "telemetry.h"
+
+#include <util/crc16.h>
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Constructor for TelemetryWriter object
+ * @param argument: Print &sink - output stream for the frames
+ * @retval None
+ */
+TelemetryWriter::TelemetryWriter(Print &sink) : _sink(sink), _sequence(0), _length(0), _overflow(false)
+{
+}
+
+/**
+ * @brief Function appends one byte to the record (CRC bytes are always reserved)
+ * @param argument: uint8_t value
+ * @retval None
+ */
+void TelemetryWriter::putByte(uint8_t value)
+{
+  if (_length < (TELEMETRY_MAX_RECORD_SIZE - TELEMETRY_CRC_SIZE)) {
+    _frame[1 + _length++] = value;
+  } else {
+    _overflow = true;
+  }
+}
+
+/**
+ * @brief Function starts a new record of the given type and fills the record header
+ * @param argument: uint8_t type - one of telemetryRecordType values
+ * @retval None
+ */
+void TelemetryWriter::begin(uint8_t type)
+{
+  _length = 0;
+  _overflow = false;
+
+  putByte(TELEMETRY_VERSION);
+  putByte(type);
+  putU16(_sequence);
+  putU32(millis());
+}
+
+/**
+ * @brief Function appends the uint8_t value to the record payload
+ * @param argument: uint8_t value
+ * @retval None
+ */
+void TelemetryWriter::putU8(uint8_t value)
+{
+  putByte(value);
+}
+
+/**
+ * @brief Function appends the uint16_t value to the record payload (little-endian)
+ * @param argument: uint16_t value
+ * @retval None
+ */
+void TelemetryWriter::putU16(uint16_t value)
+{
+  putByte((uint8_t)(value));
+  putByte((uint8_t)(value >> 8));
+}
+
+/**
+ * @brief Function appends the int16_t value to the record payload (little-endian)
+ * @param argument: int16_t value
+ * @retval None
+ */
+void TelemetryWriter::putI16(int16_t value)
+{
+  putU16((uint16_t)value);
+}
+
+/**
+ * @brief Function appends the uint32_t value to the record payload (little-endian)
+ * @param argument: uint32_t value
+ * @retval None
+ */
+void TelemetryWriter::putU32(uint32_t value)
+{
+  putU16((uint16_t)(value));
+  putU16((uint16_t)(value >> 16));
+}
+
+/**
+ * @brief Function returns the number of payload bytes which still fit into the current record
+ * @param argument: None
+ * @retval uint8_t
+ */
+uint8_t TelemetryWriter::remaining(void) const
+{
+  return (TELEMETRY_MAX_RECORD_SIZE - TELEMETRY_CRC_SIZE) - _length;
+}
+
+/**
+ * @brief Function finishes the record: appends CRC16, COBS encodes the record and writes the frame to the sink.
+ *        The record is stored behind the first code byte, so the COBS code bytes are computed in place. The frame
+ *        goes to the sink with one write() call, a buffered sink keeps or drops it as a whole.
+ * @param argument: None
+ * @retval bool: true if the frame was written, false if the record payload did not fit or the sink dropped it
+ */
+bool TelemetryWriter::end(void)
+{
+  if (_overflow) {
+    return false;
+  }
+
+  uint16_t crc = 0;
+
+  for (uint8_t i = 1; i <= _length; i++) {
+    crc = _crc16_update(crc, _frame[i]);
+  }
+
+  _frame[1 + _length++] = (uint8_t)(crc);
+  _frame[1 + _length++] = (uint8_t)(crc >> 8);
+
+  uint8_t code_index = 0;
+
+  for (uint8_t i = 1; i <= _length; i++) {
+    if (_frame[i] == 0) {
+      _frame[code_index] = (uint8_t)(i - code_index);           /* COBS code byte: distance to next zero */
+      code_index = i;
+    }
+  }
+
+  _frame[code_index] = (uint8_t)(_length + 1 - code_index);
+  _frame[_length + 1] = TELEMETRY_FRAME_DELIMITER;
+  ++_sequence;
+
+  return _sink.write(_frame, _length + 2) == (size_t)(_length + 2);
+}
@@ -0,0 +1,273 @@
+/**
+**********************************************************************************************************************
+*    @file           : unit_bus.cpp
+*    @brief          : unit_bus.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Implements the frame handling of the addressed multi-unit bus: address filter, retry detection, response
+*    building and transmission
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "unit_bus.h"
+
+#include <string.h>
+#include <util/crc16.h>
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Constructor for UnitBusNode object
+ * @param argument: uint8_t address - own address, UNIT_BUS_MASTER for the master
+ * @retval None
+ */
+UnitBusNode::UnitBusNode(uint8_t address)
+  : _reader(), _address(address), _request(), _request_length(0), _pending_f(false), _last_f(false),
+    _last_source(0), _last_sequence(0), _frame(), _frame_length(0), _silent_f(false), _overflow(false),
+    _transmit_f(false), _sequence(0), _group_f(false), _group_token(0), _group_status(0), _received_time(0),
+    _duplicates(0), _overruns(0)
+{
+}
+
+/**
+ * @brief Function takes one byte received from the bus. Frames of other units are skipped, a repeated request
+ *        (same source and sequence as the last one) is not executed again: its stored response is sent again
+ * @param argument: uint8_t value, uint32_t time - micros() of the reception
+ * @retval bool - true when the byte completed a new request for this unit
+ */
+bool UnitBusNode::feed(uint8_t value, uint32_t time)
+{
+  if (!_reader.feed(value)) {
+    return false;
+  }
+
+  /* The addresses of a frame of another version can not be trusted */
+  if (_reader.version() != UNIT_BUS_VERSION || _reader.source() == _address ||
+      (_reader.destination() != _address && _reader.destination() != UNIT_BUS_BROADCAST)) {
+    return false;
+  }
+
+  if (_last_f && _reader.source() == _last_source && _reader.sequence() == _last_sequence) {
+    ++_duplicates;
+
+    if (_frame_length != 0) {
+      _transmit_f = true;
+      _received_time = time;
+    }
+
+    return false;
+  }
+
+  if (_pending_f) {
+    ++_overruns;                                /* Not recorded as the last request, the retry is executed */
+    return false;
+  }
+
+  memcpy(_request, _reader.frame(), _reader.frameLength());
+  _request_length = _reader.frameLength();
+  _pending_f = true;
+  _last_f = true;
+  _last_source = _reader.source();
+  _last_sequence = _reader.sequence();
+  _frame_length = 0;
+  _transmit_f = false;
+  _received_time = time;
+
+  return true;
+}
+
+/**
+ * @brief Function appends one byte to the frame (CRC bytes are always reserved)
+ * @param argument: uint8_t value
+ * @retval None
+ */
+void UnitBusNode::putByte(uint8_t value)
+{
+  if (_silent_f) {
+    return;
+  }
+
+  if (_frame_length < (UNIT_BUS_MAX_FRAME_SIZE - CONSOLE_CRC_SIZE)) {
+    _frame[_frame_length++] = value;
+  } else {
+    _overflow = true;
+  }
+}
+
+/**
+ * @brief Function starts the response to the pending request. The response to a broadcast is not built, end()
+ *        only completes the request
+ * @param argument: None
+ * @retval None
+ */
+void UnitBusNode::begin(void)
+{
+  _frame_length = 0;
+  _overflow = false;
+  _silent_f = broadcast();
+
+  /* Any other request may change the values: a token reused after a restart of the master commits again */
+  if (command() != UNIT_BUS_CMD_GROUP_COMMIT) {
+    _group_f = false;
+  }
+
+  putByte(UNIT_BUS_VERSION);
+  putByte(_request[2]);
+  putByte(_address);
+  putByte(_request[3]);
+  putByte(_request[4]);
+}
+
+/**
+ * @brief Function starts a request of the master, every request gets the next sequence number
+ * @param argument: uint8_t destination - unit address or UNIT_BUS_BROADCAST, uint8_t command
+ * @retval None
+ */
+void UnitBusNode::beginRequest(uint8_t destination, uint8_t command)
+{
+  _frame_length = 0;
+  _overflow = false;
+  _silent_f = false;
+
+  putByte(UNIT_BUS_VERSION);
+  putByte(destination);
+  putByte(_address);
+  putByte(_sequence++);
+  putByte(command);
+}
+
+/**
+ * @brief Function appends the uint8_t value to the frame payload
+ * @param argument: uint8_t value
+ * @retval None
+ */
+void UnitBusNode::putU8(uint8_t value)
+{
+  putByte(value);
+}
+
+/**
+ * @brief Function appends the uint16_t value to the frame payload (little-endian)
+ * @param argument: uint16_t value
+ * @retval None
+ */
+void UnitBusNode::putU16(uint16_t value)
+{
+  putByte((uint8_t)(value));
+  putByte((uint8_t)(value >> 8));
+}
+
+/**
+ * @brief Function appends the uint32_t value to the frame payload (little-endian)
+ * @param argument: uint32_t value
+ * @retval None
+ */
+void UnitBusNode::putU32(uint32_t value)
+{
+  putU16((uint16_t)(value));
+  putU16((uint16_t)(value >> 16));
+}
+
+/**
+ * @brief Function finishes the frame: appends CRC16 and marks it for the transmission. The pending request is
+ *        done, the next one is accepted
+ * @param argument: None
+ * @retval bool - true if the frame has to be transmitted, false for a broadcast or a payload which did not fit
+ */
+bool UnitBusNode::end(void)
+{
+  _pending_f = false;
+
+  if (_silent_f || _overflow) {
+    _frame_length = 0;
+    return false;
+  }
+
+  uint16_t crc = 0;
+
+  for (uint8_t i = 0; i < _frame_length; i++) {
+    crc = _crc16_update(crc, _frame[i]);
+  }
+
+  _frame[_frame_length++] = (uint8_t)(crc);
+  _frame[_frame_length++] = (uint8_t)(crc >> 8);
+  _transmit_f = true;
+
+  return true;
+}
+
+/**
+ * @brief Function checks if the response can be sent: the master needs UNIT_BUS_TURNAROUND_US after the end of
+ *        its request to release the bus
+ * @param argument: uint32_t time - micros()
+ * @retval bool
+ */
+bool UnitBusNode::transmitReady(uint32_t time) const
+{
+  return _transmit_f && (uint32_t)(time - _received_time) >= UNIT_BUS_TURNAROUND_US;
+}
+
+/**
+ * @brief Function writes the frame COBS encoded, between two delimiters (the first one resynchronizes the
+ *        receivers after line noise). The frame is kept for a repeated request
+ * @param argument: Print &port
+ * @retval None
+ */
+void UnitBusNode::transmit(Print &port)
+{
+  uint8_t block_start = 0;
+
+  port.write(CONSOLE_FRAME_DELIMITER);
+
+  for (uint8_t i = 0; i <= _frame_length; i++) {
+    if (i == _frame_length || _frame[i] == 0) {
+      port.write((uint8_t)(i - block_start + 1));               /* COBS code byte: distance to next zero */
+      port.write(&_frame[block_start], i - block_start);
+      block_start = (uint8_t)(i + 1);
+    }
+  }
+
+  port.write(CONSOLE_FRAME_DELIMITER);
+  _transmit_f = false;
+}
+
+/**
+ * @brief Function returns the status of the group commit of the token if this unit already did it
+ * @param argument: uint8_t token, uint8_t *status
+ * @retval bool - false if the token is not the last committed one
+ */
+bool UnitBusNode::groupCommitted(uint8_t token, uint8_t *status) const
+{
+  if (!_group_f || token != _group_token) {
+    return false;
+  }
+
+  *status = _group_status;
+
+  return true;
+}
+
+/**
+ * @brief Function records the group commit of the token
+ * @param argument: uint8_t token, uint8_t status
+ * @retval None
+ */
+void UnitBusNode::setGroupCommit(uint8_t token, uint8_t status)
+{
+  _group_f = true;
+  _group_token = token;
+  _group_status = status;
+}
@@ -0,0 +1,157 @@
+/**
+**********************************************************************************************************************
+*    @file           : test_benchmark.cpp
+*    @brief          : test_benchmark.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Benchmarks of the hot paths with budgets: INC pulse generation, CS select, EEPROM load/save and the IR command
+*    dispatch. The emulated AVR time of a call is deterministic, its budget is the measured time with a small
+*    margin (EEPROM: the HAL cost of the record bytes), so an extra pulse, register write or EEPROM byte fails the
+*    test. The host time per call only guards against gross regressions (TEST_BENCH_HOST_SCALE loosens it on slow
+*    hosts).
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "test_support.h"
+#include "EEPROMStore.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#if (POTENTIOMETER_HW_PULSES == STD_ON)
+#define BENCH_STEP_BUDGET_NS        (2 * POTENTIOMETER_HW_TICK * 1000ULL + 400)   /* Per wiper step */
+#else
+#define BENCH_STEP_BUDGET_NS        (9600ULL)         /* Per wiper step: 2 digitalWrite() and 2 POTENTIOMETER_TICK */
+#endif
+
+#if (CS_FANOUT == STD_ON)
+#define BENCH_CS_BUDGET_NS          (1700ULL)         /* One CS change: SPI byte and latch */
+#define BENCH_TRANSACTION_BUDGET_NS (11500ULL)        /* CS select/release, U/D and INC idle of a transaction */
+#else
+#define BENCH_CS_BUDGET_NS          (200ULL)          /* One CS change: SBI/CBI */
+#define BENCH_TRANSACTION_BUDGET_NS (8500ULL)
+#endif
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+typedef EEPROMStore<ChannelsConfiguration, TEST_STORE_ADDRESS> TestStore;
+typedef VuController<VuConfig, NullBackend> TestController;
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+static NullBackend backend;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static void test_benchmark_pulses(void)
+{
+  X9C102_potentiometer potentiometer(UD_POTENTIOMETER_GPIO, INC_POTENTIOMETER_GPIO);
+
+  CSportInit();
+  potentiometer.potentiometerInit();
+
+  benchmark("potentiometerSetVal(RESET_VALUE)", [&]() {
+    potentiometer.potentiometerSetVal(POTETNIOMETER_RESET_VALUE, DIRECTION_UP);
+  }, TEST_BENCH_ITERATIONS / 10, (POTENTIOMETER_RESOLUTION + POTETNIOMETER_RESET_VALUE) * BENCH_STEP_BUDGET_NS,
+  200000);
+  benchmark("potentiometerSetVal(HIGH_BOUNDRY)", [&]() {
+    potentiometer.potentiometerSetVal(POTENTIOMETER_HIGH_BOUNDRY, DIRECTION_DOWN);
+  }, TEST_BENCH_ITERATIONS / 10, (POTENTIOMETER_RESOLUTION + POTENTIOMETER_HIGH_BOUNDRY) * BENCH_STEP_BUDGET_NS,
+  200000);
+
+  potentiometer.potentiometerIdle();
+  potentiometer.potentiometerTransaction(CHANNEL_MASK(LEFT_CHANNEL_INDEX), 41, DIRECTION_DOWN);
+
+  benchmark("potentiometerStepTransaction(1) x2", [&]() {
+    potentiometer.potentiometerStepTransaction(CHANNEL_MASK(LEFT_CHANNEL_INDEX), 41, 40, DIRECTION_DOWN);
+    potentiometer.potentiometerStepTransaction(CHANNEL_MASK(LEFT_CHANNEL_INDEX), 40, 41, DIRECTION_DOWN);
+  }, TEST_BENCH_ITERATIONS / 10, 2 * (BENCH_STEP_BUDGET_NS + BENCH_TRANSACTION_BUDGET_NS), 20000);
+}
+
+static void test_benchmark_chip_select(void)
+{
+  CSportInit();
+
+  benchmark("CSportSelect(channel 0)", []() { CSportSelect(CHANNEL_MASK(0)); }, TEST_BENCH_ITERATIONS * 50,
+            BENCH_CS_BUDGET_NS, 1000);
+  benchmark("LeftChipSelect::select()", []() { LeftChipSelect::select(); }, TEST_BENCH_ITERATIONS * 50,
+            BENCH_CS_BUDGET_NS, 1000);
+  benchmark("ScopedChannelSelect(left)+release", []() {
+    volatile uint8_t channel_mask = CHANNEL_MASK(LEFT_CHANNEL_INDEX);
+    ScopedChannelSelect chip_select(channel_mask);
+  }, TEST_BENCH_ITERATIONS * 50, 2 * BENCH_CS_BUDGET_NS, 2000);
+  AllChipSelect::release();
+}
+
+static void test_benchmark_eeprom_store(void)
+{
+  const uint64_t read_ns = hal::timing.eeprom_read_byte_ns;
+  const uint64_t write_ns = hal::timing.eeprom_write_byte_ns;
+  TestStore store;
+  uint8_t value = 0;
+
+  hal::eepromErase();
+  store.Save();
+
+  /* Load: both banks read once, save: the record written to the other bank and read back */
+  benchmark("EEPROMStore::Begin() (load)", [&]() { test_sink += store.Begin(); }, TEST_BENCH_ITERATIONS,
+            2 * TestStore::StorageSize * read_ns, 10000);
+  benchmark("EEPROMStore::Save() unchanged", [&]() { test_sink += store.Save(); }, TEST_BENCH_ITERATIONS,
+            2 * TestStore::StorageSize * read_ns, 10000);
+  benchmark("EEPROMStore::Save() changed", [&]() {
+    store.Data.channel_step_value[LEFT_CHANNEL_INDEX] = (uint8_t)(++value % POTENTIOMETER_HIGH_BOUNDRY);
+    test_sink += store.Save();
+  }, TEST_BENCH_ITERATIONS / 10, TestStore::StorageSize * (write_ns + 3 * read_ns), 20000);
+}
+
+static void test_benchmark_dispatch(void)
+{
+  static const uint32_t sequence[] = {
+    SELECT_LEFT_CHANNEL_CMD_RAW, INCREASE_VU_VALUE_CMD_RAW, DECREASE_VU_VALUE_CMD_RAW, DECREASE_VU_VALUE_CMD_RAW,
+    SELECT_RIGHT_CHANNEL_CMD_RAW, INCREASE_VU_VALUE_CMD_RAW, COMMIT_CHANGES_CMD_RAW, FACTORY_RESET_VU_VAL_CMD_RAW,
+  };
+
+  TestController controller(backend);
+  ChannelsConfiguration stored;
+  size_t index = 0;
+
+  stored.Reset();
+  controller.begin(stored.channel_step_value, 0);
+
+  /* Compute only: the virtual clock does not advance */
+  benchmark("VuController::dispatch()", [&]() {
+    test_sink += controller.dispatch(sequence[index], 0);
+    index = (index + 1) % (sizeof(sequence) / sizeof(sequence[0]));
+  }, TEST_BENCH_ITERATIONS * 50, 0, 500);
+}
+
+/**
+ * @brief Function runs the hot path benchmarks
+ * @param argument: None
+ * @retval None
+ */
+void runBenchmarkTests(void)
+{
+  RUN_TEST(test_benchmark_pulses);
+  RUN_TEST(test_benchmark_chip_select);
+  RUN_TEST(test_benchmark_eeprom_store);
+  RUN_TEST(test_benchmark_dispatch);
+}
@@ -0,0 +1,140 @@
+/**
+**********************************************************************************************************************
+*    @file           : test_cs_fanout.cpp
+*    @brief          : test_cs_fanout.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Chip-select layer tests on the 74HC595 fan-out (CS_FANOUT on, pio test -e native_cs_fanout): the outputs of a
+*    shift register model fed by the SPI and latch writes for every channel and channel subsets, one latch per
+*    change, neighbouring PORTD pins untouched and the typed layer on top of the fan-out.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "test_support.h"
+
+#if (CS_FANOUT == STD_ON)
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define TEST_DDRD_OTHER         (0xC8)      /* Neighbouring PORTD pins (Serial1 RX/TX, PD6/PD7) which must be kept */
+#define TEST_PORTD_OTHER        (0x45)
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Function sets up the neighbouring PORTD pins, the SPI off and the 74HC595 model, initializes the CS lines
+ * @param argument: None
+ * @retval None
+ */
+static void chipSelectInit(void)
+{
+  DDRD = TEST_DDRD_OTHER;
+  PORTD = TEST_PORTD_OTHER;
+  SPCR = 0;
+  shift_register->clear();
+  CSportInit();
+}
+
+static void test_init_latches_every_output_released(void)
+{
+  chipSelectInit();
+
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, shift_register->latches);
+  TEST_ASSERT_EQUAL_HEX8(0xFF, shift_register->outputs);
+  TEST_ASSERT_EQUAL_HEX8(0, CSportSelected());
+
+  /* SPI master and pins set up before the first byte */
+  TEST_ASSERT_EQUAL_UINT32(0, shift_register->spi_disabled_writes);
+
+  /* Latch pin: output, idle low, the other PORTD pins kept */
+  TEST_ASSERT_EQUAL_HEX8(CS_FANOUT_LATCH_MASK, DDRD & CS_FANOUT_LATCH_MASK);
+  TEST_ASSERT_EQUAL_HEX8(0, PORTD & CS_FANOUT_LATCH_MASK);
+  TEST_ASSERT_EQUAL_HEX8(TEST_DDRD_OTHER, DDRD & ~CS_FANOUT_LATCH_MASK);
+  TEST_ASSERT_EQUAL_HEX8(TEST_PORTD_OTHER, PORTD & ~CS_FANOUT_LATCH_MASK);
+}
+
+static void test_select_release_every_channel(void)
+{
+  chipSelectInit();
+
+  for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+    uint32_t latches = shift_register->latches;
+
+    CSportSelect(CHANNEL_MASK(channel));
+    TEST_ASSERT_EQUAL_HEX8((uint8_t)~CHANNEL_MASK(channel), shift_register->outputs);
+    TEST_ASSERT_EQUAL_HEX8(CHANNEL_MASK(channel), CSportSelected());
+
+    CSportRelease(CHANNEL_MASK(channel));
+    TEST_ASSERT_EQUAL_HEX8(0xFF, shift_register->outputs);
+
+    /* One latch per change */
+    TEST_ASSERT_EQUAL_UINT32(2, shift_register->latches - latches);
+  }
+}
+
+static void test_select_release_keep_other_channels(void)
+{
+  const uint8_t last = CHANNEL_MASK(VU_CHANNEL_COUNT - 1);
+
+  chipSelectInit();
+
+  CSportSelect(0x05 & ALL_CHANNELS_MASK);
+  CSportSelect(last);
+  TEST_ASSERT_EQUAL_HEX8((uint8_t)~((0x05 & ALL_CHANNELS_MASK) | last), shift_register->outputs);
+
+  CSportRelease(0x01);
+  TEST_ASSERT_EQUAL_HEX8((uint8_t)~((0x04 & ALL_CHANNELS_MASK) | last), shift_register->outputs);
+
+  /* Unconfigured outputs stay released */
+  CSportSelect(0xFF);
+  TEST_ASSERT_EQUAL_HEX8((uint8_t)~ALL_CHANNELS_MASK, shift_register->outputs);
+
+  CSportRelease(ALL_CHANNELS_MASK);
+  TEST_ASSERT_EQUAL_HEX8(TEST_PORTD_OTHER, PORTD & ~CS_FANOUT_LATCH_MASK);
+  TEST_ASSERT_EQUAL_HEX8(TEST_DDRD_OTHER, DDRD & ~CS_FANOUT_LATCH_MASK);
+}
+
+static void test_typed_chip_select_on_fanout(void)
+{
+  chipSelectInit();
+
+  LeftChipSelect::select();
+  TEST_ASSERT_TRUE(LeftChipSelect::isSelected());
+  TEST_ASSERT_EQUAL_HEX8(CHANNEL_MASK(LEFT_CHANNEL_INDEX), chipSelectLow());
+
+  AllChipSelect::release();
+  TEST_ASSERT_FALSE(LeftChipSelect::isSelected());
+  TEST_ASSERT_EQUAL_HEX8(0xFF, shift_register->outputs);
+}
+
+#endif
+
+/**
+ * @brief Function runs the chip-select tests of the 74HC595 fan-out
+ * @param argument: None
+ * @retval None
+ */
+void runChipSelectFanoutTests(void)
+{
+#if (CS_FANOUT == STD_ON)
+  RUN_TEST(test_init_latches_every_output_released);
+  RUN_TEST(test_select_release_every_channel);
+  RUN_TEST(test_select_release_keep_other_channels);
+  RUN_TEST(test_typed_chip_select_on_fanout);
+#endif
+}
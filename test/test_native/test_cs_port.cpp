@@ -0,0 +1,167 @@
+/**
+**********************************************************************************************************************
+*    @file           : test_cs_port.cpp
+*    @brief          : test_cs_port.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Chip-select layer tests on the direct PORTC lines (CS_FANOUT off): CSportSelect()/CSportRelease() port state
+*    of every channel mask, neighbouring PORTC/DDRC pins untouched, never both CS lines selected, the typed
+*    LeftChipSelect/AllChipSelect layer and ScopedChannelSelect on the same lines as CSportSelect().
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "test_support.h"
+
+#if (CS_FANOUT == STD_OFF)
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define TEST_CS_MASK            (uint8_t)((1 << PORTC6) | (1 << PORTC7))
+#define TEST_DDRC_OTHER         (0x05)      /* Neighbouring PORTC pins: outputs and pull-ups which must be kept */
+#define TEST_PORTC_OTHER        (0x2A)
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Function sets up the neighbouring PORTC pins and initializes the CS lines
+ * @param argument: None
+ * @retval None
+ */
+static void chipSelectInit(void)
+{
+  DDRC = TEST_DDRC_OTHER;
+  PORTC = TEST_PORTC_OTHER;
+  CSportInit();
+}
+
+static void test_init_releases_cs_lines_keeps_other_pins(void)
+{
+  ChipSelectMonitor monitor;
+
+  chipSelectInit();
+
+  TEST_ASSERT_EQUAL_HEX8(TEST_CS_MASK, DDRC & TEST_CS_MASK);
+  TEST_ASSERT_EQUAL_HEX8(TEST_CS_MASK, PORTC & TEST_CS_MASK);
+  TEST_ASSERT_EQUAL_HEX8(TEST_DDRC_OTHER, DDRC & ~TEST_CS_MASK);
+  TEST_ASSERT_EQUAL_HEX8(TEST_PORTC_OTHER, PORTC & ~TEST_CS_MASK);
+  TEST_ASSERT_EQUAL_UINT32(0, monitor.both_selected_writes);
+}
+
+static void test_select_port_state_per_channel_mask(void)
+{
+  const struct
+  {
+    uint8_t channel_mask;
+    uint8_t port;                               /* Active low CS: PC7 - left (pin 13), PC6 - right (pin 5) */
+  } expected[] = {
+    {CHANNEL_MASK(LEFT_CHANNEL_INDEX), (uint8_t)(1 << PORTC6)},
+    {CHANNEL_MASK(RIGHT_CHANNEL_INDEX), (uint8_t)(1 << PORTC7)},
+    {0, TEST_CS_MASK},
+    {ALL_CHANNELS_MASK, 0},
+  };
+
+  chipSelectInit();
+
+  for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+    CSportRelease(ALL_CHANNELS_MASK);
+    CSportSelect(expected[i].channel_mask);
+
+    TEST_ASSERT_EQUAL_HEX8(expected[i].port, PORTC & TEST_CS_MASK);
+    TEST_ASSERT_EQUAL_HEX8(expected[i].channel_mask, CSportSelected());
+    TEST_ASSERT_EQUAL_HEX8(TEST_PORTC_OTHER, PORTC & ~TEST_CS_MASK);
+    TEST_ASSERT_EQUAL_HEX8(TEST_DDRC_OTHER, DDRC & ~TEST_CS_MASK);
+    TEST_ASSERT_EQUAL((expected[i].port & (1 << PORTC7)) ? HIGH : LOW, digitalRead(LEFT_CHANNEL));
+    TEST_ASSERT_EQUAL((expected[i].port & (1 << PORTC6)) ? HIGH : LOW, digitalRead(RIGHT_CHANNEL));
+  }
+}
+
+static void test_scoped_channel_select_matches_port_select(void)
+{
+  const uint8_t channel_masks[] = {CHANNEL_MASK(LEFT_CHANNEL_INDEX), CHANNEL_MASK(RIGHT_CHANNEL_INDEX), 0,
+                                   ALL_CHANNELS_MASK, 0xFF};
+
+  chipSelectInit();
+
+  ChipSelectMonitor monitor;
+
+  for (size_t i = 0; i < sizeof(channel_masks); i++) {
+    CSportSelect(channel_masks[i]);
+    const uint8_t port = (uint8_t)(PORTC & TEST_CS_MASK);
+    CSportRelease(ALL_CHANNELS_MASK);
+
+    {
+      ScopedChannelSelect chip_select(channel_masks[i]);
+
+      TEST_ASSERT_EQUAL_HEX8(port, PORTC & TEST_CS_MASK);
+    }
+
+    TEST_ASSERT_EQUAL_HEX8(TEST_CS_MASK, PORTC & TEST_CS_MASK);
+  }
+
+  TEST_ASSERT_EQUAL_HEX8(TEST_PORTC_OTHER, PORTC & ~TEST_CS_MASK);
+  TEST_ASSERT_EQUAL_UINT32(0, monitor.foreign_bit_writes);
+}
+
+static void test_channel_switch_never_selects_both(void)
+{
+  chipSelectInit();
+
+  ChipSelectMonitor monitor;
+
+  CSportSelect(CHANNEL_MASK(LEFT_CHANNEL_INDEX));
+  CSportRelease(CHANNEL_MASK(LEFT_CHANNEL_INDEX));
+  CSportSelect(CHANNEL_MASK(RIGHT_CHANNEL_INDEX));
+  CSportRelease(CHANNEL_MASK(RIGHT_CHANNEL_INDEX));
+  CSportSelect(CHANNEL_MASK(LEFT_CHANNEL_INDEX));
+  CSportRelease(ALL_CHANNELS_MASK);
+
+  TEST_ASSERT_EQUAL_UINT32(0, monitor.both_selected_writes);
+  TEST_ASSERT_EQUAL_UINT32(0, monitor.foreign_bit_writes);
+}
+
+static void test_typed_chip_select(void)
+{
+  chipSelectInit();
+
+  LeftChipSelect::select();
+  TEST_ASSERT_TRUE(LeftChipSelect::isSelected());
+  TEST_ASSERT_FALSE(RightChipSelect::isSelected());
+
+  AllChipSelect::release();
+  TEST_ASSERT_FALSE(LeftChipSelect::isSelected());
+  TEST_ASSERT_FALSE(RightChipSelect::isSelected());
+  TEST_ASSERT_EQUAL_HEX8(TEST_PORTC_OTHER, PORTC & ~TEST_CS_MASK);
+}
+
+#endif
+
+/**
+ * @brief Function runs the chip-select tests of the direct CS lines
+ * @param argument: None
+ * @retval None
+ */
+void runChipSelectTests(void)
+{
+#if (CS_FANOUT == STD_OFF)
+  RUN_TEST(test_init_releases_cs_lines_keeps_other_pins);
+  RUN_TEST(test_select_port_state_per_channel_mask);
+  RUN_TEST(test_scoped_channel_select_matches_port_select);
+  RUN_TEST(test_channel_switch_never_selects_both);
+  RUN_TEST(test_typed_chip_select);
+#endif
+}
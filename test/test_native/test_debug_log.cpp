@@ -0,0 +1,283 @@
+/**
+**********************************************************************************************************************
+*    @file           : test_debug_log.cpp
+*    @brief          : test_debug_log.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    DebugLogBuffer tests: a record which does not fit is dropped as a whole and counted once, DROP_OLDEST
+*    overwrites whole records and completes the record being sent, the record queue limit, and COBS framed
+*    telemetry records which stay decodable through an overflowing buffer.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <string.h>
+
+#include <util/crc16.h>
+#include "test_support.h"
+#include "debug_log.h"
+#include "telemetry.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define TEST_CAPTURE_SIZE       (1024)
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*Sink of the drain, keeps the sent bytes*/
+class CaptureSink : public Print
+{
+public:
+  uint8_t data[TEST_CAPTURE_SIZE];
+  uint16_t length;
+
+  CaptureSink() : data(), length(0) {}
+
+  virtual size_t write(uint8_t value)
+  {
+    if (length < TEST_CAPTURE_SIZE) {
+      data[length++] = value;
+    }
+
+    return 1;
+  }
+
+  using Print::write;
+
+  /**
+   * @brief Function compares the captured bytes with a string
+   * @param argument: const char *text
+   * @retval bool - true if equal
+   */
+  bool equals(const char *text) const
+  {
+    return length == strlen(text) && memcmp(data, text, length) == 0;
+  }
+};
+
+typedef DebugLogBuffer<64, DEBUG_LOG_DROP_NEWEST> NewestBuffer;
+typedef DebugLogBuffer<64, DEBUG_LOG_DROP_OLDEST> OldestBuffer;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Function drains the whole buffer into the sink
+ * @param argument: TBuffer &buffer, CaptureSink &sink
+ * @retval None
+ */
+template <class TBuffer> static void drainAll(TBuffer &buffer, CaptureSink &sink)
+{
+  while (buffer.drain(sink, DEBUG_LOG_DRAIN_BUDGET) != 0) {
+  }
+}
+
+/**
+ * @brief Function decodes the COBS frames of the captured stream and checks their CRC16
+ * @param argument: const CaptureSink &sink, uint16_t *bad_frames
+ * @retval uint16_t - number of good frames
+ */
+static uint16_t telemetryFrames(const CaptureSink &sink, uint16_t *bad_frames)
+{
+  uint16_t good_frames = 0;
+  uint16_t start = 0;
+
+  *bad_frames = 0;
+
+  for (uint16_t end = 0; end < sink.length; end++) {
+    if (sink.data[end] != TELEMETRY_FRAME_DELIMITER) {
+      continue;
+    }
+
+    uint8_t record[TELEMETRY_MAX_FRAME_SIZE];
+    uint8_t length = 0;
+    uint16_t crc = 0;
+    uint16_t i = start;
+    bool valid_f = (end - start) <= TELEMETRY_MAX_FRAME_SIZE;
+
+    while (valid_f && i < end) {
+      uint8_t code = sink.data[i++];
+
+      for (uint8_t j = 1; j < code && i < end; j++) {
+        record[length++] = sink.data[i++];
+      }
+
+      if (i < end) {
+        record[length++] = 0;
+      }
+    }
+
+    for (uint8_t j = 0; j < length; j++) {
+      crc = _crc16_update(crc, record[j]);
+    }
+
+    if (valid_f && length >= TELEMETRY_HEADER_SIZE + TELEMETRY_CRC_SIZE && crc == 0) {
+      ++good_frames;
+    } else {
+      ++*bad_frames;
+    }
+
+    start = (uint16_t)(end + 1);
+  }
+
+  if (start != sink.length) {
+    ++*bad_frames;                              /* Frame without its delimiter */
+  }
+
+  return good_frames;
+}
+
+static void test_newest_drops_whole_record(void)
+{
+  NewestBuffer buffer;
+  CaptureSink sink;
+
+  buffer.print("first record........\n");
+  buffer.print("second record.......\n");
+  buffer.print("third record........\n");
+  TEST_ASSERT_EQUAL_UINT16(0, buffer.getOverflowCount());
+
+  /* 21 bytes do not fit into the 0 bytes left, nothing of the record is stored */
+  TEST_ASSERT_EQUAL_UINT32(0, buffer.print("fourth record.......\n"));
+  TEST_ASSERT_EQUAL_UINT16(1, buffer.getOverflowCount());
+
+  /* A text record beyond the room is dropped at endRecord(), counted once */
+  buffer.drain(sink, 21);
+  buffer.beginRecord();
+  buffer.print("fifth ");
+  buffer.print("record, longer than the room");
+  TEST_ASSERT_FALSE(buffer.endRecord());
+  TEST_ASSERT_EQUAL_UINT16(2, buffer.getOverflowCount());
+
+  drainAll(buffer, sink);
+  TEST_ASSERT_TRUE(sink.equals("first record........\nsecond record.......\nthird record........\n"));
+  TEST_ASSERT_EQUAL_UINT8(0, buffer.pending());
+}
+
+static void test_oldest_overwrites_whole_records(void)
+{
+  OldestBuffer buffer;
+  CaptureSink sink;
+
+  buffer.print("first record........\n");
+  buffer.print("second record.......\n");
+  buffer.print("third record........\n");
+
+  /* The first record is being sent: the second one is overwritten, the rest of the first one is kept */
+  buffer.drain(sink, 5);
+  buffer.beginRecord();
+  buffer.print("fourth ");
+  buffer.print("record.......\n");
+  TEST_ASSERT_TRUE(buffer.endRecord());
+  TEST_ASSERT_EQUAL_UINT16(1, buffer.getOverflowCount());
+
+  drainAll(buffer, sink);
+  TEST_ASSERT_TRUE(sink.equals("first record........\nthird record........\nfourth record.......\n"));
+
+  /* A record larger than the buffer is dropped, nothing of it is sent */
+  sink.length = 0;
+  buffer.beginRecord();
+  for (uint8_t i = 0; i < 80; i++) {
+    buffer.write('x');
+  }
+  TEST_ASSERT_FALSE(buffer.endRecord());
+  buffer.print("next\n");
+  drainAll(buffer, sink);
+  TEST_ASSERT_TRUE(sink.equals("next\n"));
+}
+
+static void test_record_queue_limit(void)
+{
+  NewestBuffer buffer;
+  CaptureSink sink;
+
+  /* 64 / DEBUG_LOG_RECORD_BYTES records */
+  for (uint8_t i = 0; i < 8; i++) {
+    TEST_ASSERT_EQUAL_UINT32(1, buffer.write((uint8_t)('0' + i)));
+  }
+
+  TEST_ASSERT_EQUAL_UINT8(0, buffer.room());
+  TEST_ASSERT_EQUAL_UINT32(0, buffer.write('8'));
+  TEST_ASSERT_EQUAL_UINT16(1, buffer.getOverflowCount());
+
+  drainAll(buffer, sink);
+  TEST_ASSERT_TRUE(sink.equals("01234567"));
+}
+
+/**
+ * @brief Function writes telemetry records through an overflowing buffer and checks the drained frames
+ * @param argument: TBuffer &buffer
+ * @retval uint16_t - number of records accepted by the buffer
+ */
+template <class TBuffer> static uint16_t telemetryThroughBuffer(TBuffer &buffer)
+{
+  TelemetryWriter writer(buffer);
+  CaptureSink sink;
+  uint16_t accepted = 0;
+  uint16_t bad_frames = 0;
+
+  /* Records of 10..39 bytes with zeros in the payload, 3 written for every 16 drained bytes */
+  for (uint16_t i = 0; i < 60; i++) {
+    writer.begin(TELEMETRY_RECORD_LOG);
+
+    for (uint8_t j = 0; j < (i * 7) % 30; j++) {
+      writer.putU8((uint8_t)((j % 3 == 0) ? 0 : i + j));
+    }
+
+    accepted = (uint16_t)(accepted + (writer.end() ? 1 : 0));
+
+    if (i % 3 == 2) {
+      buffer.drain(sink, 2 * DEBUG_LOG_DRAIN_BUDGET);
+    }
+  }
+
+  drainAll(buffer, sink);
+
+  TEST_ASSERT_TRUE(buffer.getOverflowCount() > 0);
+  TEST_ASSERT_EQUAL_UINT16(60 - buffer.getOverflowCount(), telemetryFrames(sink, &bad_frames));
+  TEST_ASSERT_EQUAL_UINT16(0, bad_frames);
+
+  return accepted;
+}
+
+static void test_telemetry_frames_survive_overflow(void)
+{
+  NewestBuffer newest;
+  OldestBuffer oldest;
+
+  /* DROP_NEWEST refuses the records it drops, DROP_OLDEST overwrites accepted ones */
+  uint16_t accepted = telemetryThroughBuffer(newest);
+
+  TEST_ASSERT_EQUAL_UINT16(60 - newest.getOverflowCount(), accepted);
+
+  accepted = telemetryThroughBuffer(oldest);
+  TEST_ASSERT_TRUE(accepted > 60 - oldest.getOverflowCount());
+}
+
+/**
+ * @brief Function runs the debug log buffer tests
+ * @param argument: None
+ * @retval None
+ */
+void runDebugLogTests(void)
+{
+  RUN_TEST(test_newest_drops_whole_record);
+  RUN_TEST(test_oldest_overwrites_whole_records);
+  RUN_TEST(test_record_queue_limit);
+  RUN_TEST(test_telemetry_frames_survive_overflow);
+}
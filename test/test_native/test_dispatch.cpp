@@ -0,0 +1,129 @@
+/**
+**********************************************************************************************************************
+*    @file           : test_dispatch.cpp
+*    @brief          : test_dispatch.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    IR command state machine tests (VuController::dispatch() with a back end without side effects): channel
+*    selection, value change, commit and unknown commands.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "test_support.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+typedef VuController<VuConfig, NullBackend> TestController;
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+static NullBackend backend;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Function starts a controller from the default channel values
+ * @param argument: TestController &controller
+ * @retval None
+ */
+static void controllerBegin(TestController &controller)
+{
+  ChannelsConfiguration stored;
+
+  stored.Reset();
+  controller.begin(stored.channel_step_value, 0);
+}
+
+static void test_left_selection_and_value_up(void)
+{
+  TestController controller(backend);
+
+  controllerBegin(controller);
+
+  TEST_ASSERT_EQUAL(IR_CMD_LEFT_CHANNEL_SELECTED, controller.dispatch(SELECT_LEFT_CHANNEL_CMD_RAW, 0));
+  TEST_ASSERT_EQUAL_UINT8(LEFT_CHANNEL_INDEX, controller.selectedChannel());
+
+  /* Value up lowers the step value */
+  TEST_ASSERT_EQUAL(IR_CMD_VALUE_UP, controller.dispatch(INCREASE_VU_VALUE_CMD_RAW, 0));
+  TEST_ASSERT_EQUAL_UINT8(TestController::value_reset - 1, controller.channelValue(LEFT_CHANNEL_INDEX));
+
+  /* Left selection stops at channel 0 */
+  TEST_ASSERT_EQUAL(IR_CMD_LEFT_CHANNEL_SELECTED, controller.dispatch(SELECT_LEFT_CHANNEL_CMD_RAW, 0));
+  TEST_ASSERT_EQUAL_UINT8(LEFT_CHANNEL_INDEX, controller.selectedChannel());
+}
+
+static void test_commit_ends_selection(void)
+{
+  TestController controller(backend);
+
+  controllerBegin(controller);
+  controller.dispatch(SELECT_LEFT_CHANNEL_CMD_RAW, 0);
+
+  TEST_ASSERT_TRUE(controller.dispatch(COMMIT_CHANGES_CMD_RAW, 0) != IR_CMD_UNKNOWN);
+  TEST_ASSERT_EQUAL_UINT8(NO_CHANNEL_SELECTED, controller.selectedChannel());
+}
+
+static void test_right_selection_steps_to_last_channel(void)
+{
+  TestController controller(backend);
+
+  controllerBegin(controller);
+
+  TEST_ASSERT_EQUAL(IR_CMD_RIGHT_CHANNEL_SELECTED, controller.dispatch(SELECT_RIGHT_CHANNEL_CMD_RAW, 0));
+  TEST_ASSERT_EQUAL_UINT8(RIGHT_CHANNEL_INDEX, controller.selectedChannel());
+
+  for (uint8_t channel = RIGHT_CHANNEL_INDEX + 1; channel < VU_CHANNEL_COUNT + 1; channel++) {
+    controller.dispatch(SELECT_RIGHT_CHANNEL_CMD_RAW, 0);
+    TEST_ASSERT_EQUAL_UINT8((channel < VU_CHANNEL_COUNT) ? channel : VU_CHANNEL_COUNT - 1,
+                            controller.selectedChannel());
+  }
+}
+
+static void test_value_change_needs_selection(void)
+{
+  TestController controller(backend);
+
+  controllerBegin(controller);
+
+  TEST_ASSERT_EQUAL(IR_CMD_VALUE_LIMIT, controller.dispatch(INCREASE_VU_VALUE_CMD_RAW, 0));
+}
+
+static void test_unknown_command(void)
+{
+  TestController controller(backend);
+
+  controllerBegin(controller);
+
+  TEST_ASSERT_EQUAL(IR_CMD_UNKNOWN, controller.dispatch(0x12345678UL, 0));
+}
+
+/**
+ * @brief Function runs the IR command dispatch tests
+ * @param argument: None
+ * @retval None
+ */
+void runDispatchTests(void)
+{
+  RUN_TEST(test_left_selection_and_value_up);
+  RUN_TEST(test_commit_ends_selection);
+  RUN_TEST(test_right_selection_steps_to_last_channel);
+  RUN_TEST(test_value_change_needs_selection);
+  RUN_TEST(test_unknown_command);
+}
@@ -0,0 +1,170 @@
+/**
+**********************************************************************************************************************
+*    @file           : test_eeprom_store.cpp
+*    @brief          : test_eeprom_store.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    EEPROMStore tests on the emulated EEPROM: erased EEPROM, save/unchanged save, reset, load and checksum error,
+*    and the search for the first release record.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "test_support.h"
+#include "EEPROMStore.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+typedef EEPROMStore<ChannelsConfiguration, TEST_STORE_ADDRESS> TestStore;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Function saves the record of the left and right channel values to the erased EEPROM
+ * @param argument: uint8_t left, uint8_t right
+ * @retval None
+ */
+static void storeSaved(uint8_t left, uint8_t right)
+{
+  TestStore store;
+
+  hal::eepromErase();
+  store.Data.channel_step_value[LEFT_CHANNEL_INDEX] = left;
+  store.Data.channel_step_value[RIGHT_CHANNEL_INDEX] = right;
+  store.Save();
+}
+
+/**
+ * @brief Function writes a first release record (checksum, left and right taps) to the EEPROM
+ * @param argument: uint16_t address, uint8_t left, uint8_t right
+ * @retval None
+ */
+static void legacyWrite(uint16_t address, uint8_t left, uint8_t right)
+{
+  const uint16_t checksum = _crc16_update(_crc16_update(0, left), right);
+
+  hal::eepromWrite(address, (uint8_t)checksum);
+  hal::eepromWrite((uint16_t)(address + 1), (uint8_t)(checksum >> 8));
+  hal::eepromWrite((uint16_t)(address + 2), left);
+  hal::eepromWrite((uint16_t)(address + 3), right);
+}
+
+static void test_erased_eeprom_loads_defaults(void)
+{
+  TestStore store;
+
+  hal::eepromErase();
+
+  TEST_ASSERT_FALSE(store.Begin());
+  TEST_ASSERT_EQUAL_UINT8(CHANNEL_RESET_VALUE, store.Data.channel_step_value[LEFT_CHANNEL_INDEX]);
+  TEST_ASSERT_EQUAL_UINT8(CHANNEL_RESET_VALUE, store.Data.channel_step_value[RIGHT_CHANNEL_INDEX]);
+}
+
+static void test_save_writes_changed_data_only(void)
+{
+  TestStore store;
+
+  hal::eepromErase();
+  store.Begin();
+  store.Data.channel_step_value[LEFT_CHANNEL_INDEX] = 7;
+
+  TEST_ASSERT_TRUE(store.Save());
+  TEST_ASSERT_FALSE(store.Save());
+}
+
+static void test_reset_restores_defaults_load_returns_saved(void)
+{
+  TestStore store;
+
+  storeSaved(7, 9);
+  store.Begin();
+  store.Reset();
+  TEST_ASSERT_EQUAL_UINT8(CHANNEL_RESET_VALUE, store.Data.channel_step_value[LEFT_CHANNEL_INDEX]);
+
+  TEST_ASSERT_TRUE(store.Load());
+  TEST_ASSERT_EQUAL_UINT8(7, store.Data.channel_step_value[LEFT_CHANNEL_INDEX]);
+  TEST_ASSERT_EQUAL_UINT8(9, store.Data.channel_step_value[RIGHT_CHANNEL_INDEX]);
+}
+
+static void test_begin_loads_saved_record(void)
+{
+  storeSaved(7, 9);
+
+  TestStore store;
+
+  /* The constructor does not read the EEPROM */
+  TEST_ASSERT_EQUAL_UINT8(CHANNEL_RESET_VALUE, store.Data.channel_step_value[LEFT_CHANNEL_INDEX]);
+
+  TEST_ASSERT_TRUE(store.Begin());
+  TEST_ASSERT_EQUAL_UINT8(7, store.Data.channel_step_value[LEFT_CHANNEL_INDEX]);
+  TEST_ASSERT_EQUAL_UINT8(9, store.Data.channel_step_value[RIGHT_CHANNEL_INDEX]);
+}
+
+static void test_checksum_error_loads_defaults(void)
+{
+  storeSaved(7, 9);
+
+  for (uint16_t address = TEST_STORE_ADDRESS; address < TEST_STORE_ADDRESS + TestStore::StorageSize; address++) {
+    hal::eepromData()[address] ^= 0x5A;
+  }
+
+  TestStore store;
+
+  TEST_ASSERT_FALSE(store.Begin());
+  TEST_ASSERT_EQUAL_UINT8(CHANNEL_RESET_VALUE, store.Data.channel_step_value[LEFT_CHANNEL_INDEX]);
+  TEST_ASSERT_EQUAL_UINT8(CHANNEL_RESET_VALUE, store.Data.channel_step_value[RIGHT_CHANNEL_INDEX]);
+}
+
+static void test_legacy_record_found_at_any_address(void)
+{
+  ChannelsConfigurationLegacy legacy;
+
+  /* Erased and all zero EEPROM: no record, the zero window passes the checksum but not the step range */
+  hal::eepromErase();
+  TEST_ASSERT_FALSE(EEPROMLegacyLoad(legacy));
+
+  for (uint16_t address = 0; address < 16; address++) {
+    hal::eepromWrite(address, 0);
+  }
+  TEST_ASSERT_FALSE(EEPROMLegacyLoad(legacy));
+
+  /* The record at the last possible address */
+  hal::eepromErase();
+  legacyWrite(E2END - 3, 7, 9);
+  TEST_ASSERT_TRUE(EEPROMLegacyLoad(legacy));
+  TEST_ASSERT_EQUAL_UINT8(7, legacy.channel_left_step_value);
+  TEST_ASSERT_EQUAL_UINT8(9, legacy.channel_right_step_value);
+
+  /* A second different record makes the search ambiguous */
+  legacyWrite(0x1C5, 3, 4);
+  TEST_ASSERT_FALSE(EEPROMLegacyLoad(legacy));
+}
+
+/**
+ * @brief Function runs the EEPROMStore tests
+ * @param argument: None
+ * @retval None
+ */
+void runEepromStoreTests(void)
+{
+  RUN_TEST(test_erased_eeprom_loads_defaults);
+  RUN_TEST(test_save_writes_changed_data_only);
+  RUN_TEST(test_reset_restores_defaults_load_returns_saved);
+  RUN_TEST(test_begin_loads_saved_record);
+  RUN_TEST(test_checksum_error_loads_defaults);
+  RUN_TEST(test_legacy_record_found_at_any_address);
+}
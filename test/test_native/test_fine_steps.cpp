@@ -0,0 +1,154 @@
+/**
+**********************************************************************************************************************
+*    @file           : test_fine_steps.cpp
+*    @brief          : test_fine_steps.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Full resolution tests: potentiometerStepTransaction() moves the wiper by the difference only (no re-homing),
+*    the controller accelerates held fine steps and jumps coarse steps from the wiper position.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <string.h>
+
+#include "test_support.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define TEST_NEC_REPEAT_PERIOD  (108)       /* ms between the repeats of a held button */
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static void test_step_transaction_moves_by_difference(void)
+{
+  X9C102_potentiometer potentiometer(UD_POTENTIOMETER_GPIO, INC_POTENTIOMETER_GPIO);
+  PulseCounter counter;
+
+  CSportInit();
+  potentiometer.potentiometerInit();
+
+  /* The left chip is wired DIRECTION_DOWN: a higher value moves the wiper down */
+  potentiometer.potentiometerTransaction(CHANNEL_MASK(LEFT_CHANNEL_INDEX), 40, DIRECTION_DOWN);
+
+  counter.clear();
+  potentiometer.potentiometerStepTransaction(CHANNEL_MASK(LEFT_CHANNEL_INDEX), 40, 43, DIRECTION_DOWN);
+  TEST_ASSERT_EQUAL_UINT32(3, counter.down_steps);
+  TEST_ASSERT_EQUAL_UINT32(0, counter.up_steps);
+  TEST_ASSERT_EQUAL_UINT32(3, counter.selected_steps[LEFT_CHANNEL_INDEX]);
+
+  counter.clear();
+  potentiometer.potentiometerStepTransaction(CHANNEL_MASK(LEFT_CHANNEL_INDEX), 43, 40, DIRECTION_DOWN);
+  TEST_ASSERT_EQUAL_UINT32(3, counter.up_steps);
+  TEST_ASSERT_EQUAL_UINT32(0, counter.down_steps);
+
+  counter.clear();
+  potentiometer.potentiometerStepTransaction(CHANNEL_MASK(LEFT_CHANNEL_INDEX), 40, 41, DIRECTION_UP);
+  TEST_ASSERT_EQUAL_UINT32(1, counter.up_steps);
+  TEST_ASSERT_EQUAL_UINT32(0, counter.down_steps);
+
+  /* Zero step: no pulse */
+  counter.clear();
+  potentiometer.potentiometerStepTransaction(CHANNEL_MASK(LEFT_CHANNEL_INDEX), 41, 41, DIRECTION_UP);
+  TEST_ASSERT_EQUAL_UINT32(0, counter.up_steps + counter.down_steps);
+
+  TEST_ASSERT_EQUAL_HEX8(0, CSportSelected());
+  TEST_ASSERT_EQUAL_HEX8(0, chipSelectLow());
+}
+
+static void test_held_button_accelerates(void)
+{
+  static const uint8_t expected_steps[] = {1, 1, 1, 1, 2, 2, 2, 2, 4, 4, 4, 4, 8, 8, 8, 8};
+
+  TapBackend backend = {};
+  VuController<TestFineConfig, TapBackend> controller(backend);
+  uint8_t stored[VU_CHANNEL_COUNT] = {};
+  uint32_t time = 1000;
+
+  controller.begin(stored, time);
+  controller.dispatch(SELECT_LEFT_CHANNEL_CMD_RAW, time);
+
+  for (uint8_t i = 0; i < sizeof(expected_steps); i++) {
+    time += TEST_NEC_REPEAT_PERIOD;
+    TEST_ASSERT_EQUAL(IR_CMD_VALUE_DOWN, controller.dispatch(DECREASE_VU_VALUE_CMD_RAW, time));
+    TEST_ASSERT_EQUAL_UINT8(expected_steps[i], backend.last_step);
+  }
+  TEST_ASSERT_EQUAL_UINT8(60, controller.channelValue(LEFT_CHANNEL_INDEX));
+
+  /* A pause longer than accel_window restarts with 1 tap */
+  time += TestFineConfig::accel_window + 1;
+  controller.dispatch(DECREASE_VU_VALUE_CMD_RAW, time);
+  TEST_ASSERT_EQUAL_UINT8(1, backend.last_step);
+
+  /* The other direction restarts with 1 tap */
+  controller.dispatch(INCREASE_VU_VALUE_CMD_RAW, time + 10);
+  TEST_ASSERT_EQUAL_UINT8(1, backend.last_step);
+  TEST_ASSERT_EQUAL_UINT8(60, controller.channelValue(LEFT_CHANNEL_INDEX));
+}
+
+static void test_coarse_steps_from_wiper_position(void)
+{
+  TapBackend backend = {};
+  VuController<TestFineConfig, TapBackend> controller(backend);
+  uint8_t stored[VU_CHANNEL_COUNT];
+
+  memset(stored, 60, sizeof(stored));
+  controller.begin(stored, 0);
+  backend.transactions = 0;
+  controller.dispatch(SELECT_LEFT_CHANNEL_CMD_RAW, 0);
+
+  TEST_ASSERT_EQUAL(IR_CMD_VALUE_UP, controller.dispatch(INCREASE_VU_VALUE_COARSE_CMD_RAW, 10));
+  TEST_ASSERT_EQUAL_UINT8(TestFineConfig::coarse_step, backend.last_step);
+  TEST_ASSERT_EQUAL_UINT8(60 - TestFineConfig::coarse_step, controller.channelValue(LEFT_CHANNEL_INDEX));
+
+  /* Coarse down stops at the high boundary */
+  for (uint8_t i = 0; i < 10; i++) {
+    controller.dispatch(DECREASE_VU_VALUE_COARSE_CMD_RAW, 20);
+  }
+  TEST_ASSERT_EQUAL_UINT8(TestFineConfig::high_boundary, controller.channelValue(LEFT_CHANNEL_INDEX));
+  TEST_ASSERT_EQUAL(IR_CMD_VALUE_LIMIT, controller.dispatch(DECREASE_VU_VALUE_COARSE_CMD_RAW, 30));
+
+  /* Up/down move the wiper from its position, no re-homing write */
+  TEST_ASSERT_EQUAL_UINT32(0, backend.transactions);
+  TEST_ASSERT_EQUAL_UINT32(0, backend.step_from_mismatches);
+  TEST_ASSERT_EQUAL_UINT8(controller.channelTap(LEFT_CHANNEL_INDEX), backend.tap[LEFT_CHANNEL_INDEX]);
+}
+
+static void test_coarse_commands_unknown_without_full_resolution(void)
+{
+  NullBackend backend;
+  VuController<VuConfig, NullBackend> controller(backend);
+
+  if constexpr (VuConfig::full_resolution) {
+    TEST_IGNORE_MESSAGE("POTENTIOMETER_FULL_RESOLUTION is on");
+  } else {
+    TEST_ASSERT_EQUAL(IR_CMD_UNKNOWN, controller.dispatch(INCREASE_VU_VALUE_COARSE_CMD_RAW, 0));
+  }
+}
+
+/**
+ * @brief Function runs the full resolution tests
+ * @param argument: None
+ * @retval None
+ */
+void runFineStepTests(void)
+{
+  RUN_TEST(test_step_transaction_moves_by_difference);
+  RUN_TEST(test_held_button_accelerates);
+  RUN_TEST(test_coarse_steps_from_wiper_position);
+  RUN_TEST(test_coarse_commands_unknown_without_full_resolution);
+}
@@ -0,0 +1,108 @@
+/**
+**********************************************************************************************************************
+*    @file           : test_inc_timer.cpp
+*    @brief          : test_inc_timer.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Timer1 INC pulse tests (POTENTIOMETER_HW_PULSES on, pio test -e native_hw_pulses): pulse count of a burst, INC
+*    edges exactly POTENTIOMETER_HW_TICK apart, Timer1 stopped with INC low after the burst, and the pulse count
+*    under a late compare ISR.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "test_support.h"
+
+#if (POTENTIOMETER_HW_PULSES == STD_ON)
+
+#include "inc_timer_LL.h"
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static void test_burst_pulse_count_and_edges(void)
+{
+  X9C102_potentiometer potentiometer(UD_POTENTIOMETER_GPIO, INC_POTENTIOMETER_GPIO);
+
+  potentiometer.potentiometerInit();
+
+  PulseCounter counter;
+  IncPhaseMonitor phases;
+
+  INCtimerPulses(POTENTIOMETER_RESOLUTION);
+
+  TEST_ASSERT_EQUAL_UINT32(POTENTIOMETER_RESOLUTION, counter.up_steps + counter.down_steps);
+
+  /* Every phase is exactly POTENTIOMETER_HW_TICK */
+  TEST_ASSERT_EQUAL_UINT32(POTENTIOMETER_HW_TICK * 1000UL, (uint32_t)phases.min_ns);
+  TEST_ASSERT_EQUAL_UINT32(POTENTIOMETER_HW_TICK * 1000UL, (uint32_t)phases.max_ns);
+}
+
+static void test_burst_stops_timer_inc_low(void)
+{
+  X9C102_potentiometer potentiometer(UD_POTENTIOMETER_GPIO, INC_POTENTIOMETER_GPIO);
+
+  potentiometer.potentiometerInit();
+  INCtimerPulses(POTENTIOMETER_RESOLUTION);
+
+  /* Timer1 stopped, OC1A disconnected, INC low until INCtimerIdle() */
+  TEST_ASSERT_EQUAL(LOW, digitalRead(INC_POTENTIOMETER_GPIO));
+  TEST_ASSERT_EQUAL_HEX8(0, TCCR1A);
+  TEST_ASSERT_EQUAL_HEX8(0, TCCR1B);
+
+  /* A burst starting low has the same falling edge count */
+  PulseCounter counter;
+
+  INCtimerPulses(POTENTIOMETER_RESOLUTION);
+  TEST_ASSERT_EQUAL_UINT32(POTENTIOMETER_RESOLUTION, counter.up_steps + counter.down_steps);
+
+  INCtimerIdle();
+  TEST_ASSERT_EQUAL(HIGH, digitalRead(INC_POTENTIOMETER_GPIO));
+  TEST_ASSERT_EQUAL_HEX8(0, TCCR1A);
+}
+
+static void test_late_compare_isr_keeps_pulse_count(void)
+{
+  X9C102_potentiometer potentiometer(UD_POTENTIOMETER_GPIO, INC_POTENTIOMETER_GPIO);
+  uint32_t isr_overhead_ns = hal::timing.isr_overhead_ns;
+
+  potentiometer.potentiometerInit();
+
+  PulseCounter counter;
+  IncPhaseMonitor phases;
+
+  /* The compare ISR starts later than the next edge is due, the phases get longer only */
+  hal::timing.isr_overhead_ns = 3 * POTENTIOMETER_HW_TICK * 1000UL;
+  INCtimerPulses(POTENTIOMETER_RESOLUTION);
+  hal::timing.isr_overhead_ns = isr_overhead_ns;
+
+  TEST_ASSERT_EQUAL_UINT32(POTENTIOMETER_RESOLUTION, counter.up_steps + counter.down_steps);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1000, (uint32_t)std::min<uint64_t>(phases.min_ns, UINT32_MAX));
+}
+
+#endif
+
+/**
+ * @brief Function runs the Timer1 INC pulse tests
+ * @param argument: None
+ * @retval None
+ */
+void runIncTimerTests(void)
+{
+#if (POTENTIOMETER_HW_PULSES == STD_ON)
+  RUN_TEST(test_burst_pulse_count_and_edges);
+  RUN_TEST(test_burst_stops_timer_inc_low);
+  RUN_TEST(test_late_compare_isr_keeps_pulse_count);
+#endif
+}
@@ -0,0 +1,186 @@
+/**
+**********************************************************************************************************************
+*    @file           : test_levels.cpp
+*    @brief          : test_levels.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Calibrated level tests (VuLevels with X9C102s at the +-20% tolerance ends): the tap of every level is the
+*    nearest to the level resistance computed with the host floating point, the percent and dB lookups, the
+*    controller stepping levels and writing the calibrated taps. The level table is printed as test messages.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <math.h>
+#include <string.h>
+
+#include "test_support.h"
+#include "vu_levels.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Configs------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*Calibrated levels, channel 1 and 2 with X9C102s at the +-20% tolerance ends*/
+struct TestLevelConfig : VuConfig
+{
+  static constexpr bool full_resolution = false;
+  static constexpr uint8_t low_boundary = POTENTIOMETER_LOW_BOUNDRY;
+  static constexpr uint8_t high_boundary = POTENTIOMETER_HIGH_BOUNDRY;
+  static constexpr bool level_calibration = true;
+  static constexpr uint16_t channel_step_ohm[VU_CONFIG_MAX_CHANNELS] = {3000, 3600, 2400, 3000,
+                                                                         3000, 3000, 3000, 3000};
+};
+
+typedef VuLevels<TestLevelConfig> Levels;
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define TEST_LAST_LEVEL         (Levels::level_count - 1)
+#define TEST_LEVEL_CHANNELS     ((VU_CHANNEL_COUNT < 3) ? VU_CHANNEL_COUNT : 3)
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Function returns the series resistance of a tap of a channel
+ * @param argument: uint8_t channel, uint8_t tap
+ * @retval double - Ohm
+ */
+static double levelTapOhm(uint8_t channel, uint8_t tap)
+{
+  return (double)tap * TestLevelConfig::channel_step_ohm[channel] + TestLevelConfig::wiper_ohm;
+}
+
+/**
+ * @brief Function returns the series resistance of a level from its definition, with the host floating point
+ * @param argument: uint8_t level
+ * @retval double - Ohm
+ */
+static double levelTargetOhm(uint8_t level)
+{
+  const double min_ohm = levelTapOhm(LEFT_CHANNEL_INDEX, TestLevelConfig::low_boundary);
+
+  return (TestLevelConfig::level_input_ohm + min_ohm) * pow(10.0, level * TestLevelConfig::level_step_cdb / 2000.0) -
+         TestLevelConfig::level_input_ohm;
+}
+
+static void test_level_table_spans_boundaries(void)
+{
+  TEST_ASSERT_EQUAL_UINT8(13, Levels::level_count);               /* 1 dB levels between the default boundaries */
+  TEST_ASSERT_EQUAL_UINT8(TestLevelConfig::low_boundary, Levels::tap(LEFT_CHANNEL_INDEX, 0));
+  TEST_ASSERT_EQUAL_UINT8(TestLevelConfig::high_boundary, Levels::tap(LEFT_CHANNEL_INDEX, TEST_LAST_LEVEL));
+  TEST_ASSERT_EQUAL_UINT8(POTETNIOMETER_RESET_VALUE, Levels::tap(LEFT_CHANNEL_INDEX, TestLevelConfig::reset_level));
+}
+
+static void test_level_taps_nearest_and_monotonic(void)
+{
+  char message[96];
+
+  for (uint8_t level = 0; level < Levels::level_count; level++) {
+    double target = levelTargetOhm(level);
+    int length = snprintf(message, sizeof(message), "level %2u %6d x0.01 dB:", level, Levels::levelCdb(level));
+
+    for (uint8_t channel = 0; channel < TEST_LEVEL_CHANNELS; channel++) {
+      uint8_t tap = Levels::tap(channel, level);
+      double error = fabs(levelTapOhm(channel, tap) - target);
+
+      length += snprintf(&message[length], sizeof(message) - length, " tap %2u", tap);
+
+      /* The nearest tap, unless clamped to a boundary */
+      if (tap > TestLevelConfig::low_boundary) {
+        TEST_ASSERT_TRUE(fabs(levelTapOhm(channel, tap - 1) - target) >= error);
+      }
+      if (tap < TestLevelConfig::high_boundary) {
+        TEST_ASSERT_TRUE(fabs(levelTapOhm(channel, tap + 1) - target) >= error);
+      }
+      if (level > 0) {
+        TEST_ASSERT_TRUE(tap >= Levels::tap(channel, level - 1));
+      }
+    }
+
+    TEST_MESSAGE(message);
+  }
+
+  /* +20% step resistance needs fewer taps */
+  TEST_ASSERT_LESS_THAN_UINT8(Levels::tap(LEFT_CHANNEL_INDEX, TEST_LAST_LEVEL),
+                              Levels::tap(RIGHT_CHANNEL_INDEX, TEST_LAST_LEVEL));
+}
+
+static void test_percent_and_db_lookups(void)
+{
+  /* Percent table ends */
+  TEST_ASSERT_EQUAL_UINT8(0, Levels::levelOfPercent(100));
+  TEST_ASSERT_EQUAL_UINT8(TEST_LAST_LEVEL, Levels::levelOfPercent(0));
+  TEST_ASSERT_EQUAL_UINT8(0, Levels::levelOfPercent(255));
+
+  /* Percent -> nearest dB level */
+  TEST_ASSERT_EQUAL_UINT8(6, Levels::levelOfPercent(50));
+  TEST_ASSERT_EQUAL_UINT8(3, Levels::levelOfPercent(71));
+
+  /* dB -> nearest level */
+  TEST_ASSERT_EQUAL_UINT8(0, Levels::levelOfCdb(0));
+  TEST_ASSERT_EQUAL_UINT8(6, Levels::levelOfCdb(-649));
+  TEST_ASSERT_EQUAL_UINT8(7, Levels::levelOfCdb(-651));
+  TEST_ASSERT_EQUAL_UINT8(TEST_LAST_LEVEL, Levels::levelOfCdb(-30000));
+  TEST_ASSERT_EQUAL_UINT8(0, Levels::levelOfCdb(500));
+
+  for (uint8_t level = 0; level < Levels::level_count; level++) {
+    TEST_ASSERT_EQUAL_UINT8(level, Levels::levelOfCdb(Levels::levelCdb(level)));
+  }
+}
+
+static void test_controller_writes_calibrated_taps(void)
+{
+  TapBackend backend = {};
+  VuController<TestLevelConfig, TapBackend> controller(backend);
+  uint8_t stored[VU_CHANNEL_COUNT];
+
+  /* Stored level clamped to the levels */
+  memset(stored, 0xFF, sizeof(stored));
+  controller.begin(stored, 0);
+  TEST_ASSERT_EQUAL_UINT8(TEST_LAST_LEVEL, controller.channelValue(LEFT_CHANNEL_INDEX));
+  TEST_ASSERT_EQUAL_UINT8(Levels::tap(LEFT_CHANNEL_INDEX, TEST_LAST_LEVEL), backend.tap[LEFT_CHANNEL_INDEX]);
+
+  /* Value up by one level */
+  controller.dispatch(SELECT_LEFT_CHANNEL_CMD_RAW, 0);
+  controller.dispatch(INCREASE_VU_VALUE_CMD_RAW, 0);
+  TEST_ASSERT_EQUAL_UINT8(TEST_LAST_LEVEL - 1, controller.channelValue(LEFT_CHANNEL_INDEX));
+  TEST_ASSERT_EQUAL_UINT8(Levels::tap(LEFT_CHANNEL_INDEX, TEST_LAST_LEVEL - 1), backend.tap[LEFT_CHANNEL_INDEX]);
+
+  /* Factory reset writes the calibrated reset tap of every channel */
+  backend.transactions = 0;
+  controller.dispatch(FACTORY_RESET_VU_VAL_CMD_RAW, 0);
+  TEST_ASSERT_EQUAL_UINT32(VU_CHANNEL_COUNT, backend.transactions);
+
+  for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+    TEST_ASSERT_EQUAL_UINT8(TestLevelConfig::reset_level, controller.channelValue(channel));
+    TEST_ASSERT_EQUAL_UINT8(Levels::tap(channel, TestLevelConfig::reset_level), backend.tap[channel]);
+  }
+}
+
+/**
+ * @brief Function runs the calibrated level tests
+ * @param argument: None
+ * @retval None
+ */
+void runLevelTests(void)
+{
+  RUN_TEST(test_level_table_spans_boundaries);
+  RUN_TEST(test_level_taps_nearest_and_monotonic);
+  RUN_TEST(test_percent_and_db_lookups);
+  RUN_TEST(test_controller_writes_calibrated_taps);
+}
@@ -0,0 +1,75 @@
+/**
+**********************************************************************************************************************
+*    @file           : test_main.cpp
+*    @brief          : test_main.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Runner of the native Unity suite, every test group lives in its own file:
+*
+*      pio test -e native
+*      pio test -e native_cs_fanout              (8 channels on the 74HC595 CS fan-out)
+*      pio test -e native_hw_pulses              (INC pulses from the Timer1 output compare)
+*
+*    The firmware sources are linked (test_build_src), the tests drive them through the native HAL registers.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "test_support.h"
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+volatile uint32_t test_sink;
+ShiftRegisterModel *shift_register;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+int main(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+
+  ShiftRegisterModel fanout_model;
+
+  hal::serialSetSink(NULL);
+  shift_register = &fanout_model;
+
+  UNITY_BEGIN();
+  runPotentiometerTests();
+  runIncTimerTests();
+  runChipSelectTests();
+  runChipSelectFanoutTests();
+  runTransactionTests();
+  runEepromStoreTests();
+  runDispatchTests();
+  runLevelTests();
+  runFineStepTests();
+  runWiperResyncTests();
+  runSerialConsoleTests();
+  runDebugLogTests();
+  runBenchmarkTests();
+
+  return UNITY_END();
+}
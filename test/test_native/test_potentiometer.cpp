@@ -0,0 +1,97 @@
+/**
+**********************************************************************************************************************
+*    @file           : test_potentiometer.cpp
+*    @brief          : test_potentiometer.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    X9C102_potentiometer tests: INC idle level after init, pulse counts per direction (full scale reset, then the
+*    value steps) and the INC low/high times.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "test_support.h"
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static void test_init_leaves_inc_high(void)
+{
+  X9C102_potentiometer potentiometer(UD_POTENTIOMETER_GPIO, INC_POTENTIOMETER_GPIO);
+
+  digitalWrite(INC_POTENTIOMETER_GPIO, LOW);
+  potentiometer.potentiometerInit();
+
+  TEST_ASSERT_EQUAL(HIGH, digitalRead(INC_POTENTIOMETER_GPIO));
+}
+
+static void test_set_value_pulse_counts_per_direction(void)
+{
+  const uint8_t values[] = {0, POTENTIOMETER_LOW_BOUNDRY, POTETNIOMETER_RESET_VALUE, POTENTIOMETER_HIGH_BOUNDRY, 99};
+
+  X9C102_potentiometer potentiometer(UD_POTENTIOMETER_GPIO, INC_POTENTIOMETER_GPIO);
+  PulseCounter counter;
+
+  /* No priming write: the first write after init has to step the full scale as well */
+  potentiometer.potentiometerInit();
+
+  for (size_t i = 0; i < sizeof(values); i++) {
+    /* DIRECTION_UP: full scale down, then the value steps up */
+    counter.clear();
+    potentiometer.potentiometerSetVal(values[i], DIRECTION_UP);
+    TEST_ASSERT_EQUAL_UINT32(POTENTIOMETER_RESOLUTION, counter.down_steps);
+    TEST_ASSERT_EQUAL_UINT32(values[i], counter.up_steps);
+
+    /* DIRECTION_DOWN: full scale up, then the value steps down */
+    counter.clear();
+    potentiometer.potentiometerSetVal(values[i], DIRECTION_DOWN);
+    TEST_ASSERT_EQUAL_UINT32(POTENTIOMETER_RESOLUTION, counter.up_steps);
+    TEST_ASSERT_EQUAL_UINT32(values[i], counter.down_steps);
+  }
+}
+
+static void test_inc_phases_meet_datasheet(void)
+{
+  X9C102_potentiometer potentiometer(UD_POTENTIOMETER_GPIO, INC_POTENTIOMETER_GPIO);
+  char message[80];
+
+  potentiometer.potentiometerInit();
+
+  IncPhaseMonitor phases;
+  uint64_t start_ns = hal::now_ns();
+  uint64_t start_sleep_ns = hal::sleepTotalNs();
+
+  potentiometer.potentiometerSetVal(POTENTIOMETER_HIGH_BOUNDRY, DIRECTION_DOWN);
+
+  uint64_t busy_ns = (hal::now_ns() - start_ns) - (hal::sleepTotalNs() - start_sleep_ns);
+
+  /* tIL/tIH >= 1 us */
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1000, (uint32_t)std::min<uint64_t>(phases.min_ns, UINT32_MAX));
+
+  snprintf(message, sizeof(message), "INC low/high time >= %.2f us, CPU busy %.2f us per step", phases.min_ns / 1000.0,
+           (double)busy_ns / (POTENTIOMETER_RESOLUTION + POTENTIOMETER_HIGH_BOUNDRY) / 1000.0);
+  TEST_MESSAGE(message);
+}
+
+/**
+ * @brief Function runs the X9C102_potentiometer tests
+ * @param argument: None
+ * @retval None
+ */
+void runPotentiometerTests(void)
+{
+  RUN_TEST(test_init_leaves_inc_high);
+  RUN_TEST(test_set_value_pulse_counts_per_direction);
+  RUN_TEST(test_inc_phases_meet_datasheet);
+}
@@ -0,0 +1,247 @@
+/**
+**********************************************************************************************************************
+*    @file           : test_serial_console.cpp
+*    @brief          : test_serial_console.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Serial console tests: ConsoleReader decoding of requests built like tools/vu_console.py (COBS, CRC16,
+*    delimiter), dropped frames with a bad CRC or an overflow, the batched channel writes of VuController::setValues()
+*    (validated first, one transaction per group of channels with the same move).
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <string.h>
+
+#include <util/crc16.h>
+#include "test_support.h"
+#include "serial_console.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+typedef VuController<VuConfig, TapBackend> BatchController;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Function builds a console request like tools/vu_console.py: CRC16, COBS, delimiter
+ * @param argument: uint8_t *frame, uint8_t command, uint16_t request_id, const uint8_t *payload, uint8_t length
+ * @retval uint8_t - frame length
+ */
+static uint8_t consoleFrame(uint8_t *frame, uint8_t command, uint16_t request_id, const uint8_t *payload,
+                            uint8_t length)
+{
+  uint8_t body[CONSOLE_MAX_FRAME_SIZE];
+  uint8_t body_length = 0;
+  uint16_t crc = 0;
+
+  body[body_length++] = CONSOLE_VERSION;
+  body[body_length++] = command;
+  body[body_length++] = (uint8_t)request_id;
+  body[body_length++] = (uint8_t)(request_id >> 8);
+  memcpy(&body[body_length], payload, length);
+  body_length = (uint8_t)(body_length + length);
+
+  for (uint8_t i = 0; i < body_length; i++) {
+    crc = _crc16_update(crc, body[i]);
+  }
+
+  body[body_length++] = (uint8_t)crc;
+  body[body_length++] = (uint8_t)(crc >> 8);
+
+  uint8_t code_index = 0;
+  uint8_t frame_length = 1;
+
+  for (uint8_t i = 0; i < body_length; i++) {
+    if (body[i] == 0) {
+      frame[code_index] = (uint8_t)(frame_length - code_index);
+      code_index = frame_length++;
+    } else {
+      frame[frame_length++] = body[i];
+    }
+  }
+
+  frame[code_index] = (uint8_t)(frame_length - code_index);
+  frame[frame_length++] = CONSOLE_FRAME_DELIMITER;
+
+  return frame_length;
+}
+
+/**
+ * @brief Function feeds a frame to the reader
+ * @param argument: ConsoleReader &reader, const uint8_t *frame, uint8_t length
+ * @retval uint8_t - number of complete requests
+ */
+static uint8_t consoleFeed(ConsoleReader &reader, const uint8_t *frame, uint8_t length)
+{
+  uint8_t complete = 0;
+
+  for (uint8_t i = 0; i < length; i++) {
+    complete = (uint8_t)(complete + (reader.feed(frame[i]) ? 1 : 0));
+  }
+
+  return complete;
+}
+
+/**
+ * @brief Function starts a batch controller at the high value, the channel list is 0..VU_CHANNEL_COUNT-1
+ * @param argument: BatchController &controller, uint8_t *channels, uint8_t *values
+ * @retval None
+ */
+static void batchBegin(BatchController &controller, uint8_t *channels, uint8_t *values)
+{
+  for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+    channels[channel] = channel;
+    values[channel] = BatchController::value_high;
+  }
+
+  controller.begin(values, 0);
+}
+
+static void test_request_decoded_at_delimiter(void)
+{
+  const uint8_t payload[] = {0, 7, 1, 0};       /* Zero bytes in the payload go through the COBS encoding */
+
+  ConsoleReader reader;
+  uint8_t frame[CONSOLE_MAX_FRAME_SIZE + 2];
+  uint8_t length = consoleFrame(frame, CONSOLE_CMD_SET_BATCH, 0x1200, payload, sizeof(payload));
+
+  TEST_ASSERT_EQUAL_UINT8(1, consoleFeed(reader, frame, length));
+  TEST_ASSERT_EQUAL_UINT8(CONSOLE_CMD_SET_BATCH, reader.command());
+  TEST_ASSERT_EQUAL_UINT8(CONSOLE_VERSION, reader.version());
+  TEST_ASSERT_EQUAL_UINT16(0x1200, reader.requestId());
+  TEST_ASSERT_EQUAL_UINT8(sizeof(payload), reader.payloadLength());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(payload, reader.payload(), sizeof(payload));
+}
+
+static void test_bad_crc_and_overflow_dropped(void)
+{
+  ConsoleReader reader;
+  uint8_t frame[CONSOLE_MAX_FRAME_SIZE + 2];
+  uint8_t garbage[CONSOLE_MAX_FRAME_SIZE + 8];
+  uint8_t length = consoleFrame(frame, CONSOLE_CMD_QUERY_STATE, 3, NULL, 0);
+
+  frame[length - 2] ^= 0x01;
+  TEST_ASSERT_EQUAL_UINT8(0, consoleFeed(reader, frame, length));
+  TEST_ASSERT_EQUAL_UINT32(1, reader.errors());
+
+  /* The next request is decoded after the delimiter of the overflow */
+  memset(garbage, 0x55, sizeof(garbage));
+  consoleFeed(reader, garbage, sizeof(garbage));
+  reader.feed(CONSOLE_FRAME_DELIMITER);
+  reader.feed(CONSOLE_FRAME_DELIMITER);
+  length = consoleFrame(frame, CONSOLE_CMD_QUERY_STATE, 3, NULL, 0);
+  TEST_ASSERT_EQUAL_UINT8(1, consoleFeed(reader, frame, length));
+  TEST_ASSERT_EQUAL_UINT32(2, reader.errors());
+  TEST_ASSERT_EQUAL_UINT32(1, reader.frames());
+  TEST_ASSERT_EQUAL_UINT8(0, reader.payloadLength());
+}
+
+static void test_invalid_batch_changes_nothing(void)
+{
+  TapBackend backend = {};
+  BatchController controller(backend);
+  uint8_t channels[VU_CHANNEL_COUNT];
+  uint8_t values[VU_CHANNEL_COUNT];
+
+  batchBegin(controller, channels, values);
+  backend.transactions = 0;
+
+  values[VU_CHANNEL_COUNT - 1] = (uint8_t)(BatchController::value_high + 1);
+  TEST_ASSERT_FALSE(controller.setValues(channels, values, VU_CHANNEL_COUNT, 0));
+  TEST_ASSERT_EQUAL_UINT8(BatchController::value_high, controller.channelValue(0));
+
+  values[VU_CHANNEL_COUNT - 1] = BatchController::value_low;
+  channels[0] = VU_CHANNEL_COUNT;
+  TEST_ASSERT_FALSE(controller.setValues(channels, values, VU_CHANNEL_COUNT, 0));
+
+  TEST_ASSERT_EQUAL_UINT32(0, backend.transactions);
+}
+
+static void test_batch_one_transaction_per_group(void)
+{
+  TapBackend backend = {};
+  BatchController controller(backend);
+  uint8_t channels[VU_CHANNEL_COUNT];
+  uint8_t values[VU_CHANNEL_COUNT];
+  uint8_t from[VU_CHANNEL_COUNT];
+  uint32_t groups = 0;
+
+  batchBegin(controller, channels, values);
+
+  for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+    from[channel] = controller.channelTap(channel);
+  }
+
+  backend.transactions = 0;
+  memset(values, BatchController::value_low, sizeof(values));
+  TEST_ASSERT_TRUE(controller.setValues(channels, values, VU_CHANNEL_COUNT, 0));
+
+  /* A group: the channels with the same tap and direction (and start tap in full resolution) */
+  for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+    bool first_f = true;
+
+    for (uint8_t other = 0; other < channel; other++) {
+      if (controller.channelTap(other) == controller.channelTap(channel) &&
+          BatchController::channelDirection(other) == BatchController::channelDirection(channel) &&
+          (!VuConfig::full_resolution || from[other] == from[channel])) {
+        first_f = false;
+      }
+    }
+
+    groups += first_f ? 1 : 0;
+    TEST_ASSERT_EQUAL_UINT8(controller.channelTap(channel), backend.tap[channel]);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(groups, backend.transactions + backend.step_transactions);
+}
+
+static void test_full_resolution_batch_steps_changed_channel(void)
+{
+  TapBackend backend = {};
+  VuController<TestFineConfig, TapBackend> controller(backend);
+  uint8_t channels[VU_CHANNEL_COUNT];
+  uint8_t values[VU_CHANNEL_COUNT];
+
+  for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+    channels[channel] = channel;
+  }
+
+  memset(values, 40, sizeof(values));
+  controller.begin(values, 0);
+  memcpy(backend.tap, values, sizeof(values));
+
+  values[0] = 45;
+  TEST_ASSERT_TRUE(controller.setValues(channels, values, VU_CHANNEL_COUNT, 0));
+  TEST_ASSERT_EQUAL_UINT32(1, backend.step_transactions);
+  TEST_ASSERT_EQUAL_UINT32(0, backend.step_from_mismatches);
+  TEST_ASSERT_EQUAL_UINT8(45, backend.tap[0]);
+}
+
+/**
+ * @brief Function runs the serial console tests
+ * @param argument: None
+ * @retval None
+ */
+void runSerialConsoleTests(void)
+{
+  RUN_TEST(test_request_decoded_at_delimiter);
+  RUN_TEST(test_bad_crc_and_overflow_dropped);
+  RUN_TEST(test_invalid_batch_changes_nothing);
+  RUN_TEST(test_batch_one_transaction_per_group);
+  RUN_TEST(test_full_resolution_batch_steps_changed_channel);
+}
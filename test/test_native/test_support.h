@@ -0,0 +1,422 @@
+/**
+**********************************************************************************************************************
+*    @file           : test_support.h
+*    @brief          : test_support.h header file body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Shared fixtures of the native Unity suite (pio test -e native): register observers of the native HAL which count
+*    the INC pulses, measure their phases, watch the CS port writes and model the 74HC595 CS fan-out, IR command back
+*    ends, the full resolution controller configuration, the micro-benchmark helper and the test group runners called
+*    by test_main.cpp.
+*
+*    A benchmark prints the emulated AVR time of one call (virtual clock of the HAL, deterministic, so a changed
+*    number is a real regression) and the host time per call.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+#ifndef TEST_SUPPORT_H_
+#define TEST_SUPPORT_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+
+#include <Arduino.h>
+#include <unity.h>
+#include "X9C102_potentiometer.h"
+#include "cs_port_LL.h"
+#include "vu_controller.h"
+#include "main.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define TEST_STORE_ADDRESS          (256)             /* Away from the firmware configuration record */
+#define TEST_BENCH_ITERATIONS       (20000UL)
+#ifndef TEST_BENCH_HOST_SCALE
+#define TEST_BENCH_HOST_SCALE       (1.0)             /* Host time budgets factor, for slow or instrumented hosts */
+#endif
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Classes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*74HC595 on the SPI: SPDR writes fill the shift register, the rising latch edge copies it to the outputs*/
+class ShiftRegisterModel : public hal::RegisterObserver
+{
+public:
+  uint8_t shift;
+  uint8_t outputs;                              /* Q7..Q0, CS of channel n on Qn, active low */
+  uint32_t latches;
+  uint32_t spi_disabled_writes;                 /* SPDR written without the SPI master set up */
+
+  ShiftRegisterModel()
+  {
+    clear();
+    hal::addObserver(this);
+  }
+
+  virtual ~ShiftRegisterModel() { hal::removeObserver(this); }
+
+  void clear(void)
+  {
+    shift = 0;
+    outputs = 0;                                /* Unknown at power up, the firmware has to latch the idle state */
+    latches = 0;
+    spi_disabled_writes = 0;
+  }
+
+  virtual void onRegisterWrite(hal::RegisterId reg, uint8_t old_value, uint8_t new_value, uint64_t time_ns)
+  {
+    (void)time_ns;
+
+    if (reg == hal::REG_SPDR) {
+      if ((SPCR & ((1 << SPE) | (1 << MSTR))) != ((1 << SPE) | (1 << MSTR)) ||
+          (DDRB & CS_FANOUT_SPI_BITMASK) != CS_FANOUT_SPI_BITMASK) {
+        ++spi_disabled_writes;
+      }
+      shift = new_value;
+    } else if (reg == hal::REG_PORTD && !(old_value & CS_FANOUT_LATCH_MASK) && (new_value & CS_FANOUT_LATCH_MASK)) {
+      outputs = shift;
+      ++latches;
+    }
+  }
+};
+
+extern ShiftRegisterModel *shift_register;       /* Created by the runner, watches every test */
+
+/**
+ * @brief Function returns the channels with the CS line driven low, read from the port or the 74HC595 model
+ * @param argument: None
+ * @retval uint8_t - channel mask
+ */
+inline uint8_t chipSelectLow(void)
+{
+#if (CS_FANOUT == STD_OFF)
+  uint8_t driven_low = (uint8_t)(DDRC.raw() & ~PORTC.raw());
+
+  return (uint8_t)(((driven_low & CS_LEFT_CHANNEL_MASK) ? CHANNEL_MASK(LEFT_CHANNEL_INDEX) : 0) |
+                   ((driven_low & CS_RIGHT_CHANNEL_MASK) ? CHANNEL_MASK(RIGHT_CHANNEL_INDEX) : 0));
+#else
+  return (uint8_t)(~shift_register->outputs & ALL_CHANNELS_MASK);
+#endif
+}
+
+/*Counts the INC falling edges (wiper steps) for both U/D levels and per selected CS line, and the CS releases with
+  INC high (X9C102 wiper stores)*/
+class PulseCounter : public hal::RegisterObserver
+{
+private:
+  hal::PinMapping _inc;
+  hal::PinMapping _ud;
+  uint8_t _selected;
+
+public:
+  uint32_t up_steps;
+  uint32_t down_steps;
+  uint32_t selected_steps[VU_CHANNEL_COUNT];
+  uint32_t stores;
+
+  PulseCounter()
+  {
+    hal::pinMapping(INC_POTENTIOMETER_GPIO, &_inc);
+    hal::pinMapping(UD_POTENTIOMETER_GPIO, &_ud);
+    _selected = chipSelectLow();
+    clear();
+    hal::addObserver(this);
+  }
+
+  virtual ~PulseCounter() { hal::removeObserver(this); }
+
+  void clear(void)
+  {
+    up_steps = 0;
+    down_steps = 0;
+    stores = 0;
+
+    for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+      selected_steps[channel] = 0;
+    }
+  }
+
+  virtual void onRegisterWrite(hal::RegisterId reg, uint8_t old_value, uint8_t new_value, uint64_t time_ns)
+  {
+    (void)time_ns;
+
+    const uint8_t selected = chipSelectLow();
+
+    if ((_selected & (uint8_t)~selected) && (hal::registers[_inc.port].raw() & (1 << _inc.bit))) {
+      ++stores;
+    }
+
+    _selected = selected;
+
+    if (reg != _inc.port || !(old_value & (1 << _inc.bit)) || (new_value & (1 << _inc.bit))) {
+      return;
+    }
+
+    if (hal::registers[_ud.port].raw() & (1 << _ud.bit)) {
+      ++up_steps;
+    } else {
+      ++down_steps;
+    }
+
+    for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+      selected_steps[channel] += (selected & CHANNEL_MASK(channel)) ? 1 : 0;
+    }
+  }
+};
+
+/*Measures the INC low/high times (between the edges on the INC pin)*/
+class IncPhaseMonitor : public hal::RegisterObserver
+{
+private:
+  hal::PinMapping _inc;
+  uint64_t _edge_ns;
+
+public:
+  uint64_t min_ns;
+  uint64_t max_ns;
+  uint32_t edges;
+
+  IncPhaseMonitor()
+  {
+    hal::pinMapping(INC_POTENTIOMETER_GPIO, &_inc);
+    clear();
+    hal::addObserver(this);
+  }
+
+  virtual ~IncPhaseMonitor() { hal::removeObserver(this); }
+
+  void clear(void)
+  {
+    _edge_ns = 0;
+    min_ns = UINT64_MAX;
+    max_ns = 0;
+    edges = 0;
+  }
+
+  virtual void onRegisterWrite(hal::RegisterId reg, uint8_t old_value, uint8_t new_value, uint64_t time_ns)
+  {
+    if (reg != _inc.port || !((old_value ^ new_value) & (1 << _inc.bit))) {
+      return;
+    }
+
+    /* The first edge of a burst follows the idle time, not a phase */
+    if (edges++ > 0) {
+      min_ns = std::min(min_ns, time_ns - _edge_ns);
+      max_ns = std::max(max_ns, time_ns - _edge_ns);
+    }
+
+    _edge_ns = time_ns;
+  }
+};
+
+/*Watches the CS port writes: other PORTC/DDRC bits changed, both CS lines driven low*/
+class ChipSelectMonitor : public hal::RegisterObserver
+{
+public:
+  uint32_t foreign_bit_writes;
+  uint32_t both_selected_writes;
+
+  ChipSelectMonitor()
+  {
+    clear();
+    hal::addObserver(this);
+  }
+
+  virtual ~ChipSelectMonitor() { hal::removeObserver(this); }
+
+  void clear(void)
+  {
+    foreign_bit_writes = 0;
+    both_selected_writes = 0;
+  }
+
+  virtual void onRegisterWrite(hal::RegisterId reg, uint8_t old_value, uint8_t new_value, uint64_t time_ns)
+  {
+    (void)time_ns;
+
+    if (reg != hal::REG_PORTC && reg != hal::REG_DDRC) {
+      return;
+    }
+
+    if ((old_value ^ new_value) & (uint8_t)~CS_ALL_CHANNELS_MASK) {
+      ++foreign_bit_writes;
+    }
+
+    uint8_t ddr = (reg == hal::REG_DDRC) ? new_value : DDRC.raw();
+    uint8_t port = (reg == hal::REG_PORTC) ? new_value : PORTC.raw();
+    uint8_t driven_low = (uint8_t)(ddr & ~port & CS_ALL_CHANNELS_MASK);
+
+    if (driven_low == CS_ALL_CHANNELS_MASK) {
+      ++both_selected_writes;
+    }
+  }
+};
+
+/*IR command back end without side effects, for the dispatch benchmark*/
+class NullBackend
+{
+public:
+  void potentiometerSetVal(uint8_t channel_mask, uint8_t val, potentiometer_direction dir)
+  {
+    (void)channel_mask;
+    (void)val;
+    (void)dir;
+  }
+
+  void potentiometerStepVal(uint8_t channel_mask, uint8_t from, uint8_t to, potentiometer_direction dir)
+  {
+    (void)channel_mask;
+    (void)from;
+    (void)to;
+    (void)dir;
+  }
+
+  bool storeConfig(const uint8_t *channel_values)
+  {
+    return (channel_values[0] ^ channel_values[VU_CHANNEL_COUNT - 1]) & 1;
+  }
+};
+
+/*Records the last tap written to every channel, relative moves have to start at that tap*/
+class TapBackend
+{
+public:
+  uint8_t tap[VU_CHANNEL_COUNT];
+  uint32_t transactions;
+  uint32_t step_transactions;
+  uint32_t step_from_mismatches;                /* potentiometerStepVal() not starting at the wiper */
+  uint8_t last_step;
+
+  void potentiometerStepVal(uint8_t channel_mask, uint8_t from, uint8_t to, potentiometer_direction dir)
+  {
+    (void)dir;
+
+    for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+      if (channel_mask & CHANNEL_MASK(channel)) {
+        step_from_mismatches += (tap[channel] != from) ? 1 : 0;
+        tap[channel] = (to < VU_CONFIG_POTENTIOMETER_TAPS) ? to : (uint8_t)(VU_CONFIG_POTENTIOMETER_TAPS - 1);
+      }
+    }
+
+    last_step = (uint8_t)((to > from) ? to - from : from - to);
+    ++step_transactions;
+  }
+
+  void potentiometerSetVal(uint8_t channel_mask, uint8_t val, potentiometer_direction dir)
+  {
+    (void)dir;
+
+    for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+      if (channel_mask & CHANNEL_MASK(channel)) {
+        tap[channel] = val;
+      }
+    }
+
+    ++transactions;
+  }
+
+  bool storeConfig(const uint8_t *channel_values)
+  {
+    (void)channel_values;
+    return true;
+  }
+};
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Configs------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*All taps, fine/coarse up/down without re-homing*/
+struct TestFineConfig : VuConfig
+{
+  static constexpr bool full_resolution = true;
+  static constexpr uint8_t low_boundary = 0;
+  static constexpr uint8_t high_boundary = VU_CONFIG_POTENTIOMETER_TAPS - 1;
+  static constexpr bool level_calibration = false;
+};
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------------PVs--------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+extern volatile uint32_t test_sink;              /* Keeps the benchmarked results alive */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+
+void runPotentiometerTests(void);
+void runIncTimerTests(void);
+void runChipSelectTests(void);
+void runChipSelectFanoutTests(void);
+void runTransactionTests(void);
+void runEepromStoreTests(void);
+void runDispatchTests(void);
+void runLevelTests(void);
+void runFineStepTests(void);
+void runWiperResyncTests(void);
+void runSerialConsoleTests(void);
+void runDebugLogTests(void);
+void runBenchmarkTests(void);
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Function times a code path and fails when it is over its budget: the emulated AVR time of one call
+ *        (deterministic, budget 0 - compute only, the virtual clock must not advance) and the host time per call
+ *        (scaled by TEST_BENCH_HOST_SCALE)
+ * @param argument: const char *name, TFunction function, unsigned long iterations, uint64_t avr_budget_ns,
+ *                  double host_budget_ns
+ * @retval None
+ */
+template <class TFunction>
+void benchmark(const char *name, TFunction function, unsigned long iterations, uint64_t avr_budget_ns,
+               double host_budget_ns)
+{
+  char message[128];
+  uint64_t start_ns = hal::now_ns();
+  function();
+  uint64_t emulated_ns = hal::now_ns() - start_ns;
+
+  auto start = std::chrono::steady_clock::now();
+
+  for (unsigned long i = 0; i < iterations; i++) {
+    function();
+  }
+
+  double host_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                   iterations;
+
+  host_budget_ns *= TEST_BENCH_HOST_SCALE;
+
+  if (avr_budget_ns == 0) {
+    snprintf(message, sizeof(message), "%-36s                                   host %9.1f ns/call (budget %.0f)",
+             name, host_ns, host_budget_ns);
+  } else {
+    snprintf(message, sizeof(message), "%-36s AVR %10.2f us (budget %10.2f)   host %9.1f ns/call (budget %.0f)",
+             name, (double)emulated_ns / 1000.0, (double)avr_budget_ns / 1000.0, host_ns, host_budget_ns);
+  }
+
+  TEST_MESSAGE(message);
+  TEST_ASSERT_TRUE_MESSAGE(emulated_ns <= avr_budget_ns, "emulated AVR time over the budget");
+  TEST_ASSERT_TRUE_MESSAGE(host_ns <= host_budget_ns, "host time over the budget");
+}
+
+#endif
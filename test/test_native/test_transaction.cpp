@@ -0,0 +1,124 @@
+/**
+**********************************************************************************************************************
+*    @file           : test_transaction.cpp
+*    @brief          : test_transaction.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    potentiometerTransaction() tests: the wiper steps only while the CS lines of its channels are selected, every
+*    transaction releases CS at the end with INC low (no wiper store), and only the store transaction stores the
+*    wipers.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "test_support.h"
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static void test_typed_transaction_steps_left_only(void)
+{
+  X9C102_potentiometer potentiometer(UD_POTENTIOMETER_GPIO, INC_POTENTIOMETER_GPIO);
+  PulseCounter counter;
+
+  CSportInit();
+  potentiometer.potentiometerInit();
+  potentiometer.potentiometerTransaction<LeftChipSelect>(POTETNIOMETER_RESET_VALUE, DIRECTION_DOWN);
+
+  TEST_ASSERT_EQUAL_UINT32(POTENTIOMETER_RESOLUTION + POTETNIOMETER_RESET_VALUE,
+                           counter.selected_steps[LEFT_CHANNEL_INDEX]);
+  TEST_ASSERT_EQUAL_UINT32(0, counter.selected_steps[RIGHT_CHANNEL_INDEX]);
+  TEST_ASSERT_EQUAL_HEX8(0, CSportSelected());
+  TEST_ASSERT_EQUAL_HEX8(0, chipSelectLow());
+}
+
+static void test_channel_transaction_steps_its_channel_only(void)
+{
+  X9C102_potentiometer potentiometer(UD_POTENTIOMETER_GPIO, INC_POTENTIOMETER_GPIO);
+  PulseCounter counter;
+
+  CSportInit();
+  potentiometer.potentiometerInit();
+
+  for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+    counter.clear();
+    potentiometer.potentiometerTransaction(CHANNEL_MASK(channel), POTENTIOMETER_HIGH_BOUNDRY, DIRECTION_UP);
+
+    for (uint8_t other = 0; other < VU_CHANNEL_COUNT; other++) {
+      TEST_ASSERT_EQUAL_UINT32((other == channel) ? POTENTIOMETER_RESOLUTION + POTENTIOMETER_HIGH_BOUNDRY : 0U,
+                               counter.selected_steps[other]);
+    }
+
+    TEST_ASSERT_EQUAL_HEX8(0, CSportSelected());
+    TEST_ASSERT_EQUAL_HEX8(0, chipSelectLow());
+    TEST_ASSERT_EQUAL_UINT32(0, counter.stores);
+    TEST_ASSERT_EQUAL(HIGH, digitalRead(INC_POTENTIOMETER_GPIO));
+  }
+}
+
+static void test_group_transaction_steps_every_channel(void)
+{
+  X9C102_potentiometer potentiometer(UD_POTENTIOMETER_GPIO, INC_POTENTIOMETER_GPIO);
+  PulseCounter counter;
+
+  CSportInit();
+  potentiometer.potentiometerInit();
+  potentiometer.potentiometerTransaction(ALL_CHANNELS_MASK, POTETNIOMETER_RESET_VALUE, DIRECTION_UP);
+
+  for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+    TEST_ASSERT_EQUAL_UINT32(POTENTIOMETER_RESOLUTION + POTETNIOMETER_RESET_VALUE, counter.selected_steps[channel]);
+  }
+
+  TEST_ASSERT_EQUAL_HEX8(0, CSportSelected());
+  TEST_ASSERT_EQUAL_HEX8(0, chipSelectLow());
+}
+
+static void test_only_store_transaction_stores(void)
+{
+  X9C102_potentiometer potentiometer(UD_POTENTIOMETER_GPIO, INC_POTENTIOMETER_GPIO);
+  PulseCounter counter;
+
+  CSportInit();
+  potentiometer.potentiometerInit();
+  potentiometer.potentiometerTransaction<LeftChipSelect>(POTETNIOMETER_RESET_VALUE, DIRECTION_DOWN);
+  potentiometer.potentiometerStepTransaction(ALL_CHANNELS_MASK, POTETNIOMETER_RESET_VALUE,
+                                             POTENTIOMETER_HIGH_BOUNDRY, DIRECTION_UP);
+  potentiometer.potentiometerStepTransaction(ALL_CHANNELS_MASK, POTENTIOMETER_HIGH_BOUNDRY,
+                                             POTETNIOMETER_RESET_VALUE, DIRECTION_UP);
+  TEST_ASSERT_EQUAL_UINT32(0, counter.stores);
+
+  /* No move: no transaction, the release would store */
+  potentiometer.potentiometerStepTransaction(ALL_CHANNELS_MASK, POTETNIOMETER_RESET_VALUE,
+                                             POTETNIOMETER_RESET_VALUE, DIRECTION_UP);
+  TEST_ASSERT_EQUAL_UINT32(0, counter.stores);
+
+  counter.clear();
+  potentiometer.potentiometerStoreTransaction(ALL_CHANNELS_MASK);
+  TEST_ASSERT_EQUAL_UINT32(1, counter.stores);
+  TEST_ASSERT_EQUAL_UINT32(0, counter.up_steps + counter.down_steps);
+  TEST_ASSERT_EQUAL_HEX8(0, chipSelectLow());
+}
+
+/**
+ * @brief Function runs the potentiometerTransaction() tests
+ * @param argument: None
+ * @retval None
+ */
+void runTransactionTests(void)
+{
+  RUN_TEST(test_typed_transaction_steps_left_only);
+  RUN_TEST(test_channel_transaction_steps_its_channel_only);
+  RUN_TEST(test_group_transaction_steps_every_channel);
+  RUN_TEST(test_only_store_transaction_stores);
+}
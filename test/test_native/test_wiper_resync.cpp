@@ -0,0 +1,213 @@
+/**
+**********************************************************************************************************************
+*    @file           : test_wiper_resync.cpp
+*    @brief          : test_wiper_resync.cpp program body
+**********************************************************************************************************************
+*    @author     Volodymyr Noha
+*    @license    MIT (see License.txt)
+*
+*    @description:
+*    Idle wiper resync tests (resync after 1 s without commands): start after the idle period, slew limited ramp
+*    against the end stop and back to the tap, channel after channel, stopped by an IR command with a re-homing
+*    write, the resync counters, and no resync when the feature is off.
+*
+*    @section  HISTORY
+*    v1.0  - First version
+*
+**********************************************************************************************************************
+*/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "test_support.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Configs------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*Idle wiper resync after 1 s without commands*/
+struct TestResyncConfig : VuConfig
+{
+  static constexpr bool wiper_resync = true;
+  static constexpr uint32_t resync_idle_period = 1000;
+};
+
+typedef VuController<TestResyncConfig, TapBackend> ResyncController;
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Constants-----------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define TEST_RESYNC_MAX_CALLS   (1000)      /* Bound of a ramp, far above resync_slew and the taps */
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/**
+ * @brief Function starts a controller from different stored values per channel
+ * @param argument: ResyncController &controller, uint32_t time
+ * @retval None
+ */
+static void resyncBegin(ResyncController &controller, uint32_t time)
+{
+  uint8_t stored[VU_CHANNEL_COUNT];
+
+  for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+    stored[channel] = (uint8_t)(POTENTIOMETER_LOW_BOUNDRY + channel % 4);
+  }
+
+  controller.begin(stored, time);
+}
+
+/**
+ * @brief Function calls wiperResync() every command period until it returns the given result
+ * @param argument: ResyncController &controller, uint32_t *time, irCommandResult result
+ * @retval uint16_t - calls, TEST_RESYNC_MAX_CALLS when the result did not come
+ */
+static uint16_t resyncUntil(ResyncController &controller, uint32_t *time, irCommandResult result)
+{
+  uint16_t calls = 0;
+
+  while (calls < TEST_RESYNC_MAX_CALLS) {
+    *time += TestResyncConfig::command_period;
+    ++calls;
+
+    if (controller.wiperResync(*time) == result) {
+      break;
+    }
+  }
+
+  return calls;
+}
+
+static void test_resync_starts_after_idle_period(void)
+{
+  TapBackend backend = {};
+  ResyncController controller(backend);
+  uint32_t time = 1000;
+
+  resyncBegin(controller, time);
+
+  time += TestResyncConfig::resync_idle_period - 1;
+  TEST_ASSERT_EQUAL(IR_CMD_RESYNC_IDLE, controller.wiperResync(time));
+
+  time += 1;
+  TEST_ASSERT_EQUAL(IR_CMD_RESYNC_STARTED, controller.wiperResync(time));
+  TEST_ASSERT_EQUAL_UINT8(0, controller.resyncChannel());
+}
+
+static void test_ramp_returns_to_tap_slew_limited(void)
+{
+  TapBackend backend = {};
+  ResyncController controller(backend);
+  uint32_t time = 1000;
+  uint16_t calls = 0;
+  uint8_t max_step = 0;
+  irCommandResult result = IR_CMD_RESYNC_IDLE;
+  char message[64];
+
+  resyncBegin(controller, time);
+  time += TestResyncConfig::resync_idle_period;
+  controller.wiperResync(time);
+
+  /* The ramp reaches the quiet end stop, is pushed beyond it and comes back to the tap */
+  while (calls < TEST_RESYNC_MAX_CALLS && result != IR_CMD_RESYNC_DONE) {
+    if (backend.last_step > max_step && backend.last_step != TestResyncConfig::resync_overshoot) {
+      max_step = backend.last_step;
+    }
+
+    time += TestResyncConfig::command_period;
+    result = controller.wiperResync(time);
+    ++calls;
+  }
+
+  TEST_ASSERT_EQUAL(IR_CMD_RESYNC_DONE, result);
+  TEST_ASSERT_EQUAL_UINT32(1, controller.resyncCount(0));
+  TEST_ASSERT_EQUAL_UINT32(0, backend.step_from_mismatches);
+  TEST_ASSERT_EQUAL_UINT8(controller.channelTap(0), backend.tap[0]);
+  TEST_ASSERT_EQUAL_UINT8(TestResyncConfig::resync_slew, max_step);
+
+  snprintf(message, sizeof(message), "channel 0 (tap %u): %u calls of %lu ms", controller.channelTap(0), calls + 1,
+           (unsigned long)TestResyncConfig::command_period);
+  TEST_MESSAGE(message);
+}
+
+static void test_ir_command_stops_ramp_and_rehomes(void)
+{
+  TapBackend backend = {};
+  ResyncController controller(backend);
+  uint32_t time = 1000;
+
+  resyncBegin(controller, time);
+  time += TestResyncConfig::resync_idle_period;
+  controller.wiperResync(time);
+  resyncUntil(controller, &time, IR_CMD_RESYNC_DONE);
+
+  /* The next channel follows */
+  time += TestResyncConfig::command_period;
+  controller.wiperResync(time);
+  time += TestResyncConfig::command_period;
+  controller.wiperResync(time);
+  TEST_ASSERT_EQUAL_UINT8(1, controller.resyncChannel());
+  TEST_ASSERT_TRUE(backend.tap[1] != controller.channelTap(1));
+
+  backend.transactions = 0;
+  controller.dispatch(PRINT_DEBUG_INFO_CMD_RAW, time);
+  TEST_ASSERT_EQUAL_UINT8(NO_CHANNEL_SELECTED, controller.resyncChannel());
+  TEST_ASSERT_EQUAL_UINT32(1, backend.transactions);
+  TEST_ASSERT_EQUAL_UINT8(controller.channelTap(1), backend.tap[1]);
+
+  /* The command restarts the idle period */
+  TEST_ASSERT_EQUAL(IR_CMD_RESYNC_IDLE, controller.wiperResync(time + TestResyncConfig::resync_idle_period - 1));
+}
+
+static void test_every_channel_resynced_once(void)
+{
+  TapBackend backend = {};
+  ResyncController controller(backend);
+  uint32_t time = 1000;
+
+  resyncBegin(controller, time);
+  time += TestResyncConfig::resync_idle_period - TestResyncConfig::command_period;
+  resyncUntil(controller, &time, IR_CMD_RESYNC_STARTED);
+  resyncUntil(controller, &time, IR_CMD_RESYNC_IDLE);
+
+  for (uint8_t channel = 0; channel < VU_CHANNEL_COUNT; channel++) {
+    TEST_ASSERT_EQUAL_UINT32(1, controller.resyncCount(channel));
+    TEST_ASSERT_EQUAL_UINT8(controller.channelTap(channel), backend.tap[channel]);
+  }
+
+  /* Nothing more to resync until the next write */
+  TEST_ASSERT_EQUAL(IR_CMD_RESYNC_IDLE, controller.wiperResync(time + 100000UL));
+}
+
+static void test_no_resync_when_disabled(void)
+{
+  NullBackend backend;
+  VuController<VuConfig, NullBackend> controller(backend);
+  uint8_t stored[VU_CHANNEL_COUNT] = {};
+
+  if constexpr (VuConfig::wiper_resync) {
+    TEST_IGNORE_MESSAGE("WIPER_RESYNC is on");
+  } else {
+    controller.begin(stored, 0);
+    TEST_ASSERT_EQUAL(IR_CMD_RESYNC_IDLE, controller.wiperResync(UINT32_MAX / 2));
+  }
+}
+
+/**
+ * @brief Function runs the idle wiper resync tests
+ * @param argument: None
+ * @retval None
+ */
+void runWiperResyncTests(void)
+{
+  RUN_TEST(test_resync_starts_after_idle_period);
+  RUN_TEST(test_ramp_returns_to_tap_slew_limited);
+  RUN_TEST(test_ir_command_stops_ramp_and_rehomes);
+  RUN_TEST(test_every_channel_resynced_once);
+  RUN_TEST(test_no_resync_when_disabled);
+}
@@ -0,0 +1,293 @@
+# ########################################################################
+#
+#  Description: Flash/SRAM footprint benchmark of the firmware feature
+#               switches (main.h). Builds the micro environment for every
+#               meaningful combination of the switches (PlatformIO,
+#               PLATFORMIO_BUILD_FLAGS), records .text/.data/.bss of the
+#               firmware, of every object file and of every symbol, and
+#               fails when a combination does not leave the configured
+#               headroom below FLASH_VOLUME/RAM_VOLUME (platform.h).
+#  Version: 1.0.0
+#  Author: Volodymyr Noha
+#
+#  Usage:
+#    python3 tools/footprint.py                      (production defaults,
+#                                                     every debug variant and
+#                                                     every single switch)
+#    python3 tools/footprint.py --all --jobs 4       (full cross product)
+#    python3 tools/footprint.py --flash-headroom 2048 --ram-headroom 768
+#    python3 tools/footprint.py --dry-run            (list the combinations)
+#
+# ########################################################################
+
+# import python modules
+import argparse
+import concurrent.futures
+import glob
+import itertools
+import json
+import os
+import re
+import subprocess
+import sys
+
+DEFAULT_ENV = "micro"
+DEFAULT_OUTPUT_DIR = ".pio/footprint"
+DEFAULT_TOOLCHAIN_GLOB = "~/.platformio/packages/toolchain-atmelavr/bin/"
+PLATFORM_HEADER = os.path.join("include", "platform.h")
+
+DEFAULT_FLASH_HEADROOM = 1024       # bytes kept free in flash
+DEFAULT_RAM_HEADROOM = 512          # bytes kept free for the stack
+
+# production values of the main.h switches
+DEFAULTS = {
+    "DEBUG_PRINTER": False,
+    "SOFTWARE_SERIAL_DEBUG": False,
+    "DEBUG_LOG_DEFERRED": True,
+    "DEBUG_IR_FULL_INFO": False,
+    "ARDUINO_PROFILER": False,
+    "AVR_WDT_ENABLE": True,
+    "EEPROM_CHECK_TASK_ENABLE": True,
+    "INIT_POTENTIOMETERS_WITH_EEPROM_VAL": True,
+    "SAMPLING_PROFILER": True,
+    "CS_FANOUT": False,
+    "POTENTIOMETER_HW_PULSES": False,
+    "POTENTIOMETER_FULL_RESOLUTION": False,
+    "WIPER_RESYNC": False,
+    "LEVEL_CALIBRATION": False,
+    "SERIAL_CONSOLE": False,
+    "USB_HID_CONTROL": False,
+    "UNIT_BUS": False,
+}
+
+# switches which only change the firmware when DEBUG_PRINTER is on
+DEBUG_SWITCHES = ("SOFTWARE_SERIAL_DEBUG", "DEBUG_LOG_DEFERRED", "DEBUG_IR_FULL_INFO", "ARDUINO_PROFILER")
+INDEPENDENT_SWITCHES = ("AVR_WDT_ENABLE", "EEPROM_CHECK_TASK_ENABLE", "INIT_POTENTIOMETERS_WITH_EEPROM_VAL",
+                        "SAMPLING_PROFILER", "CS_FANOUT", "POTENTIOMETER_HW_PULSES", "POTENTIOMETER_FULL_RESOLUTION",
+                        "WIPER_RESYNC", "LEVEL_CALIBRATION", "SERIAL_CONSOLE", "USB_HID_CONTROL",
+                        "UNIT_BUS")
+
+SECTION_TYPES = {"t": "text", "T": "text", "w": "text", "W": "text",
+                 "d": "data", "D": "data", "b": "bss", "B": "bss"}
+
+
+def find_tool(name, path):
+    if path:
+        return path
+
+    candidates = glob.glob(os.path.expanduser(DEFAULT_TOOLCHAIN_GLOB + name))
+    if candidates:
+        return candidates[0]
+
+    return name
+
+
+def read_limits(project_dir):
+    """Returns (flash, ram) volume in bytes from platform.h"""
+    with open(os.path.join(project_dir, PLATFORM_HEADER)) as header:
+        source = header.read()
+
+    limits = []
+    for name in ("FLASH_VOLUME", "RAM_VOLUME"):
+        match = re.search(r"#define\s+%s\s+\w*\(?\s*(\d+)" % name, source)
+        if match is None:
+            raise ValueError("%s not found in %s" % (name, PLATFORM_HEADER))
+        limits.append(int(match.group(1)))
+
+    return tuple(limits)
+
+
+def is_meaningful(switches):
+    """Debug sub-switches are ignored without DEBUG_PRINTER, keep them at the defaults then"""
+    if switches["DEBUG_PRINTER"]:
+        return True
+
+    return all(switches[name] == DEFAULTS[name] for name in DEBUG_SWITCHES)
+
+
+def combinations(full_f):
+    """Returns list of switch dicts: production defaults first"""
+    result = [dict(DEFAULTS)]
+
+    def add(switches):
+        if is_meaningful(switches) and switches not in result:
+            result.append(switches)
+
+    if full_f:
+        names = ("DEBUG_PRINTER",) + DEBUG_SWITCHES + INDEPENDENT_SWITCHES
+        for values in itertools.product((False, True), repeat=len(names)):
+            add(dict(zip(names, values)))
+        return result
+
+    # every debug variant with the production switches
+    for values in itertools.product((False, True), repeat=len(DEBUG_SWITCHES)):
+        switches = dict(DEFAULTS, DEBUG_PRINTER=True)
+        switches.update(zip(DEBUG_SWITCHES, values))
+        add(switches)
+
+    # every single switch toggled against the production defaults
+    for name in INDEPENDENT_SWITCHES:
+        add(dict(DEFAULTS, **{name: not DEFAULTS[name]}))
+
+    return result
+
+
+def combination_name(switches):
+    changed = ["%s=%s" % (name, "on" if value else "off")
+               for name, value in switches.items() if value != DEFAULTS[name]]
+    return ",".join(changed) if changed else "production"
+
+
+def build_flags(switches):
+    return " ".join("-D %s=%s" % (name, "STD_ON" if value else "STD_OFF") for name, value in switches.items())
+
+
+def build(project_dir, env_name, build_dir, switches):
+    environment = dict(os.environ, PLATFORMIO_BUILD_FLAGS=build_flags(switches), PLATFORMIO_BUILD_DIR=build_dir)
+    result = subprocess.run(["pio", "run", "-d", project_dir, "-e", env_name], env=environment,
+                            capture_output=True, text=True)
+
+    if result.returncode != 0:
+        raise RuntimeError(result.stdout[-2000:] + result.stderr[-2000:])
+
+    return os.path.join(build_dir, env_name, "firmware.elf")
+
+
+def section_sizes(size_tool, paths):
+    """Returns {path: {"text", "data", "bss"}} from the berkeley format of avr-size"""
+    output = subprocess.run([size_tool, "--format=berkeley"] + paths, check=True, capture_output=True,
+                            text=True).stdout
+    sizes = {}
+
+    for line in output.splitlines()[1:]:
+        fields = line.split(None, 5)
+        if len(fields) == 6:
+            sizes[fields[5]] = {"text": int(fields[0]), "data": int(fields[1]), "bss": int(fields[2])}
+
+    return sizes
+
+
+def symbol_sizes(nm_tool, elf_path):
+    """Returns list of {"name", "section", "size"}, largest first"""
+    output = subprocess.run([nm_tool, "-C", "-S", "--size-sort", "--defined-only", elf_path], check=True,
+                            capture_output=True, text=True).stdout
+    symbols = []
+
+    for line in output.splitlines():
+        fields = line.split(None, 3)
+        if len(fields) == 4 and fields[2] in SECTION_TYPES:
+            symbols.append({"name": fields[3], "section": SECTION_TYPES[fields[2]], "size": int(fields[1], 16)})
+
+    return sorted(symbols, key=lambda symbol: -symbol["size"])
+
+
+def measure(args, switches):
+    name = combination_name(switches)
+    build_dir = os.path.join(os.path.abspath(args.output_dir), "%03d" % args.index[name])
+    elf_path = build(args.project, args.env, build_dir, switches)
+
+    objects = sorted(glob.glob(os.path.join(build_dir, args.env, "**", "*.o"), recursive=True))
+    elf_size = section_sizes(args.size_tool, [elf_path])[elf_path]
+    object_sizes = section_sizes(args.size_tool, objects) if objects else {}
+
+    return {
+        "name": name,
+        "switches": switches,
+        "firmware": elf_size,
+        "flash": elf_size["text"] + elf_size["data"],       # .data initializers are stored in flash
+        "ram": elf_size["data"] + elf_size["bss"],
+        "objects": {os.path.relpath(path, build_dir): size for path, size in object_sizes.items()},
+        "symbols": symbol_sizes(args.nm_tool, elf_path),
+    }
+
+
+def print_report(results, flash_limit, ram_limit, args):
+    baseline = results[0]
+    failures = 0
+
+    print("%-72s %7s %7s %6s %6s %6s  %s" % ("combination", "flash", "ram", "text", "data", "bss", "status"))
+
+    for result in results:
+        firmware = result["firmware"]
+        flash_free = flash_limit - result["flash"]
+        ram_free = ram_limit - result["ram"]
+        status = "OK"
+
+        if flash_free < args.flash_headroom or ram_free < args.ram_headroom:
+            status = "FAIL (free flash %d, ram %d)" % (flash_free, ram_free)
+            failures += 1
+
+        print("%-72s %7d %7d %6d %6d %6d  %s" % (result["name"][:72], result["flash"], result["ram"],
+                                                 firmware["text"], firmware["data"], firmware["bss"], status))
+
+        if result is not baseline:
+            print("%-72s %+7d %+7d" % ("", result["flash"] - baseline["flash"], result["ram"] - baseline["ram"]))
+
+    print("\nlimits: flash %d - %d headroom, ram %d - %d headroom" % (flash_limit, args.flash_headroom, ram_limit,
+                                                                     args.ram_headroom))
+
+    if args.symbols:
+        largest = max(results, key=lambda result: result["flash"])
+        print("\nlargest symbols of %s:" % largest["name"])
+        for symbol in largest["symbols"][:args.symbols]:
+            print("  %6d %-4s %s" % (symbol["size"], symbol["section"], symbol["name"]))
+
+    return failures
+
+
+def main():
+    parser = argparse.ArgumentParser(description="VU-meter firmware footprint per feature switch combination")
+    parser.add_argument("--project", default=".", help="project root directory")
+    parser.add_argument("--env", default=DEFAULT_ENV, help="PlatformIO environment")
+    parser.add_argument("--all", action="store_true", help="full cross product of the switches")
+    parser.add_argument("--jobs", type=int, default=1, help="parallel builds")
+    parser.add_argument("--flash-headroom", type=int, default=DEFAULT_FLASH_HEADROOM)
+    parser.add_argument("--ram-headroom", type=int, default=DEFAULT_RAM_HEADROOM)
+    parser.add_argument("--symbols", type=int, default=20, help="largest symbols printed (0 - none)")
+    parser.add_argument("--output-dir", default=DEFAULT_OUTPUT_DIR, help="build directories and footprint.json")
+    parser.add_argument("--size", dest="size_tool", help="avr-size path")
+    parser.add_argument("--nm", dest="nm_tool", help="avr-nm path")
+    parser.add_argument("--dry-run", action="store_true", help="list the combinations only")
+    args = parser.parse_args()
+
+    switch_sets = combinations(args.all)
+
+    if args.dry_run:
+        for switches in switch_sets:
+            print("%-72s %s" % (combination_name(switches), build_flags(switches)))
+        print("%d combinations" % len(switch_sets))
+        return 0
+
+    args.size_tool = find_tool("avr-size", args.size_tool)
+    args.nm_tool = find_tool("avr-nm", args.nm_tool)
+    args.index = {combination_name(switches): index for index, switches in enumerate(switch_sets)}
+
+    try:
+        flash_limit, ram_limit = read_limits(args.project)
+    except (OSError, ValueError) as error:
+        sys.stderr.write("Footprint error: %s\n" % error)
+        return 2
+
+    try:
+        # the first build installs the library dependencies, the others can run in parallel then
+        results = [measure(args, switch_sets[0])]
+        with concurrent.futures.ThreadPoolExecutor(max_workers=max(1, args.jobs)) as executor:
+            results += list(executor.map(lambda switches: measure(args, switches), switch_sets[1:]))
+    except (RuntimeError, OSError, subprocess.CalledProcessError) as error:
+        sys.stderr.write("Footprint build error: %s\n" % error)
+        return 2
+
+    os.makedirs(args.output_dir, exist_ok=True)
+    report_path = os.path.join(args.output_dir, "footprint.json")
+    with open(report_path, "w") as report_file:
+        json.dump({"flash_volume": flash_limit, "ram_volume": ram_limit, "flash_headroom": args.flash_headroom,
+                   "ram_headroom": args.ram_headroom, "combinations": results}, report_file, indent=2)
+
+    failures = print_report(results, flash_limit, ram_limit, args)
+    print("report: %s" % report_path)
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,152 @@
+# ########################################################################
+#
+#  Description: Build step for the deferred-formatting log (LOG() macro,
+#               include/deferred_log.h). Collects every LOG() format
+#               string, computes its log site ID (the same FNV-1a hash as
+#               logId() on the device), fails on ID collisions and writes
+#               the host-side catalog used by tools/log_decoder.py.
+#  Version: 1.0.0
+#  Author: Volodymyr Noha
+#
+#  Usage:
+#    PlatformIO pre-build script (platformio.ini: extra_scripts), the
+#    catalog is written to .pio/build/<env>/log_catalog.json
+#    Standalone: python3 tools/log_catalog.py --output log_catalog.json
+#
+# ########################################################################
+
+# import python modules
+import argparse
+import ast
+import json
+import os
+import re
+import sys
+
+FNV_OFFSET_BASIS = 2166136261
+FNV_PRIME = 16777619
+
+SOURCE_DIRS = ("src", "include")
+SOURCE_EXTENSIONS = (".c", ".cpp", ".h", ".hpp")
+
+# LOG( followed by one or more adjacent string literals
+LOG_SITE_PATTERN = re.compile(r'(?<![A-Za-z0-9_])LOG\(\s*((?:"(?:[^"\\\n]|\\.)*"\s*)+)')
+LOG_CALL_PATTERN = re.compile(r'(?<![A-Za-z0-9_])LOG\(')
+LITERAL_PATTERN = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+# string/char literals are matched to skip comment markers inside of them
+COMMENT_PATTERN = re.compile(r'"(?:[^"\\\n]|\\.)*"|\'(?:[^\'\\\n]|\\.)*\'|//[^\n]*|/\*.*?\*/', re.DOTALL)
+
+
+def log_id(text):
+    """Same algorithm as logId() in include/deferred_log.h"""
+    hash_value = FNV_OFFSET_BASIS
+    for byte in text.encode("latin-1"):
+        hash_value = ((hash_value ^ byte) * FNV_PRIME) & 0xFFFFFFFF
+    return ((hash_value >> 16) ^ (hash_value & 0xFFFF)) & 0xFFFF
+
+
+def strip_comments(source):
+    """Replaces comments with blank lines, so line numbers are kept"""
+    def replace(match):
+        text = match.group(0)
+        return "\n" * text.count("\n") if text.startswith("/") else text
+
+    return COMMENT_PATTERN.sub(replace, source)
+
+
+def collect_sites(project_dir):
+    """Returns list of (format, file, line), raises ValueError for LOG() calls without literal format"""
+    sites = []
+
+    for source_dir in SOURCE_DIRS:
+        for root, _, files in os.walk(os.path.join(project_dir, source_dir)):
+            for file_name in sorted(files):
+                if not file_name.endswith(SOURCE_EXTENSIONS):
+                    continue
+
+                path = os.path.join(root, file_name)
+                with open(path, encoding="utf-8", errors="replace") as source_file:
+                    source = strip_comments(source_file.read())
+
+                for call in LOG_CALL_PATTERN.finditer(source):
+                    line_start = source.rfind("\n", 0, call.start()) + 1
+                    if source[line_start:call.start()].lstrip().startswith("#define"):
+                        continue
+
+                    line = source.count("\n", 0, call.start()) + 1
+                    site = LOG_SITE_PATTERN.match(source, call.start())
+                    if site is None:
+                        raise ValueError("%s:%d: LOG() format must be a plain string literal" % (path, line))
+
+                    text = "".join(ast.literal_eval('"%s"' % literal) for literal in LITERAL_PATTERN.findall(site.group(1)))
+                    sites.append((text, os.path.relpath(path, project_dir), line))
+
+    return sites
+
+
+def build_catalog(sites):
+    """Returns catalog dict, raises ValueError on log site ID collision"""
+    messages = {}
+
+    for text, path, line in sites:
+        key = "0x%04x" % log_id(text)
+        entry = messages.get(key)
+
+        if entry is None:
+            messages[key] = {"format": text, "sites": ["%s:%d" % (path, line)]}
+        elif entry["format"] == text:
+            entry["sites"].append("%s:%d" % (path, line))
+        else:
+            raise ValueError("log ID collision %s: \"%s\" (%s) and \"%s\" (%s:%d), reword one of the messages"
+                             % (key, entry["format"], entry["sites"][0], text, path, line))
+
+    return {"version": 1, "messages": messages}
+
+
+def write_catalog(project_dir, output_path):
+    catalog = build_catalog(collect_sites(project_dir))
+
+    output_dir = os.path.dirname(output_path)
+    if output_dir:
+        os.makedirs(output_dir, exist_ok=True)
+
+    with open(output_path, "w") as catalog_file:
+        json.dump(catalog, catalog_file, indent=2, sort_keys=True)
+
+    return len(catalog["messages"])
+
+
+def platformio_build_step(env):
+    output_path = os.path.join(env.subst("$BUILD_DIR"), "log_catalog.json")
+
+    try:
+        count = write_catalog(env.subst("$PROJECT_DIR"), output_path)
+    except ValueError as error:
+        sys.stderr.write("Log catalog error: %s\n" % error)
+        env.Exit(1)
+
+    print("Log catalog: %d messages -> %s" % (count, output_path))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="VU-meter log catalog generator")
+    parser.add_argument("--project", default=".", help="project root directory")
+    parser.add_argument("--output", default="log_catalog.json")
+    args = parser.parse_args()
+
+    try:
+        count = write_catalog(args.project, args.output)
+    except ValueError as error:
+        sys.stderr.write("Log catalog error: %s\n" % error)
+        return 1
+
+    print("Log catalog: %d messages -> %s" % (count, args.output))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
+elif "Import" in globals():
+    # executed by PlatformIO (SCons) as extra script
+    Import("env")  # noqa: F821 (provided by SCons)
+    platformio_build_step(env)  # noqa: F821
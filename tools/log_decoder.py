@@ -0,0 +1,119 @@
+# ########################################################################
+#
+#  Description: Host side decoder for the deferred-formatting log.
+#               Rebuilds the log text from TELEMETRY_RECORD_LOG records
+#               (log site ID + tagged binary arguments) using the catalog
+#               generated by tools/log_catalog.py.
+#  Version: 1.0.0
+#  Author: Volodymyr Noha
+#
+#  Usage:
+#    python3 tools/log_decoder.py --port /dev/ttyACM0
+#    python3 tools/log_decoder.py --catalog .pio/build/micro/log_catalog.json --input capture.bin
+#
+# ########################################################################
+
+# import python modules
+import argparse
+import json
+import os
+import sys
+
+from telemetry import TelemetryDecoder
+
+DEFAULT_CATALOG = ".pio/build/micro/log_catalog.json"
+
+LOG_RECORD = "log"
+ARG_SIGNED = 0x80
+ARG_STRING = 0x40
+ARG_SIZE_MASK = 0x0F
+
+
+def decode_args(data):
+    """Decodes the tagged arguments (see include/deferred_log.h)"""
+    args = []
+    index = 0
+
+    while index < len(data):
+        tag = data[index]
+        index += 1
+
+        if tag & ARG_STRING:
+            length = data[index]
+            args.append(data[index + 1:index + 1 + length].decode("latin-1"))
+            index += 1 + length
+        else:
+            size = tag & ARG_SIZE_MASK
+            args.append(int.from_bytes(data[index:index + size], "little", signed=bool(tag & ARG_SIGNED)))
+            index += size
+
+    return args
+
+
+def format_message(text, args):
+    parts = text.split("{}")
+    output = parts[0]
+
+    for index, part in enumerate(parts[1:]):
+        output += (str(args[index]) if index < len(args) else "{?}") + part
+
+    return output
+
+
+class LogDecoder:
+    def __init__(self, catalog):
+        self.messages = catalog["messages"]
+        self.telemetry = TelemetryDecoder()
+
+    def feed(self, data):
+        lines = []
+
+        for record in self.telemetry.feed(data):
+            if record["name"] != LOG_RECORD:
+                continue
+
+            entry = self.messages.get("0x%04x" % record["id"])
+            args = decode_args(bytes.fromhex(record["args"]))
+
+            if entry is None:
+                text = "<unknown log id 0x%04x> %s" % (record["id"], args)
+            else:
+                text = format_message(entry["format"], args)
+
+            lines.append("[%10d ms] %s" % (record["timestamp_ms"], text))
+
+        return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description="VU-meter deferred log decoder")
+    parser.add_argument("--catalog", default=DEFAULT_CATALOG, help="log_catalog.json of the running firmware")
+    parser.add_argument("--port", help="serial port of the target device")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--input", help="decode previously captured raw serial output")
+    args = parser.parse_args()
+
+    with open(args.catalog) as catalog_file:
+        decoder = LogDecoder(json.load(catalog_file))
+
+    if args.input:
+        with open(args.input, "rb") as capture_file:
+            for line in decoder.feed(capture_file.read()):
+                print(line)
+    elif args.port:
+        try:
+            import serial
+        except ImportError:
+            os.system("pip3 install pyserial")
+            import serial
+
+        with serial.Serial(args.port, args.baudrate, timeout=0.1) as device:
+            while True:
+                for line in decoder.feed(device.read(256)):
+                    print(line, flush=True)
+    else:
+        parser.error("--port or --input is required")
+
+
+if __name__ == "__main__":
+    sys.exit(main())
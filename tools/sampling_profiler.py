@@ -0,0 +1,173 @@
+# ########################################################################
+#
+#  Description: Host side tool for the firmware sampling CPU profiler.
+#               Starts the sampling on the target device, collects the PC
+#               samples from the USB serial port and resolves them against
+#               the firmware.elf symbol table (flat profile per function).
+#  Version: 1.0.0
+#  Author: Volodymyr Noha
+#
+#  Usage:
+#    python3 tools/sampling_profiler.py --port /dev/ttyACM0 --duration 10
+#    python3 tools/sampling_profiler.py --input capture.bin
+#    python3 tools/sampling_profiler.py --port /dev/ttyACM0 --console (SERIAL_CONSOLE build)
+#
+# ########################################################################
+
+# import python modules
+import argparse
+import bisect
+import glob
+import os
+import subprocess
+import sys
+import time
+
+from telemetry import TelemetryDecoder
+
+DEFAULT_ELF = ".pio/build/micro/firmware.elf"
+DEFAULT_NM_GLOB = "~/.platformio/packages/toolchain-atmelavr/bin/avr-nm"
+
+START_CMD = b"S"
+STOP_CMD = b"X"
+
+PROFILER_SAMPLES_RECORD = "profiler_samples"
+
+
+def find_nm(nm_path):
+    if nm_path:
+        return nm_path
+
+    candidates = glob.glob(os.path.expanduser(DEFAULT_NM_GLOB))
+    if candidates:
+        return candidates[0]
+
+    return "avr-nm"
+
+
+def load_symbols(elf_path, nm_path):
+    """Returns sorted list of (start_address, end_address, name) for the code symbols"""
+    output = subprocess.run([nm_path, "-C", "-n", "-S", "--defined-only", elf_path],
+                            check=True, capture_output=True, text=True).stdout
+
+    symbols = []
+    for line in output.splitlines():
+        fields = line.split(None, 3)
+        if len(fields) != 4 or fields[2] not in "tTwW":
+            continue
+
+        start = int(fields[0], 16)
+        size = int(fields[1], 16)
+        symbols.append((start, start + size, fields[3]))
+
+    return symbols
+
+
+def resolve(symbols, starts, byte_address):
+    index = bisect.bisect_right(starts, byte_address) - 1
+    if index >= 0:
+        start, end, name = symbols[index]
+        if byte_address < end:
+            return name
+
+    return "?? 0x%04x" % byte_address
+
+
+def parse_capture(data):
+    samples = []
+    dropped = 0
+
+    for record in TelemetryDecoder().feed(data):
+        if record["name"] != PROFILER_SAMPLES_RECORD:
+            continue
+
+        # Samples are flash word addresses, symbol table uses byte addresses
+        samples += [sample * 2 for sample in record["samples"]]
+        # Counter is cumulative since the sampling start
+        dropped = max(dropped, record["dropped"])
+
+    return samples, dropped
+
+
+def console_request(start):
+    from vu_console import CMD_PROFILER, encode_request
+
+    return encode_request(CMD_PROFILER, 1 if start else 2, b"\x01" if start else b"\x00")
+
+
+def capture(port, baudrate, duration, raw_output, console):
+    try:
+        import serial
+    except ImportError:
+        os.system("pip3 install pyserial")
+        import serial
+
+    data = bytearray()
+    with serial.Serial(port, baudrate, timeout=0.1) as device:
+        device.reset_input_buffer()
+        # With the serial console the single byte commands are console requests (the response is not needed)
+        device.write(console_request(True) if console else START_CMD)
+
+        end_time = time.time() + duration
+        while time.time() < end_time:
+            data += device.read(256)
+
+        device.write(console_request(False) if console else STOP_CMD)
+
+        # collect the samples left in the device buffer and the drop counter
+        end_time = time.time() + 0.5
+        while time.time() < end_time:
+            data += device.read(256)
+
+    if raw_output:
+        with open(raw_output, "wb") as capture_file:
+            capture_file.write(data)
+
+    return bytes(data)
+
+
+def print_profile(symbols, samples, dropped):
+    starts = [symbol[0] for symbol in symbols]
+    histogram = {}
+
+    for sample in samples:
+        name = resolve(symbols, starts, sample)
+        histogram[name] = histogram.get(name, 0) + 1
+
+    total = len(samples)
+    print("Samples: %d, dropped: %d" % (total, dropped))
+    if total == 0:
+        return
+
+    print("%8s %8s  %s" % ("samples", "%", "function"))
+    for name, count in sorted(histogram.items(), key=lambda item: item[1], reverse=True):
+        print("%8d %7.2f%%  %s" % (count, 100.0 * count / total, name))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="VU-meter sampling CPU profiler")
+    parser.add_argument("--port", help="serial port of the target device")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--duration", type=float, default=10.0, help="sampling time in seconds")
+    parser.add_argument("--elf", default=DEFAULT_ELF, help="path to the firmware.elf")
+    parser.add_argument("--nm", help="path to avr-nm")
+    parser.add_argument("--input", help="use previously captured serial output instead of the device")
+    parser.add_argument("--save", help="store the raw serial capture to file")
+    parser.add_argument("--console", action="store_true", help="start/stop with the serial console commands")
+    args = parser.parse_args()
+
+    if args.input:
+        with open(args.input, "rb") as capture_file:
+            data = capture_file.read()
+    elif args.port:
+        data = capture(args.port, args.baudrate, args.duration, args.save, args.console)
+    else:
+        parser.error("--port or --input is required")
+
+    samples, dropped = parse_capture(data)
+    symbols = load_symbols(args.elf, find_nm(args.nm))
+    print_profile(symbols, samples, dropped)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
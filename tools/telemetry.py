@@ -0,0 +1,178 @@
+# ########################################################################
+#
+#  Description: Host side decoder for the firmware binary telemetry
+#               records (include/telemetry.h). Can be used as a library
+#               (TelemetryDecoder) or as a CLI which prints every record
+#               as a JSON line.
+#  Version: 1.0.0
+#  Author: Volodymyr Noha
+#
+#  Usage:
+#    python3 tools/telemetry.py --port /dev/ttyACM0
+#    python3 tools/telemetry.py --input capture.bin
+#
+# ########################################################################
+
+# import python modules
+import argparse
+import json
+import os
+import struct
+import sys
+
+TELEMETRY_VERSION = 1
+HEADER_FORMAT = "<BBHI"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+CRC_SIZE = 2
+
+# Record schema table: type -> (name, fixed fields format, fixed field names, repeated item format, tail name)
+# Tail without item format is returned as hex string
+# Keep in sync with the telemetryRecordType enumeration in include/telemetry.h
+RECORD_SCHEMA = {
+    1: ("memory", "<hhhh", ("ram_usage", "block_usage", "free_block", "free_ram"), None, None),
+    2: ("profiler_samples", "<H", ("dropped",), "<H", "samples"),
+    6: ("log", "<H", ("id",), None, "args"),
+    7: ("console", "<HBB", ("request_id", "command", "status"), None, "data"),
+}
+
+
+def crc16_update(crc, data):
+    """Same algorithm as avr-libc _crc16_update() (poly 0xA001, reflected)"""
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            if crc & 1:
+                crc = (crc >> 1) ^ 0xA001
+            else:
+                crc >>= 1
+    return crc
+
+
+def cobs_decode(frame):
+    output = bytearray()
+    index = 0
+
+    while index < len(frame):
+        code = frame[index]
+        if code == 0 or index + code > len(frame):
+            raise ValueError("invalid COBS frame")
+
+        output += frame[index + 1:index + code]
+        index += code
+
+        if code < 0xFF and index < len(frame):
+            output.append(0)
+
+    return bytes(output)
+
+
+def decode_record(record):
+    """Decodes one unframed record, returns dict or raises ValueError"""
+    if len(record) < HEADER_SIZE + CRC_SIZE:
+        raise ValueError("record too short")
+
+    body, crc = record[:-CRC_SIZE], struct.unpack("<H", record[-CRC_SIZE:])[0]
+    if crc16_update(0, body) != crc:
+        raise ValueError("CRC mismatch")
+
+    version, record_type, sequence, timestamp = struct.unpack_from(HEADER_FORMAT, body)
+    if version != TELEMETRY_VERSION:
+        raise ValueError("unsupported telemetry version %d" % version)
+
+    result = {"type": record_type, "seq": sequence, "timestamp_ms": timestamp}
+    payload = body[HEADER_SIZE:]
+
+    schema = RECORD_SCHEMA.get(record_type)
+    if schema is None:
+        result["name"] = "unknown"
+        result["payload"] = payload.hex()
+        return result
+
+    name, fixed_format, fixed_names, item_format, item_name = schema
+    result["name"] = name
+
+    fixed_size = struct.calcsize(fixed_format)
+    result.update(zip(fixed_names, struct.unpack_from(fixed_format, payload)))
+
+    tail = payload[fixed_size:]
+    if item_format:
+        item_size = struct.calcsize(item_format)
+        result[item_name] = [item[0] for item in struct.iter_unpack(item_format, tail[:len(tail) - len(tail) % item_size])]
+    elif item_name:
+        # Variable layout payload, decoded by the record specific tool (e.g. log_decoder.py)
+        result[item_name] = tail.hex()
+
+    return result
+
+
+class TelemetryDecoder:
+    """Stream decoder: feed() raw bytes from the serial port, returns list of decoded records"""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.errors = 0
+        self.lost = 0
+        self.last_sequence = None
+
+    def feed(self, data):
+        records = []
+        self.buffer += data
+
+        while True:
+            delimiter = self.buffer.find(b"\x00")
+            if delimiter < 0:
+                break
+
+            frame = bytes(self.buffer[:delimiter])
+            del self.buffer[:delimiter + 1]
+            if not frame:
+                continue
+
+            try:
+                record = decode_record(cobs_decode(frame))
+            except ValueError:
+                # Text output (debug printer) on the same port ends up here as well
+                self.errors += 1
+                continue
+
+            if self.last_sequence is not None:
+                self.lost += (record["seq"] - self.last_sequence - 1) & 0xFFFF
+            self.last_sequence = record["seq"]
+
+            records.append(record)
+
+        return records
+
+
+def main():
+    parser = argparse.ArgumentParser(description="VU-meter telemetry decoder")
+    parser.add_argument("--port", help="serial port of the target device")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--input", help="decode previously captured raw serial output")
+    args = parser.parse_args()
+
+    decoder = TelemetryDecoder()
+
+    if args.input:
+        with open(args.input, "rb") as capture_file:
+            for record in decoder.feed(capture_file.read()):
+                print(json.dumps(record))
+    elif args.port:
+        try:
+            import serial
+        except ImportError:
+            os.system("pip3 install pyserial")
+            import serial
+
+        with serial.Serial(args.port, args.baudrate, timeout=0.1) as device:
+            while True:
+                for record in decoder.feed(device.read(256)):
+                    print(json.dumps(record), flush=True)
+    else:
+        parser.error("--port or --input is required")
+
+    print("frame errors: %d, lost records: %d" % (decoder.errors, decoder.lost), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,248 @@
+# ########################################################################
+#
+#  Description: Host master of the firmware multi-unit bus (UNIT_BUS,
+#               include/unit_bus.h) over an USB/RS-485 adapter. Sends the
+#               addressed console commands to one unit or to all of them
+#               (broadcast, never answered) and waits for the response of
+#               the addressed unit; a request without a response is
+#               repeated with the same sequence number, so a unit never
+#               executes it twice. group-commit broadcasts the commit with
+#               a token and confirms every listed unit with the same token.
+#  Version: 1.0.0
+#  Author: Volodymyr Noha
+#
+#  Usage:
+#    python3 tools/vu_bus.py --port /dev/ttyUSB0 --address 3 state
+#    python3 tools/vu_bus.py --port /dev/ttyUSB0 --broadcast batch 0:20 1:20
+#    python3 tools/vu_bus.py --port /dev/ttyUSB0 group-commit 1 2 3
+#
+# ########################################################################
+
+# import python modules
+import argparse
+import json
+import os
+import struct
+import sys
+import time
+
+from telemetry import cobs_decode, crc16_update
+from vu_console import (CMD_COMMIT, CMD_PRESET_RECALL, CMD_PRESET_STORE, CMD_QUERY_STATE, CMD_SET_BATCH,
+                        CMD_SET_LEVEL, CMD_STATS, STATUS_NAMES, STATUS_OK, STATUS_UNCHANGED, SerialPort, cobs_encode,
+                        parse_pair)
+
+# Keep in sync with include/unit_bus.h
+BUS_VERSION = 1
+BUS_MASTER = 0x00
+BUS_BROADCAST = 0xFF
+CMD_GROUP_COMMIT = 0x20
+
+HEADER = struct.Struct("<BBBBB")    # version, destination, source, sequence, command
+
+
+class BusError(Exception):
+    pass
+
+
+def encode_frame(destination, sequence, command, payload=b""):
+    """Framed request: delimiter before and after, a partial frame on the bus is dropped by the units"""
+    body = HEADER.pack(BUS_VERSION, destination, BUS_MASTER, sequence, command) + bytes(payload)
+    body += struct.pack("<H", crc16_update(0, body))
+    return b"\x00" + cobs_encode(body) + b"\x00"
+
+
+def decode_frame(encoded):
+    """Returns (destination, source, sequence, command, payload) or None for a damaged or foreign frame"""
+    try:
+        body = cobs_decode(encoded)
+    except ValueError:
+        return None
+
+    if len(body) < HEADER.size + 2 or crc16_update(0, body[:-2]) != struct.unpack_from("<H", body, len(body) - 2)[0]:
+        return None
+
+    version, destination, source, sequence, command = HEADER.unpack_from(body)
+    if version != BUS_VERSION:
+        return None
+
+    return destination, source, sequence, command, body[HEADER.size:-2]
+
+
+class BusClient:
+    """Bus master: request() returns (status, data bytes) of the response of the addressed unit"""
+
+    def __init__(self, port, timeout=0.1, retries=3):
+        self.port = port
+        self.timeout = timeout
+        self.retries = retries
+        self.sequence = int.from_bytes(os.urandom(1), "little")
+        self.buffer = bytearray()
+
+    def frames(self, timeout):
+        self.buffer += self.port.read(timeout)
+
+        # The request echo of an adapter without /RE control is dropped by the address check
+        while b"\x00" in self.buffer:
+            index = self.buffer.index(b"\x00")
+            encoded = bytes(self.buffer[:index])
+            del self.buffer[:index + 1]
+
+            frame = decode_frame(encoded) if encoded else None
+            if frame is not None:
+                yield frame
+
+    def wait_response(self, address, sequence, command, timeout):
+        end_time = time.monotonic() + timeout
+
+        while True:
+            remaining = end_time - time.monotonic()
+            if remaining <= 0:
+                return None
+
+            for destination, source, frame_sequence, frame_command, payload in self.frames(remaining):
+                if (destination, source, frame_sequence, frame_command) == (BUS_MASTER, address, sequence, command):
+                    if not payload:
+                        raise BusError("empty response of unit %d" % address)
+                    return payload[0], payload[1:]
+
+    def request(self, address, command, payload=b""):
+        self.sequence = (self.sequence + 1) & 0xFF
+        frame = encode_frame(address, self.sequence, command, payload)
+
+        # A broadcast has no response: it is sent once per retry, the units execute it once by its sequence
+        if address == BUS_BROADCAST:
+            for _ in range(self.retries):
+                self.port.write(frame)
+            return STATUS_OK, b""
+
+        for _ in range(self.retries):
+            self.port.write(frame)
+            response = self.wait_response(address, self.sequence, command, self.timeout)
+            if response is not None:
+                return response
+
+        raise BusError("no response of unit %d to command %d (sequence %d)" % (address, command, self.sequence))
+
+    def set_level(self, address, channel, value):
+        return self.request(address, CMD_SET_LEVEL, bytes((channel, value)))[0]
+
+    def set_batch(self, address, pairs):
+        return self.request(address, CMD_SET_BATCH, b"".join(bytes(pair) for pair in pairs))[0]
+
+    def state(self, address):
+        status, data = self.request(address, CMD_QUERY_STATE)
+        if status != STATUS_OK:
+            raise BusError("state: %s" % STATUS_NAMES.get(status, status))
+
+        count, scale, selected, low, high = struct.unpack_from("<BBBBB", data)
+        channels = [{"value": value, "tap": tap} for value, tap in struct.iter_unpack("<BB", data[5:5 + 2 * count])]
+
+        return {"scale": "levels" if scale else "taps", "selected": selected, "low": low, "high": high,
+                "channels": channels}
+
+    def commit(self, address):
+        return self.request(address, CMD_COMMIT)[0]
+
+    def preset_store(self, address, slot):
+        return self.request(address, CMD_PRESET_STORE, bytes((slot,)))[0]
+
+    def preset_recall(self, address, slot):
+        return self.request(address, CMD_PRESET_RECALL, bytes((slot,)))[0]
+
+    def stats(self, address):
+        status, data = self.request(address, CMD_STATS)
+        if status != STATUS_OK:
+            raise BusError("stats: %s" % STATUS_NAMES.get(status, status))
+
+        uptime, ir_commands, frames, errors = struct.unpack_from("<IHHH", data)
+        resyncs = [item[0] for item in struct.iter_unpack("<H", data[10:])]
+
+        return {"uptime_ms": uptime, "ir_commands": ir_commands, "frames": frames, "errors": errors,
+                "resyncs": resyncs}
+
+    def group_commit(self, addresses, token=None):
+        """All units persist on the broadcast, the confirms report (and repair a missed broadcast) per unit"""
+        token = int.from_bytes(os.urandom(1), "little") if token is None else token & 0xFF
+        self.request(BUS_BROADCAST, CMD_GROUP_COMMIT, bytes((token,)))
+
+        return {address: self.request(address, CMD_GROUP_COMMIT, bytes((token,)))[0] for address in addresses}
+
+
+def parse_address(text):
+    address = int(text, 0)
+    if not BUS_MASTER < address < BUS_BROADCAST:
+        raise argparse.ArgumentTypeError("unit address must be 1..254")
+    return address
+
+
+def status_result(status):
+    print(STATUS_NAMES.get(status, "status %d" % status))
+    return 0 if status in (STATUS_OK, STATUS_UNCHANGED) else 1
+
+
+def run_command(client, address, args):
+    if args.command == "set":
+        return status_result(client.set_level(address, args.channel, args.value))
+    if args.command == "batch":
+        return status_result(client.set_batch(address, args.pairs))
+    if args.command == "commit":
+        return status_result(client.commit(address))
+    if args.command == "preset-store":
+        return status_result(client.preset_store(address, args.slot))
+    if args.command == "preset-recall":
+        return status_result(client.preset_recall(address, args.slot))
+
+    if address == BUS_BROADCAST:
+        raise BusError("%s needs the response of one unit, use --address" % args.command)
+
+    print(json.dumps(client.state(address) if args.command == "state" else client.stats(address)))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="VU-meter multi-unit bus master")
+    parser.add_argument("--port", required=True, help="serial port of the RS-485 adapter")
+    parser.add_argument("--baudrate", type=int, default=115200, help="UNIT_BUS_BAUDRATE of the units")
+    parser.add_argument("--timeout", type=float, default=0.1, help="response timeout in seconds")
+    parser.add_argument("--retries", type=int, default=3, help="sends of a request (of a broadcast too)")
+    target = parser.add_mutually_exclusive_group()
+    target.add_argument("--address", type=parse_address, help="unit address (UNIT_BUS_ADDRESS)")
+    target.add_argument("--broadcast", action="store_true", help="send to all units, no response")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    command = commands.add_parser("set", help="set the value of one channel")
+    command.add_argument("channel", type=int)
+    command.add_argument("value", type=int)
+    command = commands.add_parser("batch", help="set several channels as one actuation")
+    command.add_argument("pairs", type=parse_pair, nargs="+", metavar="CHANNEL:VALUE")
+    commands.add_parser("state", help="print the channel values and taps")
+    commands.add_parser("commit", help="store the channel values of one unit to the EEPROM")
+    for name in ("preset-store", "preset-recall"):
+        commands.add_parser(name).add_argument("slot", type=int)
+    commands.add_parser("stats", help="print the uptime and the command/frame counters")
+    command = commands.add_parser("group-commit", help="make all units store their values together")
+    command.add_argument("addresses", type=parse_address, nargs="+", help="units confirmed after the broadcast")
+    command.add_argument("--token", type=lambda text: int(text, 0), help="token of the commit, random by default")
+    args = parser.parse_args()
+
+    if args.command != "group-commit" and args.address is None and not args.broadcast:
+        parser.error("--address or --broadcast is required")
+
+    port = SerialPort(args.port, args.baudrate)
+    client = BusClient(port, args.timeout, args.retries)
+    try:
+        if args.command == "group-commit":
+            statuses = client.group_commit(args.addresses, args.token)
+            print(json.dumps({address: STATUS_NAMES.get(status, status) for address, status in statuses.items()}))
+            return 0 if all(status in (STATUS_OK, STATUS_UNCHANGED) for status in statuses.values()) else 1
+
+        return run_command(client, BUS_BROADCAST if args.broadcast else args.address, args)
+    except BusError as error:
+        print(error, file=sys.stderr)
+        return 1
+    finally:
+        port.close()
+
+
+if __name__ == "__main__":
+    sys.exit(main())
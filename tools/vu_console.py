@@ -0,0 +1,371 @@
+# ########################################################################
+#
+#  Description: Host client of the firmware binary serial console
+#               (SERIAL_CONSOLE, include/serial_console.h). Sends the
+#               COBS framed requests and waits for the matching console
+#               telemetry record; a request without a response is repeated
+#               with the same request ID. The loopback command starts the
+#               native pty simulation (sim/serial_console) and runs the
+#               console checks against it.
+#  Version: 1.0.0
+#  Author: Volodymyr Noha
+#
+#  Usage:
+#    python3 tools/vu_console.py --port /dev/ttyACM0 state
+#    python3 tools/vu_console.py --port /dev/ttyACM0 batch 0:20 1:20
+#    python3 tools/vu_console.py loopback .pio/build/sim_serial_console/program
+#
+# ########################################################################
+
+# import python modules
+import argparse
+import json
+import os
+import select
+import struct
+import subprocess
+import sys
+import termios
+import time
+import tty
+
+from telemetry import TelemetryDecoder, crc16_update
+
+CONSOLE_VERSION = 1
+CONSOLE_RECORD = "console"
+
+# Keep in sync with the consoleCommand/consoleStatus enumerations in include/serial_console.h
+CMD_SET_LEVEL = 1
+CMD_SET_BATCH = 2
+CMD_QUERY_STATE = 3
+CMD_COMMIT = 4
+CMD_PRESET_STORE = 5
+CMD_PRESET_RECALL = 6
+CMD_STATS = 7
+CMD_PROFILER = 8
+
+STATUS_OK = 0
+STATUS_UNCHANGED = 1
+STATUS_BAD_LENGTH = 2
+STATUS_BAD_VALUE = 3
+STATUS_UNKNOWN_COMMAND = 4
+STATUS_EMPTY = 5
+STATUS_UNSUPPORTED = 6
+STATUS_BAD_VERSION = 7
+
+STATUS_NAMES = {
+    STATUS_OK: "ok",
+    STATUS_UNCHANGED: "unchanged",
+    STATUS_BAD_LENGTH: "bad length",
+    STATUS_BAD_VALUE: "bad value",
+    STATUS_UNKNOWN_COMMAND: "unknown command",
+    STATUS_EMPTY: "empty",
+    STATUS_UNSUPPORTED: "unsupported",
+    STATUS_BAD_VERSION: "bad version",
+}
+
+BATCH_MAX = 8
+
+
+def cobs_encode(data):
+    output = bytearray()
+    block = bytearray()
+
+    for byte in data:
+        if byte == 0:
+            output.append(len(block) + 1)
+            output += block
+            block.clear()
+            continue
+
+        block.append(byte)
+        if len(block) == 0xFE:
+            output.append(0xFF)
+            output += block
+            block.clear()
+
+    output.append(len(block) + 1)
+    output += block
+
+    return bytes(output)
+
+
+def encode_request(command, request_id, payload=b"", version=CONSOLE_VERSION):
+    """Framed request: delimiter before and after, a partial frame on the port is dropped by the device"""
+    body = struct.pack("<BBH", version, command, request_id) + bytes(payload)
+    body += struct.pack("<H", crc16_update(0, body))
+    return b"\x00" + cobs_encode(body) + b"\x00"
+
+
+class SerialPort:
+    """Raw termios port (USB CDC or pty), no pyserial needed"""
+
+    def __init__(self, path, baudrate=115200):
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.fd)
+
+        speed = getattr(termios, "B%d" % baudrate, None)
+        if speed is not None:
+            attributes = termios.tcgetattr(self.fd)
+            attributes[4] = attributes[5] = speed
+            termios.tcsetattr(self.fd, termios.TCSANOW, attributes)
+
+        termios.tcflush(self.fd, termios.TCIOFLUSH)
+
+    def write(self, data):
+        while data:
+            data = data[os.write(self.fd, data):]
+
+    def read(self, timeout):
+        readable, _, _ = select.select([self.fd], [], [], max(timeout, 0))
+        return os.read(self.fd, 256) if readable else b""
+
+    def close(self):
+        os.close(self.fd)
+
+
+class ConsoleError(Exception):
+    pass
+
+
+class ConsoleClient:
+    """Request/response client: request() returns (status, data bytes) of the matching console record"""
+
+    def __init__(self, port, timeout=0.5, retries=3):
+        self.port = port
+        self.timeout = timeout
+        self.retries = retries
+        self.decoder = TelemetryDecoder()
+        self.request_id = 0
+        self.sent = 0
+        self.other_records = []
+
+    def wait_response(self, request_id, timeout):
+        end_time = time.monotonic() + timeout
+
+        while True:
+            remaining = end_time - time.monotonic()
+            if remaining <= 0:
+                return None
+
+            for record in self.decoder.feed(self.port.read(remaining)):
+                if record["name"] == CONSOLE_RECORD and record["request_id"] == request_id:
+                    return record["status"], bytes.fromhex(record["data"])
+
+                # Log/profiler records and stale responses of repeated requests
+                self.other_records.append(record)
+
+    def request(self, command, payload=b"", version=CONSOLE_VERSION):
+        self.request_id = (self.request_id + 1) & 0xFFFF
+        frame = encode_request(command, self.request_id, payload, version)
+
+        # The commands are idempotent (a repeated store reports "unchanged"), a lost response is simply repeated
+        for _ in range(self.retries):
+            self.port.write(frame)
+            self.sent += 1
+            response = self.wait_response(self.request_id, self.timeout)
+            if response is not None:
+                return response
+
+        raise ConsoleError("no response to command %d (request %d)" % (command, self.request_id))
+
+    def set_level(self, channel, value):
+        return self.request(CMD_SET_LEVEL, bytes((channel, value)))[0]
+
+    def set_batch(self, pairs):
+        return self.request(CMD_SET_BATCH, b"".join(bytes(pair) for pair in pairs))[0]
+
+    def state(self):
+        status, data = self.request(CMD_QUERY_STATE)
+        if status != STATUS_OK:
+            raise ConsoleError("state: %s" % STATUS_NAMES.get(status, status))
+
+        count, scale, selected, low, high = struct.unpack_from("<BBBBB", data)
+        channels = [{"value": value, "tap": tap} for value, tap in struct.iter_unpack("<BB", data[5:5 + 2 * count])]
+
+        return {"scale": "levels" if scale else "taps", "selected": selected, "low": low, "high": high,
+                "channels": channels}
+
+    def commit(self):
+        return self.request(CMD_COMMIT)[0]
+
+    def preset_store(self, slot):
+        return self.request(CMD_PRESET_STORE, bytes((slot,)))[0]
+
+    def preset_recall(self, slot):
+        return self.request(CMD_PRESET_RECALL, bytes((slot,)))[0]
+
+    def stats(self):
+        status, data = self.request(CMD_STATS)
+        if status != STATUS_OK:
+            raise ConsoleError("stats: %s" % STATUS_NAMES.get(status, status))
+
+        uptime, ir_commands, frames, errors = struct.unpack_from("<IHHH", data)
+        resyncs = [item[0] for item in struct.iter_unpack("<H", data[10:])]
+
+        return {"uptime_ms": uptime, "ir_commands": ir_commands, "frames": frames, "errors": errors,
+                "resyncs": resyncs}
+
+    def profiler(self, start):
+        return self.request(CMD_PROFILER, bytes((1 if start else 0,)))[0]
+
+
+class LoopbackChecks:
+    """Console checks against the pty simulation, output like the sim programs"""
+
+    def __init__(self, client):
+        self.client = client
+        self.checks = 0
+        self.failed = 0
+
+    def check(self, condition, name):
+        self.checks += 1
+        if not condition:
+            self.failed += 1
+            print("FAIL: %s" % name)
+
+    def run(self):
+        client = self.client
+        state = client.state()
+        count, low, high = len(state["channels"]), state["low"], state["high"]
+        middle = (low + high) // 2
+
+        self.check(count >= 1 and low < high, "state: channels and range")
+
+        # Single channel set
+        self.check(client.set_level(0, low) == STATUS_OK, "set: in range")
+        self.check(client.state()["channels"][0]["value"] == low, "set: value applied")
+        self.check(client.set_level(0, high + 1) == STATUS_BAD_VALUE, "set: value beyond the range")
+        self.check(client.set_level(count, low) == STATUS_BAD_VALUE, "set: channel beyond the count")
+        self.check(client.request(CMD_SET_LEVEL, b"\x00")[0] == STATUS_BAD_LENGTH, "set: short payload")
+
+        # Batch: all channels or none
+        pairs = [(channel, middle if channel % 2 else low) for channel in range(count)]
+        self.check(client.set_batch(pairs) == STATUS_OK, "batch: in range")
+        values = [channel["value"] for channel in client.state()["channels"]]
+        self.check(values == [value for _, value in pairs], "batch: values applied")
+        self.check(client.set_batch([(0, high)] + [(count - 1, high + 1)]) == STATUS_BAD_VALUE, "batch: bad pair")
+        self.check([channel["value"] for channel in client.state()["channels"]] == values, "batch: nothing applied")
+        self.check(client.set_batch([]) == STATUS_BAD_LENGTH, "batch: empty")
+        self.check(client.set_batch([(0, low)] * (BATCH_MAX + 1)) == STATUS_BAD_LENGTH, "batch: too long")
+
+        # Commit and presets
+        self.check(client.commit() == STATUS_OK, "commit: stored")
+        self.check(client.commit() == STATUS_UNCHANGED, "commit: unchanged")
+        self.check(client.preset_recall(1) == STATUS_EMPTY, "preset: empty slot")
+        self.check(client.preset_store(1) == STATUS_OK, "preset: stored")
+        self.check(client.preset_store(1) == STATUS_UNCHANGED, "preset: unchanged")
+        self.check(client.preset_store(0xFF) == STATUS_BAD_VALUE, "preset: slot beyond the count")
+        self.check(client.set_batch([(channel, high) for channel in range(count)]) == STATUS_OK, "preset: overwrite")
+        self.check(client.preset_recall(1) == STATUS_OK, "preset: recalled")
+        self.check([channel["value"] for channel in client.state()["channels"]] == values, "preset: values restored")
+
+        # Protocol errors: a bad CRC is dropped without a response, unknown command and version are reported
+        corrupted = bytearray(encode_request(CMD_QUERY_STATE, 0xBEEF))
+        corrupted[-2] ^= 0x01
+        client.port.write(bytes(corrupted))
+        self.check(client.wait_response(0xBEEF, client.timeout) is None, "frame: bad CRC not answered")
+        self.check(client.request(0x7F)[0] == STATUS_UNKNOWN_COMMAND, "frame: unknown command")
+        self.check(client.request(CMD_QUERY_STATE, version=CONSOLE_VERSION + 1)[0] == STATUS_BAD_VERSION,
+                   "frame: unknown version")
+        self.check(client.profiler(False) in (STATUS_OK, STATUS_UNSUPPORTED), "profiler: stop")
+
+        # Valid frames: all requests sent (repeated ones included) but the corrupted one
+        stats = client.stats()
+        self.check(stats["frames"] == client.sent and stats["errors"] == 1, "stats: frame counters")
+        self.check(stats["ir_commands"] == 0 and stats["uptime_ms"] > 0, "stats: IR commands, uptime")
+        self.check(len(stats["resyncs"]) == count, "stats: resync counters")
+
+        print("%d checks, %d failed: %s" % (self.checks, self.failed, "PASS" if self.failed == 0 else "FAIL"))
+        return 0 if self.failed == 0 else 1
+
+
+def loopback(program, timeout):
+    process = subprocess.Popen([program], stdout=subprocess.PIPE, text=True)
+
+    try:
+        line = process.stdout.readline()
+        if not line.startswith("pty: "):
+            print("no pty from %s" % program, file=sys.stderr)
+            return 2
+
+        port = SerialPort(line[len("pty: "):].strip())
+        try:
+            return LoopbackChecks(ConsoleClient(port, timeout)).run()
+        finally:
+            port.close()
+    finally:
+        process.terminate()
+        process.wait()
+
+
+def parse_pair(text):
+    channel, value = text.split(":")
+    return int(channel, 0), int(value, 0)
+
+
+def run_command(client, args):
+    if args.command == "set":
+        status = client.set_level(args.channel, args.value)
+    elif args.command == "batch":
+        status = client.set_batch(args.pairs)
+    elif args.command == "state":
+        print(json.dumps(client.state()))
+        return 0
+    elif args.command == "commit":
+        status = client.commit()
+    elif args.command == "preset-store":
+        status = client.preset_store(args.slot)
+    elif args.command == "preset-recall":
+        status = client.preset_recall(args.slot)
+    elif args.command == "stats":
+        print(json.dumps(client.stats()))
+        return 0
+    else:
+        status = client.profiler(args.action == "start")
+
+    print(STATUS_NAMES.get(status, "status %d" % status))
+    return 0 if status in (STATUS_OK, STATUS_UNCHANGED) else 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description="VU-meter serial console client")
+    parser.add_argument("--port", help="serial port of the target device (or the pty of the simulation)")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--timeout", type=float, default=0.5, help="response timeout in seconds")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    command = commands.add_parser("set", help="set the value of one channel")
+    command.add_argument("channel", type=int)
+    command.add_argument("value", type=int)
+    command = commands.add_parser("batch", help="set several channels as one actuation")
+    command.add_argument("pairs", type=parse_pair, nargs="+", metavar="CHANNEL:VALUE")
+    commands.add_parser("state", help="print the channel values and taps")
+    commands.add_parser("commit", help="store the channel values to the EEPROM")
+    for name in ("preset-store", "preset-recall"):
+        commands.add_parser(name).add_argument("slot", type=int)
+    commands.add_parser("stats", help="print the uptime and the command/frame counters")
+    commands.add_parser("profiler", help="start or stop the sampling profiler").add_argument(
+        "action", choices=("start", "stop"))
+    commands.add_parser("loopback", help="run the console checks against the pty simulation").add_argument(
+        "program", help="sim_serial_console program")
+    args = parser.parse_args()
+
+    if args.command == "loopback":
+        return loopback(args.program, args.timeout)
+
+    if not args.port:
+        parser.error("--port is required")
+
+    port = SerialPort(args.port, args.baudrate)
+    try:
+        return run_command(ConsoleClient(port, args.timeout), args)
+    except ConsoleError as error:
+        print(error, file=sys.stderr)
+        return 1
+    finally:
+        port.close()
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,170 @@
+# ########################################################################
+#
+#  Description: Host client of the firmware USB HID control interface
+#               (USB_HID_CONTROL, include/hid_control.h) on Linux hidraw.
+#               Writes an output report and prints the state input report
+#               the device answers with (status and channel values). No
+#               driver or library is needed, the device node is found by
+#               its report descriptor when --device is not given.
+#  Version: 1.0.0
+#  Author: Volodymyr Noha
+#
+#  Usage:
+#    python3 tools/vu_hid.py key volume-up
+#    python3 tools/vu_hid.py --device /dev/hidraw3 levels 20 keep
+#    python3 tools/vu_hid.py preset-recall 1
+#
+# ########################################################################
+
+# import python modules
+import argparse
+import fcntl
+import glob
+import json
+import os
+import select
+import sys
+
+from vu_console import STATUS_NAMES, STATUS_OK, STATUS_UNCHANGED
+
+# Keep in sync with include/hid_control.h
+REPORT_CONSUMER = 1
+REPORT_LEVELS = 2
+REPORT_PRESET = 3
+REPORT_STATE = 4
+
+PRESET_RECALL = 0
+PRESET_STORE = 1
+VALUE_KEEP = 0xFF
+
+# Consumer page usages handled by the firmware, same actions as the IR remote buttons
+USAGES = {
+    "next": 0x00B5,             # select the next (right) channel
+    "previous": 0x00B6,         # select the previous (left) channel
+    "commit": 0x00CD,           # play/pause: store the values to the EEPROM
+    "volume-up": 0x00E9,
+    "volume-down": 0x00EA,
+    "coarse-up": 0x00B3,        # fast forward (POTENTIOMETER_FULL_RESOLUTION)
+    "coarse-down": 0x00B4,      # rewind
+}
+
+# hidraw ioctls: report descriptor size and report descriptor (linux/hidraw.h)
+HIDIOCGRDESCSIZE = 0x80044801
+HIDIOCGRDESC = 0x90044802
+HID_MAX_DESCRIPTOR_SIZE = 4096
+
+
+class HidError(Exception):
+    pass
+
+
+def report_descriptor(fd):
+    size = bytearray(4)
+    fcntl.ioctl(fd, HIDIOCGRDESCSIZE, size)
+    buffer = bytearray(4 + HID_MAX_DESCRIPTOR_SIZE)
+    buffer[0:4] = size
+    fcntl.ioctl(fd, HIDIOCGRDESC, buffer)
+    return bytes(buffer[4:4 + int.from_bytes(size, "little")])
+
+
+def is_vu_meter(descriptor):
+    """Vendor page 0xFF00 collection with the state input report, see hid_control.cpp"""
+    return b"\x06\x00\xff" in descriptor and bytes((0x85, REPORT_STATE)) in descriptor
+
+
+def find_device():
+    for path in sorted(glob.glob("/dev/hidraw*")):
+        try:
+            fd = os.open(path, os.O_RDWR)
+        except OSError:
+            continue
+
+        try:
+            if is_vu_meter(report_descriptor(fd)):
+                return path
+        except OSError:
+            pass
+        finally:
+            os.close(fd)
+
+    raise HidError("no VU-meter HID interface found (USB_HID_CONTROL build, hidraw permissions?)")
+
+
+class HidClient:
+    """Writes output reports, send() returns (status, channel values) of the next state report"""
+
+    def __init__(self, path, timeout=1.0):
+        self.fd = os.open(path, os.O_RDWR)
+        self.timeout = timeout
+
+    def close(self):
+        os.close(self.fd)
+
+    def send(self, report):
+        os.write(self.fd, bytes(report))
+
+        while True:
+            readable, _, _ = select.select([self.fd], [], [], self.timeout)
+            if not readable:
+                raise HidError("no state report within %.1f s" % self.timeout)
+
+            data = os.read(self.fd, 64)
+            if len(data) >= 2 and data[0] == REPORT_STATE:
+                return data[1], list(data[2:])
+
+    def key(self, usage):
+        status = self.send((REPORT_CONSUMER, usage & 0xFF, usage >> 8))
+        os.write(self.fd, bytes((REPORT_CONSUMER, 0, 0)))   # release, no state report
+        return status
+
+    def levels(self, values):
+        return self.send([REPORT_LEVELS] + list(values))
+
+    def preset(self, action, slot):
+        return self.send((REPORT_PRESET, action, slot))
+
+
+def parse_value(text):
+    return VALUE_KEEP if text == "keep" else int(text, 0)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="VU-meter USB HID control client")
+    parser.add_argument("--device", help="hidraw node of the device, found by the report descriptor by default")
+    parser.add_argument("--timeout", type=float, default=1.0, help="state report timeout in seconds")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    commands.add_parser("key", help="press a remote button (consumer usage)").add_argument(
+        "usage", choices=sorted(USAGES))
+    commands.add_parser("levels", help="set the channels in one transaction, keep leaves a channel").add_argument(
+        "values", type=parse_value, nargs="+", metavar="VALUE|keep")
+    for name in ("preset-store", "preset-recall"):
+        commands.add_parser(name).add_argument("slot", type=int)
+    args = parser.parse_args()
+
+    try:
+        client = HidClient(args.device or find_device(), args.timeout)
+    except (HidError, OSError) as error:
+        print(error, file=sys.stderr)
+        return 1
+
+    try:
+        if args.command == "key":
+            status, values = client.key(USAGES[args.usage])
+        elif args.command == "levels":
+            status, values = client.levels(args.values)
+        else:
+            action = PRESET_STORE if args.command == "preset-store" else PRESET_RECALL
+            status, values = client.preset(action, args.slot)
+    except (HidError, OSError) as error:
+        print(error, file=sys.stderr)
+        return 1
+    finally:
+        client.close()
+
+    print(json.dumps({"status": STATUS_NAMES.get(status, "status %d" % status), "values": values}))
+    return 0 if status in (STATUS_OK, STATUS_UNCHANGED) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())